@@ -0,0 +1,170 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief FindBiasedFeatures Determines which Features of a 3D volume are biased by its outer surface. For every
+ * phase the bounding box is shrunk, one side at a time, onto the centroids of the surface Features that lie
+ * inside it; every Feature whose centroid lies on or outside the shrunken box is flagged as biased.
+ * @param boundingBox Bounding box of the volume as {xMin, xMax, yMin, yMax, zMin, zMax}
+ * @param centroids Interleaved x, y, z centroid of every Feature
+ * @param surfaceFeatures Whether each Feature touches the outer surface
+ * @param phases Phase of every Feature, or nullptr to treat all Features as a single phase
+ * @param numFeatures Number of Features, including Feature 0 which is skipped
+ * @param biasedFeatures Set to true for every biased Feature; other entries are left untouched
+ * @param notifyPhase Called as notifyPhase(phase, numPhases) before each phase when phases is given
+ */
+template <typename Notify>
+void FindBiasedFeatures(const float boundingBox[6], const float* centroids, const bool* surfaceFeatures, const int32_t* phases, size_t numFeatures, bool* biasedFeatures, Notify notifyPhase)
+{
+  float boundbox[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  float coords[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  float dist[7] = {
+      0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+  };
+  float mindist = std::numeric_limits<float>::max();
+  int32_t sidetomove = 0;
+  int32_t move = 0;
+
+  // loop first to determine number of phases if calcByPhase is being used
+  int32_t numPhases = 1;
+  if(nullptr != phases)
+  {
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      if(phases[i] > numPhases)
+      {
+        numPhases = phases[i];
+      }
+    }
+  }
+  for(int32_t iter = 1; iter <= numPhases; iter++)
+  {
+    if(nullptr != phases)
+    {
+      notifyPhase(iter, numPhases);
+    }
+    // reset boundbox for each phase
+    for(size_t side = 0; side < 6; side++)
+    {
+      boundbox[side] = boundingBox[side];
+    }
+
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      if(surfaceFeatures[i] && (nullptr == phases || phases[i] == iter))
+      {
+        sidetomove = 0;
+        move = 1;
+        mindist = std::numeric_limits<float>::max();
+        coords[0] = centroids[3 * i];
+        coords[1] = centroids[3 * i];
+        coords[2] = centroids[3 * i + 1];
+        coords[3] = centroids[3 * i + 1];
+        coords[4] = centroids[3 * i + 2];
+        coords[5] = centroids[3 * i + 2];
+        for(int32_t j = 1; j < 7; j++)
+        {
+          dist[j] = std::numeric_limits<float>::max();
+          if(j % 2 == 1)
+          {
+            if(coords[j - 1] > boundbox[j - 1])
+            {
+              dist[j] = (coords[j - 1] - boundbox[j - 1]);
+            }
+            if(coords[j - 1] <= boundbox[j - 1])
+            {
+              move = 0;
+            }
+          }
+          if(j % 2 == 0)
+          {
+            if(coords[j - 1] < boundbox[j - 1])
+            {
+              dist[j] = (boundbox[j - 1] - coords[j - 1]);
+            }
+            if(coords[j - 1] >= boundbox[j - 1])
+            {
+              move = 0;
+            }
+          }
+          if(dist[j] < mindist)
+          {
+            mindist = dist[j];
+            sidetomove = j - 1;
+          }
+        }
+        if(move == 1)
+        {
+          boundbox[sidetomove] = coords[sidetomove];
+        }
+      }
+    }
+    for(size_t j = 1; j < numFeatures; j++)
+    {
+      if(nullptr == phases || phases[j] == iter)
+      {
+        if(centroids[3 * j] <= boundbox[0])
+        {
+          biasedFeatures[j] = true;
+        }
+        if(centroids[3 * j] >= boundbox[1])
+        {
+          biasedFeatures[j] = true;
+        }
+        if(centroids[3 * j + 1] <= boundbox[2])
+        {
+          biasedFeatures[j] = true;
+        }
+        if(centroids[3 * j + 1] >= boundbox[3])
+        {
+          biasedFeatures[j] = true;
+        }
+        if(centroids[3 * j + 2] <= boundbox[4])
+        {
+          biasedFeatures[j] = true;
+        }
+        if(centroids[3 * j + 2] >= boundbox[5])
+        {
+          biasedFeatures[j] = true;
+        }
+      }
+    }
+  }
+}
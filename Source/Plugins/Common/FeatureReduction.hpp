@@ -0,0 +1,207 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The CompensatedSum class is a running double precision sum that also tracks the rounding error
+ * of every addition (Kahan-Babuska/Neumaier summation). Two partial sums can be merged without losing
+ * the error terms, which makes it suitable for per-feature sums accumulated in independent blocks.
+ */
+class CompensatedSum
+{
+public:
+  void add(double value)
+  {
+    const double t = m_Sum + value;
+    if(std::fabs(m_Sum) >= std::fabs(value))
+    {
+      m_Compensation += (m_Sum - t) + value;
+    }
+    else
+    {
+      m_Compensation += (value - t) + m_Sum;
+    }
+    m_Sum = t;
+  }
+
+  void merge(const CompensatedSum& other)
+  {
+    add(other.m_Sum);
+    m_Compensation += other.m_Compensation;
+  }
+
+  double value() const
+  {
+    return m_Sum + m_Compensation;
+  }
+
+private:
+  double m_Sum = 0.0;
+  double m_Compensation = 0.0;
+};
+
+/**
+ * @brief The FeatureReduction namespace holds the shared machinery for filters that sweep every element
+ * of a geometry and accumulate a per-feature statistic keyed by the Feature Ids.
+ *
+ * Reduce() splits the elements into contiguous blocks, accumulates each block into its own array of
+ * per-feature accumulators in parallel, and then merges the blocks in block order. The blocks only
+ * depend on the number of elements, the number of features and the accumulator size, never on the
+ * number of threads, so the result is reproducible from run to run and machine to machine.
+ *
+ * OrderedFold() is for statistics that depend on the order in which elements are visited. It groups the
+ * element indices by feature, keeping them in ascending order, and then folds the features in parallel.
+ */
+namespace FeatureReduction
+{
+constexpr size_t k_MinElementsPerBlock = 65536;
+constexpr size_t k_MaxBlocks = 64;
+constexpr size_t k_MaxAccumulatorBytes = 256 * 1024 * 1024;
+
+/**
+ * @brief NumberOfBlocks Returns how many blocks Reduce() splits numElements into
+ */
+inline size_t NumberOfBlocks(size_t numElements, size_t numFeatures, size_t accumulatorBytes)
+{
+  size_t numBlocks = std::max<size_t>(1, numElements / k_MinElementsPerBlock);
+  numBlocks = std::min(numBlocks, k_MaxBlocks);
+  const size_t blockBytes = std::max<size_t>(1, numFeatures * accumulatorBytes);
+  numBlocks = std::min(numBlocks, std::max<size_t>(1, k_MaxAccumulatorBytes / blockBytes));
+  return numBlocks;
+}
+
+/**
+ * @brief Reduce Accumulates a per-feature statistic over every element
+ * @param numElements Number of elements to sweep
+ * @param numFeatures Number of features, i.e. the number of accumulators returned
+ * @param accumulate Called as accumulate(Accumulator* featureAccumulators, size_t elementIndex); it must
+ * only touch the accumulators it is handed
+ * @param merge Called as merge(Accumulator& into, const Accumulator& from) to append a later block onto an
+ * earlier one
+ * @return One accumulator per feature
+ */
+template <typename Accumulator, typename Accumulate, typename Merge>
+std::vector<Accumulator> Reduce(size_t numElements, size_t numFeatures, Accumulate accumulate, Merge merge)
+{
+  const size_t numBlocks = NumberOfBlocks(numElements, numFeatures, sizeof(Accumulator));
+  std::vector<std::vector<Accumulator>> blocks(numBlocks);
+
+  ParallelDataAlgorithm blockAlg;
+  blockAlg.setRange(0, numBlocks);
+  blockAlg.setGrain(1);
+  blockAlg.execute([&](const SIMPLRange& range) {
+    for(size_t block = range.min(); block < range.max(); block++)
+    {
+      std::vector<Accumulator> featureAccumulators(numFeatures);
+      const size_t end = numElements / numBlocks * (block + 1) + std::min(block + 1, numElements % numBlocks);
+      for(size_t i = numElements / numBlocks * block + std::min(block, numElements % numBlocks); i < end; i++)
+      {
+        accumulate(featureAccumulators.data(), i);
+      }
+      blocks[block] = std::move(featureAccumulators);
+    }
+  });
+
+  std::vector<Accumulator> result = std::move(blocks[0]);
+  if(numBlocks > 1)
+  {
+    ParallelDataAlgorithm mergeAlg;
+    mergeAlg.setRange(0, numFeatures);
+    mergeAlg.execute([&](const SIMPLRange& range) {
+      for(size_t featureId = range.min(); featureId < range.max(); featureId++)
+      {
+        for(size_t block = 1; block < numBlocks; block++)
+        {
+          merge(result[featureId], blocks[block][featureId]);
+        }
+      }
+    });
+  }
+  return result;
+}
+
+/**
+ * @brief OrderedFold Visits the elements of every feature in ascending element order, one feature per task
+ * @param featureIds Feature Id of every element; elements whose Feature Id lies outside [0, numFeatures) are skipped
+ * @param numElements Number of elements
+ * @param numFeatures Number of features
+ * @param fold Called once for every feature, including features without elements, as
+ * fold(size_t featureId, const size_t* elements, size_t numFeatureElements)
+ */
+template <typename Fold>
+void OrderedFold(const int32_t* featureIds, size_t numElements, size_t numFeatures, Fold fold)
+{
+  std::vector<size_t> offsets(numFeatures + 1, 0);
+  for(size_t i = 0; i < numElements; i++)
+  {
+    if(featureIds[i] >= 0 && static_cast<size_t>(featureIds[i]) < numFeatures)
+    {
+      offsets[featureIds[i] + 1]++;
+    }
+  }
+  for(size_t featureId = 0; featureId < numFeatures; featureId++)
+  {
+    offsets[featureId + 1] += offsets[featureId];
+  }
+  std::vector<size_t> elements(offsets[numFeatures]);
+  std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+  for(size_t i = 0; i < numElements; i++)
+  {
+    if(featureIds[i] >= 0 && static_cast<size_t>(featureIds[i]) < numFeatures)
+    {
+      elements[cursor[featureIds[i]]++] = i;
+    }
+  }
+
+  ParallelDataAlgorithm foldAlg;
+  foldAlg.setRange(0, numFeatures);
+  foldAlg.execute([&](const SIMPLRange& range) {
+    for(size_t featureId = range.min(); featureId < range.max(); featureId++)
+    {
+      fold(featureId, elements.data() + offsets[featureId], offsets[featureId + 1] - offsets[featureId]);
+    }
+  });
+}
+} // namespace FeatureReduction
@@ -0,0 +1,313 @@
+/* ============================================================================
+ * Copyright (c) 2021 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+/**
+ * @brief The MisorientationKernel class answers "is the misorientation between two quaternions
+ * below a tolerance" (and "what is the misorientation angle") without going through the virtual
+ * LaueOps interface for every voxel pair.
+ *
+ * The symmetry operators of every Ensemble are copied once into a structure of arrays. Because the
+ * rotation angle of a quaternion only depends on its scalar part, and w(S * q) = S.w * q.w - S.v . q.v,
+ * each symmetry operator costs a single 4 component dot product. The operators are padded to a
+ * multiple of 4 with the identity so the loops vectorize, and the tolerance test exits as soon as
+ * one block of operators brings the pair below the tolerance. The loops are instantiated for each
+ * symmetry group size and selected once per Ensemble.
+ *
+ * Quaternions are expected in the <x, y, z, w> layout used by the Quats arrays.
+ */
+class MisorientationKernel
+{
+public:
+  static constexpr size_t k_BlockSize = 4;
+  static constexpr size_t k_MaxSymOps = 24;
+
+  MisorientationKernel() = default;
+
+  /**
+   * @brief MisorientationKernel
+   * @param crystalStructures Crystal structure of each Ensemble
+   * @param numEnsembles Number of Ensembles (tuples in the crystal structures array)
+   * @param tolerance Misorientation tolerance in radians
+   */
+  MisorientationKernel(const uint32_t* crystalStructures, size_t numEnsembles, float tolerance)
+  : m_Tables(numEnsembles)
+  {
+    setTolerance(tolerance);
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+    for(size_t e = 0; e < numEnsembles; e++)
+    {
+      SymmetryTable& table = m_Tables[e];
+      if(crystalStructures[e] >= orientationOps.size())
+      {
+        continue;
+      }
+      const LaueOps::Pointer& ops = orientationOps[crystalStructures[e]];
+      size_t numSymOps = static_cast<size_t>(ops->getNumSymOps());
+      table.numSymOps = numSymOps;
+      table.paddedSymOps = ((numSymOps + k_BlockSize - 1) / k_BlockSize) * k_BlockSize;
+      for(size_t i = 0; i < table.paddedSymOps; i++)
+      {
+        // Padding repeats the identity, which never changes the minimum angle
+        QuatD symOp = ops->getQuatSymOp(static_cast<int>(i < numSymOps ? i : 0));
+        table.w[i] = static_cast<float>(symOp.w());
+        table.x[i] = static_cast<float>(symOp.x());
+        table.y[i] = static_cast<float>(symOp.y());
+        table.z[i] = static_cast<float>(symOp.z());
+      }
+    }
+  }
+
+  ~MisorientationKernel() = default;
+
+  MisorientationKernel(const MisorientationKernel&) = default;
+  MisorientationKernel(MisorientationKernel&&) = default;
+  MisorientationKernel& operator=(const MisorientationKernel&) = default;
+  MisorientationKernel& operator=(MisorientationKernel&&) = default;
+
+  /**
+   * @brief setTolerance Sets the misorientation tolerance in radians
+   * @param tolerance
+   */
+  void setTolerance(float tolerance)
+  {
+    m_Tolerance = tolerance;
+    m_CosHalfTolerance = std::cos(0.5f * tolerance);
+  }
+
+  /**
+   * @brief getTolerance
+   * @return The misorientation tolerance in radians
+   */
+  float getTolerance() const
+  {
+    return m_Tolerance;
+  }
+
+  /**
+   * @brief isValidEnsemble Returns false for Ensembles with an unknown crystal structure
+   * @param ensemble
+   * @return
+   */
+  bool isValidEnsemble(int32_t ensemble) const
+  {
+    return ensemble >= 0 && static_cast<size_t>(ensemble) < m_Tables.size() && m_Tables[ensemble].numSymOps > 0;
+  }
+
+  /**
+   * @brief isBelowTolerance Returns true if the misorientation between q1 and q2, both belonging to
+   * the given Ensemble, is strictly below the tolerance
+   */
+  bool isBelowTolerance(int32_t ensemble, const float* q1, const float* q2) const
+  {
+    if(!isValidEnsemble(ensemble))
+    {
+      return false;
+    }
+    const SymmetryTable& table = m_Tables[ensemble];
+    switch(table.paddedSymOps)
+    {
+    case 4:
+      return IsBelowTolerance<4>(table, q1, q2, m_CosHalfTolerance);
+    case 8:
+      return IsBelowTolerance<8>(table, q1, q2, m_CosHalfTolerance);
+    case 12:
+      return IsBelowTolerance<12>(table, q1, q2, m_CosHalfTolerance);
+    default:
+      return IsBelowTolerance<24>(table, q1, q2, m_CosHalfTolerance);
+    }
+  }
+
+  /**
+   * @brief misorientationAngle Returns the misorientation angle in radians between q1 and q2, both
+   * belonging to the given Ensemble, or the maximum float value for an unknown crystal structure
+   */
+  float misorientationAngle(int32_t ensemble, const float* q1, const float* q2) const
+  {
+    if(!isValidEnsemble(ensemble))
+    {
+      return std::numeric_limits<float>::max();
+    }
+    const SymmetryTable& table = m_Tables[ensemble];
+    float qr[4];
+    RelativeRotation(q1, q2, qr);
+    size_t best = 0;
+    switch(table.paddedSymOps)
+    {
+    case 4:
+      best = BestSymOp<4>(table, qr);
+      break;
+    case 8:
+      best = BestSymOp<8>(table, qr);
+      break;
+    case 12:
+      best = BestSymOp<12>(table, qr);
+      break;
+    default:
+      best = BestSymOp<24>(table, qr);
+      break;
+    }
+    // Small angles are resolved from the vector part, acos(w) loses them in single precision
+    const float sw = table.w[best];
+    const float sx = table.x[best];
+    const float sy = table.y[best];
+    const float sz = table.z[best];
+    const float w = sw * qr[3] - sx * qr[0] - sy * qr[1] - sz * qr[2];
+    const float x = sw * qr[0] + qr[3] * sx + sy * qr[2] - sz * qr[1];
+    const float y = sw * qr[1] + qr[3] * sy + sz * qr[0] - sx * qr[2];
+    const float z = sw * qr[2] + qr[3] * sz + sx * qr[1] - sy * qr[0];
+    return 2.0f * std::atan2(std::sqrt(x * x + y * y + z * z), std::fabs(w));
+  }
+
+  /**
+   * @brief countBelowTolerance Batched form of isBelowTolerance: compares the reference quaternion
+   * against the quaternions of every listed neighbor, dispatching on the symmetry group only once
+   * @param ensemble Ensemble of the reference and all neighbors
+   * @param q1 Reference quaternion
+   * @param quats Start of the Quats array
+   * @param neighbors Tuple indices into the Quats array
+   * @param count Number of neighbors
+   * @return Number of neighbors whose misorientation is below the tolerance
+   */
+  size_t countBelowTolerance(int32_t ensemble, const float* q1, const float* quats, const int64_t* neighbors, size_t count) const
+  {
+    if(!isValidEnsemble(ensemble))
+    {
+      return 0;
+    }
+    const SymmetryTable& table = m_Tables[ensemble];
+    switch(table.paddedSymOps)
+    {
+    case 4:
+      return CountBelowTolerance<4>(table, q1, quats, neighbors, count, m_CosHalfTolerance);
+    case 8:
+      return CountBelowTolerance<8>(table, q1, quats, neighbors, count, m_CosHalfTolerance);
+    case 12:
+      return CountBelowTolerance<12>(table, q1, quats, neighbors, count, m_CosHalfTolerance);
+    default:
+      return CountBelowTolerance<24>(table, q1, quats, neighbors, count, m_CosHalfTolerance);
+    }
+  }
+
+private:
+  struct SymmetryTable
+  {
+    size_t numSymOps = 0;
+    size_t paddedSymOps = 0;
+    alignas(16) std::array<float, k_MaxSymOps> w = {};
+    alignas(16) std::array<float, k_MaxSymOps> x = {};
+    alignas(16) std::array<float, k_MaxSymOps> y = {};
+    alignas(16) std::array<float, k_MaxSymOps> z = {};
+  };
+
+  /**
+   * @brief RelativeRotation Computes q1 * conjugate(q2), returned in <x, y, z, w> order
+   */
+  static inline void RelativeRotation(const float* q1, const float* q2, float* qr)
+  {
+    // q2 conjugate
+    const float bx = -q2[0];
+    const float by = -q2[1];
+    const float bz = -q2[2];
+    const float bw = q2[3];
+    qr[0] = q1[3] * bx + q1[0] * bw + q1[1] * bz - q1[2] * by;
+    qr[1] = q1[3] * by + q1[1] * bw + q1[2] * bx - q1[0] * bz;
+    qr[2] = q1[3] * bz + q1[2] * bw + q1[0] * by - q1[1] * bx;
+    qr[3] = q1[3] * bw - q1[0] * bx - q1[1] * by - q1[2] * bz;
+  }
+
+  template <size_t PaddedSymOps>
+  static inline bool IsBelowTolerance(const SymmetryTable& table, const float* q1, const float* q2, float cosHalfTolerance)
+  {
+    float qr[4];
+    RelativeRotation(q1, q2, qr);
+    for(size_t block = 0; block < PaddedSymOps; block += k_BlockSize)
+    {
+      float blockMax = 0.0f;
+      for(size_t i = block; i < block + k_BlockSize; i++)
+      {
+        float w = table.w[i] * qr[3] - table.x[i] * qr[0] - table.y[i] * qr[1] - table.z[i] * qr[2];
+        blockMax = std::max(blockMax, std::fabs(w));
+      }
+      if(blockMax > cosHalfTolerance)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <size_t PaddedSymOps>
+  static inline size_t BestSymOp(const SymmetryTable& table, const float* qr)
+  {
+    float maxW = -1.0f;
+    size_t best = 0;
+    for(size_t i = 0; i < PaddedSymOps; i++)
+    {
+      float w = std::fabs(table.w[i] * qr[3] - table.x[i] * qr[0] - table.y[i] * qr[1] - table.z[i] * qr[2]);
+      if(w > maxW)
+      {
+        maxW = w;
+        best = i;
+      }
+    }
+    return best;
+  }
+
+  template <size_t PaddedSymOps>
+  static inline size_t CountBelowTolerance(const SymmetryTable& table, const float* q1, const float* quats, const int64_t* neighbors, size_t count, float cosHalfTolerance)
+  {
+    size_t numBelow = 0;
+    for(size_t n = 0; n < count; n++)
+    {
+      if(IsBelowTolerance<PaddedSymOps>(table, q1, quats + neighbors[n] * 4, cosHalfTolerance))
+      {
+        numBelow++;
+      }
+    }
+    return numBelow;
+  }
+
+  std::vector<SymmetryTable> m_Tables;
+  float m_Tolerance = 0.0f;
+  float m_CosHalfTolerance = 1.0f;
+};
@@ -0,0 +1,165 @@
+/* ============================================================================
+ * Copyright (c) 2021 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief The PhiloxRandom class is a counter based random number generator (Philox4x32-10, Salmon et al.,
+ * "Parallel Random Numbers: As Easy as 1, 2, 3", SC11).
+ *
+ * Every number is a pure function of (seed, stream, position), so a filter can hand each thread, chunk or
+ * Feature its own stream and get the same sequence no matter how the work is scheduled. Filters that take
+ * a user seed give every random decision its own stream id, so reusing one seed across a pipeline does not
+ * correlate the filters with each other.
+ *
+ * The class satisfies the UniformRandomBitGenerator requirements, and genrand_res53() matches the interface
+ * of the SIMPLib generator so it can replace it directly.
+ */
+class PhiloxRandom
+{
+public:
+  using result_type = uint64_t;
+
+  /**
+   * @brief PhiloxRandom
+   * @param seed Key of the generator, normally the seed of the filter
+   * @param stream Index of the independent stream within that seed
+   */
+  PhiloxRandom(uint64_t seed, uint64_t stream)
+  : m_Key({static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)})
+  , m_Stream(stream)
+  {
+  }
+
+  static constexpr result_type min()
+  {
+    return 0;
+  }
+
+  static constexpr result_type max()
+  {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  /**
+   * @brief operator () Returns the next 64 random bits of the stream
+   */
+  result_type operator()()
+  {
+    if(m_Next >= 2)
+    {
+      m_Block = generateBlock(m_Counter++);
+      m_Next = 0;
+    }
+    const size_t word = 2 * m_Next++;
+    return (static_cast<uint64_t>(m_Block[word + 1]) << 32) | m_Block[word];
+  }
+
+  /**
+   * @brief genrand_res53 Returns a uniformly distributed double in [0, 1) with 53 bit resolution
+   */
+  double genrand_res53()
+  {
+    return static_cast<double>((*this)() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  /**
+   * @brief genrand_index Returns a uniformly distributed index in [0, count)
+   */
+  uint64_t genrand_index(uint64_t count)
+  {
+    return static_cast<uint64_t>(genrand_res53() * static_cast<double>(count));
+  }
+
+  /**
+   * @brief ResolveSeed Returns the fixed seed if one was requested, otherwise a seed taken from the clock
+   */
+  static uint64_t ResolveSeed(bool useFixedSeed, uint64_t fixedSeed)
+  {
+    if(useFixedSeed)
+    {
+      return fixedSeed;
+    }
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+  }
+
+  /**
+   * @brief StreamId Builds a stream id from the filter, the kind of random decision and an index (Feature, chunk, ...)
+   */
+  static constexpr uint64_t StreamId(uint64_t filter, uint64_t purpose, uint64_t index)
+  {
+    return (filter << 48) | ((purpose & 0xFFFF) << 32) | (index & 0xFFFFFFFF);
+  }
+
+  /**
+   * @brief StreamSeed Derives a 32 bit seed for a generator that can only be seeded, one per stream
+   */
+  static uint32_t StreamSeed(uint64_t seed, uint64_t stream)
+  {
+    return static_cast<uint32_t>(PhiloxRandom(seed, stream)() >> 32);
+  }
+
+private:
+  using Block = std::array<uint32_t, 4>;
+
+  Block generateBlock(uint64_t counter) const
+  {
+    constexpr uint32_t k_M0 = 0xD2511F53;
+    constexpr uint32_t k_M1 = 0xCD9E8D57;
+    constexpr uint32_t k_W0 = 0x9E3779B9;
+    constexpr uint32_t k_W1 = 0xBB67AE85;
+
+    Block ctr = {static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), static_cast<uint32_t>(m_Stream), static_cast<uint32_t>(m_Stream >> 32)};
+    std::array<uint32_t, 2> key = m_Key;
+    for(int32_t round = 0; round < 10; round++)
+    {
+      const uint64_t product0 = static_cast<uint64_t>(k_M0) * ctr[0];
+      const uint64_t product1 = static_cast<uint64_t>(k_M1) * ctr[2];
+      ctr = {static_cast<uint32_t>(product1 >> 32) ^ ctr[1] ^ key[0], static_cast<uint32_t>(product1), static_cast<uint32_t>(product0 >> 32) ^ ctr[3] ^ key[1], static_cast<uint32_t>(product0)};
+      key[0] += k_W0;
+      key[1] += k_W1;
+    }
+    return ctr;
+  }
+
+  std::array<uint32_t, 2> m_Key;
+  uint64_t m_Stream = 0;
+  uint64_t m_Counter = 0;
+  Block m_Block = {0, 0, 0, 0};
+  size_t m_Next = 2;
+};
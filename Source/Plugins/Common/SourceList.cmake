@@ -0,0 +1,18 @@
+#--////////////////////////////////////////////////////////////////////////////
+#-- Header only support files shared by several of the DREAM3D core plugins.
+#-- Each plugin that includes one of these headers ("Common/<Header>.hpp")
+#-- includes this file right after its own filter SourceList.cmake.
+#--////////////////////////////////////////////////////////////////////////////
+
+get_filename_component(DREAM3D_Common_SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}" ABSOLUTE)
+
+set(DREAM3D_Common_HDRS
+  ${DREAM3D_Common_SOURCE_DIR}/BiasedFeatures.hpp
+  ${DREAM3D_Common_SOURCE_DIR}/FeatureReduction.hpp
+  ${DREAM3D_Common_SOURCE_DIR}/MisorientationKernel.hpp
+  ${DREAM3D_Common_SOURCE_DIR}/PhiloxRandom.hpp
+  ${DREAM3D_Common_SOURCE_DIR}/TupleIndexMap.hpp
+)
+cmp_IDE_SOURCE_PROPERTIES( "Common" "${DREAM3D_Common_HDRS}" "" "0")
+
+set(Project_SRCS ${Project_SRCS} ${DREAM3D_Common_HDRS})
@@ -0,0 +1,185 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The TupleIndexMap class records, for every tuple of an Attribute Matrix, which tuple it should be
+ * overwritten with, and then applies that remapping to any number of arrays at once. This replaces loops
+ * that call IDataArray::copyTuple() once per tuple per array: the list of moves is compacted once and each
+ * array is then remapped with a typed, parallel gather into a scratch buffer followed by a parallel scatter.
+ *
+ * Every destination receives the value its source tuple held before apply() was called, so the order in
+ * which the moves were recorded does not matter.
+ */
+class TupleIndexMap
+{
+public:
+  static constexpr int64_t k_KeepTuple = -1;
+  static constexpr int64_t k_ZeroTuple = -2;
+
+  explicit TupleIndexMap(size_t numTuples)
+  : m_Sources(numTuples, k_KeepTuple)
+  {
+  }
+
+  /**
+   * @brief copyTuple Overwrites tuple destination with tuple source. Different destinations may be recorded
+   * concurrently.
+   */
+  void copyTuple(size_t source, size_t destination)
+  {
+    m_Sources[destination] = static_cast<int64_t>(source);
+  }
+
+  /**
+   * @brief zeroTuple Sets every component of tuple destination to zero
+   */
+  void zeroTuple(size_t destination)
+  {
+    m_Sources[destination] = k_ZeroTuple;
+  }
+
+  /**
+   * @brief apply Remaps every named array of the Attribute Matrix. Arrays that are not a DataArray of a
+   * primitive type fall back to IDataArray::copyFromArray() from a copy of the original array.
+   * @param filter Optional filter that receives a progress message before each array is remapped and whose
+   * cancel flag is checked between arrays
+   */
+  void apply(const AttributeMatrix::Pointer& attrMat, const QList<QString>& arrayNames, AbstractFilter* filter = nullptr) const
+  {
+    std::vector<size_t> destinations;
+    std::vector<int64_t> sources;
+    for(size_t i = 0; i < m_Sources.size(); i++)
+    {
+      if(m_Sources[i] != k_KeepTuple)
+      {
+        destinations.push_back(i);
+        sources.push_back(m_Sources[i]);
+      }
+    }
+    if(destinations.empty())
+    {
+      return;
+    }
+
+    for(int32_t a = 0; a < arrayNames.size(); a++)
+    {
+      if(nullptr != filter)
+      {
+        if(filter->getCancel())
+        {
+          return;
+        }
+        int32_t progressInt = static_cast<int32_t>((static_cast<float>(a) / static_cast<float>(arrayNames.size())) * 100.0f);
+        QString ss = QObject::tr("Transferring Cell Data %1%").arg(progressInt);
+        filter->notifyStatusMessage(ss);
+      }
+      IDataArray::Pointer p = attrMat->getAttributeArray(arrayNames[a]);
+      if(nullptr == p.get())
+      {
+        continue;
+      }
+      if(!(applyTyped<int8_t>(p, destinations, sources) || applyTyped<uint8_t>(p, destinations, sources) || applyTyped<int16_t>(p, destinations, sources) ||
+           applyTyped<uint16_t>(p, destinations, sources) || applyTyped<int32_t>(p, destinations, sources) || applyTyped<uint32_t>(p, destinations, sources) ||
+           applyTyped<int64_t>(p, destinations, sources) || applyTyped<uint64_t>(p, destinations, sources) || applyTyped<float>(p, destinations, sources) ||
+           applyTyped<double>(p, destinations, sources) || applyTyped<bool>(p, destinations, sources)))
+      {
+        IDataArray::Pointer original = p->deepCopy();
+        for(size_t m = 0; m < destinations.size(); m++)
+        {
+          if(sources[m] >= 0)
+          {
+            p->copyFromArray(destinations[m], original, static_cast<size_t>(sources[m]), 1);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  std::vector<int64_t> m_Sources;
+
+  template <typename T>
+  static bool applyTyped(const IDataArray::Pointer& p, const std::vector<size_t>& destinations, const std::vector<int64_t>& sources)
+  {
+    typename DataArray<T>::Pointer array = std::dynamic_pointer_cast<DataArray<T>>(p);
+    if(nullptr == array.get())
+    {
+      return false;
+    }
+    const size_t numComps = array->getNumberOfComponents();
+    T* data = array->getPointer(0);
+    // Not a std::vector so that bool arrays get a plain contiguous buffer as well
+    std::unique_ptr<T[]> buffer(new T[destinations.size() * numComps]());
+
+    ParallelDataAlgorithm gather;
+    gather.setRange(0ULL, destinations.size());
+    gather.execute([&](const SIMPLRange& range) {
+      for(size_t m = range.min(); m < range.max(); m++)
+      {
+        if(sources[m] >= 0)
+        {
+          std::copy_n(data + static_cast<size_t>(sources[m]) * numComps, numComps, buffer.get() + m * numComps);
+        }
+      }
+    });
+
+    ParallelDataAlgorithm scatter;
+    scatter.setRange(0ULL, destinations.size());
+    scatter.execute([&](const SIMPLRange& range) {
+      for(size_t m = range.min(); m < range.max(); m++)
+      {
+        std::copy_n(buffer.get() + m * numComps, numComps, data + destinations[m] * numComps);
+      }
+    });
+    return true;
+  }
+};
@@ -47,6 +47,8 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Common/BiasedFeatures.hpp"
+
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
 
@@ -183,127 +185,14 @@ void FindBoundingBoxFeatures::dataCheck()
 void FindBoundingBoxFeatures::find_boundingboxfeatures()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getCentroidsArrayPath().getDataContainerName());
-  ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
-
-  size_t size = m_CentroidsPtr.lock()->getNumberOfTuples();
   float boundbox[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
-  float coords[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
-  float x = 0.0f;
-  float y = 0.0f;
-  float z = 0.0f;
-  float dist[7] = {
-      0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-  };
-  float mindist = std::numeric_limits<float>::max();
-  int32_t sidetomove = 0;
-  int32_t move = 0;
-
-  // loop first to determine number of phases if calcByPhase is being used
-  int32_t numPhases = 1;
-  if(m_CalcByPhase)
-  {
-    for(size_t i = 1; i < size; i++)
-    {
-      if(m_Phases[i] > numPhases)
-      {
-        numPhases = m_Phases[i];
-      }
-    }
-  }
-  for(int32_t iter = 1; iter <= numPhases; iter++)
-  {
-    if(m_CalcByPhase)
-    {
-      QString ss = QObject::tr("Working on Phase %1 of %2").arg(iter).arg(numPhases);
-      notifyStatusMessage(ss);
-    }
-    // reset boundbox for each phase
-    imageGeom->getBoundingBox(boundbox);
+  m->getGeometryAs<ImageGeom>()->getBoundingBox(boundbox);
 
-    for(size_t i = 1; i < size; i++)
-    {
-      if(m_SurfaceFeatures[i] && (!m_CalcByPhase || m_Phases[i] == iter))
-      {
-        sidetomove = 0;
-        move = 1;
-        mindist = std::numeric_limits<float>::max();
-        x = m_Centroids[3 * i];
-        y = m_Centroids[3 * i + 1];
-        z = m_Centroids[3 * i + 2];
-        coords[0] = x;
-        coords[1] = x;
-        coords[2] = y;
-        coords[3] = y;
-        coords[4] = z;
-        coords[5] = z;
-        for(int32_t j = 1; j < 7; j++)
-        {
-          dist[j] = std::numeric_limits<float>::max();
-          if(j % 2 == 1)
-          {
-            if(coords[j - 1] > boundbox[j - 1])
-            {
-              dist[j] = (coords[j - 1] - boundbox[j - 1]);
-            }
-            if(coords[j - 1] <= boundbox[j - 1])
-            {
-              move = 0;
-            }
-          }
-          if(j % 2 == 0)
-          {
-            if(coords[j - 1] < boundbox[j - 1])
-            {
-              dist[j] = (boundbox[j - 1] - coords[j - 1]);
-            }
-            if(coords[j - 1] >= boundbox[j - 1])
-            {
-              move = 0;
-            }
-          }
-          if(dist[j] < mindist)
-          {
-            mindist = dist[j];
-            sidetomove = j - 1;
-          }
-        }
-        if(move == 1)
-        {
-          boundbox[sidetomove] = coords[sidetomove];
-        }
-      }
-    }
-    for(size_t j = 1; j < size; j++)
-    {
-      if(!m_CalcByPhase || m_Phases[j] == iter)
-      {
-        if(m_Centroids[3 * j] <= boundbox[0])
-        {
-          m_BiasedFeatures[j] = true;
-        }
-        if(m_Centroids[3 * j] >= boundbox[1])
-        {
-          m_BiasedFeatures[j] = true;
-        }
-        if(m_Centroids[3 * j + 1] <= boundbox[2])
-        {
-          m_BiasedFeatures[j] = true;
-        }
-        if(m_Centroids[3 * j + 1] >= boundbox[3])
-        {
-          m_BiasedFeatures[j] = true;
-        }
-        if(m_Centroids[3 * j + 2] <= boundbox[4])
-        {
-          m_BiasedFeatures[j] = true;
-        }
-        if(m_Centroids[3 * j + 2] >= boundbox[5])
-        {
-          m_BiasedFeatures[j] = true;
-        }
-      }
-    }
-  }
+  FindBiasedFeatures(boundbox, m_Centroids, m_SurfaceFeatures, m_CalcByPhase ? m_Phases : nullptr, m_CentroidsPtr.lock()->getNumberOfTuples(), m_BiasedFeatures,
+                     [this](int32_t phase, int32_t numPhases) {
+                       QString ss = QObject::tr("Working on Phase %1 of %2").arg(phase).arg(numPhases);
+                       notifyStatusMessage(ss);
+                     });
 }
 
 // -----------------------------------------------------------------------------
@@ -35,6 +35,7 @@
 #include "FindFeatureCentroids.h"
 
 #include <array>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -47,6 +48,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Common/FeatureReduction.hpp"
+
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
 
@@ -142,75 +145,41 @@ void FindFeatureCentroids::find_centroids()
   size_t yPoints = imageGeom->getYPoints();
   size_t zPoints = imageGeom->getZPoints();
 
-  //Copy the Coords into an array and then compute the sum
-
-  std::vector<double> sum(totalFeatures * 3, 0.0);
-  std::vector<double> c(totalFeatures * 3, 0.0);
-  std::vector<size_t> count(totalFeatures * 3, 0.0);
+  struct CentroidSum
+  {
+    std::array<CompensatedSum, 3> sum;
+    size_t count = 0;
+  };
 
-  std::array<float, 3> voxel_center = {0.0f, 0.0f, 0.0f};
+  // Sum the voxel centers of every Feature in parallel blocks
+  std::vector<CentroidSum> sums = FeatureReduction::Reduce<CentroidSum>(
+      xPoints * yPoints * zPoints, totalFeatures,
+      [&](CentroidSum* featureSums, size_t voxelIndex) {
+        std::array<float, 3> voxel_center = {0.0f, 0.0f, 0.0f};
+        imageGeom->getCoords(voxelIndex % xPoints, (voxelIndex / xPoints) % yPoints, voxelIndex / (xPoints * yPoints), voxel_center.data());
+        CentroidSum& featureSum = featureSums[m_FeatureIds[voxelIndex]];
+        featureSum.sum[0].add(voxel_center[0]);
+        featureSum.sum[1].add(voxel_center[1]);
+        featureSum.sum[2].add(voxel_center[2]);
+        featureSum.count++;
+      },
+      [](CentroidSum& into, const CentroidSum& from) {
+        into.sum[0].merge(from.sum[0]);
+        into.sum[1].merge(from.sum[1]);
+        into.sum[2].merge(from.sum[2]);
+        into.count += from.count;
+      });
 
-  size_t zStride = 0;
-  size_t yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
+  for(size_t featureId = 0; featureId < totalFeatures; featureId++)
   {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
+    if(sums[featureId].count > 0)
     {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
+      for(size_t d = 0; d < 3; d++)
       {
-        int32_t featureId = m_FeatureIds[zStride + yStride + k]; // Get the current FeatureId
-
-        imageGeom->getCoords(k, j, i, voxel_center.data()); // Get the voxel center based on XYZ index from Image Geom
-
-        //Kahan Sum for X Coord
-        size_t featureId_idx = static_cast<size_t>(featureId * 3);
-        double y = static_cast<double>(voxel_center[0] - c[featureId_idx]);
-        double t = sum[featureId_idx] + y;
-        c[featureId_idx] = (t - sum[featureId_idx]) - y;
-        sum[featureId_idx] = t;
-        count[featureId_idx]++;
-
-        //Kahan Sum for Y Coord
-        featureId_idx = static_cast<size_t>(featureId * 3 + 1);
-        y = static_cast<double>(voxel_center[1] - c[featureId_idx]);
-        t = sum[featureId_idx] + y;
-        c[featureId_idx] = (t - sum[featureId_idx]) - y;
-        sum[featureId_idx] = t;
-        count[featureId_idx]++;
-
-        //Kahan Sum for Z Coord
-        featureId_idx = static_cast<size_t>(featureId * 3 + 2);
-        y = static_cast<double>(voxel_center[2] - c[featureId_idx]);
-        t = sum[featureId_idx] + y;
-        c[featureId_idx] = (t - sum[featureId_idx]) - y;
-        sum[featureId_idx] = t;
-        count[featureId_idx]++;
+        m_Centroids[featureId * 3 + d] = sums[featureId].sum[d].value() / static_cast<double>(sums[featureId].count);
       }
     }
   }
-
-  for(size_t featureId = 0; featureId < totalFeatures; featureId++)
-  {
-    size_t featureId_idx = static_cast<size_t>(featureId * 3);
-    if(count[featureId_idx] > 0.0f)
-    {
-      m_Centroids[featureId_idx] = sum[featureId_idx] / static_cast<double>(count[featureId_idx]);
-    }
-
-    featureId_idx = static_cast<size_t>(featureId * 3 + 1);
-    if(count[featureId_idx] > 0.0f)
-    {
-      m_Centroids[featureId_idx] = sum[featureId_idx] / static_cast<double>(count[featureId_idx]);
-    }
-
-    featureId_idx = static_cast<size_t>(featureId * 3 + 2);
-    if(count[featureId_idx] > 0.0f)
-    {
-      m_Centroids[featureId_idx] = sum[featureId_idx] / static_cast<double>(count[featureId_idx]);
-    }
-  }
 }
 
 // -----------------------------------------------------------------------------
@@ -34,6 +34,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindFeaturePhases.h"
 
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -43,6 +45,8 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
+#include "Common/FeatureReduction.hpp"
+
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
 
@@ -158,33 +162,59 @@ void FindFeaturePhases::execute()
   }
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  int32_t gnum = 0;
-  QMap<int32_t, int32_t> featureMap;
+  // First pass: the phase of the first and of the last element of every Feature
+  struct PhaseSpan
+  {
+    bool found = false;
+    int32_t first = 0;
+    int32_t last = 0;
+  };
+  std::vector<PhaseSpan> spans = FeatureReduction::Reduce<PhaseSpan>(
+      totalPoints, totalFeatures,
+      [this](PhaseSpan* featureSpans, size_t i) {
+        PhaseSpan& span = featureSpans[m_FeatureIds[i]];
+        if(!span.found)
+        {
+          span.found = true;
+          span.first = m_CellPhases[i];
+        }
+        span.last = m_CellPhases[i];
+      },
+      [](PhaseSpan& into, const PhaseSpan& from) {
+        if(!into.found)
+        {
+          into = from;
+        }
+        else if(from.found)
+        {
+          into.last = from.last;
+        }
+      });
+
+  // Second pass: count the elements that disagree with the first phase found for their Feature
+  std::vector<int32_t> mismatches = FeatureReduction::Reduce<int32_t>(
+      totalPoints, totalFeatures,
+      [this, &spans](int32_t* featureMismatches, size_t i) {
+        if(m_CellPhases[i] != spans[m_FeatureIds[i]].first)
+        {
+          featureMismatches[m_FeatureIds[i]]++;
+        }
+      },
+      [](int32_t& into, const int32_t& from) { into += from; });
 
   QMap<int32_t, int32_t> warningMap;
-
-  for(size_t i = 0; i < totalPoints; i++)
+  for(size_t i = 0; i < totalFeatures; i++)
   {
-    gnum = m_FeatureIds[i];
-    if(!featureMap.contains(gnum))
+    if(spans[i].found)
     {
-      featureMap.insert(gnum, m_CellPhases[i]);
+      m_FeaturePhases[i] = spans[i].last;
     }
-    int32_t curPhaseVal = featureMap.value(gnum);
-
-    if(curPhaseVal != m_CellPhases[i])
+    if(mismatches[i] > 0)
     {
-      if(!warningMap.contains(gnum))
-      {
-        warningMap[gnum] = 1;
-      }
-      else
-      {
-        warningMap[gnum]++;
-      }
+      warningMap[static_cast<int32_t>(i)] = mismatches[i];
     }
-    m_FeaturePhases[gnum] = m_CellPhases[i];
   }
 
   if(!warningMap.empty())
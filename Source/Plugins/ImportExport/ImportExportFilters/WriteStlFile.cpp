@@ -34,6 +34,11 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "WriteStlFile.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -46,12 +51,67 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include <QtCore/QDir>
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
 
+namespace
+{
+constexpr size_t k_StlTriangleRecordSize = 50;
+
+/**
+ * @brief WriteTriangleRecord Fills one 50 byte binary STL record for a triangle. The low bit of
+ * the entry selects the backward winding used when the feature is on the second side of the face.
+ * @param nodes Vertex coordinates
+ * @param triangles Triangle vertex indices
+ * @param entry Triangle index times 2 plus the winding bit
+ * @param record Destination for the normal, the 3 vertices and the attribute byte count
+ */
+void WriteTriangleRecord(const float* nodes, const MeshIndexType* triangles, MeshIndexType entry, uint8_t* record)
+{
+  MeshIndexType t = entry / 2;
+  MeshIndexType nId0 = triangles[t * 3];
+  MeshIndexType nId1 = triangles[t * 3 + 1];
+  MeshIndexType nId2 = triangles[t * 3 + 2];
+  if((entry & 1) != 0)
+  {
+    std::swap(nId1, nId2);
+  }
+
+  float data[12] = {0.0f};
+  float* normal = data;
+  float* vert1 = data + 3;
+  float* vert2 = data + 6;
+  float* vert3 = data + 9;
+  for(size_t c = 0; c < 3; c++)
+  {
+    vert1[c] = nodes[nId0 * 3 + c];
+    vert2[c] = nodes[nId1 * 3 + c];
+    vert3[c] = nodes[nId2 * 3 + c];
+  }
+
+  // Compute the normal
+  float u[3] = {vert2[0] - vert1[0], vert2[1] - vert1[1], vert2[2] - vert1[2]};
+  float w[3] = {vert3[0] - vert1[0], vert3[1] - vert1[1], vert3[2] - vert1[2]};
+
+  normal[0] = u[1] * w[2] - u[2] * w[1];
+  normal[1] = u[2] * w[0] - u[0] * w[2];
+  normal[2] = u[0] * w[1] - u[1] * w[0];
+
+  float length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+  normal[0] = normal[0] / length;
+  normal[1] = normal[1] / length;
+  normal[2] = normal[2] / length;
+
+  ::memcpy(record, data, sizeof(data));
+  uint16_t attrByteCount = 0;
+  ::memcpy(record + sizeof(data), &attrByteCount, sizeof(attrByteCount));
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -70,6 +130,7 @@ void WriteStlFile::setupFilterParameters()
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_OUTPUT_PATH_FP("Output STL Directory", OutputStlDirectory, FilterParameter::Category::Parameter, WriteStlFile));
   parameters.push_back(SIMPL_NEW_STRING_FP("STL File Prefix", OutputStlPrefix, FilterParameter::Category::Parameter, WriteStlFile));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Write Files in Parallel", WriteFilesInParallel, FilterParameter::Category::Parameter, WriteStlFile));
   // std::vector<QString> linkedProps = {"SurfaceMeshFacePhasesArrayPath"};
   // parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Group Files by Ensemble", GroupByPhase, FilterParameter::Category::Parameter, WriteStlFile, linkedProps));
   parameters.push_back(SeparatorFilterParameter::Create("Face Data", FilterParameter::Category::RequiredArray));
@@ -92,6 +153,7 @@ void WriteStlFile::readFilterParameters(AbstractFilterParametersReader* reader,
   setSurfaceMeshFaceLabelsArrayPath(reader->readDataArrayPath("SurfaceMeshFaceLabelsArrayPath", getSurfaceMeshFaceLabelsArrayPath()));
   setOutputStlDirectory(reader->readString("OutputStlDirectory", getOutputStlDirectory()));
   setOutputStlPrefix(reader->readString("OutputStlPrefix", getOutputStlPrefix()));
+  setWriteFilesInParallel(reader->readValue("WriteFilesInParallel", getWriteFilesInParallel()));
   reader->closeFilterGroup();
 }
 
@@ -184,7 +246,6 @@ void WriteStlFile::dataCheck()
 // -----------------------------------------------------------------------------
 void WriteStlFile::execute()
 {
-  int32_t err = 0;
   clearErrorCode();
   clearWarningCode();
   dataCheck();
@@ -215,133 +276,185 @@ void WriteStlFile::execute()
     return;
   }
 
-  // Store all the unique Spins
-  QMap<int32_t, int32_t> uniqueGrainIdtoPhase;
-  if(m_GroupByPhase)
+  // Find the range of feature ids so the triangles can be bucketed by feature with a counting sort
+  int32_t minLabel = 0;
+  int32_t maxLabel = -1;
+  if(nTriangles > 0)
   {
-    for(MeshIndexType i = 0; i < nTriangles; i++)
+    minLabel = m_SurfaceMeshFaceLabels[0];
+    maxLabel = m_SurfaceMeshFaceLabels[0];
+  }
+  for(MeshIndexType i = 0; i < nTriangles * 2; i++)
+  {
+    minLabel = std::min(minLabel, m_SurfaceMeshFaceLabels[i]);
+    maxLabel = std::max(maxLabel, m_SurfaceMeshFaceLabels[i]);
+  }
+  size_t numLabels = static_cast<size_t>(static_cast<int64_t>(maxLabel) - static_cast<int64_t>(minLabel) + 1);
+
+  // Feature ids are normally dense, so each label indexes its bucket by its offset from the smallest label. When the
+  // ids are sparse and span far more values than there are face sides, the distinct labels are compacted with a sort
+  // instead so the buckets stay proportional to the mesh.
+  const size_t numSides = static_cast<size_t>(nTriangles) * 2;
+  const bool compactLabels = numLabels > 4 * numSides + 1;
+  std::vector<int32_t> sortedLabels;
+  if(compactLabels)
+  {
+    sortedLabels.assign(m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceLabels + numSides);
+    std::sort(sortedLabels.begin(), sortedLabels.end());
+    sortedLabels.erase(std::unique(sortedLabels.begin(), sortedLabels.end()), sortedLabels.end());
+    numLabels = sortedLabels.size();
+  }
+  auto labelIndexOf = [compactLabels, minLabel, &sortedLabels](int32_t label) {
+    if(compactLabels)
+    {
+      return static_cast<size_t>(std::lower_bound(sortedLabels.begin(), sortedLabels.end(), label) - sortedLabels.begin());
+    }
+    return static_cast<size_t>(static_cast<int64_t>(label) - static_cast<int64_t>(minLabel));
+  };
+
+  // Count the triangles of every feature. A face with the same feature on both sides is only written once.
+  std::vector<uint8_t> labelUsed(numLabels, 0);
+  std::vector<int32_t> labelPhase(numLabels, 0);
+  std::vector<MeshIndexType> labelOffsets(numLabels + 1, 0);
+  for(MeshIndexType i = 0; i < nTriangles; i++)
+  {
+    size_t label0 = labelIndexOf(m_SurfaceMeshFaceLabels[i * 2]);
+    size_t label1 = labelIndexOf(m_SurfaceMeshFaceLabels[i * 2 + 1]);
+    labelUsed[label0] = 1;
+    labelUsed[label1] = 1;
+    if(m_GroupByPhase)
     {
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2], m_SurfaceMeshFacePhases[i * 2]);
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2 + 1], m_SurfaceMeshFacePhases[i * 2 + 1]);
+      labelPhase[label0] = m_SurfaceMeshFacePhases[i * 2];
+      labelPhase[label1] = m_SurfaceMeshFacePhases[i * 2 + 1];
+    }
+    labelOffsets[label0 + 1]++;
+    if(label1 != label0)
+    {
+      labelOffsets[label1 + 1]++;
     }
   }
-  else
+  for(size_t l = 0; l < numLabels; l++)
   {
+    labelOffsets[l + 1] += labelOffsets[l];
+  }
+
+  // Bucket the triangles by feature, keeping them in mesh order within each feature
+  std::vector<MeshIndexType> labelTriangles(labelOffsets[numLabels]);
+  {
+    std::vector<MeshIndexType> cursor(labelOffsets.begin(), labelOffsets.end() - 1);
     for(MeshIndexType i = 0; i < nTriangles; i++)
     {
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2], 0);
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2 + 1], 0);
+      size_t label0 = labelIndexOf(m_SurfaceMeshFaceLabels[i * 2]);
+      size_t label1 = labelIndexOf(m_SurfaceMeshFaceLabels[i * 2 + 1]);
+      labelTriangles[cursor[label0]++] = i * 2;
+      if(label1 != label0)
+      {
+        // Write it using backward spin
+        labelTriangles[cursor[label1]++] = i * 2 + 1;
+      }
     }
   }
 
-  unsigned char data[50];
-  float* normal = reinterpret_cast<float*>(data);
-  float* vert1 = reinterpret_cast<float*>(data + 12);
-  float* vert2 = reinterpret_cast<float*>(data + 24);
-  float* vert3 = reinterpret_cast<float*>(data + 36);
-  uint16_t* attrByteCount = reinterpret_cast<uint16_t*>(data + 48);
-  *attrByteCount = 0;
-
-  size_t totalWritten = 0;
-  float u[3] = {0.0f, 0.0f, 0.0f}, w[3] = {0.0f, 0.0f, 0.0f};
-  float length = 0.0f;
-
-  int32_t spin = 0;
-  int32_t triCount = 0;
-
-  // Loop over the unique Spins
-  for(QMap<int32_t, int32_t>::iterator spinIter = uniqueGrainIdtoPhase.begin(); spinIter != uniqueGrainIdtoPhase.end(); ++spinIter)
+  std::vector<int32_t> uniqueLabels;
+  for(size_t l = 0; l < numLabels; l++)
   {
-    spin = spinIter.key();
+    if(labelUsed[l] != 0)
+    {
+      uniqueLabels.push_back(compactLabels ? sortedLabels[l] : static_cast<int32_t>(static_cast<int64_t>(l) + minLabel));
+    }
+  }
+
+  // Each file is assembled in memory and written with a single call
+  std::atomic<int32_t> failedSpin(0);
+  std::atomic<int32_t> failedError(0);
+  auto writeFeatureFile = [&](int32_t spin) {
+    size_t labelIndex = labelIndexOf(spin);
+    int32_t phase = labelPhase[labelIndex];
+    MeshIndexType begin = labelOffsets[labelIndex];
+    MeshIndexType end = labelOffsets[labelIndex + 1];
+    int32_t triCount = static_cast<int32_t>(end - begin);
 
     // Generate the output file name
     QString filename = getOutputStlDirectory() + "/" + getOutputStlPrefix();
     if(m_GroupByPhase)
     {
-      filename = filename + QString("Ensemble_") + QString::number(spinIter.value()) + QString("_");
+      filename = filename + QString("Ensemble_") + QString::number(phase) + QString("_");
     }
     filename = filename + QString("Feature_") + QString::number(spin) + ".stl";
-    FILE* f = fopen(filename.toLatin1().data(), "wb");
-
-    QString ss = QObject::tr("Writing STL for Feature Id %1").arg(spin);
-    notifyStatusMessage(ss);
 
-    QString header = "DREAM3D Generated For Feature ID " + QString::number(spin);
-    if(m_GroupByPhase)
+    std::vector<uint8_t> buffer(static_cast<size_t>(triCount) * k_StlTriangleRecordSize);
+    for(MeshIndexType t = begin; t < end; t++)
     {
-      header = header + " Phase " + QString::number(spinIter.value());
+      WriteTriangleRecord(nodes, triangles, labelTriangles[t], buffer.data() + (t - begin) * k_StlTriangleRecordSize);
     }
-    err = writeHeader(f, header, 0);
-    if(err < 0)
+
+    FILE* f = fopen(filename.toLatin1().data(), "wb");
+    if(nullptr == f)
     {
+      failedError = -1202;
+      failedSpin = spin;
+      return;
     }
-    triCount = 0; // Reset this to Zero. Increment for every triangle written
 
-    // Loop over all the triangles for this spin
-    for(MeshIndexType t = 0; t < nTriangles; ++t)
+    QString header = "DREAM3D Generated For Feature ID " + QString::number(spin);
+    if(m_GroupByPhase)
     {
-      // Get the true indices of the 3 nodes
-      MeshIndexType nId0 = triangles[t * 3];
-      MeshIndexType nId1 = triangles[t * 3 + 1];
-      MeshIndexType nId2 = triangles[t * 3 + 2];
+      header = header + " Phase " + QString::number(phase);
+    }
+    writeHeader(f, header, triCount);
 
-      vert1[0] = static_cast<float>(nodes[nId0 * 3]);
-      vert1[1] = static_cast<float>(nodes[nId0 * 3 + 1]);
-      vert1[2] = static_cast<float>(nodes[nId0 * 3 + 2]);
+    size_t totalWritten = fwrite(buffer.data(), 1, buffer.size(), f);
+    fclose(f);
+    if(totalWritten != buffer.size())
+    {
+      failedError = -1201;
+      failedSpin = spin;
+    }
+  };
 
-      if(m_SurfaceMeshFaceLabels[t * 2] == spin)
-      {
-        // winding = 0; // 0 = Write it using forward spin
-      }
-      else if(m_SurfaceMeshFaceLabels[t * 2 + 1] == spin)
-      {
-        // winding = 1; // Write it using backward spin
-        // Switch the 2 node indices
-        MeshIndexType temp = nId1;
-        nId1 = nId2;
-        nId2 = temp;
-      }
-      else
+  if(m_WriteFilesInParallel)
+  {
+    notifyStatusMessage(QObject::tr("Writing STL files for %1 Features").arg(uniqueLabels.size()));
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0ULL, uniqueLabels.size());
+    dataAlg.setGrain(1);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      for(size_t i = range.min(); i < range.max(); i++)
       {
-        continue; // We do not match either spin so move to the next triangle
+        // Same as the serial loop: stop before the next Feature once canceled or after a failure
+        if(getCancel() || failedError != 0)
+        {
+          return;
+        }
+        writeFeatureFile(uniqueLabels[i]);
       }
-
-      vert2[0] = static_cast<float>(nodes[nId1 * 3]);
-      vert2[1] = static_cast<float>(nodes[nId1 * 3 + 1]);
-      vert2[2] = static_cast<float>(nodes[nId1 * 3 + 2]);
-
-      vert3[0] = static_cast<float>(nodes[nId2 * 3]);
-      vert3[1] = static_cast<float>(nodes[nId2 * 3 + 1]);
-      vert3[2] = static_cast<float>(nodes[nId2 * 3 + 2]);
-
-      // Compute the normal
-      u[0] = vert2[0] - vert1[0];
-      u[1] = vert2[1] - vert1[1];
-      u[2] = vert2[2] - vert1[2];
-
-      w[0] = vert3[0] - vert1[0];
-      w[1] = vert3[1] - vert1[1];
-      w[2] = vert3[2] - vert1[2];
-
-      normal[0] = u[1] * w[2] - u[2] * w[1];
-      normal[1] = u[2] * w[0] - u[0] * w[2];
-      normal[2] = u[0] * w[1] - u[1] * w[0];
-
-      length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
-      normal[0] = normal[0] / length;
-      normal[1] = normal[1] / length;
-      normal[2] = normal[2] / length;
-
-      totalWritten = fwrite(data, 1, 50, f);
-      if(totalWritten != 50)
+    });
+  }
+  else
+  {
+    for(int32_t spin : uniqueLabels)
+    {
+      if(getCancel() || failedError != 0)
       {
-        QString ss = QObject::tr("Error Writing STL File. Not enough elements written for Feature Id %1. Wrote %2 of 50.").arg(spin).arg(totalWritten);
-        setErrorCondition(-1201, ss);
+        break;
       }
-      triCount++;
+      QString ss = QObject::tr("Writing STL for Feature Id %1").arg(spin);
+      notifyStatusMessage(ss);
+      writeFeatureFile(spin);
     }
-    fclose(f);
-    err = writeNumTrianglesToFile(filename, triCount);
+  }
+
+  if(failedError == -1202)
+  {
+    QString ss = QObject::tr("Error opening the STL file for Feature Id %1").arg(failedSpin.load());
+    setErrorCondition(-1202, ss);
+    return;
+  }
+  if(failedError == -1201)
+  {
+    QString ss = QObject::tr("Error Writing STL File. Not enough elements written for Feature Id %1.").arg(failedSpin.load());
+    setErrorCondition(-1201, ss);
+    return;
   }
 
   clearErrorCode();
@@ -351,7 +464,7 @@ void WriteStlFile::execute()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int32_t WriteStlFile::writeHeader(FILE* f, const QString& header, int32_t triCount)
+int32_t WriteStlFile::writeHeader(FILE* f, const QString& header, int32_t triCount) const
 {
   if(nullptr == f)
   {
@@ -373,22 +486,6 @@ int32_t WriteStlFile::writeHeader(FILE* f, const QString& header, int32_t triCou
   return 0;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int32_t WriteStlFile::writeNumTrianglesToFile(const QString& filename, int32_t triCount)
-{
-  // We need to update the number of triangles in the file
-  int32_t err = 0;
-
-  FILE* out = fopen(filename.toLatin1().data(), "r+b");
-  fseek(out, 80L, SEEK_SET);
-  fwrite(reinterpret_cast<char*>(&triCount), 1, 4, out);
-  fclose(out);
-
-  return err;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -525,6 +622,18 @@ bool WriteStlFile::getGroupByPhase() const
   return m_GroupByPhase;
 }
 
+// -----------------------------------------------------------------------------
+void WriteStlFile::setWriteFilesInParallel(bool value)
+{
+  m_WriteFilesInParallel = value;
+}
+
+// -----------------------------------------------------------------------------
+bool WriteStlFile::getWriteFilesInParallel() const
+{
+  return m_WriteFilesInParallel;
+}
+
 // -----------------------------------------------------------------------------
 void WriteStlFile::setSurfaceMeshFaceLabelsArrayPath(const DataArrayPath& value)
 {
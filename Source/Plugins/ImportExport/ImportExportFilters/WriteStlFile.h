@@ -58,6 +58,7 @@ class ImportExport_EXPORT WriteStlFile : public AbstractFilter
   PYB11_PROPERTY(QString OutputStlDirectory READ getOutputStlDirectory WRITE setOutputStlDirectory)
   PYB11_PROPERTY(QString OutputStlPrefix READ getOutputStlPrefix WRITE setOutputStlPrefix)
   PYB11_PROPERTY(bool GroupByPhase READ getGroupByPhase WRITE setGroupByPhase)
+  PYB11_PROPERTY(bool WriteFilesInParallel READ getWriteFilesInParallel WRITE setWriteFilesInParallel)
   PYB11_PROPERTY(DataArrayPath SurfaceMeshFaceLabelsArrayPath READ getSurfaceMeshFaceLabelsArrayPath WRITE setSurfaceMeshFaceLabelsArrayPath)
   PYB11_PROPERTY(DataArrayPath SurfaceMeshFacePhasesArrayPath READ getSurfaceMeshFacePhasesArrayPath WRITE setSurfaceMeshFacePhasesArrayPath)
   PYB11_END_BINDINGS()
@@ -127,6 +128,17 @@ public:
   bool getGroupByPhase() const;
   Q_PROPERTY(bool GroupByPhase READ getGroupByPhase WRITE setGroupByPhase)
 
+  /**
+   * @brief Setter property for WriteFilesInParallel
+   */
+  void setWriteFilesInParallel(bool value);
+  /**
+   * @brief Getter property for WriteFilesInParallel
+   * @return Value of WriteFilesInParallel
+   */
+  bool getWriteFilesInParallel() const;
+  Q_PROPERTY(bool WriteFilesInParallel READ getWriteFilesInParallel WRITE setWriteFilesInParallel)
+
   /**
    * @brief Setter property for SurfaceMeshFaceLabelsArrayPath
    */
@@ -242,6 +254,7 @@ private:
   QString m_OutputStlDirectory = {""};
   QString m_OutputStlPrefix = {""};
   bool m_GroupByPhase = {false};
+  bool m_WriteFilesInParallel = {false};
   DataArrayPath m_SurfaceMeshFaceLabelsArrayPath = {SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels};
   DataArrayPath m_SurfaceMeshFacePhasesArrayPath = {SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFacePhases};
 
@@ -252,15 +265,7 @@ private:
    * @param triCount Number of triangles
    * @return Integer error value
    */
-  int32_t writeHeader(FILE* f, const QString& header, int32_t triCount);
-
-  /**
-   * @brief writeNumTrianglesToFile Writes the number of triangles to the STL file
-   * @param filename Name of the output file
-   * @param triCount Number of triangles
-   * @return Integer error value
-   */
-  int32_t writeNumTrianglesToFile(const QString& filename, int32_t triCount);
+  int32_t writeHeader(FILE* f, const QString& header, int32_t triCount) const;
 
 public:
   WriteStlFile(const WriteStlFile&) = delete;            // Copy Constructor Not Implemented
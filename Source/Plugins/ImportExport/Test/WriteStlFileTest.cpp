@@ -0,0 +1,253 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "ImportExport/ImportExportFilters/WriteStlFile.h"
+#include "ImportExportTestFileLocations.h"
+
+/**
+ * @brief The WriteStlFileTest class writes the STL files of a small labeled mesh and reads them back, checking that
+ * every Feature gets exactly its own triangles in mesh order, flipped when the Feature is on the second side of a
+ * face. It runs with dense Feature Ids, which are bucketed by value, and with sparse Ids spanning the whole int32
+ * range, which are compacted first.
+ */
+class WriteStlFileTest
+{
+  const QString k_DataContainerName = QString("TriangleDataContainer");
+  const QString k_FaceAttrMatName = QString("FaceData");
+  const QString k_FaceLabelsName = QString("FaceLabels");
+  const QString k_Prefix = QString("Mesh_");
+  static constexpr size_t k_NumTris = 6;
+  static constexpr size_t k_HeaderSize = 84;
+  static constexpr size_t k_RecordSize = 50;
+
+public:
+  WriteStlFileTest() = default;
+  virtual ~WriteStlFileTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QDir(UnitTest::WriteStlFileTest::OutputDir).removeRecursively();
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  // The labels of each triangle come from the ids table: {0, 1} is the first pair of ids and so on. The last
+  // triangle has the same Feature on both sides and must only be written once for it.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateMesh(const std::array<int32_t, 4>& ids)
+  {
+    const int32_t labelIndices[k_NumTris][2] = {{0, 1}, {1, 2}, {2, 0}, {3, 1}, {0, 3}, {2, 2}};
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    SharedVertexList::Pointer vertexList = TriangleGeom::CreateSharedVertexList(5);
+    TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(k_NumTris, vertexList, SIMPL::Geometry::TriangleGeometry);
+    dc->setGeometry(triangleGeom);
+    const float coords[5][3] = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}};
+    const MeshIndexType tris[k_NumTris][3] = {{0, 1, 2}, {0, 1, 3}, {0, 2, 3}, {1, 2, 3}, {1, 2, 4}, {2, 3, 4}};
+    std::memcpy(triangleGeom->getVertexPointer(0), coords, sizeof(coords));
+    std::memcpy(triangleGeom->getTriPointer(0), tris, sizeof(tris));
+
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New({k_NumTris}, k_FaceAttrMatName, AttributeMatrix::Type::Face);
+    dc->addOrReplaceAttributeMatrix(faceAttrMat);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(k_NumTris, std::vector<size_t>(1, 2), k_FaceLabelsName, true);
+    for(size_t t = 0; t < k_NumTris; t++)
+    {
+      faceLabels->setComponent(t, 0, ids[labelIndices[t][0]]);
+      faceLabels->setComponent(t, 1, ids[labelIndices[t][1]]);
+    }
+    faceAttrMat->insertOrAssign(faceLabels);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The expected vertex coordinates of every record, per Feature: the triangles that carry the Feature in mesh
+  // order, with the second and third vertex swapped when the Feature is the second label.
+  // -----------------------------------------------------------------------------
+  std::map<int32_t, std::vector<float>> ExpectedRecords(const DataContainerArray::Pointer& dca)
+  {
+    DataContainer::Pointer dc = dca->getDataContainer(k_DataContainerName);
+    TriangleGeom::Pointer triangleGeom = dc->getGeometryAs<TriangleGeom>();
+    Int32ArrayType::Pointer faceLabels = dc->getAttributeMatrix(k_FaceAttrMatName)->getAttributeArrayAs<Int32ArrayType>(k_FaceLabelsName);
+    const float* nodes = triangleGeom->getVertexPointer(0);
+    const MeshIndexType* tris = triangleGeom->getTriPointer(0);
+
+    std::map<int32_t, std::vector<float>> expected;
+    for(size_t t = 0; t < k_NumTris; t++)
+    {
+      for(size_t side = 0; side < 2; side++)
+      {
+        int32_t label = faceLabels->getComponent(t, side);
+        if(side == 1 && label == faceLabels->getComponent(t, 0))
+        {
+          continue;
+        }
+        MeshIndexType order[3] = {tris[3 * t], tris[3 * t + 1], tris[3 * t + 2]};
+        if(side == 1)
+        {
+          std::swap(order[1], order[2]);
+        }
+        std::vector<float>& records = expected[label];
+        for(MeshIndexType v : order)
+        {
+          records.insert(records.end(), nodes + 3 * v, nodes + 3 * v + 3);
+        }
+      }
+    }
+    return expected;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int WriteAndCompare(const std::array<int32_t, 4>& ids, bool writeInParallel)
+  {
+    QDir outputDir(UnitTest::WriteStlFileTest::OutputDir);
+    outputDir.removeRecursively();
+
+    DataContainerArray::Pointer dca = CreateMesh(ids);
+    WriteStlFile::Pointer filter = WriteStlFile::New();
+    filter->setDataContainerArray(dca);
+    filter->setSurfaceMeshFaceLabelsArrayPath(DataArrayPath(k_DataContainerName, k_FaceAttrMatName, k_FaceLabelsName));
+    filter->setOutputStlDirectory(UnitTest::WriteStlFileTest::OutputDir);
+    filter->setOutputStlPrefix(k_Prefix);
+    filter->setWriteFilesInParallel(writeInParallel);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    std::map<int32_t, std::vector<float>> expected = ExpectedRecords(dca);
+    QStringList files = outputDir.entryList(QStringList() << "*.stl", QDir::Files);
+    DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(files.size()), expected.size())
+
+    for(const auto& feature : expected)
+    {
+      QFile file(outputDir.filePath(k_Prefix + QString("Feature_") + QString::number(feature.first) + ".stl"));
+      DREAM3D_REQUIRE_EQUAL(file.open(QIODevice::ReadOnly), true)
+      QByteArray contents = file.readAll();
+      const std::vector<float>& coords = feature.second;
+      const size_t numRecords = coords.size() / 9;
+      DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(contents.size()), k_HeaderSize + numRecords * k_RecordSize)
+
+      int32_t triCount = 0;
+      std::memcpy(&triCount, contents.constData() + 80, sizeof(triCount));
+      DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(triCount), numRecords)
+
+      for(size_t r = 0; r < numRecords; r++)
+      {
+        float record[12] = {0.0f};
+        std::memcpy(record, contents.constData() + k_HeaderSize + r * k_RecordSize, sizeof(record));
+        for(size_t c = 0; c < 9; c++)
+        {
+          DREAM3D_REQUIRE_EQUAL(record[3 + c], coords[9 * r + c])
+        }
+        // The stored normal follows the winding, so a flipped triangle points the other way
+        const float* v = coords.data() + 9 * r;
+        float u[3] = {v[3] - v[0], v[4] - v[1], v[5] - v[2]};
+        float w[3] = {v[6] - v[0], v[7] - v[1], v[8] - v[2]};
+        float n[3] = {u[1] * w[2] - u[2] * w[1], u[2] * w[0] - u[0] * w[2], u[0] * w[1] - u[1] * w[0]};
+        DREAM3D_REQUIRE(record[0] * n[0] + record[1] * n[1] + record[2] * n[2] > 0.0f)
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestDenseFeatureIds()
+  {
+    const std::array<int32_t, 4> ids = {-1, 1, 2, 4};
+    WriteAndCompare(ids, false);
+    WriteAndCompare(ids, true);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSparseFeatureIds()
+  {
+    const std::array<int32_t, 4> ids = {std::numeric_limits<int32_t>::min(), 7, 1000000000, std::numeric_limits<int32_t>::max()};
+    WriteAndCompare(ids, false);
+    WriteAndCompare(ids, true);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestDenseFeatureIds())
+    DREAM3D_REGISTER_TEST(TestSparseFeatureIds())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  WriteStlFileTest(const WriteStlFileTest&) = delete;            // Copy Constructor Not Implemented
+  WriteStlFileTest(WriteStlFileTest&&) = delete;                 // Move Constructor Not Implemented
+  WriteStlFileTest& operator=(const WriteStlFileTest&) = delete; // Copy Assignment Not Implemented
+  WriteStlFileTest& operator=(WriteStlFileTest&&) = delete;      // Move Assignment Not Implemented
+};
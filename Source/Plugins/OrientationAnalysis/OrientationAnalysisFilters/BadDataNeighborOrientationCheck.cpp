@@ -48,7 +48,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
-#include "EbsdLib/LaueOps/LaueOps.h"
+#include "Common/MisorientationKernel.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
@@ -56,10 +56,7 @@
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-BadDataNeighborOrientationCheck::BadDataNeighborOrientationCheck()
-{
-  m_OrientationOps = LaueOps::GetAllOrientationOps();
-}
+BadDataNeighborOrientationCheck::BadDataNeighborOrientationCheck() = default;
 
 // -----------------------------------------------------------------------------
 //
@@ -183,6 +180,7 @@ void BadDataNeighborOrientationCheck::execute()
   }
 
   float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_PiF / 180.0f;
+  MisorientationKernel misorientationKernel(m_CrystalStructures, m_CrystalStructuresPtr.lock()->getNumberOfTuples(), misorientationTolerance);
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_GoodVoxelsArrayPath.getDataContainerName());
   size_t totalPoints = m_GoodVoxelsPtr.lock()->getNumberOfTuples();
@@ -207,12 +205,7 @@ void BadDataNeighborOrientationCheck::execute()
   neighpoints[4] = static_cast<int64_t>(dims[0]);
   neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
 
-  float w = 10000.0f;
-
-  uint32_t phase1 = 0, phase2 = 0;
-
   QVector<int32_t> neighborCount(totalPoints, 0);
-  float* currentQuatPtr = nullptr;
 
   for(size_t i = 0; i < totalPoints; i++)
   {
@@ -251,20 +244,7 @@ void BadDataNeighborOrientationCheck::execute()
         }
         if(good == 1 && m_GoodVoxels[neighbor])
         {
-          phase1 = m_CrystalStructures[m_CellPhases[i]];
-          currentQuatPtr = m_Quats + i * 4;
-          QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-
-          phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-          currentQuatPtr = m_Quats + neighbor * 4;
-          QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-
-          if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-          {
-            OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-            w = axisAngle[3];
-          }
-          if(w < misorientationTolerance)
+          if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0 && misorientationKernel.isBelowTolerance(m_CellPhases[i], m_Quats + i * 4, m_Quats + neighbor * 4))
           {
             neighborCount[i]++;
           }
@@ -321,20 +301,7 @@ void BadDataNeighborOrientationCheck::execute()
             }
             if(good == 1 && !m_GoodVoxels[neighbor])
             {
-
-              currentQuatPtr = m_Quats + i * 4;
-              QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-
-              phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-              currentQuatPtr = m_Quats + neighbor * 4;
-              QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-
-              if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-              {
-                OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-                w = axisAngle[3];
-              }
-              if(w < misorientationTolerance)
+              if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0 && misorientationKernel.isBelowTolerance(m_CellPhases[i], m_Quats + i * 4, m_Quats + neighbor * 4))
               {
                 neighborCount[neighbor]++;
               }
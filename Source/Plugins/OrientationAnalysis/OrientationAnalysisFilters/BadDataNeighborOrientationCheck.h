@@ -43,10 +43,6 @@
 
 #include "OrientationAnalysis/OrientationAnalysisDLLExport.h"
 
-class LaueOps;
-using LaueOpsShPtrType = std::shared_ptr<LaueOps>;
-using LaueOpsContainer = std::vector<LaueOpsShPtrType>;
-
 /**
  * @brief The BadDataNeighborOrientationCheck class. See [Filter documentation](@ref baddataneighbororientationcheck) for details.
  */
@@ -253,8 +249,6 @@ private:
   DataArrayPath m_CrystalStructuresArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures};
   DataArrayPath m_QuatsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats};
 
-  LaueOpsContainer m_OrientationOps;
-
 public:
   BadDataNeighborOrientationCheck(const BadDataNeighborOrientationCheck&) = delete;            // Copy Constructor Not Implemented
   BadDataNeighborOrientationCheck(BadDataNeighborOrientationCheck&&) = delete;                 // Move Constructor Not Implemented
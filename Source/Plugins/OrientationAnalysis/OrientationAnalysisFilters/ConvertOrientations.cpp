@@ -35,6 +35,9 @@
 
 #include "ConvertOrientations.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/DataContainers/DataContainerArray.h"
@@ -44,6 +47,7 @@
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/LaueOps/LaueOps.h"
 #include "EbsdLib/OrientationMath/OrientationConverter.hpp"
@@ -213,6 +217,36 @@ void ConvertOrientations::dataCheck()
   }
 }
 
+namespace
+{
+// Number of tuples converted per task. Each task only ever holds the converted output of its own chunk.
+constexpr size_t k_ChunkSize = 65536;
+
+// -----------------------------------------------------------------------------
+template <typename T>
+typename OrientationConverter<DataArray<T>, T>::Pointer createConverter(int32_t inputType)
+{
+  using ArrayType = DataArray<T>;
+  switch(inputType)
+  {
+  case 0:
+    return EulerConverter<ArrayType, T>::New();
+  case 1:
+    return OrientationMatrixConverter<ArrayType, T>::New();
+  case 2:
+    return QuaternionConverter<ArrayType, T>::New();
+  case 3:
+    return AxisAngleConverter<ArrayType, T>::New();
+  case 4:
+    return RodriguesConverter<ArrayType, T>::New();
+  case 5:
+    return HomochoricConverter<ArrayType, T>::New();
+  default:
+    return CubochoricConverter<ArrayType, T>::New();
+  }
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -222,30 +256,53 @@ void generateRepresentation(ConvertOrientations* filter, typename DataArray<T>::
   using ArrayType = DataArray<T>;
   using ArrayPointerType = typename ArrayType::Pointer;
   using OCType = OrientationConverter<ArrayType, T>;
-  std::vector<typename OCType::Pointer> converters(7);
-
-  converters[0] = EulerConverter<ArrayType, T>::New();
-  converters[1] = OrientationMatrixConverter<ArrayType, T>::New();
-  converters[2] = QuaternionConverter<ArrayType, T>::New();
-  converters[3] = AxisAngleConverter<ArrayType, T>::New();
-  converters[4] = RodriguesConverter<ArrayType, T>::New();
-  converters[5] = HomochoricConverter<ArrayType, T>::New();
-  converters[6] = CubochoricConverter<ArrayType, T>::New();
 
-  std::vector<OrientationRepresentation::Type> ocTypes = OCType::GetOrientationTypes();
-
-  converters[filter->getInputType()]->setInputData(inputOrientations);
-  converters[filter->getInputType()]->convertRepresentationTo(ocTypes[filter->getOutputType()]);
+  const OrientationRepresentation::Type outputType = OCType::GetOrientationTypes()[filter->getOutputType()];
+  const size_t numTuples = inputOrientations->getNumberOfTuples();
+  const size_t outputStride = outputOrientations->getNumberOfComponents();
+  const size_t numChunks = (numTuples + k_ChunkSize - 1) / k_ChunkSize;
+
+  // The input is converted in chunks that wrap the input array in place and whose results are copied
+  // straight into the output array, so no second array the size of the whole output is ever allocated.
+  std::atomic_bool conversionFailed(false);
+  std::atomic_bool copyFailed(false);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numChunks);
+  dataAlg.setGrain(1);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      const size_t start = chunk * k_ChunkSize;
+      const size_t count = std::min(k_ChunkSize, numTuples - start);
+      ArrayPointerType input = ArrayType::WrapPointer(inputOrientations->getTuplePointer(start), count, inputOrientations->getComponentDimensions(), inputOrientations->getName(), false);
+
+      typename OCType::Pointer converter = createConverter<T>(filter->getInputType());
+      converter->setInputData(input);
+      converter->convertRepresentationTo(outputType);
+
+      ArrayPointerType output = converter->getOutputData();
+      if(nullptr == output.get())
+      {
+        conversionFailed = true;
+        return;
+      }
+      if(output->getNumberOfTuples() != count || output->getNumberOfComponents() != outputStride)
+      {
+        copyFailed = true;
+        return;
+      }
+      std::copy_n(output->getPointer(0), count * outputStride, outputOrientations->getTuplePointer(start));
+    }
+  });
 
-  ArrayPointerType output = converters[filter->getInputType()]->getOutputData();
-  if(nullptr == output.get())
+  if(conversionFailed)
   {
-    QString ss = QObject::tr("There was an error converting the input data using convertor %1").arg(QString::fromStdString(converters[filter->getInputType()]->getNameOfClass()));
+    QString ss = QObject::tr("There was an error converting the input data using convertor %1").arg(QString::fromStdString(createConverter<T>(filter->getInputType())->getNameOfClass()));
     filter->setErrorCondition(-1004, ss);
     return;
   }
 
-  if(!output->copyIntoArray(outputOrientations))
+  if(copyFailed)
   {
     QString ss = QObject::tr("There was an error copying the final results into the output array.");
     filter->setErrorCondition(-1003, ss);
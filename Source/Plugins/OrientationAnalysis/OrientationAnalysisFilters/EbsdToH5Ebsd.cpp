@@ -34,6 +34,11 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "EbsdToH5Ebsd.h"
 
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <thread>
+
 #include <QtCore/QDir>
 #include <QtCore/QTextStream>
 
@@ -51,6 +56,130 @@
 #include "OrientationAnalysis/FilterParameters/EbsdToH5EbsdFilterParameter.h"
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/OrderedPipeline.hpp"
+
+namespace
+{
+/**
+ * @brief One EBSD file imported into its own in-memory HDF5 file, waiting to be copied into the output file
+ */
+struct StagedSlice
+{
+  hid_t fileId = -1;
+  int32_t error = 0;
+  QString errorMessage;
+  int32_t numberOfSlices = 0;
+  int64_t xDim = 0;
+  int64_t yDim = 0;
+  float xRes = 0.0f;
+  float yRes = 0.0f;
+
+  StagedSlice() = default;
+  ~StagedSlice()
+  {
+    if(fileId >= 0)
+    {
+      H5Fclose(fileId);
+    }
+  }
+
+  StagedSlice(const StagedSlice&) = delete;
+  StagedSlice& operator=(const StagedSlice&) = delete;
+};
+using StagedSlicePtr = std::unique_ptr<StagedSlice>;
+
+// -----------------------------------------------------------------------------
+EbsdImporter::Pointer createImporter(const std::string& ext)
+{
+  if(ext == EbsdLib::Ang::FileExt)
+  {
+    return H5AngImporter::New();
+  }
+  return H5CtfImporter::New();
+}
+
+// -----------------------------------------------------------------------------
+StagedSlicePtr stageSlice(const std::string& ext, const std::string& ebsdFName, int64_t z)
+{
+  StagedSlicePtr slice = std::make_unique<StagedSlice>();
+
+  // The core driver keeps the whole file in memory and never writes it to disk
+  std::string stageName = "EbsdToH5Ebsd_Stage_" + std::to_string(reinterpret_cast<uintptr_t>(slice.get())) + ".h5";
+  hid_t faplId = H5Pcreate(H5P_FILE_ACCESS);
+  H5Pset_fapl_core(faplId, 16 * 1024 * 1024, false);
+  slice->fileId = H5Fcreate(stageName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, faplId);
+  H5Pclose(faplId);
+  if(slice->fileId < 0)
+  {
+    slice->error = -1;
+    slice->errorMessage = QObject::tr("Could not create the in-memory HDF5 file for '%1'").arg(QString::fromStdString(ebsdFName));
+    return slice;
+  }
+
+  EbsdImporter::Pointer fileImporter = createImporter(ext);
+  int32_t err = fileImporter->importFile(slice->fileId, z, ebsdFName);
+  if(err < 0)
+  {
+    slice->error = err;
+    slice->errorMessage = QString::fromStdString(fileImporter->getPipelineMessage());
+    return slice;
+  }
+  slice->numberOfSlices = fileImporter->numberOfSlicesImported();
+  fileImporter->getDims(slice->xDim, slice->yDim);
+  fileImporter->getSpacing(slice->xRes, slice->yRes);
+  return slice;
+}
+
+// -----------------------------------------------------------------------------
+herr_t copyStagedLink(hid_t groupId, const char* name, const H5L_info_t* /* info */, void* destId)
+{
+  return H5Ocopy(groupId, name, *static_cast<hid_t*>(destId), name, H5P_DEFAULT, H5P_DEFAULT);
+}
+
+// -----------------------------------------------------------------------------
+herr_t copyStagedAttribute(hid_t locationId, const char* name, const H5A_info_t* /* info */, void* destId)
+{
+  hid_t fileId = *static_cast<hid_t*>(destId);
+  // Root attributes such as the file version are only written once
+  if(H5Aexists(fileId, name) > 0)
+  {
+    return 0;
+  }
+  hid_t attrId = H5Aopen(locationId, name, H5P_DEFAULT);
+  hid_t typeId = H5Aget_type(attrId);
+  hid_t spaceId = H5Aget_space(attrId);
+  std::vector<uint8_t> buffer(H5Tget_size(typeId) * static_cast<size_t>(H5Sget_simple_extent_npoints(spaceId)));
+  herr_t err = H5Aread(attrId, typeId, buffer.data());
+  if(err >= 0)
+  {
+    hid_t destAttrId = H5Acreate2(fileId, name, typeId, spaceId, H5P_DEFAULT, H5P_DEFAULT);
+    err = destAttrId < 0 ? -1 : H5Awrite(destAttrId, typeId, buffer.data());
+    if(destAttrId >= 0)
+    {
+      H5Aclose(destAttrId);
+    }
+    if(H5Tis_variable_str(typeId) > 0)
+    {
+      H5Dvlen_reclaim(typeId, spaceId, H5P_DEFAULT, buffer.data());
+    }
+  }
+  H5Sclose(spaceId);
+  H5Tclose(typeId);
+  H5Aclose(attrId);
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+herr_t copyStagedSlice(const StagedSlice& slice, hid_t fileId)
+{
+  herr_t err = H5Literate(slice.fileId, H5_INDEX_NAME, H5_ITER_INC, nullptr, copyStagedLink, &fileId);
+  if(err < 0)
+  {
+    return err;
+  }
+  return H5Aiterate2(slice.fileId, H5_INDEX_NAME, H5_ITER_INC, nullptr, copyStagedAttribute, &fileId);
+}
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -377,44 +506,110 @@ void EbsdToH5Ebsd::execute()
   int64_t biggestxDim = 0;
   int64_t biggestyDim = 0;
   int32_t totalSlicesImported = 0;
-  for(QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
-  {
-    QString ebsdFName = *filepath;
-    progress = static_cast<int32_t>(z - m_ZStartIndex);
-    progress = (int32_t)(100.0f * (float)(progress) / total);
-    QString msg = "Converting File: " + ebsdFName;
 
-    notifyStatusMessage(msg.toLatin1().data());
-    err = fileImporter->importFile(fileId, z, ebsdFName.toStdString());
-    if(err < 0)
+  // Parsing the text files dominates the import, so when HDF5 may be called from several threads the
+  // files are parsed concurrently, each into its own in-memory HDF5 file, and copied into the output
+  // file in slice order by this thread. Only a few staged slices are held at any time.
+  size_t numThreads = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  hbool_t threadSafe = 0;
+  H5is_library_threadsafe(&threadSafe);
+  if(threadSafe)
+  {
+    numThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+#endif
+  if(numThreads > 1 && fileList.size() > 1)
+  {
+    const QVector<QString>& files = fileList;
+    bool sliceFailed = false;
+    OrientationAnalysis::OrderedPipeline<StagedSlicePtr> pipeline(numThreads, 2 * numThreads);
+    // A slice that fails to parse by throwing is reported like any other failed slice
+    try
     {
-      setErrorCondition(err, QString::fromStdString(fileImporter->getPipelineMessage()));
-      return;
-    }
-    totalSlicesImported = totalSlicesImported + fileImporter->numberOfSlicesImported();
-
-    fileImporter->getDims(xDim, yDim);
-    fileImporter->getSpacing(xRes, yRes);
-    if(xDim > biggestxDim)
+      pipeline.run(
+          static_cast<size_t>(files.size()), [&](size_t i) { return stageSlice(ext, files.at(static_cast<int32_t>(i)).toStdString(), m_ZStartIndex + static_cast<int64_t>(i)); },
+          [&](size_t i, StagedSlicePtr& slice) {
+            QString msg = "Converting File: " + files.at(static_cast<int32_t>(i));
+            notifyStatusMessage(msg.toLatin1().data());
+            if(slice->error < 0)
+            {
+              setErrorCondition(slice->error, slice->errorMessage);
+              sliceFailed = true;
+              return false;
+            }
+            if(copyStagedSlice(*slice, fileId) < 0)
+            {
+              QString ss = QObject::tr("Could not write dataset for slice to HDF5 file");
+              setErrorCondition(-1, ss);
+              sliceFailed = true;
+              return false;
+            }
+            totalSlicesImported = totalSlicesImported + slice->numberOfSlices;
+            xRes = slice->xRes;
+            yRes = slice->yRes;
+            biggestxDim = std::max(biggestxDim, slice->xDim);
+            biggestyDim = std::max(biggestyDim, slice->yDim);
+            indices.push_back(static_cast<int32_t>(m_ZStartIndex + static_cast<int64_t>(i)));
+            return !getCancel();
+          });
+    } catch(const std::exception& e)
     {
-      biggestxDim = xDim;
-    }
-    if(yDim > biggestyDim)
+      QString ss = QObject::tr("Error converting the EBSD files: %1").arg(e.what());
+      setErrorCondition(-998, ss);
+      sliceFailed = true;
+    } catch(...)
     {
-      biggestyDim = yDim;
+      QString ss = QObject::tr("Unknown error converting the EBSD files");
+      setErrorCondition(-998, ss);
+      sliceFailed = true;
     }
-
-    if(err < 0)
+    if(sliceFailed || getCancel())
     {
-      QString ss = QObject::tr("Could not write dataset for slice to HDF5 file");
-      setErrorCondition(-1, ss);
+      return;
     }
-
-    indices.push_back(static_cast<int32_t>(z));
-    ++z;
-    if(getCancel())
+  }
+  else
+  {
+    for(QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
     {
-      return;
+      QString ebsdFName = *filepath;
+      progress = static_cast<int32_t>(z - m_ZStartIndex);
+      progress = (int32_t)(100.0f * (float)(progress) / total);
+      QString msg = "Converting File: " + ebsdFName;
+
+      notifyStatusMessage(msg.toLatin1().data());
+      err = fileImporter->importFile(fileId, z, ebsdFName.toStdString());
+      if(err < 0)
+      {
+        setErrorCondition(err, QString::fromStdString(fileImporter->getPipelineMessage()));
+        return;
+      }
+      totalSlicesImported = totalSlicesImported + fileImporter->numberOfSlicesImported();
+
+      fileImporter->getDims(xDim, yDim);
+      fileImporter->getSpacing(xRes, yRes);
+      if(xDim > biggestxDim)
+      {
+        biggestxDim = xDim;
+      }
+      if(yDim > biggestyDim)
+      {
+        biggestyDim = yDim;
+      }
+
+      if(err < 0)
+      {
+        QString ss = QObject::tr("Could not write dataset for slice to HDF5 file");
+        setErrorCondition(-1, ss);
+      }
+
+      indices.push_back(static_cast<int32_t>(z));
+      ++z;
+      if(getCancel())
+      {
+        return;
+      }
     }
   }
 
@@ -48,6 +48,8 @@
 #include "EbsdLib/Core/Quaternion.hpp"
 #include "EbsdLib/LaueOps/LaueOps.h"
 
+#include "Common/FeatureReduction.hpp"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -207,55 +209,49 @@ void FindAvgOrientations::execute()
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_AvgQuatsPtr.lock()->getNumberOfTuples();
 
-  std::vector<float> counts(totalFeatures, 0.0f);
-
-  int32_t phase = 0;
-
   m_AvgQuatsPtr.lock()->initializeWithZeros();
-
-  float* avgQuatsPtr = nullptr;
-  float* currentVoxelQuatPtr = nullptr;
-  // Initialize all Average Quats to Identity
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    avgQuatsPtr = m_AvgQuats + i * 4; // Get the pointer to the current average quaternion
-    QuatF::identity().copyInto(avgQuatsPtr, QuatF::Order::VectorScalar);
-  }
   // Initialize all Euler Angles to Zero
   m_FeatureEulerAnglesPtr.lock()->initializeWithZeros();
 
-  for(size_t i = 0; i < totalPoints; i++)
-  {
-    if(m_FeatureIds[i] > 0 && m_CellPhases[i] > 0)
+  // The running average of a Feature depends on the order its voxels are visited in, so every Feature is
+  // folded over its own voxels in ascending order while the Features themselves run in parallel
+  FeatureReduction::OrderedFold(m_FeatureIds, totalPoints, totalFeatures, [&](size_t featureId, const size_t* voxels, size_t numVoxels) {
+    if(featureId == 0)
     {
-      counts[m_FeatureIds[i]] += 1.0f;
-      phase = m_CellPhases[i];
-
-      avgQuatsPtr = m_AvgQuats + m_FeatureIds[i] * 4;                                   // Get the pointer to the current average quaternion
-      QuatF curavgquat(avgQuatsPtr[0], avgQuatsPtr[1], avgQuatsPtr[2], avgQuatsPtr[3]); // Makes a copy into curavgquat!!!!
-      curavgquat.scalarDivide(counts[m_FeatureIds[i]]);
-
-      currentVoxelQuatPtr = m_Quats + i * 4;                                                                         // Get the pointer to the current voxel's Quaternion
-      QuatF voxquat(currentVoxelQuatPtr[0], currentVoxelQuatPtr[1], currentVoxelQuatPtr[2], currentVoxelQuatPtr[3]); // Makes a copy into voxquat!!!!
-      QuatF nearestQuat = m_OrientationOps[m_CrystalStructures[phase]]->getNearestQuat(curavgquat, voxquat);
+      return;
+    }
+    float* avgQuatsPtr = m_AvgQuats + featureId * 4; // Get the pointer to the current average quaternion
+    QuatF::identity().copyInto(avgQuatsPtr, QuatF::Order::VectorScalar);
 
-      // QuatF qSum(m_AvgQuats + m_FeatureIds[i] * 4); // Makes a copy into qSum!!!!
-      curavgquat = curavgquat + nearestQuat;
-      curavgquat.copyInto(avgQuatsPtr, Quaternion<float>::Order::VectorScalar); // Copy back into the m_AvgQuats storage
+    float count = 0.0f;
+    for(size_t v = 0; v < numVoxels; v++)
+    {
+      size_t i = voxels[v];
+      if(m_CellPhases[i] > 0)
+      {
+        count += 1.0f;
+        int32_t phase = m_CellPhases[i];
+
+        QuatF curavgquat(avgQuatsPtr[0], avgQuatsPtr[1], avgQuatsPtr[2], avgQuatsPtr[3]); // Makes a copy into curavgquat!!!!
+        curavgquat.scalarDivide(count);
+
+        float* currentVoxelQuatPtr = m_Quats + i * 4;                                                                  // Get the pointer to the current voxel's Quaternion
+        QuatF voxquat(currentVoxelQuatPtr[0], currentVoxelQuatPtr[1], currentVoxelQuatPtr[2], currentVoxelQuatPtr[3]); // Makes a copy into voxquat!!!!
+        QuatF nearestQuat = m_OrientationOps[m_CrystalStructures[phase]]->getNearestQuat(curavgquat, voxquat);
+
+        curavgquat = curavgquat + nearestQuat;
+        curavgquat.copyInto(avgQuatsPtr, Quaternion<float>::Order::VectorScalar); // Copy back into the m_AvgQuats storage
+      }
     }
-  }
 
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    avgQuatsPtr = m_AvgQuats + i * 4;                                           // Get the pointer to the current average quaternion
     QuatF qAvg(avgQuatsPtr[0], avgQuatsPtr[1], avgQuatsPtr[2], avgQuatsPtr[3]); // Create a copy of the quaternion
-    qAvg.scalarDivide(counts[i]);
+    qAvg.scalarDivide(count);
     qAvg = qAvg.unitQuaternion();
     qAvg.copyInto(avgQuatsPtr, QuatF::Order::VectorScalar);
 
     OrientationF eu = OrientationTransformation::qu2eu<Quaternion<float>, Orientation<float>>(qAvg);
-    eu.copyInto(m_FeatureEulerAngles + (3 * i), 3);
-  }
+    eu.copyInto(m_FeatureEulerAngles + (3 * featureId), 3);
+  });
 }
 
 // -----------------------------------------------------------------------------
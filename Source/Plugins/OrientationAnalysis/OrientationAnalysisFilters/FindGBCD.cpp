@@ -34,7 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindGBCD.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
@@ -63,8 +65,10 @@
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_for.h>
 #include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
 #endif
 
 using LaueOpsShPtrType = std::shared_ptr<LaueOps>;
@@ -79,60 +83,96 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+/**
+ * @brief The GBCDHistogram struct holds the share of the GBCD and of the total face area per phase accumulated by a
+ * single thread
+ */
+struct GBCDHistogram
+{
+  GBCDHistogram(size_t gbcdSize, size_t totalPhases)
+  : gbcd(gbcdSize, 0.0)
+  , totalFaceArea(totalPhases, 0.0)
+  {
+  }
+
+  std::vector<double> gbcd;
+  std::vector<double> totalFaceArea;
+};
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+using GBCDHistograms = tbb::enumerable_thread_specific<GBCDHistogram>;
+
+namespace
+{
+// Upper bound on the memory held by all of the per thread histograms together. Once a single histogram is so large
+// that every core holding one would pass this bound, fewer threads bin the faces.
+constexpr size_t k_HistogramMemoryBudget = 2ULL * 1024ULL * 1024ULL * 1024ULL;
+} // namespace
+#endif
+
 /**
  * @brief The CalculateGBCDImpl class implements a threaded algorithm that calculates the
- * grain boundary character distribution (GBCD) for a surface mesh
+ * grain boundary character distribution (GBCD) for a surface mesh. Every face adds its area directly
+ * into the histogram of the calling thread.
  */
 class CalculateGBCDImpl
 {
-  size_t startOffset;
-  size_t numEntriesPerTri;
   Int32ArrayType::Pointer m_LabelsArray;
   DoubleArrayType::Pointer m_NormalsArray;
+  DoubleArrayType::Pointer m_AreasArray;
   Int32ArrayType::Pointer m_PhasesArray;
   FloatArrayType::Pointer m_EulersArray;
 
   FloatArrayType::Pointer m_GbcdDeltasArray;
   FloatArrayType::Pointer m_GbcdLimitsArray;
   Int32ArrayType::Pointer m_GbcdSizesArray;
-  Int32ArrayType::Pointer m_GbcdBinsArray;
-  BoolArrayType::Pointer m_GbcdHemiCheckArray;
+  size_t m_TotalGBCDBins = 0;
 
   UInt32ArrayType::Pointer m_CrystalStructuresArray;
   LaueOpsContainer m_OrientationOps;
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  GBCDHistograms* m_Histograms = nullptr;
+#endif
+
 public:
-  CalculateGBCDImpl(size_t i, size_t numMisoReps, Int32ArrayType::Pointer labels, DoubleArrayType::Pointer normals, FloatArrayType::Pointer eulers, Int32ArrayType::Pointer phases,
-                    UInt32ArrayType::Pointer crystalStructures, Int32ArrayType::Pointer bins, BoolArrayType::Pointer hemiCheck, FloatArrayType::Pointer gbcdDeltas, Int32ArrayType::Pointer gbcdSizes,
-                    FloatArrayType::Pointer gbcdLimits)
-  : startOffset(i)
-  , numEntriesPerTri(numMisoReps)
-  , m_LabelsArray(std::move(labels))
+  CalculateGBCDImpl(Int32ArrayType::Pointer labels, DoubleArrayType::Pointer normals, DoubleArrayType::Pointer areas, FloatArrayType::Pointer eulers, Int32ArrayType::Pointer phases,
+                    UInt32ArrayType::Pointer crystalStructures, FloatArrayType::Pointer gbcdDeltas, Int32ArrayType::Pointer gbcdSizes, FloatArrayType::Pointer gbcdLimits, size_t totalGBCDBins)
+  : m_LabelsArray(std::move(labels))
   , m_NormalsArray(std::move(normals))
+  , m_AreasArray(std::move(areas))
   , m_PhasesArray(std::move(phases))
   , m_EulersArray(std::move(eulers))
   , m_GbcdDeltasArray(std::move(gbcdDeltas))
   , m_GbcdLimitsArray(std::move(gbcdLimits))
   , m_GbcdSizesArray(std::move(gbcdSizes))
-  , m_GbcdBinsArray(std::move(bins))
-  , m_GbcdHemiCheckArray(std::move(hemiCheck))
+  , m_TotalGBCDBins(totalGBCDBins)
   , m_CrystalStructuresArray(std::move(crystalStructures))
   {
     m_OrientationOps = LaueOps::GetAllOrientationOps();
   }
   virtual ~CalculateGBCDImpl() = default;
 
-  void generate(size_t start, size_t end) const
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void setHistograms(GBCDHistograms* histograms)
+  {
+    m_Histograms = histograms;
+  }
+#endif
+
+  /**
+   * @brief generate Bins the faces in [start, end) and adds their areas into gbcd and totalFaceArea
+   */
+  void generate(size_t start, size_t end, double* gbcd, double* totalFaceArea) const
   {
 
     // We want to work with the raw pointers for speed so get those pointers.
     float* gbcdDeltas = m_GbcdDeltasArray->getPointer(0);
     float* gbcdLimits = m_GbcdLimitsArray->getPointer(0);
     int* gbcdSizes = m_GbcdSizesArray->getPointer(0);
-    int32_t* bins = m_GbcdBinsArray->getPointer(0);
-    bool* hemiCheck = m_GbcdHemiCheckArray->getPointer(0);
 
     int32_t* labels = m_LabelsArray->getPointer(0);
+    double* areas = m_AreasArray->getPointer(0);
     double* normals = m_NormalsArray->getPointer(0);
     int32_t* phases = m_PhasesArray->getPointer(0);
     float* eulers = m_EulersArray->getPointer(0);
@@ -156,13 +196,9 @@ public:
     int32_t gbcd_index = 0;
     float sqCoord[2] = {0.0f, 0.0f}, sqCoordInv[2] = {0.0f, 0.0f};
     bool nhCheck = false, nhCheckInv = true;
-    int32_t SYMcounter = 0;
-    auto TRIcounter = static_cast<int64_t>(start - startOffset);
-    int64_t TRIcounterShift = 0;
 
     for(size_t i = start; i < end; i++)
     {
-      SYMcounter = 0;
       feature1 = labels[2 * i];
       feature2 = labels[2 * i + 1];
       normal[0] = normals[3 * i];
@@ -176,7 +212,9 @@ public:
 
       if(phases[feature1] == phases[feature2] && phases[feature1] > 0)
       {
-        TRIcounterShift = (TRIcounter * numEntriesPerTri);
+        const double area = areas[i];
+        double* phaseGBCD = gbcd + phases[feature1] * m_TotalGBCDBins;
+        double& phaseFaceArea = totalFaceArea[phases[feature1]];
         uint32_t cryst = crystalStructures[phases[feature1]];
         for(int32_t q = 0; q < 2; q++)
         {
@@ -240,37 +278,32 @@ public:
                 gbcd_index = GBCDIndex(gbcdDeltas, gbcdSizes, gbcdLimits, euler_mis, sqCoord);
                 if(gbcd_index != -1)
                 {
-                  hemiCheck[TRIcounterShift + SYMcounter] = nhCheck;
-                  bins[TRIcounterShift + SYMcounter] = gbcd_index;
+                  // The northern hemisphere is stored in the even bins
+                  phaseGBCD[2 * gbcd_index + (nhCheck ? 0 : 1)] += area;
+                  phaseFaceArea += area;
                 }
-                SYMcounter++;
                 if(inversion == 1)
                 {
                   gbcd_index = GBCDIndex(gbcdDeltas, gbcdSizes, gbcdLimits, euler_mis, sqCoordInv);
                   if(gbcd_index != -1)
                   {
-                    hemiCheck[TRIcounterShift + SYMcounter] = nhCheckInv;
-                    bins[TRIcounterShift + SYMcounter] = gbcd_index;
+                    phaseGBCD[2 * gbcd_index + (nhCheckInv ? 0 : 1)] += area;
+                    phaseFaceArea += area;
                   }
-                  SYMcounter++;
                 }
               }
-              else
-              {
-                SYMcounter += 2;
-              }
             }
           }
         }
       }
-      TRIcounter++;
     }
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   void operator()(const tbb::blocked_range<size_t>& r) const
   {
-    generate(r.begin(), r.end());
+    GBCDHistogram& histogram = m_Histograms->local();
+    generate(r.begin(), r.end(), histogram.gbcd.data(), histogram.totalFaceArea.data());
   }
 #endif
 
@@ -365,8 +398,6 @@ FindGBCD::FindGBCD()
   m_GbcdDeltasArray = FloatArrayType::NullPointer();
   m_GbcdSizesArray = Int32ArrayType::NullPointer();
   m_GbcdLimitsArray = FloatArrayType::NullPointer();
-  m_GbcdBinsArray = Int32ArrayType::NullPointer();
-  m_GbcdHemiCheckArray = BoolArrayType::NullPointer();
 }
 
 // -----------------------------------------------------------------------------
@@ -447,14 +478,10 @@ void FindGBCD::initialize()
   m_GbcdDeltasArray = FloatArrayType::NullPointer();
   m_GbcdSizesArray = Int32ArrayType::NullPointer();
   m_GbcdLimitsArray = FloatArrayType::NullPointer();
-  m_GbcdBinsArray = Int32ArrayType::NullPointer();
-  m_GbcdHemiCheckArray = BoolArrayType::NullPointer();
 
   m_GbcdDeltas = nullptr;
   m_GbcdSizes = nullptr;
   m_GbcdLimits = nullptr;
-  m_GbcdBins = nullptr;
-  m_HemiCheck = nullptr;
 }
 
 // -----------------------------------------------------------------------------
@@ -500,8 +527,8 @@ void FindGBCD::dataCheckSurfaceMesh()
     m_SurfaceMeshFaceAreas = m_SurfaceMeshFaceAreasPtr.lock()->getPointer(0);
   } /* Now assign the raw pointer to data from the DataArray<T> object */
 
-  // call the sizeGBCD function to get the GBCD ranges, dimensions, etc.  Note that the input parameters do not affect the size and can be dummy values here;
-  sizeGBCD(0, 0);
+  // call the sizeGBCD function to get the GBCD ranges, dimensions, etc.
+  sizeGBCD();
   cDims.resize(6);
   cDims[0] = m_GbcdSizes[0];
   cDims[1] = m_GbcdSizes[1];
@@ -579,14 +606,9 @@ void FindGBCD::execute()
   size_t totalPhases = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
   size_t totalFaces = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
   size_t faceChunkSize = 50000;
-  size_t numMisoReps = 576 * 4;
-  if(totalFaces < faceChunkSize)
-  {
-    faceChunkSize = totalFaces;
-  }
-  // call the sizeGBCD function with proper chunkSize and numMisoReps to get Bins array set up properly
-  sizeGBCD(faceChunkSize, numMisoReps);
+  sizeGBCD();
   int32_t totalGBCDBins = m_GbcdSizes[0] * m_GbcdSizes[1] * m_GbcdSizes[2] * m_GbcdSizes[3] * m_GbcdSizes[4] * 2;
+  size_t gbcdSize = totalPhases * static_cast<size_t>(totalGBCDBins);
 
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
   uint64_t currentMillis = millis;
@@ -594,13 +616,30 @@ void FindGBCD::execute()
   uint64_t estimatedTime = 0;
   float timeDiff = 0.0f;
   startMillis = QDateTime::currentMSecsSinceEpoch();
-  int32_t hemisphere = 0;
 
   // create an array to hold the total face area for each phase and initialize the array to 0.0
   DoubleArrayType::Pointer totalFaceAreaPtr = DoubleArrayType::CreateArray(totalPhases, std::string("totalFaceArea"), true);
   totalFaceAreaPtr->initializeWithValue(0.0);
   double* totalFaceArea = totalFaceAreaPtr->getPointer(0);
 
+  CalculateGBCDImpl gbcdImpl(m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_SurfaceMeshFaceAreasPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(),
+                             m_CrystalStructuresPtr.lock(), m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray, totalGBCDBins);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  // Each thread bins its faces into a private copy of the GBCD; the copies are only created for threads that take part
+  GBCDHistograms histograms([gbcdSize, totalPhases]() { return GBCDHistogram(gbcdSize, totalPhases); });
+  gbcdImpl.setHistograms(&histograms);
+
+  const size_t histogramBytes = (gbcdSize + totalPhases) * sizeof(double);
+  const size_t maxHistograms = std::max<size_t>(1, k_HistogramMemoryBudget / histogramBytes);
+  const size_t maxConcurrency = static_cast<size_t>(tbb::this_task_arena::max_concurrency());
+  tbb::task_arena arena(static_cast<int>(std::min(maxConcurrency, maxHistograms)));
+  if(maxHistograms < maxConcurrency)
+  {
+    QString ss = QObject::tr("Limiting the GBCD binning to %1 threads to keep the per thread histograms under %2 MB").arg(maxHistograms).arg(k_HistogramMemoryBudget / (1024 * 1024));
+    notifyStatusMessage(ss);
+  }
+#endif
+
   QString ss = QObject::tr("Calculating GBCD || 0/%1 Completed").arg(totalFaces);
   for(size_t i = 0; i < totalFaces; i = i + faceChunkSize)
   {
@@ -608,20 +647,11 @@ void FindGBCD::execute()
     {
       return;
     }
-    if(i + faceChunkSize >= totalFaces)
-    {
-      faceChunkSize = totalFaces - i;
-    }
-    m_GbcdBinsArray->initializeWithValue(-1);
+    size_t chunkEnd = std::min(i + faceChunkSize, totalFaces);
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(i, i + faceChunkSize),
-                      CalculateGBCDImpl(i, numMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(),
-                                        m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray),
-                      tbb::auto_partitioner());
+    arena.execute([&]() { tbb::parallel_for(tbb::blocked_range<size_t>(i, chunkEnd), gbcdImpl, tbb::auto_partitioner()); });
 #else
-    CalculateGBCDImpl serial(i, numMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(),
-                             m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray);
-    serial.generate(i, i + faceChunkSize);
+    gbcdImpl.generate(i, chunkEnd, m_GBCD, totalFaceArea);
 #endif
 
     currentMillis = QDateTime::currentMSecsSinceEpoch();
@@ -634,41 +664,33 @@ void FindGBCD::execute()
       millis = QDateTime::currentMSecsSinceEpoch();
       notifyStatusMessage(ss);
     }
+  }
 
-    if(getCancel())
-    {
-      return;
-    }
+  if(getCancel())
+  {
+    return;
+  }
 
-    int32_t phase = 0;
-    int32_t feature = 0;
-    double area = 0.0;
-    for(size_t j = 0; j < faceChunkSize; j++)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  // Sum the per thread histograms, splitting the GBCD bins across the threads
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, gbcdSize), [&](const tbb::blocked_range<size_t>& r) {
+    for(const GBCDHistogram& histogram : histograms)
     {
-      area = m_SurfaceMeshFaceAreas[i + j];
-      feature = m_SurfaceMeshFaceLabels[2 * (i + j)];
-      if(feature < 0)
+      const double* threadGBCD = histogram.gbcd.data();
+      for(size_t j = r.begin(); j < r.end(); j++)
       {
-        continue;
-      }
-      phase = m_FeaturePhases[feature];
-      for(size_t k = 0; k < numMisoReps; k++)
-      {
-        if(m_GbcdBins[(j * numMisoReps) + (k)] >= 0)
-        {
-          hemisphere = 0;
-          if(!m_HemiCheck[(j * numMisoReps) + k])
-          {
-            hemisphere = 1;
-          }
-          size_t gbcdBinIdx = (j * numMisoReps) + k;
-          size_t gbcdIdx = (phase * totalGBCDBins) + (2 * m_GbcdBins[gbcdBinIdx] + hemisphere);
-          m_GBCD[gbcdIdx] += area;
-          totalFaceArea[phase] += area;
-        }
+        m_GBCD[j] += threadGBCD[j];
       }
     }
+  });
+  for(const GBCDHistogram& histogram : histograms)
+  {
+    for(size_t j = 0; j < totalPhases; j++)
+    {
+      totalFaceArea[j] += histogram.totalFaceArea[j];
+    }
   }
+#endif
 
   ss = QObject::tr("Starting GBCD Normalization");
   notifyStatusMessage(ss);
@@ -687,7 +709,7 @@ void FindGBCD::execute()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FindGBCD::sizeGBCD(size_t faceChunkSize, size_t numMisoReps)
+void FindGBCD::sizeGBCD()
 {
   m_GbcdDeltasArray = FloatArrayType::CreateArray(5, std::string("GBCDDeltas"), true);
   m_GbcdDeltasArray->initializeWithZeros();
@@ -695,17 +717,10 @@ void FindGBCD::sizeGBCD(size_t faceChunkSize, size_t numMisoReps)
   m_GbcdLimitsArray->initializeWithZeros();
   m_GbcdSizesArray = Int32ArrayType::CreateArray(5, std::string("GBCDSizes"), true);
   m_GbcdSizesArray->initializeWithZeros();
-  std::vector<size_t> cDims(1, numMisoReps);
-  m_GbcdBinsArray = Int32ArrayType::CreateArray(faceChunkSize, cDims, "GBCDBins", true);
-  m_GbcdBinsArray->initializeWithZeros();
-  m_GbcdHemiCheckArray = BoolArrayType::CreateArray(faceChunkSize, cDims, "GBCDHemiCheck", true);
-  m_GbcdHemiCheckArray->initializeWithValue(false);
 
   m_GbcdDeltas = m_GbcdDeltasArray->getPointer(0);
   m_GbcdSizes = m_GbcdSizesArray->getPointer(0);
   m_GbcdLimits = m_GbcdLimitsArray->getPointer(0);
-  m_GbcdBins = m_GbcdBinsArray->getPointer(0);
-  m_HemiCheck = m_GbcdHemiCheckArray->getPointer(0);
 
   // Original Ranges from Dave R.
   // m_GBCDlimits[0] = 0.0f;
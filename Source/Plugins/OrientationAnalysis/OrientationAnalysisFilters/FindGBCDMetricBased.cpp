@@ -44,6 +44,11 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindGBCDMetricBased.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
 #include <QtCore/QDir>
 #include <QtCore/QTextStream>
 
@@ -65,6 +70,7 @@
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/SphericalBucketIndex.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -310,22 +316,29 @@ public:
 #endif
 };
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+using SelectedTrisType = tbb::concurrent_vector<TriAreaAndNormals>;
+#else
+using SelectedTrisType = QVector<TriAreaAndNormals>;
+#endif
+
 /**
  * @brief The ProbeDistrib class implements a threaded algorithm that determines the distribution values
- * for the GBCD
+ * for the GBCD. The selected triangles are only visited when their first normal lies near the probe
+ * direction according to a spherical index over those normals: since the distance is the root mean
+ * square of the two normal angles, a triangle can only be counted when its first angle is below
+ * sqrt(2) times the plane resolution, so the index is queried with that angle. Without an index every
+ * selected triangle is visited.
  */
 class ProbeDistrib
 {
   QVector<double>* distribValues = nullptr;
   QVector<double>* errorValues = nullptr;
-  QVector<float> samplPtsX;
-  QVector<float> samplPtsY;
-  QVector<float> samplPtsZ;
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
-#else
-  QVector<TriAreaAndNormals> selectedTris;
-#endif
+  const QVector<float>& samplPtsX;
+  const QVector<float>& samplPtsY;
+  const QVector<float>& samplPtsZ;
+  const SelectedTrisType& selectedTris;
+  const OrientationAnalysis::SphericalBucketIndex* normalIndex = nullptr;
   float planeResolSq;
   double totalFaceArea;
   int numDistinctGBs;
@@ -333,19 +346,16 @@ class ProbeDistrib
   float (&gFixedT)[3][3];
 
 public:
-  ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float> __samplPtsX, QVector<float> __samplPtsY, QVector<float> __samplPtsZ,
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
-#else
-               QVector<TriAreaAndNormals> __selectedTris,
-#endif
-               float __planeResolSq, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, float (&__gFixedT)[3][3])
+  ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, const QVector<float>& __samplPtsX, const QVector<float>& __samplPtsY, const QVector<float>& __samplPtsZ,
+               const SelectedTrisType& __selectedTris, const OrientationAnalysis::SphericalBucketIndex* __normalIndex, float __planeResolSq, double __totalFaceArea, int __numDistinctGBs,
+               double __ballVolume, float (&__gFixedT)[3][3])
   : distribValues(__distribValues)
   , errorValues(__errorValues)
   , samplPtsX(__samplPtsX)
   , samplPtsY(__samplPtsY)
   , samplPtsZ(__samplPtsZ)
   , selectedTris(__selectedTris)
+  , normalIndex(__normalIndex)
   , planeResolSq(__planeResolSq)
   , totalFaceArea(__totalFaceArea)
   , numDistinctGBs(__numDistinctGBs)
@@ -358,13 +368,33 @@ public:
 
   void probe(size_t start, size_t end) const
   {
+    const double searchAngle = std::sqrt(2.0 * static_cast<double>(planeResolSq));
+    std::vector<size_t> candidates;
     for(size_t ptIdx = start; ptIdx < end; ptIdx++)
     {
       float fixedNormal1[3] = {samplPtsX.at(ptIdx), samplPtsY.at(ptIdx), samplPtsZ.at(ptIdx)};
       float fixedNormal2[3] = {0.0f, 0.0f, 0.0f};
       MatrixMath::Multiply3x3with3x1(gFixedT, fixedNormal1, fixedNormal2);
 
-      for(int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
+      // Both the probe direction and its inverse are tested against every triangle
+      float invertedNormal1[3] = {-fixedNormal1[0], -fixedNormal1[1], -fixedNormal1[2]};
+      candidates.clear();
+      if(nullptr != normalIndex)
+      {
+        auto addCandidate = [&candidates](size_t triRepresIdx) { candidates.push_back(triRepresIdx); };
+        normalIndex->forEachInCap(fixedNormal1, searchAngle, addCandidate);
+        normalIndex->forEachInCap(invertedNormal1, searchAngle, addCandidate);
+        // Ascending order keeps the area sum identical to visiting every triangle
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+      }
+      else
+      {
+        candidates.resize(selectedTris.size());
+        std::iota(candidates.begin(), candidates.end(), static_cast<size_t>(0));
+      }
+
+      for(const auto& triRepresIdx : candidates)
       {
         for(int inversion = 0; inversion <= 1; inversion++)
         {
@@ -933,6 +963,17 @@ void FindGBCDMetricBased::execute()
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
+  // Index the first normals of the selected triangles so each probe only visits nearby triangles
+  std::vector<float> selectedNormals(3 * selectedTris.size(), 0.0f);
+  for(size_t triRepresIdx = 0; triRepresIdx < selectedTris.size(); triRepresIdx++)
+  {
+    selectedNormals[3 * triRepresIdx] = selectedTris[triRepresIdx].normal_grain1_x;
+    selectedNormals[3 * triRepresIdx + 1] = selectedTris[triRepresIdx].normal_grain1_y;
+    selectedNormals[3 * triRepresIdx + 2] = selectedTris[triRepresIdx].normal_grain1_z;
+  }
+  OrientationAnalysis::SphericalBucketIndex normalIndex(selectedNormals.data(), selectedTris.size(), std::sqrt(2.0 * static_cast<double>(m_PlaneResolSq)));
+  const OrientationAnalysis::SphericalBucketIndex* probeIndex = m_UseSphericalIndex ? &normalIndex : nullptr;
+
   int32_t pointsChunkSize = 100;
   if(samplPtsX.size() < pointsChunkSize)
   {
@@ -956,13 +997,13 @@ void FindGBCDMetricBased::execute()
     if(doParallel)
     {
       tbb::parallel_for(tbb::blocked_range<size_t>(i, i + pointsChunkSize),
-                        GBCDMetricBased::ProbeDistrib(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT),
+                        GBCDMetricBased::ProbeDistrib(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, probeIndex, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT),
                         tbb::auto_partitioner());
     }
     else
 #endif
     {
-      GBCDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT);
+      GBCDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, probeIndex, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT);
       serial.probe(i, i + pointsChunkSize);
     }
   }
@@ -1292,3 +1333,15 @@ DataArrayPath FindGBCDMetricBased::getNodeTypesArrayPath() const
 {
   return m_NodeTypesArrayPath;
 }
+
+// -----------------------------------------------------------------------------
+void FindGBCDMetricBased::setUseSphericalIndex(bool value)
+{
+  m_UseSphericalIndex = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindGBCDMetricBased::getUseSphericalIndex() const
+{
+  return m_UseSphericalIndex;
+}
@@ -294,6 +294,18 @@ public:
   DataArrayPath getNodeTypesArrayPath() const;
   Q_PROPERTY(DataArrayPath NodeTypesArrayPath READ getNodeTypesArrayPath WRITE setNodeTypesArrayPath)
 
+  /**
+   * @brief Setter property for UseSphericalIndex. This is not a filter parameter: turning the index off makes
+   * every probe visit every selected triangle, which gives the reference the unit test compares against.
+   */
+  void setUseSphericalIndex(bool value);
+  /**
+   * @brief Getter property for UseSphericalIndex
+   * @return Value of UseSphericalIndex
+   */
+  bool getUseSphericalIndex() const;
+  Q_PROPERTY(bool UseSphericalIndex READ getUseSphericalIndex WRITE setUseSphericalIndex)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -401,6 +413,7 @@ private:
   DataArrayPath m_SurfaceMeshFaceAreasArrayPath = {SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceAreas};
   DataArrayPath m_SurfaceMeshFeatureFaceLabelsArrayPath = {SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceFeatureAttributeMatrixName, "FaceLabels"};
   DataArrayPath m_NodeTypesArrayPath = {SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::VertexAttributeMatrixName, SIMPL::VertexData::SurfaceMeshNodeType};
+  bool m_UseSphericalIndex = {true};
 
   static const int k_NumberResolutionChoices = 7;
   static const int k_DefaultResolutionChoice = 2;
@@ -45,6 +45,11 @@
 
 #include "FindGBPDMetricBased.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
 #include <QtCore/QDir>
 #include <QtCore/QTextStream>
 
@@ -66,6 +71,7 @@
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/SphericalBucketIndex.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -240,9 +246,19 @@ public:
 #endif
 };
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+using SelectedTrisType = tbb::concurrent_vector<TriAreaAndNormals>;
+#else
+using SelectedTrisType = QVector<TriAreaAndNormals>;
+#endif
+
 /**
  * @brief The ProbeDistrib class implements a threaded algorithm that determines the distribution values
- * for the GBPD
+ * for the GBPD. Both normals of every selected triangle are held in a spherical index (item 2 * t for
+ * the first normal of triangle t, 2 * t + 1 for the second). A symmetric normal sym * n lies within the
+ * limiting distance of +/- the probe exactly when n lies within it of +/- transpose(sym) * probe, so
+ * only the triangles found around those directions are visited. Without an index every selected
+ * triangle is visited.
  */
 class ProbeDistrib
 {
@@ -251,11 +267,8 @@ class ProbeDistrib
   QVector<float>* samplPtsX;
   QVector<float>* samplPtsY;
   QVector<float>* samplPtsZ;
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
-#else
-  QVector<TriAreaAndNormals> selectedTris;
-#endif
+  const SelectedTrisType& selectedTris;
+  const OrientationAnalysis::SphericalBucketIndex* normalIndex = nullptr;
   float limitDist;
   double totalFaceArea;
   int numDistinctGBs;
@@ -266,18 +279,15 @@ class ProbeDistrib
 
 public:
   ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float>* __samplPtsX, QVector<float>* __samplPtsY, QVector<float>* __samplPtsZ,
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
-#else
-               QVector<TriAreaAndNormals> __selectedTris,
-#endif
-               float __limitDist, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, int32_t __cryst)
+               const SelectedTrisType& __selectedTris, const OrientationAnalysis::SphericalBucketIndex* __normalIndex, float __limitDist, double __totalFaceArea, int __numDistinctGBs,
+               double __ballVolume, int32_t __cryst)
   : distribValues(__distribValues)
   , errorValues(__errorValues)
   , samplPtsX(__samplPtsX)
   , samplPtsY(__samplPtsY)
   , samplPtsZ(__samplPtsZ)
   , selectedTris(__selectedTris)
+  , normalIndex(__normalIndex)
   , limitDist(__limitDist)
   , totalFaceArea(__totalFaceArea)
   , numDistinctGBs(__numDistinctGBs)
@@ -292,13 +302,41 @@ public:
 
   void probe(size_t start, size_t end) const
   {
+    std::vector<size_t> candidates;
+    auto addCandidate = [&candidates](size_t normalIdx) { candidates.push_back(normalIdx / 2); };
     for(size_t ptIdx = start; ptIdx < end; ptIdx++)
     {
       double __c = 0.0;
 
       float probeNormal[3] = {(*samplPtsX).at(ptIdx), (*samplPtsY).at(ptIdx), (*samplPtsZ).at(ptIdx)};
 
-      for(int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
+      candidates.clear();
+      if(nullptr != normalIndex)
+      {
+        for(int j = 0; j < nsym; j++)
+        {
+          float sym[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+          m_OrientationOps[cryst]->getMatSymOp(j, sym);
+          float symProbe[3] = {0.0f, 0.0f, 0.0f};
+          for(int k = 0; k < 3; k++)
+          {
+            symProbe[k] = sym[0][k] * probeNormal[0] + sym[1][k] * probeNormal[1] + sym[2][k] * probeNormal[2];
+          }
+          float invertedSymProbe[3] = {-symProbe[0], -symProbe[1], -symProbe[2]};
+          normalIndex->forEachInCap(symProbe, limitDist, addCandidate);
+          normalIndex->forEachInCap(invertedSymProbe, limitDist, addCandidate);
+        }
+        // Ascending order keeps the compensated sum identical to visiting every triangle
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+      }
+      else
+      {
+        candidates.resize(selectedTris.size());
+        std::iota(candidates.begin(), candidates.end(), static_cast<size_t>(0));
+      }
+
+      for(const auto& triRepresIdx : candidates)
       {
         float normal1[3] = {selectedTris[triRepresIdx].normal_grain1_x, selectedTris[triRepresIdx].normal_grain1_y, selectedTris[triRepresIdx].normal_grain1_z};
 
@@ -1014,6 +1052,20 @@ void FindGBPDMetricBased::execute()
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
+  // Index both normals of the selected triangles so each probe only visits nearby triangles
+  std::vector<float> selectedNormals(6 * selectedTris.size(), 0.0f);
+  for(size_t triRepresIdx = 0; triRepresIdx < selectedTris.size(); triRepresIdx++)
+  {
+    selectedNormals[6 * triRepresIdx] = selectedTris[triRepresIdx].normal_grain1_x;
+    selectedNormals[6 * triRepresIdx + 1] = selectedTris[triRepresIdx].normal_grain1_y;
+    selectedNormals[6 * triRepresIdx + 2] = selectedTris[triRepresIdx].normal_grain1_z;
+    selectedNormals[6 * triRepresIdx + 3] = selectedTris[triRepresIdx].normal_grain2_x;
+    selectedNormals[6 * triRepresIdx + 4] = selectedTris[triRepresIdx].normal_grain2_y;
+    selectedNormals[6 * triRepresIdx + 5] = selectedTris[triRepresIdx].normal_grain2_z;
+  }
+  OrientationAnalysis::SphericalBucketIndex normalIndex(selectedNormals.data(), 2 * selectedTris.size(), m_LimitDist);
+  const OrientationAnalysis::SphericalBucketIndex* probeIndex = m_UseSphericalIndex ? &normalIndex : nullptr;
+
   int32_t pointsChunkSize = 20;
   if(samplPtsX.size() < pointsChunkSize)
   {
@@ -1037,13 +1089,13 @@ void FindGBPDMetricBased::execute()
     if(doParallel)
     {
       tbb::parallel_for(tbb::blocked_range<size_t>(i, i + pointsChunkSize),
-                        GBPDMetricBased::ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst),
+                        GBPDMetricBased::ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, probeIndex, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst),
                         tbb::auto_partitioner());
     }
     else
 #endif
     {
-      GBPDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst);
+      GBPDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, probeIndex, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst);
       serial.probe(i, i + pointsChunkSize);
     }
   }
@@ -1384,3 +1436,15 @@ DataArrayPath FindGBPDMetricBased::getNodeTypesArrayPath() const
 {
   return m_NodeTypesArrayPath;
 }
+
+// -----------------------------------------------------------------------------
+void FindGBPDMetricBased::setUseSphericalIndex(bool value)
+{
+  m_UseSphericalIndex = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindGBPDMetricBased::getUseSphericalIndex() const
+{
+  return m_UseSphericalIndex;
+}
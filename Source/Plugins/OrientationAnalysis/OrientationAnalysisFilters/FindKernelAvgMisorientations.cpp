@@ -35,12 +35,16 @@
 
 #include "FindKernelAvgMisorientations.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
@@ -48,15 +52,223 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "Common/MisorientationKernel.hpp"
 
-#include "EbsdLib/Core/EbsdLibConstants.h"
-#include "EbsdLib/Core/Orientation.hpp"
-#include "EbsdLib/Core/OrientationTransformation.hpp"
-#include "EbsdLib/Core/Quaternion.hpp"
-#include "EbsdLib/LaueOps/LaueOps.h"
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+namespace
+{
+/**
+ * @brief The FindKernelAvgMisorientationsImpl class computes the kernel average misorientation of
+ * every cell in a range of rows (one row is the X extent of a fixed Y and Z index). Cells are
+ * visited in memory order and the kernel is clamped to the volume once per cell, so the innermost
+ * loop only checks the Feature Id.
+ */
+class FindKernelAvgMisorientationsImpl
+{
+public:
+  FindKernelAvgMisorientationsImpl(const MisorientationKernel& misorientationKernel, const int64_t dims[3], const int64_t kernel[3], const int32_t* featureIds,
+                                   const int32_t* cellPhases, const float* quats, float* kernelAverageMisorientations)
+  : m_MisorientationKernel(misorientationKernel)
+  , m_Dims{dims[0], dims[1], dims[2]}
+  , m_Kernel{kernel[0], kernel[1], kernel[2]}
+  , m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_Quats(quats)
+  , m_KernelAverageMisorientations(kernelAverageMisorientations)
+  {
+  }
+
+  void compute(int64_t rowStart, int64_t rowEnd) const
+  {
+    const int64_t sliceStride = m_Dims[0] * m_Dims[1];
+    for(int64_t rowIndex = rowStart; rowIndex < rowEnd; rowIndex++)
+    {
+      const int64_t plane = rowIndex / m_Dims[1];
+      const int64_t row = rowIndex % m_Dims[1];
+      const int64_t zMin = std::max(plane - m_Kernel[2], static_cast<int64_t>(0));
+      const int64_t zMax = std::min(plane + m_Kernel[2], m_Dims[2] - 1);
+      const int64_t yMin = std::max(row - m_Kernel[1], static_cast<int64_t>(0));
+      const int64_t yMax = std::min(row + m_Kernel[1], m_Dims[1] - 1);
+
+      for(int64_t col = 0; col < m_Dims[0]; col++)
+      {
+        const int64_t point = rowIndex * m_Dims[0] + col;
+        const int32_t featureId = m_FeatureIds[point];
+        const int32_t phase = m_CellPhases[point];
+        if(featureId <= 0 || phase <= 0 || !m_MisorientationKernel.isValidEnsemble(phase))
+        {
+          m_KernelAverageMisorientations[point] = 0.0f;
+          continue;
+        }
+        const int64_t xMin = std::max(col - m_Kernel[0], static_cast<int64_t>(0));
+        const int64_t xMax = std::min(col + m_Kernel[0], m_Dims[0] - 1);
+        const float* q1 = m_Quats + point * 4;
+
+        float totalMisorientation = 0.0f;
+        int32_t numVoxel = 0;
+        for(int64_t z = zMin; z <= zMax; z++)
+        {
+          for(int64_t y = yMin; y <= yMax; y++)
+          {
+            const int64_t rowOffset = z * sliceStride + y * m_Dims[0];
+            for(int64_t neighbor = rowOffset + xMin; neighbor <= rowOffset + xMax; neighbor++)
+            {
+              if(m_FeatureIds[neighbor] == featureId)
+              {
+                float angle = m_MisorientationKernel.misorientationAngle(phase, q1, m_Quats + neighbor * 4);
+                totalMisorientation = totalMisorientation + (angle * SIMPLib::Constants::k_180OverPiD);
+                numVoxel++;
+              }
+            }
+          }
+        }
+        m_KernelAverageMisorientations[point] = numVoxel > 0 ? totalMisorientation / static_cast<float>(numVoxel) : 0.0f;
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    compute(static_cast<int64_t>(range.min()), static_cast<int64_t>(range.max()));
+  }
+
+private:
+  const MisorientationKernel& m_MisorientationKernel;
+  const int64_t m_Dims[3];
+  const int64_t m_Kernel[3];
+  const int32_t* m_FeatureIds = nullptr;
+  const int32_t* m_CellPhases = nullptr;
+  const float* m_Quats = nullptr;
+  float* m_KernelAverageMisorientations = nullptr;
+};
+
+/**
+ * @brief The FindKernelAvgMisorientationsPairImpl class visits every unordered pair of cells inside
+ * the kernel once, through the forward half of the kernel, and adds the misorientation to the running
+ * sums of both cells. Sums and counts of cells up to kernel[2] * dims[1] + kernel[1] rows past the
+ * processed range are updated, so callers must not run overlapping ranges concurrently.
+ */
+class FindKernelAvgMisorientationsPairImpl
+{
+public:
+  FindKernelAvgMisorientationsPairImpl(const MisorientationKernel& misorientationKernel, const int64_t dims[3], const int64_t kernel[3], const int32_t* featureIds,
+                                       const int32_t* cellPhases, const float* quats, float* sums, int32_t* counts)
+  : m_MisorientationKernel(misorientationKernel)
+  , m_Dims{dims[0], dims[1], dims[2]}
+  , m_Kernel{kernel[0], kernel[1], kernel[2]}
+  , m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_Quats(quats)
+  , m_Sums(sums)
+  , m_Counts(counts)
+  {
+  }
+
+  void accumulate(int64_t rowStart, int64_t rowEnd) const
+  {
+    const int64_t sliceStride = m_Dims[0] * m_Dims[1];
+    for(int64_t rowIndex = rowStart; rowIndex < rowEnd; rowIndex++)
+    {
+      const int64_t plane = rowIndex / m_Dims[1];
+      const int64_t row = rowIndex % m_Dims[1];
+      const int64_t zMax = std::min(plane + m_Kernel[2], m_Dims[2] - 1);
+      const int64_t yMin = std::max(row - m_Kernel[1], static_cast<int64_t>(0));
+      const int64_t yMax = std::min(row + m_Kernel[1], m_Dims[1] - 1);
+
+      for(int64_t col = 0; col < m_Dims[0]; col++)
+      {
+        const int64_t point = rowIndex * m_Dims[0] + col;
+        const int32_t featureId = m_FeatureIds[point];
+        if(featureId <= 0)
+        {
+          continue;
+        }
+        const bool pointValid = isValidCenter(point);
+        if(pointValid)
+        {
+          addPair(point, point, false);
+        }
+        const int64_t xMin = std::max(col - m_Kernel[0], static_cast<int64_t>(0));
+        const int64_t xMax = std::min(col + m_Kernel[0], m_Dims[0] - 1);
+
+        // Forward half of the kernel: the rest of this row, the following rows of this plane and
+        // the full kernel footprint of the following planes
+        for(int64_t neighbor = point + 1; neighbor <= rowIndex * m_Dims[0] + xMax; neighbor++)
+        {
+          visit(point, neighbor, featureId, pointValid);
+        }
+        for(int64_t z = plane; z <= zMax; z++)
+        {
+          for(int64_t y = (z == plane ? row + 1 : yMin); y <= yMax; y++)
+          {
+            const int64_t rowOffset = z * sliceStride + y * m_Dims[0];
+            for(int64_t neighbor = rowOffset + xMin; neighbor <= rowOffset + xMax; neighbor++)
+            {
+              visit(point, neighbor, featureId, pointValid);
+            }
+          }
+        }
+      }
+    }
+  }
+
+private:
+  const MisorientationKernel& m_MisorientationKernel;
+  const int64_t m_Dims[3];
+  const int64_t m_Kernel[3];
+  const int32_t* m_FeatureIds = nullptr;
+  const int32_t* m_CellPhases = nullptr;
+  const float* m_Quats = nullptr;
+  float* m_Sums = nullptr;
+  int32_t* m_Counts = nullptr;
+
+  bool isValidCenter(int64_t point) const
+  {
+    return m_FeatureIds[point] > 0 && m_CellPhases[point] > 0 && m_MisorientationKernel.isValidEnsemble(m_CellPhases[point]);
+  }
+
+  void visit(int64_t point, int64_t neighbor, int32_t featureId, bool pointValid) const
+  {
+    if(m_FeatureIds[neighbor] != featureId)
+    {
+      return;
+    }
+    const bool neighborValid = isValidCenter(neighbor);
+    if(pointValid && neighborValid && m_CellPhases[point] == m_CellPhases[neighbor])
+    {
+      addPair(point, neighbor, true);
+      return;
+    }
+    // The misorientation is measured with the symmetry of the center cell, so cells of different
+    // Ensembles sharing a Feature need one evaluation per side
+    if(pointValid)
+    {
+      addPair(point, neighbor, false);
+    }
+    if(neighborValid)
+    {
+      addPair(neighbor, point, false);
+    }
+  }
+
+  void addPair(int64_t center, int64_t other, bool bothSides) const
+  {
+    float angle = m_MisorientationKernel.misorientationAngle(m_CellPhases[center], m_Quats + center * 4, m_Quats + other * 4) * SIMPLib::Constants::k_180OverPiD;
+    m_Sums[center] += angle;
+    m_Counts[center]++;
+    if(bothSides)
+    {
+      m_Sums[other] += angle;
+      m_Counts[other]++;
+    }
+  }
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -79,6 +291,7 @@ void FindKernelAvgMisorientations::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Kernel Radius", KernelSize, FilterParameter::Category::Parameter, FindKernelAvgMisorientations));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Reuse Pairwise Misorientations", ReusePairwiseMisorientations, FilterParameter::Category::Parameter, FindKernelAvgMisorientations));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
 
   {
@@ -115,6 +328,7 @@ void FindKernelAvgMisorientations::readFilterParameters(AbstractFilterParameters
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
   setKernelSize(reader->readIntVec3("KernelSize", getKernelSize()));
+  setReusePairwiseMisorientations(reader->readValue("ReusePairwiseMisorientations", getReusePairwiseMisorientations()));
   reader->closeFilterGroup();
 }
 
@@ -134,6 +348,12 @@ void FindKernelAvgMisorientations::dataCheck()
   clearWarningCode();
   DataArrayPath tempPath;
 
+  if(m_KernelSize[0] < 0 || m_KernelSize[1] < 0 || m_KernelSize[2] < 0)
+  {
+    QString ss = QObject::tr("The Kernel Radius must be zero or positive in every direction (%1, %2, %3)").arg(m_KernelSize[0]).arg(m_KernelSize[1]).arg(m_KernelSize[2]);
+    setErrorCondition(-5600, ss);
+  }
+
   getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getFeatureIdsArrayPath().getDataContainerName());
 
   QVector<DataArrayPath> dataArrayPaths;
@@ -198,103 +418,58 @@ void FindKernelAvgMisorientations::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  const int64_t dims[3] = {static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2])};
+  const int64_t kernel[3] = {m_KernelSize[0], m_KernelSize[1], m_KernelSize[2]};
 
-  std::vector<LaueOps::Pointer> m_OrientationOps = LaueOps::GetAllOrientationOps();
-  FloatArrayType::Pointer quatPtr = m_QuatsPtr.lock();
-
-  int32_t numVoxel = 0; // number of voxels in the feature...
-  bool good = false;
-
-  float totalmisorientation = 0.0f;
+  MisorientationKernel misorientationKernel(m_CrystalStructures, m_CrystalStructuresPtr.lock()->getNumberOfTuples(), 0.0f);
 
-  uint32_t phase1 = EbsdLib::CrystalStructure::UnknownCrystalStructure;
-  uint32_t phase2 = EbsdLib::CrystalStructure::UnknownCrystalStructure;
-  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  const int64_t numRows = dims[1] * dims[2];
+  if(!m_ReusePairwiseMisorientations)
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numRows);
+    dataAlg.execute(FindKernelAvgMisorientationsImpl(misorientationKernel, dims, kernel, m_FeatureIds, m_CellPhases, m_Quats, m_KernelAverageMisorientations));
+    return;
+  }
 
-  int64_t xPoints = static_cast<int64_t>(udims[0]);
-  int64_t yPoints = static_cast<int64_t>(udims[1]);
-  int64_t zPoints = static_cast<int64_t>(udims[2]);
-  int64_t point = 0;
-  size_t neighbor = 0;
-  int64_t jStride = 0;
-  int64_t kStride = 0;
-  float* currentQuatPtr = nullptr;
-  for(int64_t col = 0; col < xPoints; col++)
+  // Every forward pair written from row block b lands at most kernel[2] * dims[1] + kernel[1] rows
+  // ahead, so blocks at least that tall can be processed concurrently as long as two neighboring
+  // blocks never run at the same time: all even blocks first, then all odd blocks.
+  const size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  std::vector<int32_t> pairCounts(totalPoints, 0);
+  std::fill(m_KernelAverageMisorientations, m_KernelAverageMisorientations + totalPoints, 0.0f);
+
+  const int64_t blockRows = std::max(kernel[2] * dims[1] + kernel[1], static_cast<int64_t>(1));
+  const int64_t numBlocks = (numRows + blockRows - 1) / blockRows;
+  FindKernelAvgMisorientationsPairImpl pairImpl(misorientationKernel, dims, kernel, m_FeatureIds, m_CellPhases, m_Quats, m_KernelAverageMisorientations, pairCounts.data());
+  for(int64_t parity = 0; parity < 2; parity++)
   {
-    for(int64_t row = 0; row < yPoints; row++)
+    if(getCancel())
     {
-      for(int64_t plane = 0; plane < zPoints; plane++)
+      return;
+    }
+    const int64_t numParityBlocks = (numBlocks - parity + 1) / 2;
+    ParallelDataAlgorithm blockAlg;
+    blockAlg.setRange(0, numParityBlocks);
+    blockAlg.setGrain(1);
+    blockAlg.execute([&](const SIMPLRange& range) {
+      for(size_t i = range.min(); i < range.max(); i++)
       {
-        point = (plane * xPoints * yPoints) + (row * xPoints) + col;
-        if(m_FeatureIds[point] > 0 && m_CellPhases[point] > 0)
-        {
-          totalmisorientation = 0.0f;
-          numVoxel = 0;
-          currentQuatPtr = quatPtr->getTuplePointer(point);
-          QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-
-          phase1 = m_CrystalStructures[m_CellPhases[point]];
-          for(int32_t j = -m_KernelSize[2]; j < m_KernelSize[2] + 1; j++)
-          {
-            jStride = j * xPoints * yPoints;
-            for(int32_t k = -m_KernelSize[1]; k < m_KernelSize[1] + 1; k++)
-            {
-              kStride = k * xPoints;
-              for(int32_t l = -m_KernelSize[0]; l < m_KernelSize[0] + 1; l++)
-              {
-                good = true;
-                neighbor = point + (jStride) + (kStride) + (l);
-                if(plane + j < 0)
-                {
-                  good = false;
-                }
-                else if(plane + j > zPoints - 1)
-                {
-                  good = false;
-                }
-                else if(row + k < 0)
-                {
-                  good = false;
-                }
-                else if(row + k > yPoints - 1)
-                {
-                  good = false;
-                }
-                else if(col + l < 0)
-                {
-                  good = false;
-                }
-                else if(col + l > xPoints - 1)
-                {
-                  good = false;
-                }
-                if(good && m_FeatureIds[point] == m_FeatureIds[neighbor])
-                {
-                  currentQuatPtr = quatPtr->getTuplePointer(neighbor);
-
-                  QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-                  phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                  OrientationF axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-
-                  totalmisorientation = totalmisorientation + (axisAngle[3] * SIMPLib::Constants::k_180OverPiD);
-                  numVoxel++;
-                }
-              }
-            }
-          }
-          m_KernelAverageMisorientations[point] = totalmisorientation / (float)numVoxel;
-          if(numVoxel == 0)
-          {
-            m_KernelAverageMisorientations[point] = 0.0f;
-          }
-        }
-        if(m_FeatureIds[point] == 0 || m_CellPhases[point] == 0)
-        {
-          m_KernelAverageMisorientations[point] = 0.0f;
-        }
+        const int64_t block = static_cast<int64_t>(i) * 2 + parity;
+        pairImpl.accumulate(block * blockRows, std::min((block + 1) * blockRows, numRows));
       }
-    }
+    });
   }
+
+  ParallelDataAlgorithm averageAlg;
+  averageAlg.setRange(0, totalPoints);
+  averageAlg.execute([&](const SIMPLRange& range) {
+    for(size_t point = range.min(); point < range.max(); point++)
+    {
+      m_KernelAverageMisorientations[point] = pairCounts[point] > 0 ? m_KernelAverageMisorientations[point] / static_cast<float>(pairCounts[point]) : 0.0f;
+    }
+  });
 }
 
 // -----------------------------------------------------------------------------
@@ -468,3 +643,15 @@ IntVec3Type FindKernelAvgMisorientations::getKernelSize() const
 {
   return m_KernelSize;
 }
+
+// -----------------------------------------------------------------------------
+void FindKernelAvgMisorientations::setReusePairwiseMisorientations(bool value)
+{
+  m_ReusePairwiseMisorientations = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindKernelAvgMisorientations::getReusePairwiseMisorientations() const
+{
+  return m_ReusePairwiseMisorientations;
+}
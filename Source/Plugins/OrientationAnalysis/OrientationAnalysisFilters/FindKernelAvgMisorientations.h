@@ -62,6 +62,7 @@ class OrientationAnalysis_EXPORT FindKernelAvgMisorientations : public AbstractF
   PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
   PYB11_PROPERTY(QString KernelAverageMisorientationsArrayName READ getKernelAverageMisorientationsArrayName WRITE setKernelAverageMisorientationsArrayName)
   PYB11_PROPERTY(IntVec3Type KernelSize READ getKernelSize WRITE setKernelSize)
+  PYB11_PROPERTY(bool ReusePairwiseMisorientations READ getReusePairwiseMisorientations WRITE setReusePairwiseMisorientations)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -161,6 +162,17 @@ public:
   IntVec3Type getKernelSize() const;
   Q_PROPERTY(IntVec3Type KernelSize READ getKernelSize WRITE setKernelSize)
 
+  /**
+   * @brief Setter property for ReusePairwiseMisorientations
+   */
+  void setReusePairwiseMisorientations(bool value);
+  /**
+   * @brief Getter property for ReusePairwiseMisorientations
+   * @return Value of ReusePairwiseMisorientations
+   */
+  bool getReusePairwiseMisorientations() const;
+  Q_PROPERTY(bool ReusePairwiseMisorientations READ getReusePairwiseMisorientations WRITE setReusePairwiseMisorientations)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -251,6 +263,7 @@ private:
   DataArrayPath m_QuatsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats};
   QString m_KernelAverageMisorientationsArrayName = {SIMPL::CellData::KernelAverageMisorientations};
   IntVec3Type m_KernelSize = {};
+  bool m_ReusePairwiseMisorientations = {false};
 
 public:
   FindKernelAvgMisorientations(const FindKernelAvgMisorientations&) = delete;            // Copy Constructor Not Implemented
@@ -34,11 +34,14 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ReadH5Ebsd.h"
 
+#include <limits>
+
 #include <QtCore/QFileInfo>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/CoreFilters/RotateSampleRefFrame.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -46,11 +49,14 @@
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
-#include "SIMPLib/Filtering/FilterManager.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/MatrixMath.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/Core/EbsdMacros.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/IO/H5EbsdVolumeInfo.h"
 #include "EbsdLib/IO/HKL/CtfFields.h"
 #include "EbsdLib/IO/HKL/H5CtfVolumeReader.h"
@@ -82,6 +88,71 @@ std::set<std::string> convertToStl(const QSet<QString>& in)
   return out;
 }
 
+/**
+ * @brief The EulerRefFrameRotation class rotates Euler angles about an axis-angle pair exactly like the
+ * RotateEulerRefFrame filter does, one tuple at a time so it can be applied while the angles are copied.
+ */
+class EulerRefFrameRotation
+{
+public:
+  /**
+   * @brief EulerRefFrameRotation
+   * @param transformation Rotation axis and angle (in degrees)
+   */
+  explicit EulerRefFrameRotation(const AxisAngleInput& transformation)
+  {
+    float rotAngle = transformation.angle * SIMPLib::Constants::k_PiD / 180.0f;
+    float rotAxis[3] = {transformation.h, transformation.k, transformation.l};
+    MatrixMath::Normalize3x1(rotAxis);
+    OrientationTransformation::ax2om<OrientationF, OrientationF>(OrientationF(rotAxis[0], rotAxis[1], rotAxis[2], rotAngle)).toGMatrix(m_RotMat);
+  }
+
+  /**
+   * @brief rotate Rotates one Euler angle triplet in place
+   * @param eulers The 3 Euler angles (in radians)
+   */
+  void rotate(float* eulers) const
+  {
+    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float gNew[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    OrientationTransformation::eu2om<OrientationF, OrientationF>(OrientationF(eulers[0], eulers[1], eulers[2])).toGMatrix(g);
+    MatrixMath::Multiply3x3with3x3(g, m_RotMat, gNew);
+    MatrixMath::Normalize3x3(gNew);
+    OrientationF eu(eulers, 3);
+    eu = OrientationTransformation::om2eu<OrientationF, OrientationF>(OrientationF(gNew));
+  }
+
+private:
+  float m_RotMat[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+};
+
+/**
+ * @brief copyRemapped Copies a single component array out of the reader into the Cell array,
+ * applying the slice remap on the way; Cells without a source are zero filled
+ * @param source Array as read
+ * @param dest Cell array
+ * @param remap Slice remap of the sample reference frame transformation
+ */
+template <typename T>
+void copyRemapped(const T* source, T* dest, const OrientationAnalysis::SliceRemap& remap)
+{
+  const size_t totalPoints = remap.getNumberOfTuples();
+  if(remap.isIdentity())
+  {
+    ::memcpy(dest, source, sizeof(T) * totalPoints);
+    return;
+  }
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, totalPoints);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      const int64_t sourceIndex = remap.sourceIndex(i);
+      dest[i] = sourceIndex == OrientationAnalysis::SliceRemap::k_NoSource ? T{} : source[sourceIndex];
+    }
+  });
+}
+
 #if 0
 QSet<QString> convertToQt(std::set<std::string>& in)
 {
@@ -574,14 +645,26 @@ void ReadH5Ebsd::execute()
     return;
   }
 
+  // The sample reference frame rotation is applied as an index remap while the arrays are copied
+  ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
+  OrientationAnalysis::SliceRemap remap(imageGeom->getNumberOfElements());
+  if(m_UseTransformations && m_SampleTransformation.angle > 0)
+  {
+    computeSampleTransformation(remap);
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+  }
+
   // Copy the data from the pointers embedded in the reader object into our data container (Cell array).
   if(manufacturer == EbsdLib::Ang::Manufacturer)
   {
-    copyTSLArrays(ebsdReader.get());
+    copyTSLArrays(ebsdReader.get(), remap);
   }
   else if(manufacturer == EbsdLib::Ctf::Manufacturer)
   {
-    copyHKLArrays(ebsdReader.get());
+    copyHKLArrays(ebsdReader.get(), remap);
   }
 
   else
@@ -592,99 +675,106 @@ void ReadH5Ebsd::execute()
     setErrorCondition(-109875, ss);
     return;
   }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadH5Ebsd::computeSampleTransformation(OrientationAnalysis::SliceRemap& remap)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
+  const SizeVec3Type dims = imageGeom->getDimensions();
+  const size_t sliceSize = dims[0] * dims[1];
+  if(sliceSize >= static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+  {
+    QString ss = QObject::tr("A slice of %1 x %2 Cells is too large for the sample reference frame transformation").arg(dims[0]).arg(dims[1]);
+    setErrorCondition(-389, ss);
+    return;
+  }
 
-  if(m_UseTransformations)
+  // The rotation is slice by slice, so every slice is moved the same way and no Cell changes slice. RotateSampleRefFrame
+  // is therefore run over a proxy of a single slice whose Cells only hold their own index + 1 (a 0 marks the Cells that
+  // are zero filled for being left without a source), and the resulting table is reused for every slice. The proxy and
+  // its rotated copy hold 4 bytes and the table 8 bytes per Cell of one slice, independent of the number of slices.
+  const QString sourceName("_ReadH5Ebsd_SliceSource");
+
+  DataContainerArray::Pointer proxyDca = DataContainerArray::New();
+  DataContainer::Pointer proxyDc = DataContainer::New(getDataContainerName().getDataContainerName());
+  ImageGeom::Pointer proxyGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+  proxyGeom->setDimensions(SizeVec3Type(dims[0], dims[1], 1));
+  proxyGeom->setOrigin(imageGeom->getOrigin());
+  proxyGeom->setSpacing(imageGeom->getSpacing());
+  proxyDc->setGeometry(proxyGeom);
+  proxyDca->addOrReplaceDataContainer(proxyDc);
+  std::vector<size_t> tDims = {dims[0], dims[1], 1};
+  AttributeMatrix::Pointer proxyAttrMat = AttributeMatrix::New(tDims, getCellAttributeMatrixName(), AttributeMatrix::Type::Cell);
+  proxyDc->addOrReplaceAttributeMatrix(proxyAttrMat);
+  Int32ArrayType::Pointer sourceArray = Int32ArrayType::CreateArray(sliceSize, sourceName, true);
+  int32_t* source = sourceArray->getPointer(0);
+  for(size_t i = 0; i < sliceSize; i++)
   {
+    source[i] = static_cast<int32_t>(i + 1);
+  }
+  proxyAttrMat->insertOrAssign(sourceArray);
 
-    if(m_SampleTransformation.angle > 0)
-    {
-      FloatVec3Type sampleAxis;
-      sampleAxis[0] = m_SampleTransformation.h;
-      sampleAxis[1] = m_SampleTransformation.k;
-      sampleAxis[2] = m_SampleTransformation.l;
-
-      RotateSampleRefFrame::Pointer rot_Sample = RotateSampleRefFrame::New();
-
-      // Connect up the Error/Warning/Progress object so the filter can report those things
-      connect(rot_Sample.get(), SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), this, SIGNAL(messageGenerated(const AbstractMessage::Pointer&)));
-      rot_Sample->setDataContainerArray(getDataContainerArray()); // AbstractFilter implements this so no problem
-      // Now set the filter parameters for the filter using QProperty System since we can not directly
-      // instantiate the filter since it resides in a plugin. These calls are SLOW. DO NOT EVER do this in a
-      // tight loop. Your filter will slow down by 10X.
-      rot_Sample->setRotationAngle(m_SampleTransformation.angle);
-      rot_Sample->setRotationAxis(sampleAxis);
-      rot_Sample->setSliceBySlice(true);
-
-      DataArrayPath tempPath;
-      tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), "");
-      rot_Sample->setCellAttributeMatrixPath(tempPath);
-
-      rot_Sample->execute();
-    }
+  FloatVec3Type sampleAxis;
+  sampleAxis[0] = m_SampleTransformation.h;
+  sampleAxis[1] = m_SampleTransformation.k;
+  sampleAxis[2] = m_SampleTransformation.l;
+
+  RotateSampleRefFrame::Pointer rot_Sample = RotateSampleRefFrame::New();
+
+  // Connect up the Error/Warning/Progress object so the filter can report those things
+  connect(rot_Sample.get(), SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), this, SIGNAL(messageGenerated(const AbstractMessage::Pointer&)));
+  rot_Sample->setDataContainerArray(proxyDca);
+  rot_Sample->setRotationAngle(m_SampleTransformation.angle);
+  rot_Sample->setRotationAxis(sampleAxis);
+  rot_Sample->setSliceBySlice(true);
 
-    if(m_EulerTransformation.angle > 0)
+  DataArrayPath tempPath;
+  tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), "");
+  rot_Sample->setCellAttributeMatrixPath(tempPath);
+
+  rot_Sample->execute();
+  if(rot_Sample->getErrorCode() < 0)
+  {
+    QString ss = QObject::tr("Error applying the sample reference frame transformation (%1 degrees about <%2, %3, %4>)")
+                     .arg(m_SampleTransformation.angle)
+                     .arg(m_SampleTransformation.h)
+                     .arg(m_SampleTransformation.k)
+                     .arg(m_SampleTransformation.l);
+    setErrorCondition(rot_Sample->getErrorCode(), ss);
+    return;
+  }
+
+  ImageGeom::Pointer rotatedGeom = proxyDc->getGeometryAs<ImageGeom>();
+  const SizeVec3Type rotatedDims = rotatedGeom->getDimensions();
+  if(rotatedDims[2] != 1)
+  {
+    QString ss = QObject::tr("The sample reference frame transformation moved Cells between slices");
+    setErrorCondition(-390, ss);
+    return;
+  }
+  source = proxyDc->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayAs<Int32ArrayType>(sourceName)->getPointer(0);
+  std::vector<int64_t> sliceSources(rotatedDims[0] * rotatedDims[1], OrientationAnalysis::SliceRemap::k_NoSource);
+  for(size_t i = 0; i < sliceSources.size(); i++)
+  {
+    if(source[i] != 0)
     {
-      FloatVec3Type eulerAxis;
-      eulerAxis[0] = m_EulerTransformation.h;
-      eulerAxis[1] = m_EulerTransformation.k;
-      eulerAxis[2] = m_EulerTransformation.l;
-
-      QString filtName = "RotateEulerRefFrame";
-      FilterManager* fm = FilterManager::Instance();
-      IFilterFactory::Pointer rotEulerFactory = fm->getFactoryFromClassName(filtName);
-      if(nullptr != rotEulerFactory.get())
-      {
-        // If we get this far, the Factory is good so creating the filter should not fail unless something has
-        // horribly gone wrong in which case the system is going to come down quickly after this.
-        AbstractFilter::Pointer rot_Euler = rotEulerFactory->create();
-
-        // Connect up the Error/Warning/Progress object so the filter can report those things
-        connect(rot_Euler.get(), SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), this, SIGNAL(messageGenerated(const AbstractMessage::Pointer&)));
-        rot_Euler->setDataContainerArray(getDataContainerArray()); // AbstractFilter implements this so no problem
-        // Now set the filter parameters for the filter using QProperty System since we can not directly
-        // instantiate the filter since it resides in a plugin. These calls are SLOW. DO NOT EVER do this in a
-        // tight loop. Your filter will slow down by 10X.
-        bool propWasSet = rot_Euler->setProperty("RotationAngle", m_EulerTransformation.angle);
-        if(!propWasSet)
-        {
-          QString ss = QObject::tr("ReadH5Ebsd Error Setting Property '%1' into filter '%2' which is a subfilter called by ReadH5Ebsd. The property was not set which could mean the property was not "
-                                   "exposed with a Q_PROPERTY macro. Please notify the developers")
-                           .arg("RotationAngle")
-                           .arg(filtName);
-          setErrorCondition(-109884, ss);
-        }
-        QVariant v;
-        v.setValue(eulerAxis);
-        propWasSet = rot_Euler->setProperty("RotationAxis", v);
-        if(!propWasSet)
-        {
-          QString ss = QObject::tr("ReadH5Ebsd Error Setting Property '%1' into filter '%2' which is a subfilter called by ReadH5Ebsd. The property was not set which could mean the property was not "
-                                   "exposed with a Q_PROPERTY macro. Please notify the developers")
-                           .arg("RotationAxis")
-                           .arg(filtName);
-          setErrorCondition(-109873, ss);
-        }
-        DataArrayPath tempPath;
-        tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), getCellEulerAnglesArrayName());
-        v.setValue(tempPath);
-        propWasSet = rot_Euler->setProperty("CellEulerAnglesArrayPath", v);
-        if(!propWasSet)
-        {
-          QString ss = QObject::tr("ReadH5Ebsd Error Setting Property '%1' into filter '%2' which is a subfilter called by ReadH5Ebsd. The property was not set which could mean the property was not "
-                                   "exposed with a Q_PROPERTY macro. Please notify the developers")
-                           .arg("CellEulerAnglesArrayPath")
-                           .arg(filtName);
-          setErrorCondition(-109872, ss);
-        }
-        rot_Euler->execute();
-      }
-      else
-      {
-        QString ss = QObject::tr("ReadH5Ebsd Error creating filter '%1' which is a subfilter called by ReadH5Ebsd. Filter was not created/executed. Please notify the developers").arg(filtName);
-        setErrorCondition(-109881, ss);
-      }
+      sliceSources[i] = source[i] - 1;
     }
   }
+  remap.setSliceSources(std::move(sliceSources), sliceSize, dims[2]);
+
+  // The slices stay where they are, so only the in plane part of the rotated geometry is taken over
+  const FloatVec3Type origin = imageGeom->getOrigin();
+  const FloatVec3Type spacing = imageGeom->getSpacing();
+  const FloatVec3Type rotatedOrigin = rotatedGeom->getOrigin();
+  const FloatVec3Type rotatedSpacing = rotatedGeom->getSpacing();
+  imageGeom->setDimensions(SizeVec3Type(rotatedDims[0], rotatedDims[1], dims[2]));
+  imageGeom->setOrigin(FloatVec3Type(rotatedOrigin[0], rotatedOrigin[1], origin[2]));
+  imageGeom->setSpacing(FloatVec3Type(rotatedSpacing[0], rotatedSpacing[1], spacing[2]));
 }
 
 // -----------------------------------------------------------------------------
@@ -754,7 +844,7 @@ H5EbsdVolumeReader::Pointer ReadH5Ebsd::initHKLEbsdVolumeReader()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
+void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader, const OrientationAnalysis::SliceRemap& remap)
 {
   float* f1 = nullptr;
   float* f2 = nullptr;
@@ -778,7 +868,7 @@ void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
   {
     phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(EbsdLib::Ang::PhaseData));
     iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases, true);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
+    ::copyRemapped(phasePtr, iArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(iArray);
   }
 
@@ -795,12 +885,34 @@ void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
     {
       degToRad = SIMPLib::Constants::k_PiOver180D;
     }
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      cellEulerAngles[3 * i] = f1[i] * degToRad;
-      cellEulerAngles[3 * i + 1] = f2[i] * degToRad;
-      cellEulerAngles[3 * i + 2] = f3[i] * degToRad;
-    }
+    // The Euler reference frame transformation is applied to each tuple as it is copied
+    bool rotateEulers = m_UseTransformations && m_EulerTransformation.angle > 0;
+    ::EulerRefFrameRotation eulerRotation(m_EulerTransformation);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, totalPoints);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      for(size_t i = range.min(); i < range.max(); i++)
+      {
+        const int64_t source = remap.sourceIndex(i);
+        // Cells the sample rotation leaves without a source get zero angles, which are still rotated
+        if(source == OrientationAnalysis::SliceRemap::k_NoSource)
+        {
+          cellEulerAngles[3 * i] = 0.0f;
+          cellEulerAngles[3 * i + 1] = 0.0f;
+          cellEulerAngles[3 * i + 2] = 0.0f;
+        }
+        else
+        {
+          cellEulerAngles[3 * i] = f1[source] * degToRad;
+          cellEulerAngles[3 * i + 1] = f2[source] * degToRad;
+          cellEulerAngles[3 * i + 2] = f3[source] * degToRad;
+        }
+        if(rotateEulers)
+        {
+          eulerRotation.rotate(cellEulerAngles + 3 * i);
+        }
+      }
+    });
     cellAttrMatrix->insertOrAssign(fArray);
   }
 
@@ -811,7 +923,7 @@ void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
   {
     f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::ImageQuality));
     fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ang::ImageQuality), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
+    ::copyRemapped(f1, fArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(fArray);
   }
 
@@ -819,7 +931,7 @@ void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
   {
     f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::ConfidenceIndex));
     fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ang::ConfidenceIndex), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
+    ::copyRemapped(f1, fArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(fArray);
   }
 
@@ -827,7 +939,7 @@ void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
   {
     f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::SEMSignal));
     fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ang::SEMSignal), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
+    ::copyRemapped(f1, fArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(fArray);
   }
 
@@ -835,7 +947,7 @@ void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
   {
     f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::Fit));
     fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ang::Fit), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
+    ::copyRemapped(f1, fArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(fArray);
   }
 
@@ -843,7 +955,7 @@ void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
   {
     f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::XPosition));
     fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ang::XPosition), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
+    ::copyRemapped(f1, fArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(fArray);
   }
 
@@ -851,7 +963,7 @@ void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
   {
     f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::YPosition));
     fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ang::YPosition), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
+    ::copyRemapped(f1, fArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(fArray);
   }
 }
@@ -859,7 +971,7 @@ void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
+void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader, const OrientationAnalysis::SliceRemap& remap)
 {
   float* f1 = nullptr;
   float* f2 = nullptr;
@@ -880,7 +992,7 @@ void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
   std::vector<size_t> cDims(1, 1);
   phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(EbsdLib::Ctf::Phase));
   iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases, true);
-  ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
+  ::copyRemapped(phasePtr, iArray->getPointer(0), remap);
   cellAttrMatrix->insertOrAssign(iArray);
 
   if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
@@ -898,16 +1010,38 @@ void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
     {
       degToRad = SIMPLib::Constants::k_PiOver180D;
     }
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      cellEulerAngles[3 * i] = f1[i] * degToRad;
-      cellEulerAngles[3 * i + 1] = f2[i] * degToRad;
-      cellEulerAngles[3 * i + 2] = f3[i] * degToRad;
-      if(m_CrystalStructures[cellPhases[i]] == EbsdLib::CrystalStructure::Hexagonal_High)
+    // The Euler reference frame transformation is applied to each tuple as it is copied
+    bool rotateEulers = m_UseTransformations && m_EulerTransformation.angle > 0;
+    ::EulerRefFrameRotation eulerRotation(m_EulerTransformation);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, totalPoints);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      for(size_t i = range.min(); i < range.max(); i++)
       {
-        cellEulerAngles[3 * i + 2] = cellEulerAngles[3 * i + 2] + (30.0 * degToRad);
+        const int64_t source = remap.sourceIndex(i);
+        // Cells the sample rotation leaves without a source get zero angles, which are still rotated
+        if(source == OrientationAnalysis::SliceRemap::k_NoSource)
+        {
+          cellEulerAngles[3 * i] = 0.0f;
+          cellEulerAngles[3 * i + 1] = 0.0f;
+          cellEulerAngles[3 * i + 2] = 0.0f;
+        }
+        else
+        {
+          cellEulerAngles[3 * i] = f1[source] * degToRad;
+          cellEulerAngles[3 * i + 1] = f2[source] * degToRad;
+          cellEulerAngles[3 * i + 2] = f3[source] * degToRad;
+          if(m_CrystalStructures[cellPhases[i]] == EbsdLib::CrystalStructure::Hexagonal_High)
+          {
+            cellEulerAngles[3 * i + 2] = cellEulerAngles[3 * i + 2] + (30.0 * degToRad);
+          }
+        }
+        if(rotateEulers)
+        {
+          eulerRotation.rotate(cellEulerAngles + 3 * i);
+        }
       }
-    }
+    });
     cellAttrMatrix->insertOrAssign(fArray);
   }
 
@@ -916,7 +1050,7 @@ void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
   {
     phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(EbsdLib::Ctf::Bands));
     iArray = Int32ArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::Bands), true);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
+    ::copyRemapped(phasePtr, iArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(iArray);
   }
 
@@ -924,7 +1058,7 @@ void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
   {
     phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(EbsdLib::Ctf::Error));
     iArray = Int32ArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::Error), true);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
+    ::copyRemapped(phasePtr, iArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(iArray);
   }
 
@@ -932,7 +1066,7 @@ void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
   {
     f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ctf::MAD));
     fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::MAD), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
+    ::copyRemapped(f1, fArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(fArray);
   }
 
@@ -940,7 +1074,7 @@ void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
   {
     phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(EbsdLib::Ctf::BC));
     iArray = Int32ArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::BC), true);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
+    ::copyRemapped(phasePtr, iArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(iArray);
   }
 
@@ -948,21 +1082,21 @@ void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
   {
     phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(EbsdLib::Ctf::BS));
     iArray = Int32ArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::BS), true);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
+    ::copyRemapped(phasePtr, iArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(iArray);
   }
   if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ctf::X)) != m_SelectedArrayNames.end())
   {
     f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ctf::X));
     fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::X), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
+    ::copyRemapped(f1, fArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(fArray);
   }
   if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ctf::Y)) != m_SelectedArrayNames.end())
   {
     f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ctf::Y));
     fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::Y), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
+    ::copyRemapped(f1, fArray->getPointer(0), remap);
     cellAttrMatrix->insertOrAssign(fArray);
   }
 }
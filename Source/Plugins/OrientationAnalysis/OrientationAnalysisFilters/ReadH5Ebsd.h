@@ -49,6 +49,7 @@
 #include "EbsdLib/IO/H5EbsdVolumeReader.h"
 
 #include "OrientationAnalysis/OrientationAnalysisDLLExport.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/SliceRemap.hpp"
 
 class H5EbsdVolumeReader;
 
@@ -423,17 +424,29 @@ protected:
    */
   H5EbsdVolumeReader::Pointer initHKLEbsdVolumeReader();
 
+  /**
+   * @brief computeSampleTransformation Runs the slice by slice sample reference frame rotation over a proxy of
+   * a single slice, moves the geometry to the rotated dimensions, origin and spacing and stores the source of each
+   * Cell of a rotated slice in the remap
+   * @param remap Cell index remap of the sample reference frame transformation
+   */
+  void computeSampleTransformation(OrientationAnalysis::SliceRemap& remap);
+
   /**
    * @brief copyTSLArrays Copies the read arrays into the data container structure (TSL variant)
+   * applying the sample and Euler reference frame transformations on the way
    * @param ebsdReader H5EbsdVolumeReader instance pointer
+   * @param remap Cell index remap of the sample reference frame transformation
    */
-  void copyTSLArrays(H5EbsdVolumeReader* ebsdReader);
+  void copyTSLArrays(H5EbsdVolumeReader* ebsdReader, const OrientationAnalysis::SliceRemap& remap);
 
   /**
    * @brief copyHKLArrays Copies the read arrays into the data container structure (HKL variant)
+   * applying the sample and Euler reference frame transformations on the way
    * @param ebsdReader H5EbsdVolumeReader instance pointer
+   * @param remap Cell index remap of the sample reference frame transformation
    */
-  void copyHKLArrays(H5EbsdVolumeReader* ebsdReader);
+  void copyHKLArrays(H5EbsdVolumeReader* ebsdReader, const OrientationAnalysis::SliceRemap& remap);
 
   /**
    * @brief loadInfo Reads the values for the phase type, crystal structure
@@ -0,0 +1,204 @@
+/* ============================================================================
+ * Copyright (c) 2021 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#if __has_include(<tbb/parallel_pipeline.h>)
+#include <tbb/parallel_pipeline.h>
+#else
+#include <tbb/pipeline.h>
+#endif
+#endif
+
+namespace OrientationAnalysis
+{
+
+/**
+ * @brief The OrderedPipeline class runs a producer over the indices [0, count) in parallel and hands every
+ * result to a consumer in index order, using tbb::parallel_pipeline with a parallel produce stage between
+ * two serial_in_order stages. The token limit keeps the producer from running more than a fixed number of
+ * results ahead of the consumer, which caps the memory held by results that are waiting to be consumed.
+ * Exceptions never cross the pipeline: one thrown by the producer is carried to the consumer stage with its
+ * result, and from there, like one thrown by the consumer, stops the pipeline and is rethrown on the calling
+ * thread once every result before it has been consumed. Without SIMPL_USE_PARALLEL_ALGORITHMS everything
+ * runs serially on the calling thread.
+ */
+template <typename T>
+class OrderedPipeline
+{
+public:
+  using Producer = std::function<T(size_t)>;
+  using Consumer = std::function<bool(size_t, T&)>;
+
+  /**
+   * @brief OrderedPipeline
+   * @param numThreads Maximum number of threads running the pipeline; 0 or 1 runs everything serially on the calling thread
+   * @param capacity Maximum number of results in flight at once (the token limit of the pipeline)
+   */
+  OrderedPipeline(size_t numThreads, size_t capacity)
+  : m_NumThreads(numThreads)
+  , m_Capacity(capacity < 1 ? 1 : capacity)
+  {
+  }
+
+  /**
+   * @brief run Produces and consumes the indices [0, count)
+   * @param count Number of indices
+   * @param produce Called concurrently, once per index
+   * @param consume Called in index order, one index at a time; returning false stops the pipeline
+   * @return Number of results handed to the consumer
+   * @throws Whatever the producer or the consumer threw, on the calling thread
+   */
+  size_t run(size_t count, const Producer& produce, const Consumer& consume) const
+  {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(m_NumThreads > 1 && count > 1)
+    {
+      return runParallel(count, produce, consume);
+    }
+#endif
+    for(size_t index = 0; index < count; index++)
+    {
+      T result = produce(index);
+      if(!consume(index, result))
+      {
+        return index + 1;
+      }
+    }
+    return count;
+  }
+
+private:
+  size_t m_NumThreads = 0;
+  size_t m_Capacity = 1;
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  // oneTBB moved parallel_pipeline into its own header and the filter modes into tbb::filter_mode
+#if __has_include(<tbb/parallel_pipeline.h>)
+  using FilterMode = tbb::filter_mode;
+#else
+  using FilterMode = tbb::filter;
+#endif
+
+  /**
+   * @brief The Slot struct is the token handed from the produce stage to the consume stage
+   */
+  struct Slot
+  {
+    size_t index = 0;
+    T result = {};
+    std::exception_ptr error;
+  };
+
+  size_t runParallel(size_t count, const Producer& produce, const Consumer& consume) const
+  {
+    std::atomic<bool> stop(false);
+    std::exception_ptr error;
+    size_t nextIndex = 0;
+    size_t numConsumed = 0;
+
+    auto input = [&](tbb::flow_control& fc) -> size_t {
+      if(stop || nextIndex >= count)
+      {
+        fc.stop();
+        return 0;
+      }
+      return nextIndex++;
+    };
+
+    auto producer = [&](size_t index) -> Slot* {
+      Slot* slot = new Slot;
+      slot->index = index;
+      if(stop)
+      {
+        return slot;
+      }
+      try
+      {
+        slot->result = produce(index);
+      } catch(...)
+      {
+        slot->error = std::current_exception();
+      }
+      return slot;
+    };
+
+    auto consumer = [&](Slot* token) {
+      std::unique_ptr<Slot> slot(token);
+      if(stop)
+      {
+        return;
+      }
+      if(slot->error)
+      {
+        error = slot->error;
+        stop = true;
+        return;
+      }
+      try
+      {
+        numConsumed++;
+        stop = !consume(slot->index, slot->result);
+      } catch(...)
+      {
+        error = std::current_exception();
+        stop = true;
+      }
+    };
+
+    tbb::task_arena arena(static_cast<int>(m_NumThreads));
+    arena.execute([&]() {
+      tbb::parallel_pipeline(m_Capacity, tbb::make_filter<void, size_t>(FilterMode::serial_in_order, input) & tbb::make_filter<size_t, Slot*>(FilterMode::parallel, producer) &
+                                             tbb::make_filter<Slot*, void>(FilterMode::serial_in_order, consumer));
+    });
+    if(error)
+    {
+      std::rethrow_exception(error);
+    }
+    return numConsumed;
+  }
+#endif
+};
+
+} // namespace OrientationAnalysis
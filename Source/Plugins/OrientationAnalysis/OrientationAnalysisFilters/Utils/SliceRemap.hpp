@@ -0,0 +1,119 @@
+/* ============================================================================
+ * Copyright (c) 2021 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace OrientationAnalysis
+{
+
+/**
+ * @brief The SliceRemap class maps every Cell of an image volume onto the Cell of the volume as read
+ * that it takes its values from, so a slice by slice sample reference frame rotation can be applied
+ * while the arrays are copied instead of rewriting every array afterwards. A slice by slice rotation
+ * moves every slice the same way and never moves a Cell to another slice, so only the table of a single
+ * slice is stored and the slice index is carried over unchanged. The table itself is produced by the
+ * rotation (see ReadH5Ebsd::computeSampleTransformation); Cells that the rotation leaves without a
+ * source are marked with k_NoSource and are zero filled.
+ */
+class SliceRemap
+{
+public:
+  static constexpr int64_t k_NoSource = -1;
+
+  /**
+   * @brief SliceRemap Creates the identity remap of a volume
+   * @param numTuples Number of Cells of the volume
+   */
+  explicit SliceRemap(size_t numTuples)
+  : m_NumTuples(numTuples)
+  {
+  }
+
+  /**
+   * @brief setSliceSources Replaces the remap with an explicit table of a single slice
+   * @param sliceSources Index inside the source slice of each Cell of a remapped slice, or k_NoSource
+   * @param sourceSliceSize Number of Cells of a slice of the volume as read
+   * @param numSlices Number of slices of the volume
+   */
+  void setSliceSources(std::vector<int64_t> sliceSources, size_t sourceSliceSize, size_t numSlices)
+  {
+    m_NumTuples = sliceSources.size() * numSlices;
+    m_SourceSliceSize = static_cast<int64_t>(sourceSliceSize);
+    m_SliceSources = std::move(sliceSources);
+    m_Identity = false;
+  }
+
+  /**
+   * @brief isIdentity Returns whether every Cell is read from the same index
+   */
+  bool isIdentity() const
+  {
+    return m_Identity;
+  }
+
+  /**
+   * @brief getNumberOfTuples Returns the number of Cells of the remapped volume
+   */
+  size_t getNumberOfTuples() const
+  {
+    return m_NumTuples;
+  }
+
+  /**
+   * @brief sourceIndex Returns the index of the Cell that is copied to destIndex, or k_NoSource
+   * @param destIndex Index into the remapped volume
+   */
+  int64_t sourceIndex(size_t destIndex) const
+  {
+    if(m_Identity)
+    {
+      return static_cast<int64_t>(destIndex);
+    }
+    const size_t sliceSize = m_SliceSources.size();
+    const int64_t sliceSource = m_SliceSources[destIndex % sliceSize];
+    return sliceSource == k_NoSource ? k_NoSource : static_cast<int64_t>(destIndex / sliceSize) * m_SourceSliceSize + sliceSource;
+  }
+
+private:
+  size_t m_NumTuples = 0;
+  bool m_Identity = true;
+  int64_t m_SourceSliceSize = 0;
+  std::vector<int64_t> m_SliceSources;
+};
+
+} // namespace OrientationAnalysis
@@ -0,0 +1,225 @@
+/* ============================================================================
+ * Copyright (c) 2021 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace OrientationAnalysis
+{
+
+/**
+ * @brief The SphericalBucketIndex class buckets a set of directions (unit vectors) into roughly equal
+ * area latitude/longitude cells so that "which directions are within some angle of this one" only
+ * visits the cells overlapping that spherical cap instead of every direction.
+ *
+ * The polar angle is split into equal bands and each band into as many azimuth cells as keeps the
+ * cells roughly square. The items are stored in compressed sparse row form per cell, in ascending
+ * item order. Directions that are not unit length within k_UnitTolerance cannot be bounded by their
+ * angle and are reported by every query.
+ */
+class SphericalBucketIndex
+{
+public:
+  static constexpr double k_UnitTolerance = 1.0E-5;
+  static constexpr double k_AngleMargin = 1.0E-3;
+  static constexpr int32_t k_MaxBands = 720;
+
+  /**
+   * @brief SphericalBucketIndex
+   * @param directions Interleaved x, y, z components, one triple per item
+   * @param numItems Number of items
+   * @param cellAngle Preferred angular size of a cell in radians, typically the query angle
+   */
+  SphericalBucketIndex(const float* directions, size_t numItems, double cellAngle)
+  {
+    if(!(cellAngle > 0.0) || !std::isfinite(cellAngle))
+    {
+      cellAngle = k_Pi;
+    }
+    m_NumBands = std::max(1, std::min(k_MaxBands, static_cast<int32_t>(std::ceil(k_Pi / cellAngle))));
+    m_BandHeight = k_Pi / m_NumBands;
+    m_BandOffsets.resize(m_NumBands + 1, 0);
+    m_BandCells.resize(m_NumBands, 1);
+    for(int32_t b = 0; b < m_NumBands; b++)
+    {
+      const double width = 2.0 * k_Pi * std::sin((b + 0.5) * m_BandHeight);
+      m_BandCells[b] = std::max(1, std::min(2 * k_MaxBands, static_cast<int32_t>(std::ceil(width / m_BandHeight))));
+      m_BandOffsets[b + 1] = m_BandOffsets[b] + m_BandCells[b];
+    }
+
+    std::vector<int64_t> itemCells(numItems, -1);
+    m_CellOffsets.assign(static_cast<size_t>(m_BandOffsets[m_NumBands]) + 1, 0);
+    for(size_t i = 0; i < numItems; i++)
+    {
+      const double x = directions[3 * i];
+      const double y = directions[3 * i + 1];
+      const double z = directions[3 * i + 2];
+      const double length = std::sqrt(x * x + y * y + z * z);
+      if(!(std::fabs(length - 1.0) <= k_UnitTolerance))
+      {
+        m_UnboundedItems.push_back(i);
+        continue;
+      }
+      itemCells[i] = cellIndex(std::acos(std::max(-1.0, std::min(1.0, z / length))), azimuth(x, y));
+      m_CellOffsets[itemCells[i] + 1]++;
+    }
+    for(size_t c = 1; c < m_CellOffsets.size(); c++)
+    {
+      m_CellOffsets[c] += m_CellOffsets[c - 1];
+    }
+    m_Items.resize(m_CellOffsets.back());
+    std::vector<size_t> cursor(m_CellOffsets.begin(), m_CellOffsets.end() - 1);
+    for(size_t i = 0; i < numItems; i++)
+    {
+      if(itemCells[i] >= 0)
+      {
+        m_Items[cursor[itemCells[i]]++] = i;
+      }
+    }
+  }
+
+  /**
+   * @brief forEachInCap Calls callback(item) once for every item whose direction may be within angle
+   * (radians) of center. Items outside the cap may be reported; the caller applies the exact test.
+   */
+  template <typename Callback>
+  void forEachInCap(const float center[3], double angle, Callback&& callback) const
+  {
+    const double x = center[0];
+    const double y = center[1];
+    const double z = center[2];
+    const double length = std::sqrt(x * x + y * y + z * z);
+    const double cap = angle + k_AngleMargin;
+    if(!(length > 0.0) || !(cap < k_Pi))
+    {
+      forEachItem(callback);
+      return;
+    }
+    const double polar = std::acos(std::max(-1.0, std::min(1.0, z / length)));
+    const double lowPolar = polar - cap;
+    const double highPolar = polar + cap;
+    const int32_t firstBand = std::max(0, static_cast<int32_t>(std::floor(lowPolar / m_BandHeight)));
+    const int32_t lastBand = std::min(m_NumBands - 1, static_cast<int32_t>(std::floor(highPolar / m_BandHeight)));
+
+    // A cap that does not contain a pole spans asin(sin(cap) / sin(polar)) either side of its azimuth
+    bool fullAzimuth = lowPolar <= 0.0 || highPolar >= k_Pi;
+    double halfWidth = k_Pi;
+    if(!fullAzimuth)
+    {
+      const double ratio = std::sin(cap) / std::sin(polar);
+      fullAzimuth = ratio >= 1.0;
+      if(!fullAzimuth)
+      {
+        halfWidth = std::asin(ratio);
+      }
+    }
+    const double centerAzimuth = azimuth(x, y);
+
+    for(int32_t b = firstBand; b <= lastBand; b++)
+    {
+      const int32_t numCells = m_BandCells[b];
+      int64_t firstCell = 0;
+      int64_t lastCell = numCells - 1;
+      if(!fullAzimuth)
+      {
+        firstCell = static_cast<int64_t>(std::floor((centerAzimuth - halfWidth) / (2.0 * k_Pi) * numCells));
+        lastCell = static_cast<int64_t>(std::floor((centerAzimuth + halfWidth) / (2.0 * k_Pi) * numCells));
+        if(lastCell - firstCell + 1 >= numCells)
+        {
+          firstCell = 0;
+          lastCell = numCells - 1;
+        }
+      }
+      for(int64_t c = firstCell; c <= lastCell; c++)
+      {
+        const int64_t cell = m_BandOffsets[b] + ((c % numCells) + numCells) % numCells;
+        for(size_t p = m_CellOffsets[cell]; p < m_CellOffsets[cell + 1]; p++)
+        {
+          callback(m_Items[p]);
+        }
+      }
+    }
+    for(const auto& item : m_UnboundedItems)
+    {
+      callback(item);
+    }
+  }
+
+private:
+  static constexpr double k_Pi = 3.14159265358979323846;
+
+  int32_t m_NumBands = 1;
+  double m_BandHeight = k_Pi;
+  std::vector<int64_t> m_BandOffsets;
+  std::vector<int32_t> m_BandCells;
+  std::vector<size_t> m_CellOffsets;
+  std::vector<size_t> m_Items;
+  std::vector<size_t> m_UnboundedItems;
+
+  static double azimuth(double x, double y)
+  {
+    double phi = std::atan2(y, x);
+    if(phi < 0.0)
+    {
+      phi += 2.0 * k_Pi;
+    }
+    return phi;
+  }
+
+  int64_t cellIndex(double polar, double phi) const
+  {
+    const int32_t band = std::max(0, std::min(m_NumBands - 1, static_cast<int32_t>(std::floor(polar / m_BandHeight))));
+    const int32_t numCells = m_BandCells[band];
+    const int32_t cell = std::max(0, std::min(numCells - 1, static_cast<int32_t>(std::floor(phi / (2.0 * k_Pi) * numCells))));
+    return m_BandOffsets[band] + cell;
+  }
+
+  template <typename Callback>
+  void forEachItem(Callback& callback) const
+  {
+    for(const auto& item : m_Items)
+    {
+      callback(item);
+    }
+    for(const auto& item : m_UnboundedItems)
+    {
+      callback(item);
+    }
+  }
+};
+
+} // namespace OrientationAnalysis
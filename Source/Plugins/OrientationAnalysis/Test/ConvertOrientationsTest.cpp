@@ -0,0 +1,148 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+
+#include "EbsdLib/OrientationMath/OrientationConverter.hpp"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/ConvertOrientations.h"
+#include "OrientationAnalysisTestFileLocations.h"
+
+/**
+ * @brief The ConvertOrientationsTest class converts more Euler angle triplets than fit in a single chunk of
+ * ConvertOrientations, including a partial last chunk, and requires every output tuple to match the conversion
+ * of that tuple on its own.
+ */
+class ConvertOrientationsTest
+{
+  const QString k_DataContainerName = QString("DataContainer");
+  const QString k_CellAttrMatName = QString("CellData");
+  const QString k_InputArrayName = QString("EulerAngles");
+  const QString k_OutputArrayName = QString("Converted");
+  // Two full chunks of 65536 tuples and a partial third one
+  static constexpr size_t k_NumTuples = 2 * 65536 + 17;
+  static constexpr uint64_t k_Seed = 5489;
+
+public:
+  ConvertOrientationsTest() = default;
+  virtual ~ConvertOrientationsTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  int TestChunkedConversion(int32_t outputType)
+  {
+    using ArrayType = DataArray<T>;
+    using OCType = OrientationConverter<ArrayType, T>;
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    AttributeMatrix::Pointer am = AttributeMatrix::New({k_NumTuples}, k_CellAttrMatName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(am);
+    typename ArrayType::Pointer eulers = ArrayType::CreateArray(k_NumTuples, std::vector<size_t>(1, 3), k_InputArrayName, true);
+    am->insertOrAssign(eulers);
+
+    std::mt19937_64 generator(k_Seed);
+    std::uniform_real_distribution<T> phi1Dist(0, static_cast<T>(SIMPLib::Constants::k_2PiD));
+    std::uniform_real_distribution<T> phiDist(0, static_cast<T>(SIMPLib::Constants::k_PiD));
+    for(size_t i = 0; i < k_NumTuples; i++)
+    {
+      eulers->setComponent(i, 0, phi1Dist(generator));
+      eulers->setComponent(i, 1, phiDist(generator));
+      eulers->setComponent(i, 2, phi1Dist(generator));
+    }
+
+    ConvertOrientations::Pointer filter = ConvertOrientations::New();
+    filter->setDataContainerArray(dca);
+    filter->setInputType(0);
+    filter->setOutputType(outputType);
+    filter->setInputOrientationArrayPath(DataArrayPath(k_DataContainerName, k_CellAttrMatName, k_InputArrayName));
+    filter->setOutputOrientationArrayName(k_OutputArrayName);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    typename ArrayType::Pointer output = am->getAttributeArrayAs<ArrayType>(k_OutputArrayName);
+    DREAM3D_REQUIRE_VALID_POINTER(output.get())
+    DREAM3D_REQUIRE_EQUAL(output->getNumberOfTuples(), k_NumTuples)
+    const size_t numComps = output->getNumberOfComponents();
+
+    const OrientationRepresentation::Type representation = OCType::GetOrientationTypes()[outputType];
+    typename OCType::Pointer converter = EulerConverter<ArrayType, T>::New();
+    for(size_t i = 0; i < k_NumTuples; i++)
+    {
+      typename ArrayType::Pointer tuple = ArrayType::WrapPointer(eulers->getTuplePointer(i), 1, std::vector<size_t>(1, 3), k_InputArrayName, false);
+      converter->setInputData(tuple);
+      converter->convertRepresentationTo(representation);
+      typename ArrayType::Pointer reference = converter->getOutputData();
+      DREAM3D_REQUIRE_VALID_POINTER(reference.get())
+      DREAM3D_REQUIRE_EQUAL(reference->getNumberOfComponents(), numComps)
+      for(size_t c = 0; c < numComps; c++)
+      {
+        DREAM3D_REQUIRE(output->getComponent(i, c) == reference->getComponent(0, c))
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    // Quaternions from float and Rodrigues vectors from double Euler angles
+    DREAM3D_REGISTER_TEST(TestChunkedConversion<float>(2))
+    DREAM3D_REGISTER_TEST(TestChunkedConversion<double>(4))
+  }
+
+public:
+  ConvertOrientationsTest(const ConvertOrientationsTest&) = delete;            // Copy Constructor Not Implemented
+  ConvertOrientationsTest(ConvertOrientationsTest&&) = delete;                 // Move Constructor Not Implemented
+  ConvertOrientationsTest& operator=(const ConvertOrientationsTest&) = delete; // Copy Assignment Not Implemented
+  ConvertOrientationsTest& operator=(ConvertOrientationsTest&&) = delete;      // Move Assignment Not Implemented
+};
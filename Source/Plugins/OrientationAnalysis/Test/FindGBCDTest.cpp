@@ -0,0 +1,522 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <QtCore/QDebug>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#endif
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+/**
+ * @brief The FindGBCDTest class checks the GBCD of a small random mesh against the two pass scheme the filter used
+ * before the faces were accumulated into per thread histograms: every face first records the bin and hemisphere of
+ * each of its symmetric misorientations, then a serial pass adds the face areas into those bins.
+ */
+class FindGBCDTest
+{
+  const QString k_ImageDataContainerName = QString("ImageDataContainer");
+  const QString k_TriangleDataContainerName = QString("TriangleDataContainer");
+  const QString k_FeatureAttrMatName = QString("FeatureData");
+  const QString k_EnsembleAttrMatName = QString("EnsembleData");
+  const QString k_FaceAttrMatName = QString("FaceData");
+  const QString k_FaceEnsembleAttrMatName = QString("FaceEnsembleData");
+  const QString k_GBCDName = QString("GBCD");
+  static constexpr size_t k_NumFaces = 400;
+  static constexpr int32_t k_NumFeatures = 8;
+  static constexpr uint64_t k_Seed = 5489;
+  const float k_GBCDRes = 9.0f;
+
+public:
+  FindGBCDTest() = default;
+  virtual ~FindGBCDTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QString filtName = "FindGBCD";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindGBCDTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Feature 0 is unindexed, Features 1-4 are cubic and Features 5-7 hexagonal. The faces pair random Features, so
+  // the mesh also holds faces to the outside (-1), faces touching Feature 0 and faces between the two phases.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+
+    DataContainer::Pointer imageDc = DataContainer::New(k_ImageDataContainerName);
+    dca->addOrReplaceDataContainer(imageDc);
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(4, 4, 4));
+    imageDc->setGeometry(imageGeom);
+
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New({3}, k_EnsembleAttrMatName, AttributeMatrix::Type::CellEnsemble);
+    imageDc->addOrReplaceAttributeMatrix(ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, SIMPL::EnsembleData::CrystalStructures, true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, EbsdLib::CrystalStructure::Cubic_High);
+    crystalStructures->setValue(2, EbsdLib::CrystalStructure::Hexagonal_High);
+    ensembleAM->insertOrAssign(crystalStructures);
+
+    std::mt19937_64 generator(k_Seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New({static_cast<size_t>(k_NumFeatures)}, k_FeatureAttrMatName, AttributeMatrix::Type::CellFeature);
+    imageDc->addOrReplaceAttributeMatrix(featureAM);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(k_NumFeatures, SIMPL::FeatureData::Phases, true);
+    FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(k_NumFeatures, std::vector<size_t>(1, 3), SIMPL::FeatureData::AvgEulerAngles, true);
+    for(int32_t feature = 0; feature < k_NumFeatures; feature++)
+    {
+      phases->setValue(feature, (feature == 0) ? 0 : (feature < 5 ? 1 : 2));
+      eulers->setComponent(feature, 0, unit(generator) * SIMPLib::Constants::k_2PiF);
+      eulers->setComponent(feature, 1, std::acos(2.0f * unit(generator) - 1.0f));
+      eulers->setComponent(feature, 2, unit(generator) * SIMPLib::Constants::k_2PiF);
+    }
+    featureAM->insertOrAssign(phases);
+    featureAM->insertOrAssign(eulers);
+
+    DataContainer::Pointer triangleDc = DataContainer::New(k_TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(triangleDc);
+    SharedVertexList::Pointer vertexList = TriangleGeom::CreateSharedVertexList(3);
+    TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(k_NumFaces, vertexList, SIMPL::Geometry::TriangleGeometry);
+    triangleDc->setGeometry(triangleGeom);
+
+    AttributeMatrix::Pointer faceAM = AttributeMatrix::New({k_NumFaces}, k_FaceAttrMatName, AttributeMatrix::Type::Face);
+    triangleDc->addOrReplaceAttributeMatrix(faceAM);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(k_NumFaces, std::vector<size_t>(1, 2), SIMPL::FaceData::SurfaceMeshFaceLabels, true);
+    DoubleArrayType::Pointer faceNormals = DoubleArrayType::CreateArray(k_NumFaces, std::vector<size_t>(1, 3), SIMPL::FaceData::SurfaceMeshFaceNormals, true);
+    DoubleArrayType::Pointer faceAreas = DoubleArrayType::CreateArray(k_NumFaces, SIMPL::FaceData::SurfaceMeshFaceAreas, true);
+    std::uniform_int_distribution<int32_t> featureDist(-1, k_NumFeatures - 1);
+    for(size_t face = 0; face < k_NumFaces; face++)
+    {
+      int32_t feature1 = featureDist(generator);
+      int32_t feature2 = featureDist(generator);
+      while(feature2 == feature1)
+      {
+        feature2 = featureDist(generator);
+      }
+      faceLabels->setComponent(face, 0, feature1);
+      faceLabels->setComponent(face, 1, feature2);
+
+      double normal[3] = {2.0 * unit(generator) - 1.0, 2.0 * unit(generator) - 1.0, 2.0 * unit(generator) - 1.0};
+      double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+      for(size_t c = 0; c < 3; c++)
+      {
+        faceNormals->setComponent(face, c, normal[c] / length);
+      }
+      faceAreas->setValue(face, 0.1 + 2.0 * unit(generator));
+    }
+    faceAM->insertOrAssign(faceLabels);
+    faceAM->insertOrAssign(faceNormals);
+    faceAM->insertOrAssign(faceAreas);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void SizeGBCD(float gbcdDeltas[5], int32_t gbcdSizes[5], float gbcdLimits[10])
+  {
+    gbcdLimits[0] = 0.0f;
+    gbcdLimits[1] = 0.0f;
+    gbcdLimits[2] = 0.0f;
+    gbcdLimits[3] = 0.0f;
+    gbcdLimits[4] = 0.0f;
+    gbcdLimits[5] = SIMPLib::Constants::k_PiOver2D;
+    gbcdLimits[6] = 1.0f;
+    gbcdLimits[7] = SIMPLib::Constants::k_PiOver2D;
+    gbcdLimits[8] = 1.0f;
+    gbcdLimits[9] = SIMPLib::Constants::k_2PiD;
+
+    float binsize = k_GBCDRes * SIMPLib::Constants::k_PiOver180D;
+    float binsize2 = binsize * (2.0 / SIMPLib::Constants::k_PiD);
+    gbcdDeltas[0] = binsize;
+    gbcdDeltas[1] = binsize2;
+    gbcdDeltas[2] = binsize;
+    gbcdDeltas[3] = binsize2;
+    gbcdDeltas[4] = binsize;
+
+    for(size_t i = 0; i < 5; i++)
+    {
+      gbcdSizes[i] = int32_t(0.5 + (gbcdLimits[i + 5] - gbcdLimits[i]) / gbcdDeltas[i]);
+    }
+
+    float totalNormalBins = gbcdSizes[3] * gbcdSizes[4];
+    gbcdSizes[3] = int32_t(sqrtf(totalNormalBins) + 0.5f);
+    gbcdSizes[4] = int32_t(sqrtf(totalNormalBins) + 0.5f);
+    gbcdLimits[3] = -sqrtf(SIMPLib::Constants::k_PiOver2D);
+    gbcdLimits[4] = -sqrtf(SIMPLib::Constants::k_PiOver2D);
+    gbcdLimits[8] = sqrtf(SIMPLib::Constants::k_PiOver2D);
+    gbcdLimits[9] = sqrtf(SIMPLib::Constants::k_PiOver2D);
+    gbcdDeltas[3] = (gbcdLimits[8] - gbcdLimits[3]) / float(gbcdSizes[3]);
+    gbcdDeltas[4] = (gbcdLimits[9] - gbcdLimits[4]) / float(gbcdSizes[4]);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int32_t GBCDIndex(const float* gbcddelta, const int32_t* gbcdsz, const float* gbcdlimits, const float* eulerN, const float* sqCoord)
+  {
+    float misEulerNorm[5] = {eulerN[0], eulerN[1], eulerN[2], sqCoord[0], sqCoord[1]};
+    for(size_t i = 0; i < 5; i++)
+    {
+      if(misEulerNorm[i] < gbcdlimits[i] || misEulerNorm[i] > gbcdlimits[i + 5])
+      {
+        return -1;
+      }
+    }
+
+    int32_t index[5] = {0, 0, 0, 0, 0};
+    for(size_t i = 0; i < 5; i++)
+    {
+      index[i] = (int32_t)((misEulerNorm[i] - gbcdlimits[i]) / gbcddelta[i]);
+      index[i] = std::max(0, std::min(index[i], gbcdsz[i] - 1));
+    }
+    int32_t n1 = gbcdsz[0];
+    int32_t n1n2 = n1 * gbcdsz[1];
+    int32_t n1n2n3 = n1n2 * gbcdsz[2];
+    int32_t n1n2n3n4 = n1n2n3 * gbcdsz[3];
+    return index[0] + n1 * index[1] + n1n2 * index[2] + n1n2n3 * index[3] + n1n2n3n4 * index[4];
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  bool GetSquareCoord(const float* xstl1_norm1, float* sqCoord)
+  {
+    bool nhCheck = false;
+    float adjust = 1.0;
+    if(xstl1_norm1[2] >= 0.0)
+    {
+      adjust = -1.0;
+      nhCheck = true;
+    }
+    if(fabsf(xstl1_norm1[0]) >= fabsf(xstl1_norm1[1]))
+    {
+      sqCoord[0] = (xstl1_norm1[0] / fabsf(xstl1_norm1[0])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * (SIMPLib::Constants::k_SqrtPiD / 2.0f);
+      sqCoord[1] =
+          (xstl1_norm1[0] / fabsf(xstl1_norm1[0])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * ((2.0f / SIMPLib::Constants::k_SqrtPiD) * atanf(xstl1_norm1[1] / xstl1_norm1[0]));
+    }
+    else
+    {
+      sqCoord[0] = (xstl1_norm1[1] / fabsf(xstl1_norm1[1])) * sqrtf(2.0 * 1.0 * (1.0 + (xstl1_norm1[2] * adjust))) * ((2.0f / SIMPLib::Constants::k_SqrtPiD) * atanf(xstl1_norm1[0] / xstl1_norm1[1]));
+      sqCoord[1] = (xstl1_norm1[1] / fabsf(xstl1_norm1[1])) * sqrtf(2.0 * 1.0 * (1.0 + (xstl1_norm1[2] * adjust))) * (SIMPLib::Constants::k_SqrtPiD / 2.0f);
+    }
+    return nhCheck;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<double> ComputeReference(const DataContainerArray::Pointer& dca)
+  {
+    AttributeMatrix::Pointer faceAM = dca->getAttributeMatrix(DataArrayPath(k_TriangleDataContainerName, k_FaceAttrMatName, ""));
+    Int32ArrayType::Pointer labels = faceAM->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+    DoubleArrayType::Pointer normals = faceAM->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshFaceNormals);
+    DoubleArrayType::Pointer areas = faceAM->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshFaceAreas);
+    AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix(DataArrayPath(k_ImageDataContainerName, k_FeatureAttrMatName, ""));
+    Int32ArrayType::Pointer phases = featureAM->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::Phases);
+    FloatArrayType::Pointer eulers = featureAM->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AvgEulerAngles);
+    UInt32ArrayType::Pointer crystalStructures =
+        dca->getAttributeMatrix(DataArrayPath(k_ImageDataContainerName, k_EnsembleAttrMatName, ""))->getAttributeArrayAs<UInt32ArrayType>(SIMPL::EnsembleData::CrystalStructures);
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+
+    float gbcdDeltas[5];
+    int32_t gbcdSizes[5];
+    float gbcdLimits[10];
+    SizeGBCD(gbcdDeltas, gbcdSizes, gbcdLimits);
+    const size_t totalPhases = crystalStructures->getNumberOfTuples();
+    const size_t totalGBCDBins = static_cast<size_t>(gbcdSizes[0] * gbcdSizes[1] * gbcdSizes[2] * gbcdSizes[3] * gbcdSizes[4] * 2);
+    const size_t numMisoReps = 576 * 4;
+
+    // First pass: the bin and hemisphere of every symmetric misorientation of every face
+    std::vector<int32_t> bins(k_NumFaces * numMisoReps, -1);
+    std::vector<bool> hemiCheck(k_NumFaces * numMisoReps, false);
+    for(size_t i = 0; i < k_NumFaces; i++)
+    {
+      int32_t feature1 = labels->getComponent(i, 0);
+      int32_t feature2 = labels->getComponent(i, 1);
+      if(feature1 < 0 || feature2 < 0 || phases->getValue(feature1) != phases->getValue(feature2) || phases->getValue(feature1) <= 0)
+      {
+        continue;
+      }
+      float normal[3] = {static_cast<float>(normals->getComponent(i, 0)), static_cast<float>(normals->getComponent(i, 1)), static_cast<float>(normals->getComponent(i, 2))};
+      LaueOps::Pointer ops = orientationOps[crystalStructures->getValue(phases->getValue(feature1))];
+      size_t symCounter = 0;
+      for(int32_t q = 0; q < 2; q++)
+      {
+        if(q == 1)
+        {
+          std::swap(feature1, feature2);
+          normal[0] = -normal[0];
+          normal[1] = -normal[1];
+          normal[2] = -normal[2];
+        }
+        float g1ea[3] = {eulers->getComponent(feature1, 0), eulers->getComponent(feature1, 1), eulers->getComponent(feature1, 2)};
+        float g2ea[3] = {eulers->getComponent(feature2, 0), eulers->getComponent(feature2, 1), eulers->getComponent(feature2, 2)};
+        float g1[3][3], g2[3][3], g1s[3][3], g2s[3][3], g2t[3][3], dg[3][3], sym1[3][3], sym2[3][3];
+        OrientationTransformation::eu2om<OrientationF, OrientationF>(OrientationF(g1ea, 3)).toGMatrix(g1);
+        OrientationTransformation::eu2om<OrientationF, OrientationF>(OrientationF(g2ea, 3)).toGMatrix(g2);
+
+        int32_t nsym = ops->getNumSymOps();
+        for(int32_t j = 0; j < nsym; j++)
+        {
+          ops->getMatSymOp(j, sym1);
+          MatrixMath::Multiply3x3with3x3(sym1, g1, g1s);
+          float xstl1_norm1[3];
+          MatrixMath::Multiply3x3with3x1(g1s, normal, xstl1_norm1);
+          float sqCoord[2];
+          bool nhCheck = GetSquareCoord(xstl1_norm1, sqCoord);
+          float sqCoordInv[2] = {-sqCoord[0], -sqCoord[1]};
+          bool nhCheckInv = !nhCheck;
+
+          for(int32_t k = 0; k < nsym; k++)
+          {
+            ops->getMatSymOp(k, sym2);
+            MatrixMath::Multiply3x3with3x3(sym2, g2, g2s);
+            MatrixMath::Transpose3x3(g2s, g2t);
+            MatrixMath::Multiply3x3with3x3(g1s, g2t, dg);
+            OrientationF om(dg);
+            float euler_mis[3] = {0.0f, 0.0f, 0.0f};
+            OrientationF eu(euler_mis, 3);
+            eu = OrientationTransformation::om2eu<OrientationF, OrientationF>(om);
+
+            if(euler_mis[0] < SIMPLib::Constants::k_PiOver2D && euler_mis[1] < SIMPLib::Constants::k_PiOver2D && euler_mis[2] < SIMPLib::Constants::k_PiOver2D)
+            {
+              euler_mis[1] = cosf(euler_mis[1]);
+              int32_t gbcdIndex = GBCDIndex(gbcdDeltas, gbcdSizes, gbcdLimits, euler_mis, sqCoord);
+              if(gbcdIndex != -1)
+              {
+                hemiCheck[i * numMisoReps + symCounter] = nhCheck;
+                bins[i * numMisoReps + symCounter] = gbcdIndex;
+              }
+              symCounter++;
+              gbcdIndex = GBCDIndex(gbcdDeltas, gbcdSizes, gbcdLimits, euler_mis, sqCoordInv);
+              if(gbcdIndex != -1)
+              {
+                hemiCheck[i * numMisoReps + symCounter] = nhCheckInv;
+                bins[i * numMisoReps + symCounter] = gbcdIndex;
+              }
+              symCounter++;
+            }
+            else
+            {
+              symCounter += 2;
+            }
+          }
+        }
+      }
+    }
+
+    // Second pass: add the face areas into the recorded bins, then normalize to multiples of random
+    std::vector<double> gbcd(totalPhases * totalGBCDBins, 0.0);
+    std::vector<double> totalFaceArea(totalPhases, 0.0);
+    for(size_t i = 0; i < k_NumFaces; i++)
+    {
+      int32_t feature = labels->getComponent(i, 0);
+      if(feature < 0)
+      {
+        continue;
+      }
+      size_t phase = static_cast<size_t>(phases->getValue(feature));
+      for(size_t k = 0; k < numMisoReps; k++)
+      {
+        int32_t bin = bins[i * numMisoReps + k];
+        if(bin >= 0)
+        {
+          size_t hemisphere = hemiCheck[i * numMisoReps + k] ? 0 : 1;
+          gbcd[phase * totalGBCDBins + 2 * static_cast<size_t>(bin) + hemisphere] += areas->getValue(i);
+          totalFaceArea[phase] += areas->getValue(i);
+        }
+      }
+    }
+    for(size_t phase = 0; phase < totalPhases; phase++)
+    {
+      double mrdFactor = double(totalGBCDBins) / totalFaceArea[phase];
+      for(size_t j = 0; j < totalGBCDBins; j++)
+      {
+        gbcd[phase * totalGBCDBins + j] *= mrdFactor;
+      }
+    }
+    return gbcd;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void setProperty(const AbstractFilter::Pointer& filter, const char* name, const QVariant& value)
+  {
+    bool propWasSet = filter->setProperty(name, value);
+    if(!propWasSet)
+    {
+      qDebug() << "Unable to set property " << name;
+    }
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QVariant pathVariant(const QString& dcName, const QString& amName, const QString& arrayName)
+  {
+    QVariant var;
+    var.setValue(DataArrayPath(dcName, amName, arrayName));
+    return var;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunAndCompare(int threadCount)
+  {
+    DataContainerArray::Pointer dca = CreateTestData();
+    std::vector<double> reference = ComputeReference(dca);
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("FindGBCD");
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+    setProperty(filter, "GBCDRes", k_GBCDRes);
+    setProperty(filter, "SurfaceMeshFaceLabelsArrayPath", pathVariant(k_TriangleDataContainerName, k_FaceAttrMatName, SIMPL::FaceData::SurfaceMeshFaceLabels));
+    setProperty(filter, "SurfaceMeshFaceNormalsArrayPath", pathVariant(k_TriangleDataContainerName, k_FaceAttrMatName, SIMPL::FaceData::SurfaceMeshFaceNormals));
+    setProperty(filter, "SurfaceMeshFaceAreasArrayPath", pathVariant(k_TriangleDataContainerName, k_FaceAttrMatName, SIMPL::FaceData::SurfaceMeshFaceAreas));
+    setProperty(filter, "FeatureEulerAnglesArrayPath", pathVariant(k_ImageDataContainerName, k_FeatureAttrMatName, SIMPL::FeatureData::AvgEulerAngles));
+    setProperty(filter, "FeaturePhasesArrayPath", pathVariant(k_ImageDataContainerName, k_FeatureAttrMatName, SIMPL::FeatureData::Phases));
+    setProperty(filter, "CrystalStructuresArrayPath", pathVariant(k_ImageDataContainerName, k_EnsembleAttrMatName, SIMPL::EnsembleData::CrystalStructures));
+    setProperty(filter, "FaceEnsembleAttributeMatrixName", k_FaceEnsembleAttrMatName);
+    setProperty(filter, "GBCDArrayName", k_GBCDName);
+
+    auto findGBCD = [&]() { filter->execute(); };
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_arena arena(threadCount);
+    arena.execute(findGBCD);
+#else
+    findGBCD();
+#endif
+    int err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    DoubleArrayType::Pointer gbcd =
+        dca->getAttributeMatrix(DataArrayPath(k_TriangleDataContainerName, k_FaceEnsembleAttrMatName, ""))->getAttributeArrayAs<DoubleArrayType>(k_GBCDName);
+    DREAM3D_REQUIRE_VALID_POINTER(gbcd.get())
+    DREAM3D_REQUIRE_EQUAL(gbcd->getSize(), reference.size())
+
+    // Only the order of the area sums differs from the reference, so the bins agree to rounding
+    size_t filledBins = 0;
+    for(size_t i = 0; i < reference.size(); i++)
+    {
+      DREAM3D_REQUIRE(std::fabs(gbcd->getValue(i) - reference[i]) <= 1.0E-9 * std::max(1.0, std::fabs(reference[i])))
+      filledBins += (reference[i] > 0.0) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE(filledBins > 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSingleThread()
+  {
+    return RunAndCompare(1);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMultipleThreads()
+  {
+    return RunAndCompare(4);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestSingleThread())
+    DREAM3D_REGISTER_TEST(TestMultipleThreads())
+  }
+
+public:
+  FindGBCDTest(const FindGBCDTest&) = delete;            // Copy Constructor Not Implemented
+  FindGBCDTest(FindGBCDTest&&) = delete;                 // Move Constructor Not Implemented
+  FindGBCDTest& operator=(const FindGBCDTest&) = delete; // Copy Assignment Not Implemented
+  FindGBCDTest& operator=(FindGBCDTest&&) = delete;      // Move Assignment Not Implemented
+};
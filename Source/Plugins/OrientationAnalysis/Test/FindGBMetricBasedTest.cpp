@@ -0,0 +1,345 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/AxisAngleInput.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/FindGBCDMetricBased.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/FindGBPDMetricBased.h"
+#include "OrientationAnalysisTestFileLocations.h"
+
+/**
+ * @brief The FindGBMetricBasedTest class runs the metric based GBCD and GBPD on a small random mesh with and without
+ * the spherical index over the triangle normals and requires identical output files.
+ *
+ * All Features are cubic. The odd Features are close to the identity and the even ones close to a 40 degree rotation
+ * about [001], so the faces between an odd and an even Feature carry roughly the misorientation the GBCD is asked for
+ * and the GBCD has triangles to select. The face normals are spread over the whole sphere.
+ */
+class FindGBMetricBasedTest
+{
+  const QString k_ImageDataContainerName = QString("ImageDataContainer");
+  const QString k_TriangleDataContainerName = QString("TriangleDataContainer");
+  const QString k_FeatureAttrMatName = QString("FeatureData");
+  const QString k_EnsembleAttrMatName = QString("EnsembleData");
+  const QString k_VertexAttrMatName = QString("VertexData");
+  const QString k_FaceAttrMatName = QString("FaceData");
+  const QString k_FaceFeatureAttrMatName = QString("FaceFeatureData");
+  const QString k_FaceFeatureLabelsName = QString("FaceLabels");
+  static constexpr size_t k_NumFaces = 600;
+  static constexpr int32_t k_NumFeatures = 13;
+  static constexpr uint64_t k_Seed = 5489;
+  const float k_MisorientationAngle = 40.0f;
+
+public:
+  FindGBMetricBasedTest() = default;
+  virtual ~FindGBMetricBasedTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::FindGBMetricBasedTest::IndexedDistFile);
+    QFile::remove(UnitTest::FindGBMetricBasedTest::IndexedErrFile);
+    QFile::remove(UnitTest::FindGBMetricBasedTest::ExhaustiveDistFile);
+    QFile::remove(UnitTest::FindGBMetricBasedTest::ExhaustiveErrFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+
+    DataContainer::Pointer imageDc = DataContainer::New(k_ImageDataContainerName);
+    dca->addOrReplaceDataContainer(imageDc);
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(4, 4, 4));
+    imageDc->setGeometry(imageGeom);
+
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New({2}, k_EnsembleAttrMatName, AttributeMatrix::Type::CellEnsemble);
+    imageDc->addOrReplaceAttributeMatrix(ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, SIMPL::EnsembleData::CrystalStructures, true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, EbsdLib::CrystalStructure::Cubic_High);
+    ensembleAM->insertOrAssign(crystalStructures);
+
+    std::mt19937_64 generator(k_Seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> scatter(-2.0f * SIMPLib::Constants::k_PiOver180F, 2.0f * SIMPLib::Constants::k_PiOver180F);
+
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New({static_cast<size_t>(k_NumFeatures)}, k_FeatureAttrMatName, AttributeMatrix::Type::CellFeature);
+    imageDc->addOrReplaceAttributeMatrix(featureAM);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(k_NumFeatures, SIMPL::FeatureData::Phases, true);
+    FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(k_NumFeatures, std::vector<size_t>(1, 3), SIMPL::FeatureData::AvgEulerAngles, true);
+    for(int32_t feature = 0; feature < k_NumFeatures; feature++)
+    {
+      const float phi1 = (feature % 2 == 0 && feature > 0) ? k_MisorientationAngle * SIMPLib::Constants::k_PiOver180F : 0.0f;
+      phases->setValue(feature, (feature == 0) ? 0 : 1);
+      eulers->setComponent(feature, 0, phi1 + scatter(generator) + 2.0f * SIMPLib::Constants::k_PiOver180F);
+      eulers->setComponent(feature, 1, scatter(generator) + 2.0f * SIMPLib::Constants::k_PiOver180F);
+      eulers->setComponent(feature, 2, scatter(generator) + 2.0f * SIMPLib::Constants::k_PiOver180F);
+    }
+    featureAM->insertOrAssign(phases);
+    featureAM->insertOrAssign(eulers);
+
+    DataContainer::Pointer triangleDc = DataContainer::New(k_TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(triangleDc);
+    SharedVertexList::Pointer vertexList = TriangleGeom::CreateSharedVertexList(3);
+    TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(k_NumFaces, vertexList, SIMPL::Geometry::TriangleGeometry);
+    triangleDc->setGeometry(triangleGeom);
+
+    AttributeMatrix::Pointer vertexAM = AttributeMatrix::New({3}, k_VertexAttrMatName, AttributeMatrix::Type::Vertex);
+    triangleDc->addOrReplaceAttributeMatrix(vertexAM);
+    Int8ArrayType::Pointer nodeTypes = Int8ArrayType::CreateArray(3, SIMPL::VertexData::SurfaceMeshNodeType, true);
+    nodeTypes->initializeWithValue(2);
+    vertexAM->insertOrAssign(nodeTypes);
+
+    AttributeMatrix::Pointer faceAM = AttributeMatrix::New({k_NumFaces}, k_FaceAttrMatName, AttributeMatrix::Type::Face);
+    triangleDc->addOrReplaceAttributeMatrix(faceAM);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(k_NumFaces, std::vector<size_t>(1, 2), SIMPL::FaceData::SurfaceMeshFaceLabels, true);
+    DoubleArrayType::Pointer faceNormals = DoubleArrayType::CreateArray(k_NumFaces, std::vector<size_t>(1, 3), SIMPL::FaceData::SurfaceMeshFaceNormals, true);
+    DoubleArrayType::Pointer faceAreas = DoubleArrayType::CreateArray(k_NumFaces, SIMPL::FaceData::SurfaceMeshFaceAreas, true);
+    std::uniform_int_distribution<int32_t> featureDist(-1, k_NumFeatures - 1);
+    std::set<std::pair<int32_t, int32_t>> boundaries;
+    for(size_t face = 0; face < k_NumFaces; face++)
+    {
+      int32_t feature1 = featureDist(generator);
+      int32_t feature2 = featureDist(generator);
+      while(feature2 == feature1)
+      {
+        feature2 = featureDist(generator);
+      }
+      faceLabels->setComponent(face, 0, feature1);
+      faceLabels->setComponent(face, 1, feature2);
+      boundaries.insert(std::make_pair(std::min(feature1, feature2), std::max(feature1, feature2)));
+
+      double normal[3] = {2.0 * unit(generator) - 1.0, 2.0 * unit(generator) - 1.0, 2.0 * unit(generator) - 1.0};
+      double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+      for(size_t c = 0; c < 3; c++)
+      {
+        faceNormals->setComponent(face, c, normal[c] / length);
+      }
+      faceAreas->setValue(face, 0.1 + 2.0 * unit(generator));
+    }
+    faceAM->insertOrAssign(faceLabels);
+    faceAM->insertOrAssign(faceNormals);
+    faceAM->insertOrAssign(faceAreas);
+
+    AttributeMatrix::Pointer faceFeatureAM = AttributeMatrix::New({boundaries.size()}, k_FaceFeatureAttrMatName, AttributeMatrix::Type::FaceFeature);
+    triangleDc->addOrReplaceAttributeMatrix(faceFeatureAM);
+    Int32ArrayType::Pointer featureFaceLabels = Int32ArrayType::CreateArray(boundaries.size(), std::vector<size_t>(1, 2), k_FaceFeatureLabelsName, true);
+    size_t boundaryIdx = 0;
+    for(const auto& boundary : boundaries)
+    {
+      featureFaceLabels->setComponent(boundaryIdx, 0, boundary.first);
+      featureFaceLabels->setComponent(boundaryIdx, 1, boundary.second);
+      boundaryIdx++;
+    }
+    faceFeatureAM->insertOrAssign(featureFaceLabels);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::string ReadFile(const QString& filePath)
+  {
+    std::ifstream inFile(filePath.toStdString(), std::ios::in | std::ios::binary);
+    DREAM3D_REQUIRE(inFile.is_open())
+    return std::string(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+  }
+
+  // -----------------------------------------------------------------------------
+  // Compares the two runs and makes sure that at least one sampling point has a non zero distribution value, so the
+  // comparison is not between two empty distributions
+  // -----------------------------------------------------------------------------
+  void CompareOutputs()
+  {
+    const std::string indexedDist = ReadFile(UnitTest::FindGBMetricBasedTest::IndexedDistFile);
+    const std::string exhaustiveDist = ReadFile(UnitTest::FindGBMetricBasedTest::ExhaustiveDistFile);
+    DREAM3D_REQUIRE(indexedDist == exhaustiveDist)
+    DREAM3D_REQUIRE(ReadFile(UnitTest::FindGBMetricBasedTest::IndexedErrFile) == ReadFile(UnitTest::FindGBMetricBasedTest::ExhaustiveErrFile))
+
+    std::istringstream lines(indexedDist);
+    std::string line;
+    std::getline(lines, line);
+    size_t numNonZero = 0;
+    float azimuth = 0.0f;
+    float elevation = 0.0f;
+    float value = 0.0f;
+    while(lines >> azimuth >> elevation >> value)
+    {
+      if(value > 0.0f)
+      {
+        numNonZero++;
+      }
+    }
+    DREAM3D_REQUIRED(numNonZero, >, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RunGBCD(bool useSphericalIndex, const QString& distFile, const QString& errFile)
+  {
+    DataContainerArray::Pointer dca = CreateTestData();
+    FindGBCDMetricBased::Pointer filter = FindGBCDMetricBased::New();
+    filter->setDataContainerArray(dca);
+    filter->setPhaseOfInterest(1);
+    AxisAngleInput misorientation;
+    misorientation.angle = k_MisorientationAngle;
+    misorientation.h = 0.0f;
+    misorientation.k = 0.0f;
+    misorientation.l = 1.0f;
+    filter->setMisorientationRotation(misorientation);
+    // 8 degrees for both the misorientation and the plane resolution
+    filter->setChosenLimitDists(6);
+    filter->setNumSamplPts(500);
+    filter->setExcludeTripleLines(false);
+    filter->setDistOutputFile(distFile);
+    filter->setErrOutputFile(errFile);
+    filter->setSaveRelativeErr(false);
+    filter->setCrystalStructuresArrayPath(DataArrayPath(k_ImageDataContainerName, k_EnsembleAttrMatName, SIMPL::EnsembleData::CrystalStructures));
+    filter->setFeatureEulerAnglesArrayPath(DataArrayPath(k_ImageDataContainerName, k_FeatureAttrMatName, SIMPL::FeatureData::AvgEulerAngles));
+    filter->setFeaturePhasesArrayPath(DataArrayPath(k_ImageDataContainerName, k_FeatureAttrMatName, SIMPL::FeatureData::Phases));
+    filter->setSurfaceMeshFaceLabelsArrayPath(DataArrayPath(k_TriangleDataContainerName, k_FaceAttrMatName, SIMPL::FaceData::SurfaceMeshFaceLabels));
+    filter->setSurfaceMeshFaceNormalsArrayPath(DataArrayPath(k_TriangleDataContainerName, k_FaceAttrMatName, SIMPL::FaceData::SurfaceMeshFaceNormals));
+    filter->setSurfaceMeshFaceAreasArrayPath(DataArrayPath(k_TriangleDataContainerName, k_FaceAttrMatName, SIMPL::FaceData::SurfaceMeshFaceAreas));
+    filter->setSurfaceMeshFeatureFaceLabelsArrayPath(DataArrayPath(k_TriangleDataContainerName, k_FaceFeatureAttrMatName, k_FaceFeatureLabelsName));
+    filter->setNodeTypesArrayPath(DataArrayPath(k_TriangleDataContainerName, k_VertexAttrMatName, SIMPL::VertexData::SurfaceMeshNodeType));
+    filter->setUseSphericalIndex(useSphericalIndex);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RunGBPD(bool useSphericalIndex, const QString& distFile, const QString& errFile)
+  {
+    DataContainerArray::Pointer dca = CreateTestData();
+    FindGBPDMetricBased::Pointer filter = FindGBPDMetricBased::New();
+    filter->setDataContainerArray(dca);
+    filter->setPhaseOfInterest(1);
+    filter->setLimitDist(7.0f);
+    filter->setNumSamplPts(500);
+    filter->setExcludeTripleLines(false);
+    filter->setDistOutputFile(distFile);
+    filter->setErrOutputFile(errFile);
+    filter->setSaveRelativeErr(false);
+    filter->setCrystalStructuresArrayPath(DataArrayPath(k_ImageDataContainerName, k_EnsembleAttrMatName, SIMPL::EnsembleData::CrystalStructures));
+    filter->setFeatureEulerAnglesArrayPath(DataArrayPath(k_ImageDataContainerName, k_FeatureAttrMatName, SIMPL::FeatureData::AvgEulerAngles));
+    filter->setFeaturePhasesArrayPath(DataArrayPath(k_ImageDataContainerName, k_FeatureAttrMatName, SIMPL::FeatureData::Phases));
+    filter->setSurfaceMeshFaceLabelsArrayPath(DataArrayPath(k_TriangleDataContainerName, k_FaceAttrMatName, SIMPL::FaceData::SurfaceMeshFaceLabels));
+    filter->setSurfaceMeshFaceNormalsArrayPath(DataArrayPath(k_TriangleDataContainerName, k_FaceAttrMatName, SIMPL::FaceData::SurfaceMeshFaceNormals));
+    filter->setSurfaceMeshFaceAreasArrayPath(DataArrayPath(k_TriangleDataContainerName, k_FaceAttrMatName, SIMPL::FaceData::SurfaceMeshFaceAreas));
+    filter->setSurfaceMeshFeatureFaceLabelsArrayPath(DataArrayPath(k_TriangleDataContainerName, k_FaceFeatureAttrMatName, k_FaceFeatureLabelsName));
+    filter->setNodeTypesArrayPath(DataArrayPath(k_TriangleDataContainerName, k_VertexAttrMatName, SIMPL::VertexData::SurfaceMeshNodeType));
+    filter->setUseSphericalIndex(useSphericalIndex);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestGBCDMetricBased()
+  {
+    RunGBCD(true, UnitTest::FindGBMetricBasedTest::IndexedDistFile, UnitTest::FindGBMetricBasedTest::IndexedErrFile);
+    RunGBCD(false, UnitTest::FindGBMetricBasedTest::ExhaustiveDistFile, UnitTest::FindGBMetricBasedTest::ExhaustiveErrFile);
+    CompareOutputs();
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestGBPDMetricBased()
+  {
+    RunGBPD(true, UnitTest::FindGBMetricBasedTest::IndexedDistFile, UnitTest::FindGBMetricBasedTest::IndexedErrFile);
+    RunGBPD(false, UnitTest::FindGBMetricBasedTest::ExhaustiveDistFile, UnitTest::FindGBMetricBasedTest::ExhaustiveErrFile);
+    CompareOutputs();
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestGBCDMetricBased())
+    DREAM3D_REGISTER_TEST(TestGBPDMetricBased())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  FindGBMetricBasedTest(const FindGBMetricBasedTest&) = delete;            // Copy Constructor Not Implemented
+  FindGBMetricBasedTest(FindGBMetricBasedTest&&) = delete;                 // Move Constructor Not Implemented
+  FindGBMetricBasedTest& operator=(const FindGBMetricBasedTest&) = delete; // Copy Assignment Not Implemented
+  FindGBMetricBasedTest& operator=(FindGBMetricBasedTest&&) = delete;      // Move Assignment Not Implemented
+};
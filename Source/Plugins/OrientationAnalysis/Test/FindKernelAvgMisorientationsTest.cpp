@@ -0,0 +1,290 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class FindKernelAvgMisorientationsTest
+{
+  const size_t k_Dims[3] = {13, 11, 7};
+  const int32_t k_Kernel[3] = {2, 1, 1};
+
+public:
+  FindKernelAvgMisorientationsTest() = default;
+  virtual ~FindKernelAvgMisorientationsTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindKernelAvgMisorientations Filter from the FilterManager
+    QString filtName = "FindKernelAvgMisorientations";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindKernelAvgMisorientationsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("Test");
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer igeom = ImageGeom::New();
+    size_t dims_in[3] = {k_Dims[0], k_Dims[1], k_Dims[2]};
+    igeom->setDimensions(dims_in);
+    dc->setGeometry(igeom);
+    std::vector<size_t> dims = {k_Dims[0], k_Dims[1], k_Dims[2]};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, "CellData", AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New({2}, "EnsembleData", AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, std::string("CrystalStructures"), true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, EbsdLib::CrystalStructure::Cubic_High);
+    ensembleAM->insertOrAssign(crystalStructures);
+
+    // Blocky Features, a few unindexed Cells and orientations scattered by a couple of degrees inside each Feature
+    size_t totalPoints = k_Dims[0] * k_Dims[1] * k_Dims[2];
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, std::string("FeatureIds"), true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, std::string("Phases"), true);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, std::vector<size_t>(1, 4), std::string("Quats"), true);
+    for(size_t z = 0; z < k_Dims[2]; z++)
+    {
+      for(size_t y = 0; y < k_Dims[1]; y++)
+      {
+        for(size_t x = 0; x < k_Dims[0]; x++)
+        {
+          size_t index = (z * k_Dims[1] + y) * k_Dims[0] + x;
+          int32_t featureId = static_cast<int32_t>(1 + (x / 5) + 3 * (y / 4) + 9 * (z / 3));
+          int32_t phase = 1;
+          if((x * 7 + y * 3 + z) % 17 == 0)
+          {
+            featureId = 0;
+            phase = 0;
+          }
+          featureIds->setValue(index, featureId);
+          phases->setValue(index, phase);
+
+          float q[4] = {std::sin(0.7f * featureId), std::cos(1.3f * featureId), std::sin(2.1f * featureId + 0.5f), 1.5f};
+          q[0] += 0.02f * std::sin(static_cast<float>(index));
+          q[1] += 0.02f * std::cos(static_cast<float>(3 * index));
+          float norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+          for(size_t c = 0; c < 4; c++)
+          {
+            quats->setComponent(index, c, q[c] / norm);
+          }
+        }
+      }
+    }
+    cellAM->insertOrAssign(featureIds);
+    cellAM->insertOrAssign(phases);
+    cellAM->insertOrAssign(quats);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<float> ComputeReference(const DataContainerArray::Pointer& dca)
+  {
+    AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix(DataArrayPath("Test", "CellData", ""));
+    Int32ArrayType::Pointer featureIds = cellAM->getAttributeArrayAs<Int32ArrayType>("FeatureIds");
+    FloatArrayType::Pointer quats = cellAM->getAttributeArrayAs<FloatArrayType>("Quats");
+    LaueOps::Pointer ops = LaueOps::GetAllOrientationOps()[EbsdLib::CrystalStructure::Cubic_High];
+
+    const int64_t dims[3] = {static_cast<int64_t>(k_Dims[0]), static_cast<int64_t>(k_Dims[1]), static_cast<int64_t>(k_Dims[2])};
+    std::vector<float> kam(featureIds->getNumberOfTuples(), 0.0f);
+    for(int64_t z = 0; z < dims[2]; z++)
+    {
+      for(int64_t y = 0; y < dims[1]; y++)
+      {
+        for(int64_t x = 0; x < dims[0]; x++)
+        {
+          int64_t point = (z * dims[1] + y) * dims[0] + x;
+          if(featureIds->getValue(point) <= 0)
+          {
+            continue;
+          }
+          QuatD q1(quats->getComponent(point, 0), quats->getComponent(point, 1), quats->getComponent(point, 2), quats->getComponent(point, 3));
+          double total = 0.0;
+          int32_t count = 0;
+          for(int64_t k = z - k_Kernel[2]; k <= z + k_Kernel[2]; k++)
+          {
+            for(int64_t j = y - k_Kernel[1]; j <= y + k_Kernel[1]; j++)
+            {
+              for(int64_t i = x - k_Kernel[0]; i <= x + k_Kernel[0]; i++)
+              {
+                if(i < 0 || j < 0 || k < 0 || i >= dims[0] || j >= dims[1] || k >= dims[2])
+                {
+                  continue;
+                }
+                int64_t neighbor = (k * dims[1] + j) * dims[0] + i;
+                if(featureIds->getValue(neighbor) != featureIds->getValue(point))
+                {
+                  continue;
+                }
+                QuatD q2(quats->getComponent(neighbor, 0), quats->getComponent(neighbor, 1), quats->getComponent(neighbor, 2), quats->getComponent(neighbor, 3));
+                OrientationD axisAngle = ops->calculateMisorientation(q1, q2);
+                total += axisAngle[3] * SIMPLib::Constants::k_180OverPiD;
+                count++;
+              }
+            }
+          }
+          kam[point] = static_cast<float>(total / count);
+        }
+      }
+    }
+    return kam;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunAndCompare(bool reusePairwiseMisorientations)
+  {
+    DataContainerArray::Pointer dca = CreateTestData();
+    std::vector<float> reference = ComputeReference(dca);
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("FindKernelAvgMisorientations");
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant variant;
+    variant.setValue(DataArrayPath("Test", "CellData", "FeatureIds"));
+    bool ok = filter->setProperty("FeatureIdsArrayPath", variant);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    variant.setValue(DataArrayPath("Test", "CellData", "Phases"));
+    ok = filter->setProperty("CellPhasesArrayPath", variant);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    variant.setValue(DataArrayPath("Test", "CellData", "Quats"));
+    ok = filter->setProperty("QuatsArrayPath", variant);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    variant.setValue(DataArrayPath("Test", "EnsembleData", "CrystalStructures"));
+    ok = filter->setProperty("CrystalStructuresArrayPath", variant);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    variant.setValue(IntVec3Type(k_Kernel[0], k_Kernel[1], k_Kernel[2]));
+    ok = filter->setProperty("KernelSize", variant);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = filter->setProperty("ReusePairwiseMisorientations", reusePairwiseMisorientations);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    filter->execute();
+    int err = filter->getErrorCode();
+    DREAM3D_REQUIRE(err >= 0)
+
+    FloatArrayType::Pointer kam =
+        dca->getAttributeMatrix(DataArrayPath("Test", "CellData", ""))->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::KernelAverageMisorientations);
+    DREAM3D_REQUIRE_VALID_POINTER(kam.get())
+    // The reference is evaluated in double precision, so any loss of small angles in the filter shows up here
+    for(size_t i = 0; i < reference.size(); i++)
+    {
+      DREAM3D_REQUIRE(std::fabs(kam->getValue(i) - reference[i]) < 1.0E-4f)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestKernelAverages()
+  {
+    return RunAndCompare(false);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestPairwiseReuse()
+  {
+    return RunAndCompare(true);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestKernelAverages())
+    DREAM3D_REGISTER_TEST(TestPairwiseReuse())
+  }
+
+public:
+  FindKernelAvgMisorientationsTest(const FindKernelAvgMisorientationsTest&) = delete;            // Copy Constructor Not Implemented
+  FindKernelAvgMisorientationsTest(FindKernelAvgMisorientationsTest&&) = delete;                 // Move Constructor Not Implemented
+  FindKernelAvgMisorientationsTest& operator=(const FindKernelAvgMisorientationsTest&) = delete; // Copy Assignment Not Implemented
+  FindKernelAvgMisorientationsTest& operator=(FindKernelAvgMisorientationsTest&&) = delete;      // Move Assignment Not Implemented
+};
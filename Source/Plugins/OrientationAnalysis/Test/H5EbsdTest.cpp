@@ -0,0 +1,472 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/CoreFilters/RotateSampleRefFrame.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/AxisAngleInput.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/IO/TSL/AngConstants.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/EbsdToH5Ebsd.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/ReadH5Ebsd.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/RotateEulerRefFrame.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/OrderedPipeline.hpp"
+#include "OrientationAnalysisTestFileLocations.h"
+
+/**
+ * @brief The H5EbsdTest class imports a small stack of synthetic .ang slices with EbsdToH5Ebsd and checks that
+ * ReadH5Ebsd, which applies the stored reference frame transformations while it copies the slices, produces the
+ * same volume as reading the file untransformed and running Rotate Sample Reference Frame (slice by slice) and
+ * Rotate Euler Reference Frame afterwards. It also checks that the slices, which EbsdToH5Ebsd parses concurrently
+ * when HDF5 is thread safe, are written in slice order.
+ */
+class H5EbsdTest
+{
+  const QString k_DataContainerName = QString("DataContainer");
+  const QString k_CellAttrMatName = QString("CellData");
+  const float k_EulerTolerance = 1.0E-5f;
+  // Unequal X and Y steps so that quarter turns about the stacking direction change the grid
+  static constexpr int32_t k_XPoints = 7;
+  static constexpr int32_t k_YPoints = 5;
+  static constexpr int32_t k_NumSlices = 12;
+  static constexpr int64_t k_ZStartIndex = 1;
+  static constexpr float k_XStep = 0.5f;
+  static constexpr float k_YStep = 0.25f;
+  static constexpr float k_ZStep = 0.75f;
+
+public:
+  H5EbsdTest() = default;
+  virtual ~H5EbsdTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QString SliceFile(int64_t slice) const
+  {
+    return QString("%1/%2%3.ang").arg(UnitTest::H5EbsdTest::InputDir, UnitTest::H5EbsdTest::FilePrefix).arg(slice, 4, 10, QChar('0'));
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    for(int64_t slice = k_ZStartIndex; slice < k_ZStartIndex + k_NumSlices; slice++)
+    {
+      QFile::remove(SliceFile(slice));
+    }
+    QFile::remove(UnitTest::H5EbsdTest::OutputFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  // The Image Quality of every Cell is its slice index * 1000 + its index in the slice, which identifies the Cell
+  // -----------------------------------------------------------------------------
+  void WriteAngFiles()
+  {
+    for(int64_t slice = k_ZStartIndex; slice < k_ZStartIndex + k_NumSlices; slice++)
+    {
+      QFile file(SliceFile(slice));
+      DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Text))
+      QTextStream out(&file);
+      out << "# TEM_PIXperUM          1.000000\n";
+      out << "# x-star                0.500000\n";
+      out << "# y-star                0.500000\n";
+      out << "# z-star                0.500000\n";
+      out << "# WorkingDistance       15.000000\n";
+      out << "#\n";
+      out << "# Phase 1\n";
+      out << "# MaterialName  \tNickel\n";
+      out << "# Formula     \tNi\n";
+      out << "# Info\n";
+      out << "# Symmetry              43\n";
+      out << "# LatticeConstants      3.560 3.560 3.560  90.000  90.000  90.000\n";
+      out << "# NumberFamilies        0\n";
+      out << "# Categories0 0 0 0 0 \n";
+      out << "#\n";
+      out << "# GRID: SqrGrid\n";
+      out << "# XSTEP: " << k_XStep << "\n";
+      out << "# YSTEP: " << k_YStep << "\n";
+      out << "# NCOLS_ODD: " << k_XPoints << "\n";
+      out << "# NCOLS_EVEN: " << k_XPoints << "\n";
+      out << "# NROWS: " << k_YPoints << "\n";
+      out << "#\n";
+      out << "# OPERATOR: \tH5EbsdTest\n";
+      out << "#\n";
+      out << "# SAMPLEID: \t\n";
+      out << "#\n";
+      out << "# SCANID: \t\n";
+      out << "#\n";
+      for(int32_t y = 0; y < k_YPoints; y++)
+      {
+        for(int32_t x = 0; x < k_XPoints; x++)
+        {
+          const int32_t index = y * k_XPoints + x;
+          const float phi1 = 0.05f + 0.17f * static_cast<float>(index % 31);
+          const float phi = 0.1f + 0.09f * static_cast<float>((index + 3 * static_cast<int32_t>(slice)) % 29);
+          const float phi2 = 0.2f + 0.13f * static_cast<float>((7 * index + static_cast<int32_t>(slice)) % 37);
+          out << phi1 << " " << phi << " " << phi2 << " " << k_XStep * static_cast<float>(x) << " " << k_YStep * static_cast<float>(y) << " " << (slice * 1000 + index) << " "
+              << 0.01f * static_cast<float>((x + y) % 10) << " " << 1 << " " << (x + 2 * y) << " " << 0.5f * static_cast<float>(slice) << "\n";
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void ImportSlices(const AxisAngleInput& sampleTransformation, const AxisAngleInput& eulerTransformation)
+  {
+    EbsdToH5Ebsd::Pointer filter = EbsdToH5Ebsd::New();
+    filter->setInputPath(UnitTest::H5EbsdTest::InputDir);
+    filter->setFilePrefix(UnitTest::H5EbsdTest::FilePrefix);
+    filter->setFileSuffix(QString(""));
+    filter->setFileExtension(QString("ang"));
+    filter->setPaddingDigits(4);
+    filter->setZStartIndex(k_ZStartIndex);
+    filter->setZEndIndex(k_ZStartIndex + k_NumSlices - 1);
+    filter->setZResolution(k_ZStep);
+    filter->setRefFrameZDir(SIMPL::RefFrameZDir::LowtoHigh);
+    filter->setSampleTransformation(sampleTransformation);
+    filter->setEulerTransformation(eulerTransformation);
+    filter->setOutputFile(UnitTest::H5EbsdTest::OutputFile);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer ReadVolume(bool useTransformations)
+  {
+    QSet<QString> selectedArrayNames = {SIMPL::CellData::EulerAngles,
+                                        SIMPL::CellData::Phases,
+                                        QString::fromStdString(EbsdLib::Ang::ImageQuality),
+                                        QString::fromStdString(EbsdLib::Ang::ConfidenceIndex),
+                                        QString::fromStdString(EbsdLib::Ang::SEMSignal),
+                                        QString::fromStdString(EbsdLib::Ang::Fit)};
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    ReadH5Ebsd::Pointer filter = ReadH5Ebsd::New();
+    filter->setDataContainerArray(dca);
+    filter->setDataContainerName(DataArrayPath(k_DataContainerName, "", ""));
+    filter->setCellAttributeMatrixName(k_CellAttrMatName);
+    filter->setInputFile(UnitTest::H5EbsdTest::OutputFile);
+    filter->setZStartIndex(static_cast<int>(k_ZStartIndex));
+    filter->setZEndIndex(static_cast<int>(k_ZStartIndex + k_NumSlices - 1));
+    filter->setUseTransformations(useTransformations);
+    filter->setAngleRepresentation(EbsdLib::AngleRepresentation::Radians);
+    filter->setSelectedArrayNames(selectedArrayNames);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The path ReadH5Ebsd took before the transformations were fused into the copy
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer ReadVolumeWithSubFilters(const AxisAngleInput& sampleTransformation, const AxisAngleInput& eulerTransformation)
+  {
+    DataContainerArray::Pointer dca = ReadVolume(false);
+
+    if(sampleTransformation.angle > 0)
+    {
+      RotateSampleRefFrame::Pointer filter = RotateSampleRefFrame::New();
+      filter->setDataContainerArray(dca);
+      filter->setRotationAngle(sampleTransformation.angle);
+      filter->setRotationAxis(FloatVec3Type(sampleTransformation.h, sampleTransformation.k, sampleTransformation.l));
+      filter->setSliceBySlice(true);
+      filter->setCellAttributeMatrixPath(DataArrayPath(k_DataContainerName, k_CellAttrMatName, ""));
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+    }
+
+    if(eulerTransformation.angle > 0)
+    {
+      RotateEulerRefFrame::Pointer filter = RotateEulerRefFrame::New();
+      filter->setDataContainerArray(dca);
+      filter->setRotationAngle(eulerTransformation.angle);
+      filter->setRotationAxis(FloatVec3Type(eulerTransformation.h, eulerTransformation.k, eulerTransformation.l));
+      filter->setCellEulerAnglesArrayPath(DataArrayPath(k_DataContainerName, k_CellAttrMatName, SIMPL::CellData::EulerAngles));
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+    }
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void CompareArrays(const AttributeMatrix::Pointer& fused, const AttributeMatrix::Pointer& reference, const QString& name, float tolerance)
+  {
+    typename DataArray<T>::Pointer fusedArray = fused->getAttributeArrayAs<DataArray<T>>(name);
+    typename DataArray<T>::Pointer referenceArray = reference->getAttributeArrayAs<DataArray<T>>(name);
+    DREAM3D_REQUIRE_VALID_POINTER(fusedArray.get())
+    DREAM3D_REQUIRE_VALID_POINTER(referenceArray.get())
+    DREAM3D_REQUIRE_EQUAL(fusedArray->getNumberOfTuples(), referenceArray->getNumberOfTuples())
+    DREAM3D_REQUIRE_EQUAL(fusedArray->getNumberOfComponents(), referenceArray->getNumberOfComponents())
+    for(size_t i = 0; i < referenceArray->getSize(); i++)
+    {
+      if(tolerance > 0.0f)
+      {
+        DREAM3D_REQUIRE(std::fabs(static_cast<float>(fusedArray->getValue(i)) - static_cast<float>(referenceArray->getValue(i))) <= tolerance)
+      }
+      else
+      {
+        DREAM3D_REQUIRE_EQUAL(fusedArray->getValue(i), referenceArray->getValue(i))
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareVolumes(const AxisAngleInput& sampleTransformation, const AxisAngleInput& eulerTransformation)
+  {
+    ImportSlices(sampleTransformation, eulerTransformation);
+    DataContainerArray::Pointer fusedDca = ReadVolume(true);
+    DataContainerArray::Pointer referenceDca = ReadVolumeWithSubFilters(sampleTransformation, eulerTransformation);
+
+    DataContainer::Pointer fusedDc = fusedDca->getDataContainer(k_DataContainerName);
+    DataContainer::Pointer referenceDc = referenceDca->getDataContainer(k_DataContainerName);
+    ImageGeom::Pointer fusedGeom = fusedDc->getGeometryAs<ImageGeom>();
+    ImageGeom::Pointer referenceGeom = referenceDc->getGeometryAs<ImageGeom>();
+    SizeVec3Type fusedDims = fusedGeom->getDimensions();
+    SizeVec3Type referenceDims = referenceGeom->getDimensions();
+    FloatVec3Type fusedOrigin = fusedGeom->getOrigin();
+    FloatVec3Type referenceOrigin = referenceGeom->getOrigin();
+    FloatVec3Type fusedSpacing = fusedGeom->getSpacing();
+    FloatVec3Type referenceSpacing = referenceGeom->getSpacing();
+    for(size_t a = 0; a < 3; a++)
+    {
+      DREAM3D_REQUIRE_EQUAL(fusedDims[a], referenceDims[a])
+      DREAM3D_REQUIRE_EQUAL(fusedOrigin[a], referenceOrigin[a])
+      DREAM3D_REQUIRE_EQUAL(fusedSpacing[a], referenceSpacing[a])
+    }
+
+    AttributeMatrix::Pointer fusedAttrMat = fusedDc->getAttributeMatrix(k_CellAttrMatName);
+    AttributeMatrix::Pointer referenceAttrMat = referenceDc->getAttributeMatrix(k_CellAttrMatName);
+    DREAM3D_REQUIRE(fusedAttrMat->getTupleDimensions() == referenceAttrMat->getTupleDimensions())
+    DREAM3D_REQUIRE_EQUAL(fusedAttrMat->getNumAttributeArrays(), referenceAttrMat->getNumAttributeArrays())
+
+    CompareArrays<int32_t>(fusedAttrMat, referenceAttrMat, SIMPL::CellData::Phases, 0.0f);
+    CompareArrays<float>(fusedAttrMat, referenceAttrMat, SIMPL::CellData::EulerAngles, k_EulerTolerance);
+    CompareArrays<float>(fusedAttrMat, referenceAttrMat, QString::fromStdString(EbsdLib::Ang::ImageQuality), 0.0f);
+    CompareArrays<float>(fusedAttrMat, referenceAttrMat, QString::fromStdString(EbsdLib::Ang::ConfidenceIndex), 0.0f);
+    CompareArrays<float>(fusedAttrMat, referenceAttrMat, QString::fromStdString(EbsdLib::Ang::SEMSignal), 0.0f);
+    CompareArrays<float>(fusedAttrMat, referenceAttrMat, QString::fromStdString(EbsdLib::Ang::Fit), 0.0f);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AxisAngleInput MakeAxisAngle(float angle, float h, float k, float l) const
+  {
+    AxisAngleInput axisAngle;
+    axisAngle.angle = angle;
+    axisAngle.h = h;
+    axisAngle.k = k;
+    axisAngle.l = l;
+    return axisAngle;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The transformations EbsdToH5Ebsd recommends for TSL data
+  // -----------------------------------------------------------------------------
+  int TestDefaultTransformations()
+  {
+    CompareVolumes(MakeAxisAngle(180.0f, 0.0f, 1.0f, 0.0f), MakeAxisAngle(90.0f, 0.0f, 0.0f, 1.0f));
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A quarter turn about the stacking direction swaps the unequal X and Y spacings
+  // -----------------------------------------------------------------------------
+  int TestQuarterTurnTransformation()
+  {
+    CompareVolumes(MakeAxisAngle(90.0f, 0.0f, 0.0f, 1.0f), MakeAxisAngle(45.0f, 1.0f, 1.0f, 0.0f));
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // An arbitrary angle resamples the slices and leaves Cells of the enlarged grid without a source
+  // -----------------------------------------------------------------------------
+  int TestArbitraryTransformation()
+  {
+    CompareVolumes(MakeAxisAngle(30.0f, 0.0f, 0.0f, 1.0f), MakeAxisAngle(90.0f, 0.0f, 0.0f, 1.0f));
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestNoTransformations()
+  {
+    CompareVolumes(MakeAxisAngle(0.0f, 0.0f, 0.0f, 1.0f), MakeAxisAngle(0.0f, 0.0f, 0.0f, 1.0f));
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSliceOrder()
+  {
+    ImportSlices(MakeAxisAngle(0.0f, 0.0f, 0.0f, 1.0f), MakeAxisAngle(0.0f, 0.0f, 0.0f, 1.0f));
+    DataContainerArray::Pointer dca = ReadVolume(false);
+
+    DataContainer::Pointer dc = dca->getDataContainer(k_DataContainerName);
+    SizeVec3Type dims = dc->getGeometryAs<ImageGeom>()->getDimensions();
+    DREAM3D_REQUIRE_EQUAL(dims[0], static_cast<size_t>(k_XPoints))
+    DREAM3D_REQUIRE_EQUAL(dims[1], static_cast<size_t>(k_YPoints))
+    DREAM3D_REQUIRE_EQUAL(dims[2], static_cast<size_t>(k_NumSlices))
+
+    FloatArrayType::Pointer imageQuality = dc->getAttributeMatrix(k_CellAttrMatName)->getAttributeArrayAs<FloatArrayType>(QString::fromStdString(EbsdLib::Ang::ImageQuality));
+    DREAM3D_REQUIRE_VALID_POINTER(imageQuality.get())
+    size_t cell = 0;
+    for(int32_t z = 0; z < k_NumSlices; z++)
+    {
+      for(int32_t index = 0; index < k_XPoints * k_YPoints; index++)
+      {
+        const float expected = static_cast<float>((k_ZStartIndex + z) * 1000 + index);
+        DREAM3D_REQUIRE_EQUAL(imageQuality->getValue(cell), expected)
+        cell++;
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // An exception thrown while a slice is produced or consumed reaches the calling thread after the slices before it
+  // -----------------------------------------------------------------------------
+  int TestOrderedPipelineErrors()
+  {
+    const size_t count = 32;
+    const size_t failingIndex = 13;
+    OrientationAnalysis::OrderedPipeline<size_t> pipeline(4, 8);
+
+    std::vector<size_t> consumed;
+    bool threw = false;
+    try
+    {
+      pipeline.run(
+          count,
+          [&](size_t i) {
+            if(i == failingIndex)
+            {
+              throw std::runtime_error("producer");
+            }
+            return i;
+          },
+          [&](size_t /* i */, size_t& value) {
+            consumed.push_back(value);
+            return true;
+          });
+    } catch(const std::runtime_error& e)
+    {
+      threw = std::string(e.what()) == "producer";
+    }
+    DREAM3D_REQUIRE(threw)
+    DREAM3D_REQUIRE_EQUAL(consumed.size(), failingIndex)
+    for(size_t i = 0; i < consumed.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(consumed[i], i)
+    }
+
+    consumed.clear();
+    threw = false;
+    try
+    {
+      pipeline.run(
+          count, [](size_t i) { return i; },
+          [&](size_t i, size_t& value) {
+            if(i == failingIndex)
+            {
+              throw std::runtime_error("consumer");
+            }
+            consumed.push_back(value);
+            return true;
+          });
+    } catch(const std::runtime_error& e)
+    {
+      threw = std::string(e.what()) == "consumer";
+    }
+    DREAM3D_REQUIRE(threw)
+    DREAM3D_REQUIRE_EQUAL(consumed.size(), failingIndex)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(WriteAngFiles())
+
+    DREAM3D_REGISTER_TEST(TestNoTransformations())
+    DREAM3D_REGISTER_TEST(TestDefaultTransformations())
+    DREAM3D_REGISTER_TEST(TestQuarterTurnTransformation())
+    DREAM3D_REGISTER_TEST(TestArbitraryTransformation())
+    DREAM3D_REGISTER_TEST(TestSliceOrder())
+    DREAM3D_REGISTER_TEST(TestOrderedPipelineErrors())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  H5EbsdTest(const H5EbsdTest&) = delete;            // Copy Constructor Not Implemented
+  H5EbsdTest(H5EbsdTest&&) = delete;                 // Move Constructor Not Implemented
+  H5EbsdTest& operator=(const H5EbsdTest&) = delete; // Copy Assignment Not Implemented
+  H5EbsdTest& operator=(H5EbsdTest&&) = delete;      // Move Assignment Not Implemented
+};
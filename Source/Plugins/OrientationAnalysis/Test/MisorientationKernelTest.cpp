@@ -0,0 +1,205 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "Common/MisorientationKernel.hpp"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class MisorientationKernelTest
+{
+  const size_t k_NumPairs = 20000;
+  const uint64_t k_Seed = 5489;
+
+public:
+  MisorientationKernelTest() = default;
+  virtual ~MisorientationKernelTest() = default;
+
+  // -----------------------------------------------------------------------------
+  // Random unit quaternions in <x, y, z, w> order. Every other second quaternion is the first one
+  // rotated by a small angle so that the pairs also cover the range around segmentation tolerances
+  // -----------------------------------------------------------------------------
+  std::vector<float> CreateQuaternionPairs()
+  {
+    std::mt19937_64 generator(k_Seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::uniform_real_distribution<double> smallAngle(0.0, 10.0 * SIMPLib::Constants::k_PiOver180D);
+
+    auto randomQuat = [&](double* q) {
+      double norm = 0.0;
+      for(size_t c = 0; c < 4; c++)
+      {
+        q[c] = normal(generator);
+        norm += q[c] * q[c];
+      }
+      norm = std::sqrt(norm);
+      for(size_t c = 0; c < 4; c++)
+      {
+        q[c] /= norm;
+      }
+    };
+
+    std::vector<float> quats(k_NumPairs * 8);
+    for(size_t p = 0; p < k_NumPairs; p++)
+    {
+      double q1[4];
+      double q2[4];
+      randomQuat(q1);
+      randomQuat(q2);
+      if(p % 2 == 1)
+      {
+        // q2 = q1 * rotation by a small angle about a random axis
+        double halfAngle = 0.5 * smallAngle(generator);
+        double axisNorm = std::sqrt(q2[0] * q2[0] + q2[1] * q2[1] + q2[2] * q2[2]);
+        double r[4] = {q2[0] / axisNorm * std::sin(halfAngle), q2[1] / axisNorm * std::sin(halfAngle), q2[2] / axisNorm * std::sin(halfAngle), std::cos(halfAngle)};
+        q2[0] = q1[3] * r[0] + q1[0] * r[3] + q1[1] * r[2] - q1[2] * r[1];
+        q2[1] = q1[3] * r[1] + q1[1] * r[3] + q1[2] * r[0] - q1[0] * r[2];
+        q2[2] = q1[3] * r[2] + q1[2] * r[3] + q1[0] * r[1] - q1[1] * r[0];
+        q2[3] = q1[3] * r[3] - q1[0] * r[0] - q1[1] * r[1] - q1[2] * r[2];
+      }
+      for(size_t c = 0; c < 4; c++)
+      {
+        quats[p * 8 + c] = static_cast<float>(q1[c]);
+        quats[p * 8 + 4 + c] = static_cast<float>(q2[c]);
+      }
+    }
+    return quats;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestAgainstLaueOps()
+  {
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+    std::vector<uint32_t> crystalStructures(orientationOps.size());
+    for(size_t e = 0; e < crystalStructures.size(); e++)
+    {
+      crystalStructures[e] = static_cast<uint32_t>(e);
+    }
+
+    const float tolerance = 5.0f * SIMPLib::Constants::k_PiOver180F;
+    MisorientationKernel kernel(crystalStructures.data(), crystalStructures.size(), tolerance);
+    std::vector<float> quats = CreateQuaternionPairs();
+
+    for(size_t e = 0; e < crystalStructures.size(); e++)
+    {
+      const int32_t ensemble = static_cast<int32_t>(e);
+      DREAM3D_REQUIRE(kernel.isValidEnsemble(ensemble))
+      for(size_t p = 0; p < k_NumPairs; p++)
+      {
+        const float* q1 = quats.data() + p * 8;
+        const float* q2 = q1 + 4;
+        QuatD laueQ1(q1[0], q1[1], q1[2], q1[3]);
+        QuatD laueQ2(q2[0], q2[1], q2[2], q2[3]);
+        OrientationD axisAngle = orientationOps[e]->calculateMisorientation(laueQ1, laueQ2);
+        const double expected = axisAngle[3];
+
+        const float angle = kernel.misorientationAngle(ensemble, q1, q2);
+        DREAM3D_REQUIRE(std::fabs(angle - expected) < 1.0E-5)
+
+        // The tolerance test must agree with LaueOps except for pairs within rounding of the tolerance
+        if(std::fabs(expected - tolerance) > 1.0E-5)
+        {
+          DREAM3D_REQUIRE_EQUAL(kernel.isBelowTolerance(ensemble, q1, q2), expected < tolerance)
+        }
+      }
+    }
+
+    // Unknown crystal structures never match and report the maximum angle
+    uint32_t unknown = EbsdLib::CrystalStructure::UnknownCrystalStructure;
+    MisorientationKernel unknownKernel(&unknown, 1, tolerance);
+    DREAM3D_REQUIRE_EQUAL(unknownKernel.isValidEnsemble(0), false)
+    DREAM3D_REQUIRE_EQUAL(unknownKernel.isBelowTolerance(0, quats.data(), quats.data()), false)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestCountBelowTolerance()
+  {
+    uint32_t cubic = EbsdLib::CrystalStructure::Cubic_High;
+    MisorientationKernel kernel(&cubic, 1, 5.0f * SIMPLib::Constants::k_PiOver180F);
+    std::vector<float> quats = CreateQuaternionPairs();
+
+    std::vector<int64_t> neighbors;
+    for(int64_t n = 1; n < 2000; n += 2)
+    {
+      neighbors.push_back(n);
+    }
+    size_t expected = 0;
+    for(int64_t neighbor : neighbors)
+    {
+      if(kernel.isBelowTolerance(0, quats.data(), quats.data() + neighbor * 4))
+      {
+        expected++;
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(kernel.countBelowTolerance(0, quats.data(), quats.data(), neighbors.data(), neighbors.size()), expected)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestAgainstLaueOps())
+    DREAM3D_REGISTER_TEST(TestCountBelowTolerance())
+  }
+
+public:
+  MisorientationKernelTest(const MisorientationKernelTest&) = delete;            // Copy Constructor Not Implemented
+  MisorientationKernelTest(MisorientationKernelTest&&) = delete;                 // Move Constructor Not Implemented
+  MisorientationKernelTest& operator=(const MisorientationKernelTest&) = delete; // Copy Assignment Not Implemented
+  MisorientationKernelTest& operator=(MisorientationKernelTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,129 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cstdint>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "Common/PhiloxRandom.hpp"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class PhiloxRandomTest
+{
+public:
+  PhiloxRandomTest() = default;
+  virtual ~PhiloxRandomTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestKnownAnswer()
+  {
+    // Philox4x32-10 with a zero counter and a zero key (Random123 known answer vector)
+    PhiloxRandom rng(0, 0);
+    DREAM3D_REQUIRE_EQUAL(rng(), 0xe169c58d6627e8d5ULL)
+    DREAM3D_REQUIRE_EQUAL(rng(), 0x9b00dbd8bc57ac4cULL)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestStreams()
+  {
+    const uint64_t seed = 5489;
+    const uint64_t streamA = PhiloxRandom::StreamId(1, 0, 7);
+    const uint64_t streamB = PhiloxRandom::StreamId(1, 0, 8);
+
+    PhiloxRandom first(seed, streamA);
+    PhiloxRandom second(seed, streamA);
+    PhiloxRandom other(seed, streamB);
+    int32_t differences = 0;
+    for(int32_t i = 0; i < 1000; i++)
+    {
+      uint64_t value = first();
+      DREAM3D_REQUIRE_EQUAL(value, second())
+      if(value != other())
+      {
+        differences++;
+      }
+    }
+    DREAM3D_REQUIRE(differences > 990)
+
+    DREAM3D_REQUIRE_EQUAL(PhiloxRandom::StreamSeed(seed, streamA), PhiloxRandom::StreamSeed(seed, streamA))
+    DREAM3D_REQUIRE_EQUAL(PhiloxRandom::ResolveSeed(true, seed), seed)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestRanges()
+  {
+    PhiloxRandom rng(42, 0);
+    double sum = 0.0;
+    const int32_t count = 100000;
+    for(int32_t i = 0; i < count; i++)
+    {
+      double value = rng.genrand_res53();
+      DREAM3D_REQUIRE(value >= 0.0 && value < 1.0)
+      sum += value;
+      DREAM3D_REQUIRE(rng.genrand_index(17) < 17)
+    }
+    DREAM3D_REQUIRE(sum / count > 0.49 && sum / count < 0.51)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestKnownAnswer())
+    DREAM3D_REGISTER_TEST(TestStreams())
+    DREAM3D_REGISTER_TEST(TestRanges())
+  }
+
+public:
+  PhiloxRandomTest(const PhiloxRandomTest&) = delete;            // Copy Constructor Not Implemented
+  PhiloxRandomTest(PhiloxRandomTest&&) = delete;                 // Move Constructor Not Implemented
+  PhiloxRandomTest& operator=(const PhiloxRandomTest&) = delete; // Copy Assignment Not Implemented
+  PhiloxRandomTest& operator=(PhiloxRandomTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -48,6 +48,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Common/TupleIndexMap.hpp"
+
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
@@ -295,6 +297,7 @@ void ErodeDilateBadData::execute()
       voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
     }
 
+    TupleIndexMap indexMap(totalPoints);
     for(size_t j = 0; j < totalPoints; j++)
     {
       featurename = m_FeatureIds[j];
@@ -303,14 +306,11 @@ void ErodeDilateBadData::execute()
       {
         if((featurename == 0 && m_FeatureIds[neighbor] > 0 && m_Direction == 1) || (featurename > 0 && m_FeatureIds[neighbor] == 0 && m_Direction == 0))
         {
-          for(const auto& arrayName : voxelArrayNames)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName);
-            p->copyTuple(neighbor, j);
-          }
+          indexMap.copyTuple(neighbor, j);
         }
       }
     }
+    indexMap.apply(m->getAttributeMatrix(attrMatName), voxelArrayNames);
   }
 }
 
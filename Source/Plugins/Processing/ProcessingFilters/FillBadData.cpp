@@ -48,6 +48,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Common/TupleIndexMap.hpp"
+
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
@@ -389,19 +391,17 @@ void FillBadData::execute()
     QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
     QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
 
+    TupleIndexMap indexMap(totalPoints);
     for(size_t j = 0; j < totalPoints; j++)
     {
       featurename = m_FeatureIds[j];
       neighbor = m_Neighbors[j];
       if(featurename < 0 && neighbor != -1 && m_FeatureIds[neighbor] > 0)
       {
-        for(const auto& arrayName : voxelArrayNames)
-        {
-          IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName);
-          p->copyTuple(neighbor, j);
-        }
+        indexMap.copyTuple(neighbor, j);
       }
     }
+    indexMap.apply(m->getAttributeMatrix(attrMatName), voxelArrayNames);
   }
 }
 
@@ -47,6 +47,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Common/TupleIndexMap.hpp"
+
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
@@ -376,19 +378,17 @@ void MinNeighbors::assign_badpoints()
     {
       voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
     }
+    TupleIndexMap indexMap(totalPoints);
     for(size_t j = 0; j < totalPoints; j++)
     {
       featurename = m_FeatureIds[j];
       neighbor = m_Neighbors[j];
       if(featurename < 0 && neighbor >= 0 && m_FeatureIds[neighbor] >= 0)
       {
-        for(const auto& arrayName : voxelArrayNames)
-        {
-          IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName);
-          p->copyTuple(neighbor, j);
-        }
+        indexMap.copyTuple(neighbor, j);
       }
     }
+    indexMap.apply(m->getAttributeMatrix(attrMatName), voxelArrayNames);
   }
 }
 
@@ -47,6 +47,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Common/TupleIndexMap.hpp"
+
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
@@ -373,7 +375,7 @@ void MinSize::assign_badpoints()
     {
       voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
     }
-    // TODO: This loop could be parallelized. Look at NeighborOrientationCorrelation filter
+    TupleIndexMap indexMap(totalPoints);
     for(size_t j = 0; j < totalPoints; j++)
     {
       featurename = m_FeatureIds[j];
@@ -382,14 +384,11 @@ void MinSize::assign_badpoints()
       {
         if(featurename < 0 && m_FeatureIds[neighbor] >= 0)
         {
-          for(auto& voxelArrayName : voxelArrayNames)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(voxelArrayName);
-            p->copyTuple(neighbor, j);
-          }
+          indexMap.copyTuple(neighbor, j);
         }
       }
     }
+    indexMap.apply(m->getAttributeMatrix(attrMatName), voxelArrayNames);
   }
 }
 
@@ -0,0 +1,639 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/StringDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "ProcessingTestFileLocations.h"
+
+/**
+ * @brief The CleanupFiltersTest class checks that MinSize, MinNeighbors, FillBadData and ErodeDilateBadData move
+ * every Cell array exactly as the original per tuple IDataArray::copyTuple() loops did: each modified Cell takes all
+ * of its values from the single neighbor that the filter votes for, Cells that are not modified keep their values
+ * and ignored arrays are left alone.
+ */
+class CleanupFiltersTest
+{
+  const QString k_DataContainerName = QString("DataContainer");
+  const QString k_CellAttrMatName = QString("CellData");
+  const QString k_FeatureAttrMatName = QString("CellFeatureData");
+  const QString k_FeatureIdsName = QString("FeatureIds");
+  const QString k_PhasesName = QString("Phases");
+  const QString k_IndexName = QString("Index");
+  const QString k_VectorName = QString("Vector");
+  const QString k_UInt8Name = QString("UInt8");
+  const QString k_MaskName = QString("Mask");
+  const QString k_LabelName = QString("Label");
+  const QString k_IgnoredName = QString("Ignored");
+  const QString k_NumCellsName = QString("NumCells");
+  const QString k_NumNeighborsName = QString("NumNeighbors");
+  // The volume is a stack of slabs along X, k_SlabWidth Cells wide, each one its own Feature
+  static constexpr size_t k_XPoints = 12;
+  static constexpr size_t k_YPoints = 9;
+  static constexpr size_t k_ZPoints = 6;
+  static constexpr size_t k_SlabWidth = 3;
+  static constexpr int64_t k_KeepTuple = -1;
+
+public:
+  CleanupFiltersTest() = default;
+  virtual ~CleanupFiltersTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    FilterManager* fm = FilterManager::Instance();
+    QStringList filtNames = {"MinSize", "MinNeighbors", "FillBadData", "ErodeDilateBadData"};
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The CleanupFiltersTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Processing Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer createFilter(const DataContainerArray::Pointer& dca, const QString& filtName)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == factory.get())
+    {
+      return AbstractFilter::NullPointer();
+    }
+    AbstractFilter::Pointer filter = factory->create();
+    filter->setDataContainerArray(dca);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void setProperty(const AbstractFilter::Pointer& filter, const char* name, const QVariant& value)
+  {
+    bool propWasSet = filter->setProperty(name, value);
+    if(!propWasSet)
+    {
+      qDebug() << "Unable to set property " << name;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QVariant pathVariant(const QString& amName, const QString& arrayName)
+  {
+    QVariant var;
+    var.setValue(DataArrayPath(k_DataContainerName, amName, arrayName));
+    return var;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QVariant ignoredPathsVariant()
+  {
+    DataArrayPathVec paths = {DataArrayPath(k_DataContainerName, k_CellAttrMatName, k_IgnoredName)};
+    QVariant var;
+    var.setValue(paths);
+    return var;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  size_t cellIndex(size_t x, size_t y, size_t z)
+  {
+    return (z * k_XPoints * k_YPoints) + (y * k_XPoints) + x;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int32_t slabFeature(size_t index)
+  {
+    return static_cast<int32_t>(1 + (index % k_XPoints) / k_SlabWidth);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Small defects, all in the middle column of a slab so that every face neighbor
+  // that is not part of the same defect belongs to that slab
+  // -----------------------------------------------------------------------------
+  std::vector<std::vector<size_t>> smallDefects()
+  {
+    return {{cellIndex(1, 2, 0)}, {cellIndex(4, 4, 3)}, {cellIndex(7, 7, 5)}, {cellIndex(10, 1, 2)}, {cellIndex(4, 1, 1), cellIndex(4, 2, 1)}, {cellIndex(7, 3, 3), cellIndex(7, 4, 3)}};
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<size_t> faceNeighbors(size_t index)
+  {
+    const size_t x = index % k_XPoints;
+    const size_t y = (index / k_XPoints) % k_YPoints;
+    const size_t z = index / (k_XPoints * k_YPoints);
+    // Same order as the filters visit them: -Z, -Y, -X, +X, +Y, +Z
+    std::vector<size_t> neighbors;
+    if(z > 0)
+    {
+      neighbors.push_back(index - k_XPoints * k_YPoints);
+    }
+    if(y > 0)
+    {
+      neighbors.push_back(index - k_XPoints);
+    }
+    if(x > 0)
+    {
+      neighbors.push_back(index - 1);
+    }
+    if(x < k_XPoints - 1)
+    {
+      neighbors.push_back(index + 1);
+    }
+    if(y < k_YPoints - 1)
+    {
+      neighbors.push_back(index + k_XPoints);
+    }
+    if(z < k_ZPoints - 1)
+    {
+      neighbors.push_back(index + k_XPoints * k_YPoints);
+    }
+    return neighbors;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Where each Cell should take its values from when the bad Cells are filled: the
+  // first good face neighbor wins the vote since all of them belong to the same Feature
+  // -----------------------------------------------------------------------------
+  std::vector<int64_t> fillSources(const std::vector<bool>& bad)
+  {
+    std::vector<int64_t> sources(bad.size(), k_KeepTuple);
+    for(size_t i = 0; i < bad.size(); i++)
+    {
+      if(!bad[i])
+      {
+        continue;
+      }
+      for(size_t neighbor : faceNeighbors(i))
+      {
+        if(!bad[neighbor])
+        {
+          sources[i] = static_cast<int64_t>(neighbor);
+          break;
+        }
+      }
+    }
+    return sources;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Where each Cell should take its values from when the bad Cells are eroded: a good
+  // Cell takes the last bad face neighbor that is visited
+  // -----------------------------------------------------------------------------
+  std::vector<int64_t> erodeSources(const std::vector<bool>& bad)
+  {
+    std::vector<int64_t> sources(bad.size(), k_KeepTuple);
+    for(size_t i = 0; i < bad.size(); i++)
+    {
+      if(!bad[i])
+      {
+        continue;
+      }
+      for(size_t neighbor : faceNeighbors(i))
+      {
+        if(!bad[neighbor])
+        {
+          sources[neighbor] = static_cast<int64_t>(i);
+        }
+      }
+    }
+    return sources;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createVolume(const std::vector<int32_t>& featureIdValues)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    std::vector<size_t> tDims = {k_XPoints, k_YPoints, k_ZPoints};
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(tDims.data());
+    image->setSpacing(FloatVec3Type(1.0f, 1.0f, 1.0f));
+    image->setOrigin(FloatVec3Type(0.0f, 0.0f, 0.0f));
+    dc->setGeometry(image);
+
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, k_CellAttrMatName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+
+    // Every array encodes the Cell it started in so that the Cell each value ends up in can be traced back
+    const size_t totalPoints = k_XPoints * k_YPoints * k_ZPoints;
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, k_FeatureIdsName, true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, k_PhasesName, true);
+    Int64ArrayType::Pointer indices = Int64ArrayType::CreateArray(totalPoints, k_IndexName, true);
+    FloatArrayType::Pointer vectors = FloatArrayType::CreateArray(tDims, std::vector<size_t>(1, 3), k_VectorName, true);
+    UInt8ArrayType::Pointer bytes = UInt8ArrayType::CreateArray(totalPoints, k_UInt8Name, true);
+    BoolArrayType::Pointer mask = BoolArrayType::CreateArray(totalPoints, k_MaskName, true);
+    StringDataArray::Pointer labels = StringDataArray::CreateArray(totalPoints, k_LabelName, true);
+    DoubleArrayType::Pointer ignored = DoubleArrayType::CreateArray(totalPoints, k_IgnoredName, true);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      featureIds->setValue(i, featureIdValues[i]);
+      phases->setValue(i, static_cast<int32_t>(1 + i % 2));
+      indices->setValue(i, static_cast<int64_t>(i));
+      vectors->setComponent(i, 0, static_cast<float>(i) * 0.5f);
+      vectors->setComponent(i, 1, static_cast<float>(featureIdValues[i]));
+      vectors->setComponent(i, 2, -static_cast<float>(i));
+      bytes->setValue(i, static_cast<uint8_t>(i % 251));
+      mask->setValue(i, i % 3 == 0);
+      labels->setValue(i, QString::number(i));
+      ignored->setValue(i, static_cast<double>(i) * 0.25);
+    }
+    cellAttrMat->insertOrAssign(featureIds);
+    cellAttrMat->insertOrAssign(phases);
+    cellAttrMat->insertOrAssign(indices);
+    cellAttrMat->insertOrAssign(vectors);
+    cellAttrMat->insertOrAssign(bytes);
+    cellAttrMat->insertOrAssign(mask);
+    cellAttrMat->insertOrAssign(labels);
+    cellAttrMat->insertOrAssign(ignored);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Adds the Feature Attribute Matrix that MinSize and MinNeighbors read
+  // -----------------------------------------------------------------------------
+  void addFeatureData(const DataContainerArray::Pointer& dca, const std::vector<int32_t>& featureIdValues)
+  {
+    int32_t maxFeatureId = 0;
+    for(int32_t featureId : featureIdValues)
+    {
+      maxFeatureId = std::max(maxFeatureId, featureId);
+    }
+    const size_t numFeatures = static_cast<size_t>(maxFeatureId) + 1;
+    DataContainer::Pointer dc = dca->getDataContainer(k_DataContainerName);
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New({numFeatures}, k_FeatureAttrMatName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAttrMat);
+    Int32ArrayType::Pointer numCells = Int32ArrayType::CreateArray(numFeatures, k_NumCellsName, true);
+    Int32ArrayType::Pointer numNeighbors = Int32ArrayType::CreateArray(numFeatures, k_NumNeighborsName, true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(numFeatures, k_PhasesName, true);
+    numCells->initializeWithZeros();
+    phases->initializeWithValue(1);
+    phases->setValue(0, 0);
+    for(int32_t featureId : featureIdValues)
+    {
+      numCells->setValue(featureId, numCells->getValue(featureId) + 1);
+    }
+    // Slabs touch one or two other slabs and the ends of the volume, the small Features only touch the slab around them
+    const int32_t numSlabs = static_cast<int32_t>(k_XPoints / k_SlabWidth);
+    numNeighbors->setValue(0, 0);
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      numNeighbors->setValue(i, static_cast<int32_t>(i) <= numSlabs ? 5 : 1);
+    }
+    featureAttrMat->insertOrAssign(numCells);
+    featureAttrMat->insertOrAssign(numNeighbors);
+    featureAttrMat->insertOrAssign(phases);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void checkTuples(const IDataArray::Pointer& original, const IDataArray::Pointer& remapped, const std::vector<int64_t>& sources)
+  {
+    typename DataArray<T>::Pointer input = std::dynamic_pointer_cast<DataArray<T>>(original);
+    typename DataArray<T>::Pointer output = std::dynamic_pointer_cast<DataArray<T>>(remapped);
+    DREAM3D_REQUIRE_VALID_POINTER(input.get())
+    DREAM3D_REQUIRE_VALID_POINTER(output.get())
+    DREAM3D_REQUIRE_EQUAL(output->getNumberOfTuples(), sources.size())
+    const size_t numComps = input->getNumberOfComponents();
+    for(size_t i = 0; i < sources.size(); i++)
+    {
+      const size_t source = sources[i] == k_KeepTuple ? i : static_cast<size_t>(sources[i]);
+      for(size_t c = 0; c < numComps; c++)
+      {
+        DREAM3D_REQUIRE_EQUAL(output->getValue(i * numComps + c), input->getValue(source * numComps + c))
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void checkStrings(const IDataArray::Pointer& original, const IDataArray::Pointer& remapped, const std::vector<int64_t>& sources)
+  {
+    StringDataArray::Pointer input = std::dynamic_pointer_cast<StringDataArray>(original);
+    StringDataArray::Pointer output = std::dynamic_pointer_cast<StringDataArray>(remapped);
+    DREAM3D_REQUIRE_VALID_POINTER(input.get())
+    DREAM3D_REQUIRE_VALID_POINTER(output.get())
+    for(size_t i = 0; i < sources.size(); i++)
+    {
+      const size_t source = sources[i] == k_KeepTuple ? i : static_cast<size_t>(sources[i]);
+      DREAM3D_REQUIRE(output->getValue(i) == input->getValue(source))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Compares every Cell array after the filter ran against the copy taken before it ran
+  // -----------------------------------------------------------------------------
+  void checkCellArrays(const AttributeMatrix::Pointer& original, const DataContainerArray::Pointer& dca, const std::vector<int64_t>& sources, const std::vector<int32_t>& expectedFeatureIds)
+  {
+    AttributeMatrix::Pointer cellAttrMat = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttrMatName);
+    DREAM3D_REQUIRE_VALID_POINTER(cellAttrMat.get())
+
+    checkTuples<int32_t>(original->getAttributeArray(k_PhasesName), cellAttrMat->getAttributeArray(k_PhasesName), sources);
+    checkTuples<int64_t>(original->getAttributeArray(k_IndexName), cellAttrMat->getAttributeArray(k_IndexName), sources);
+    checkTuples<float>(original->getAttributeArray(k_VectorName), cellAttrMat->getAttributeArray(k_VectorName), sources);
+    checkTuples<uint8_t>(original->getAttributeArray(k_UInt8Name), cellAttrMat->getAttributeArray(k_UInt8Name), sources);
+    checkTuples<bool>(original->getAttributeArray(k_MaskName), cellAttrMat->getAttributeArray(k_MaskName), sources);
+    checkStrings(original->getAttributeArray(k_LabelName), cellAttrMat->getAttributeArray(k_LabelName), sources);
+
+    // The ignored array is never touched
+    std::vector<int64_t> keepAll(sources.size(), k_KeepTuple);
+    checkTuples<double>(original->getAttributeArray(k_IgnoredName), cellAttrMat->getAttributeArray(k_IgnoredName), keepAll);
+
+    Int32ArrayType::Pointer featureIds = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsName);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+    for(size_t i = 0; i < expectedFeatureIds.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), expectedFeatureIds[i])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Slabs with every small defect given its own Feature, numbered after the slabs
+  // -----------------------------------------------------------------------------
+  std::vector<int32_t> smallFeatureIds(std::vector<bool>& bad)
+  {
+    const size_t totalPoints = k_XPoints * k_YPoints * k_ZPoints;
+    std::vector<int32_t> featureIds(totalPoints, 0);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      featureIds[i] = slabFeature(i);
+    }
+    bad.assign(totalPoints, false);
+    int32_t nextFeature = static_cast<int32_t>(k_XPoints / k_SlabWidth) + 1;
+    for(const auto& defect : smallDefects())
+    {
+      for(size_t index : defect)
+      {
+        featureIds[index] = nextFeature;
+        bad[index] = true;
+      }
+      nextFeature++;
+    }
+    return featureIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Slabs with every small defect set to 0
+  // -----------------------------------------------------------------------------
+  std::vector<int32_t> badDataFeatureIds(std::vector<bool>& bad)
+  {
+    std::vector<int32_t> featureIds = smallFeatureIds(bad);
+    for(size_t i = 0; i < featureIds.size(); i++)
+    {
+      if(bad[i])
+      {
+        featureIds[i] = 0;
+      }
+    }
+    return featureIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<int32_t> slabFeatureIds()
+  {
+    std::vector<int32_t> featureIds(k_XPoints * k_YPoints * k_ZPoints, 0);
+    for(size_t i = 0; i < featureIds.size(); i++)
+    {
+      featureIds[i] = slabFeature(i);
+    }
+    return featureIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMinSize()
+  {
+    std::vector<bool> bad;
+    std::vector<int32_t> featureIds = smallFeatureIds(bad);
+    DataContainerArray::Pointer dca = createVolume(featureIds);
+    addFeatureData(dca, featureIds);
+    AttributeMatrix::Pointer original = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttrMatName)->deepCopy(false);
+
+    AbstractFilter::Pointer filter = createFilter(dca, "MinSize");
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    setProperty(filter, "MinAllowedFeatureSize", 3);
+    setProperty(filter, "ApplyToSinglePhase", false);
+    setProperty(filter, "FeatureIdsArrayPath", pathVariant(k_CellAttrMatName, k_FeatureIdsName));
+    setProperty(filter, "FeaturePhasesArrayPath", pathVariant(k_FeatureAttrMatName, k_PhasesName));
+    setProperty(filter, "NumCellsArrayPath", pathVariant(k_FeatureAttrMatName, k_NumCellsName));
+    setProperty(filter, "IgnoredDataArrayPaths", ignoredPathsVariant());
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCode() >= 0)
+
+    checkCellArrays(original, dca, fillSources(bad), slabFeatureIds());
+    AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_FeatureAttrMatName);
+    DREAM3D_REQUIRE_EQUAL(featureAttrMat->getNumberOfTuples(), k_XPoints / k_SlabWidth + 1)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMinNeighbors()
+  {
+    std::vector<bool> bad;
+    std::vector<int32_t> featureIds = smallFeatureIds(bad);
+    DataContainerArray::Pointer dca = createVolume(featureIds);
+    addFeatureData(dca, featureIds);
+    AttributeMatrix::Pointer original = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttrMatName)->deepCopy(false);
+
+    AbstractFilter::Pointer filter = createFilter(dca, "MinNeighbors");
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    setProperty(filter, "MinNumNeighbors", 2);
+    setProperty(filter, "ApplyToSinglePhase", false);
+    setProperty(filter, "FeatureIdsArrayPath", pathVariant(k_CellAttrMatName, k_FeatureIdsName));
+    setProperty(filter, "FeaturePhasesArrayPath", pathVariant(k_FeatureAttrMatName, k_PhasesName));
+    setProperty(filter, "NumNeighborsArrayPath", pathVariant(k_FeatureAttrMatName, k_NumNeighborsName));
+    setProperty(filter, "IgnoredDataArrayPaths", ignoredPathsVariant());
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCode() >= 0)
+
+    checkCellArrays(original, dca, fillSources(bad), slabFeatureIds());
+    AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_FeatureAttrMatName);
+    DREAM3D_REQUIRE_EQUAL(featureAttrMat->getNumberOfTuples(), k_XPoints / k_SlabWidth + 1)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFillBadData()
+  {
+    std::vector<bool> bad;
+    std::vector<int32_t> featureIds = badDataFeatureIds(bad);
+    // One defect that is large enough to be kept as it is
+    std::vector<int32_t> expectedFeatureIds = slabFeatureIds();
+    for(size_t z = 3; z < 5; z++)
+    {
+      for(size_t y = 5; y < 7; y++)
+      {
+        for(size_t x = 9; x < 11; x++)
+        {
+          featureIds[cellIndex(x, y, z)] = 0;
+          expectedFeatureIds[cellIndex(x, y, z)] = 0;
+        }
+      }
+    }
+    DataContainerArray::Pointer dca = createVolume(featureIds);
+    AttributeMatrix::Pointer original = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttrMatName)->deepCopy(false);
+
+    AbstractFilter::Pointer filter = createFilter(dca, "FillBadData");
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    setProperty(filter, "MinAllowedDefectSize", 5);
+    setProperty(filter, "StoreAsNewPhase", false);
+    setProperty(filter, "FeatureIdsArrayPath", pathVariant(k_CellAttrMatName, k_FeatureIdsName));
+    setProperty(filter, "CellPhasesArrayPath", pathVariant(k_CellAttrMatName, k_PhasesName));
+    setProperty(filter, "IgnoredDataArrayPaths", ignoredPathsVariant());
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCode() >= 0)
+
+    checkCellArrays(original, dca, fillSources(bad), expectedFeatureIds);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int runErodeDilate(unsigned int direction, const std::vector<int64_t>& sources, const std::vector<int32_t>& featureIds, const std::vector<int32_t>& expectedFeatureIds)
+  {
+    DataContainerArray::Pointer dca = createVolume(featureIds);
+    AttributeMatrix::Pointer original = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttrMatName)->deepCopy(false);
+
+    AbstractFilter::Pointer filter = createFilter(dca, "ErodeDilateBadData");
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    setProperty(filter, "Direction", direction);
+    setProperty(filter, "NumIterations", 1);
+    setProperty(filter, "XDirOn", true);
+    setProperty(filter, "YDirOn", true);
+    setProperty(filter, "ZDirOn", true);
+    setProperty(filter, "FeatureIdsArrayPath", pathVariant(k_CellAttrMatName, k_FeatureIdsName));
+    setProperty(filter, "IgnoredDataArrayPaths", ignoredPathsVariant());
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCode() >= 0)
+
+    checkCellArrays(original, dca, sources, expectedFeatureIds);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestDilateBadData()
+  {
+    std::vector<bool> bad;
+    std::vector<int32_t> featureIds = badDataFeatureIds(bad);
+    return runErodeDilate(1, fillSources(bad), featureIds, slabFeatureIds());
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestErodeBadData()
+  {
+    std::vector<bool> bad;
+    std::vector<int32_t> featureIds = badDataFeatureIds(bad);
+    std::vector<int64_t> sources = erodeSources(bad);
+    std::vector<int32_t> expectedFeatureIds = featureIds;
+    for(size_t i = 0; i < sources.size(); i++)
+    {
+      if(sources[i] != k_KeepTuple)
+      {
+        expectedFeatureIds[i] = 0;
+      }
+    }
+    return runErodeDilate(0, sources, featureIds, expectedFeatureIds);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestMinSize())
+    DREAM3D_REGISTER_TEST(TestMinNeighbors())
+    DREAM3D_REGISTER_TEST(TestFillBadData())
+    DREAM3D_REGISTER_TEST(TestDilateBadData())
+    DREAM3D_REGISTER_TEST(TestErodeBadData())
+  }
+
+public:
+  CleanupFiltersTest(const CleanupFiltersTest&) = delete;            // Copy Constructor Not Implemented
+  CleanupFiltersTest(CleanupFiltersTest&&) = delete;                 // Move Constructor Not Implemented
+  CleanupFiltersTest& operator=(const CleanupFiltersTest&) = delete; // Copy Assignment Not Implemented
+  CleanupFiltersTest& operator=(CleanupFiltersTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -37,7 +37,6 @@
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
-#include "SIMPLib/Common/TemplateHelpers.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -46,119 +45,13 @@
 #include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "Common/TupleIndexMap.hpp"
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/task_group.h>
-#include <tbb/tick_count.h>
-#endif
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-template <typename T>
-void initializeArrayValues(IDataArray::Pointer p, size_t index)
-{
-
-  typename DataArray<T>::Pointer ptr = std::dynamic_pointer_cast<DataArray<T>>(p);
-  T var = static_cast<T>(0);
-  ptr->initializeTuple(index, &var);
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-class AlignSectionsTransferDataImpl
-{
-public:
-  AlignSectionsTransferDataImpl() = delete;
-  AlignSectionsTransferDataImpl(const AlignSectionsTransferDataImpl&) = default; // Copy Constructor Default Implemented
-  AlignSectionsTransferDataImpl(AlignSectionsTransferDataImpl&&) = default;      // Move Constructor Default Implemented
-
-  AlignSectionsTransferDataImpl(AlignSections* filter, size_t* dims, const std::vector<int64_t>& xshifts, const std::vector<int64_t>& yshifts, IDataArray::Pointer dataArrayPtr)
-  : m_Filter(filter)
-  , m_Dims(dims)
-  , m_xshifts(xshifts)
-  , m_yshifts(yshifts)
-  , m_DataArrayPtr(dataArrayPtr)
-  {
-  }
-
-  ~AlignSectionsTransferDataImpl() = default;
-
-  AlignSectionsTransferDataImpl& operator=(const AlignSectionsTransferDataImpl&) = delete; // Copy Assignment Not Implemented
-  AlignSectionsTransferDataImpl& operator=(AlignSectionsTransferDataImpl&&) = delete;      // Move Assignment Not Implemented
-
-  void operator()() const
-  {
-    size_t progIncrement = m_Dims[2] / 50;
-    size_t prog = 1;
-    size_t slice = 0;
-
-    for(size_t i = 1; i < m_Dims[2]; i++)
-    {
-      if(i > prog)
-      {
-        prog = prog + progIncrement;
-        m_Filter->updateProgress(progIncrement);
-      }
-      if(m_Filter->getCancel())
-      {
-        return;
-      }
-      slice = (m_Dims[2] - 1) - i;
-      for(size_t l = 0; l < m_Dims[1]; l++)
-      {
-        for(size_t n = 0; n < m_Dims[0]; n++)
-        {
-          int64_t xspot = 0, yspot = 0;
-          int64_t newPosition = 0;
-          int64_t currentPosition = 0;
-          if(m_yshifts[i] >= 0)
-          {
-            yspot = static_cast<int64_t>(l);
-          }
-          else if(m_yshifts[i] < 0)
-          {
-            yspot = static_cast<int64_t>(m_Dims[1]) - 1 - static_cast<int64_t>(l);
-          }
-          if(m_xshifts[i] >= 0)
-          {
-            xspot = static_cast<int64_t>(n);
-          }
-          else if(m_xshifts[i] < 0)
-          {
-            xspot = static_cast<int64_t>(m_Dims[0]) - 1 - static_cast<int64_t>(n);
-          }
-          newPosition = (slice * m_Dims[0] * m_Dims[1]) + (yspot * m_Dims[0]) + xspot;
-          currentPosition = (slice * m_Dims[0] * m_Dims[1]) + ((yspot + m_yshifts[i]) * m_Dims[0]) + (xspot + m_xshifts[i]);
-          if((yspot + m_yshifts[i]) >= 0 && (yspot + m_yshifts[i]) <= static_cast<int64_t>(m_Dims[1]) - 1 && (xspot + m_xshifts[i]) >= 0 &&
-             (xspot + m_xshifts[i]) <= static_cast<int64_t>(m_Dims[0]) - 1)
-          {
-            m_DataArrayPtr->copyTuple(static_cast<size_t>(currentPosition), static_cast<size_t>(newPosition));
-          }
-          if((yspot + m_yshifts[i]) < 0 || (yspot + m_yshifts[i]) > static_cast<int64_t>(m_Dims[1] - 1) || (xspot + m_xshifts[i]) < 0 || (xspot + m_xshifts[i]) > static_cast<int64_t>(m_Dims[0]) - 1)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(m_Filter, initializeArrayValues, m_DataArrayPtr, m_DataArrayPtr, newPosition)
-          }
-        }
-      }
-    }
-  }
-
-private:
-  AlignSections* m_Filter = nullptr;
-  size_t* m_Dims = nullptr;
-  std::vector<int64_t> m_xshifts;
-  std::vector<int64_t> m_yshifts;
-  IDataArray::Pointer m_DataArrayPtr;
-};
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -237,17 +130,6 @@ void AlignSections::find_shifts(std::vector<int64_t>& xshifts, std::vector<int64
 {
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void AlignSections::updateProgress(size_t p)
-{
-  m_Progress += p;
-  int32_t progressInt = static_cast<int>((static_cast<float>(m_Progress) / static_cast<float>(m_TotalProgress)) * 100.0f);
-  QString ss = QObject::tr("Transferring Cell Data %1%").arg(progressInt);
-  notifyStatusMessage(ss);
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -261,9 +143,6 @@ void AlignSections::execute()
     return;
   }
 
-  m_Progress = 0;
-  m_TotalProgress = 0;
-
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   SizeVec3Type dims = m->getGeometryAs<ImageGeom>()->getDimensions();
@@ -273,93 +152,55 @@ void AlignSections::execute()
 
   find_shifts(xshifts, yshifts);
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  // The idea for this parallel section is to parallelize over each Data Array that
-  // will need it's data adjusted. This should go faster than before by about 2x.
-  // Better speed up could be achieved if we had better data locality.
-
-  std::shared_ptr<tbb::task_group> taskGroup(new tbb::task_group);
   QList<QString> voxelArrayNames = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayNames();
   for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
   {
     voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
   }
-  m_TotalProgress = voxelArrayNames.size() * dims[2]; // Total number of slices to update
-  // Create all the tasks
-  for(const auto& arrayName : voxelArrayNames)
-  {
-    IDataArray::Pointer dataArrayPtr = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(arrayName);
-    taskGroup->run(AlignSectionsTransferDataImpl(this, dims.data(), xshifts, yshifts, dataArrayPtr));
-  }
-  // Wait for them to complete.
-  taskGroup->wait();
-#else
 
-  QList<QString> voxelArrayNames = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayNames();
-  size_t progIncrement = dims[2] / 100;
-  size_t prog = 1;
-  size_t progressInt = 0;
-  size_t slice = 0;
-
-  for(size_t i = 1; i < dims[2]; i++)
-  {
-    if(i > prog)
-    {
-      progressInt = static_cast<int>((static_cast<float>(i) / static_cast<float>(dims[2])) * 100.0f);
-      QString ss = QObject::tr("Transferring Cell Data %1%").arg(progressInt);
-      notifyStatusMessage(ss);
-      prog = prog + progIncrement;
-    }
-    if(getCancel())
+  // Record where every shifted Cell takes its value from (or that it falls off the slice and is zeroed),
+  // then move all of the Cell arrays in one pass each.
+  TupleIndexMap indexMap(dims[0] * dims[1] * dims[2]);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1ULL, dims[2]);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      return;
-    }
-    slice = (dims[2] - 1) - i;
-    for(size_t l = 0; l < dims[1]; l++)
-    {
-      for(size_t n = 0; n < dims[0]; n++)
+      if(getCancel())
       {
-        int64_t xspot = 0, yspot = 0;
-        int64_t newPosition = 0;
-        int64_t currentPosition = 0;
-        if(yshifts[i] >= 0)
-        {
-          yspot = static_cast<int64_t>(l);
-        }
-        else if(yshifts[i] < 0)
-        {
-          yspot = static_cast<int64_t>(dims[1]) - 1 - static_cast<int64_t>(l);
-        }
-        if(xshifts[i] >= 0)
-        {
-          xspot = static_cast<int64_t>(n);
-        }
-        else if(xshifts[i] < 0)
-        {
-          xspot = static_cast<int64_t>(dims[0]) - 1 - static_cast<int64_t>(n);
-        }
-        newPosition = (slice * dims[0] * dims[1]) + (yspot * dims[0]) + xspot;
-        currentPosition = (slice * dims[0] * dims[1]) + ((yspot + yshifts[i]) * dims[0]) + (xspot + xshifts[i]);
-        if((yspot + yshifts[i]) >= 0 && (yspot + yshifts[i]) <= static_cast<int64_t>(dims[1]) - 1 && (xspot + xshifts[i]) >= 0 && (xspot + xshifts[i]) <= static_cast<int64_t>(dims[0]) - 1)
+        return;
+      }
+      if(xshifts[i] == 0 && yshifts[i] == 0)
+      {
+        continue;
+      }
+      const size_t slice = (dims[2] - 1) - i;
+      for(size_t l = 0; l < dims[1]; l++)
+      {
+        for(size_t n = 0; n < dims[0]; n++)
         {
-          for(const auto& arrayName : voxelArrayNames)
+          const int64_t yspot = static_cast<int64_t>(l);
+          const int64_t xspot = static_cast<int64_t>(n);
+          const int64_t newPosition = (slice * dims[0] * dims[1]) + (yspot * dims[0]) + xspot;
+          const int64_t currentPosition = (slice * dims[0] * dims[1]) + ((yspot + yshifts[i]) * dims[0]) + (xspot + xshifts[i]);
+          if((yspot + yshifts[i]) >= 0 && (yspot + yshifts[i]) <= static_cast<int64_t>(dims[1]) - 1 && (xspot + xshifts[i]) >= 0 && (xspot + xshifts[i]) <= static_cast<int64_t>(dims[0]) - 1)
           {
-            IDataArray::Pointer p = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(arrayName);
-            p->copyTuple(static_cast<size_t>(currentPosition), static_cast<size_t>(newPosition));
+            indexMap.copyTuple(static_cast<size_t>(currentPosition), static_cast<size_t>(newPosition));
           }
-        }
-        if((yspot + yshifts[i]) < 0 || (yspot + yshifts[i]) > static_cast<int64_t>(dims[1] - 1) || (xspot + xshifts[i]) < 0 || (xspot + xshifts[i]) > static_cast<int64_t>(dims[0]) - 1)
-        {
-          for(const auto& arrayName : voxelArrayNames)
+          else
           {
-            IDataArray::Pointer p = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(arrayName);
-            EXECUTE_FUNCTION_TEMPLATE(this, initializeArrayValues, p, p, newPosition)
+            indexMap.zeroTuple(static_cast<size_t>(newPosition));
           }
         }
       }
     }
+  });
+  if(getCancel())
+  {
+    return;
   }
-#endif
+
+  indexMap.apply(m->getAttributeMatrix(getCellAttributeMatrixName()), voxelArrayNames, this);
 }
 
 // -----------------------------------------------------------------------------
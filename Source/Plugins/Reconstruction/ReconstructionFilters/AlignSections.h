@@ -147,8 +147,6 @@ public:
   QVector<DataArrayPath> getIgnoredDataArrayPaths() const;
   Q_PROPERTY(QVector<DataArrayPath> IgnoredDataArrayPaths READ getIgnoredDataArrayPaths WRITE setIgnoredDataArrayPaths)
 
-  void updateProgress(size_t p);
-
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -235,9 +233,6 @@ private:
   QString m_AlignmentShiftFileName = {""};
   QVector<DataArrayPath> m_IgnoredDataArrayPaths = {};
 
-  size_t m_Progress = 0;
-  size_t m_TotalProgress = 0;
-
 public:
   AlignSections(const AlignSections&) = delete;            // Copy Constructor Not Implemented
   AlignSections(AlignSections&&) = delete;                 // Move Constructor Not Implemented
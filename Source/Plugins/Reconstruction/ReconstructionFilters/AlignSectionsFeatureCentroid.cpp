@@ -36,6 +36,7 @@
 
 #include <cmath>
 #include <fstream>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -48,6 +49,7 @@
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
@@ -167,38 +169,41 @@ void AlignSectionsFeatureCentroid::find_shifts(std::vector<int64_t>& xshifts, st
 
   size_t newxshift = 0;
   size_t newyshift = 0;
-  size_t count = 0;
   size_t slice = 0;
-  size_t point = 0;
   FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
   std::vector<float> xCentroid(dims[2], 0.0f);
   std::vector<float> yCentroid(dims[2], 0.0f);
 
-  for(size_t iter = 0; iter < dims[2]; iter++)
-  {
-    count = 0;
-    xCentroid[iter] = 0;
-    yCentroid[iter] = 0;
-
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg((static_cast<double>(iter) / dims[2]) * 100);
-    notifyStatusMessage(ss);
-    slice = static_cast<size_t>((dims[2] - 1) - iter);
-    for(size_t l = 0; l < dims[1]; l++)
+  notifyStatusMessage("Aligning Sections || Determining Shifts");
+
+  // Each slice centroid is independent, so the slices are summed concurrently
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, dims[2]);
+  dataAlg.setGrain(1);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t iter = range.min(); iter < range.max(); iter++)
     {
-      for(size_t n = 0; n < dims[0]; n++)
+      size_t count = 0;
+      float xSum = 0.0f;
+      float ySum = 0.0f;
+      const size_t sliceIndex = static_cast<size_t>((dims[2] - 1) - iter);
+      for(size_t l = 0; l < dims[1]; l++)
       {
-        point = ((slice)*dims[0] * dims[1]) + (l * dims[0]) + n;
-        if(m_GoodVoxels[point])
+        for(size_t n = 0; n < dims[0]; n++)
         {
-          xCentroid[iter] = xCentroid[iter] + (static_cast<float>(n) * spacing[0]);
-          yCentroid[iter] = yCentroid[iter] + (static_cast<float>(l) * spacing[1]);
-          count++;
+          const size_t point = ((sliceIndex)*dims[0] * dims[1]) + (l * dims[0]) + n;
+          if(m_GoodVoxels[point])
+          {
+            xSum = xSum + (static_cast<float>(n) * spacing[0]);
+            ySum = ySum + (static_cast<float>(l) * spacing[1]);
+            count++;
+          }
         }
       }
+      xCentroid[iter] = xSum / static_cast<float>(count);
+      yCentroid[iter] = ySum / static_cast<float>(count);
     }
-    xCentroid[iter] = xCentroid[iter] / static_cast<float>(count);
-    yCentroid[iter] = yCentroid[iter] / static_cast<float>(count);
-  }
+  });
 
   bool xWarning = false;
   bool yWarning = false;
@@ -35,7 +35,9 @@
 
 #include "AlignSectionsMisorientation.h"
 
+#include <algorithm>
 #include <fstream>
+#include <vector>
 
 #include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
@@ -50,9 +52,9 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
-#include "EbsdLib/Core/Quaternion.hpp"
-#include "EbsdLib/LaueOps/LaueOps.h"
+#include "Common/MisorientationKernel.hpp"
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
@@ -222,142 +224,125 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
       static_cast<int64_t>(udims[2]),
   };
 
-  std::vector<LaueOps::Pointer> m_OrientationOps = LaueOps::GetAllOrientationOps();
-
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-  float w = 0.0f;
-
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-
-  uint32_t phase1 = 0, phase2 = 0;
-  int64_t progInt = 0;
-
-  // Allocate a 2D Array which will be reused from slice to slice
-  BoolArrayType::Pointer misorientsPtr = BoolArrayType::CreateArray(dims[0] * dims[1], std::string("_INTERNAL_USE_ONLY_Misorients"), true);
-  misorientsPtr->initializeWithValue(false);
-  bool* misorients = misorientsPtr->getPointer(0); // Get the raw pointer to use in our calculations for speed.
-
-  int64_t idx = 0; // This will be used to compute the index into the flat array
-  int64_t xIdx = 0;
-  int64_t yIdx = 0;
+  float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_PiOver180D;
+  MisorientationKernel misorientationKernel(m_CrystalStructures, m_CrystalStructuresPtr.lock()->getNumberOfTuples(), misorientationTolerance);
 
   const int64_t halfDim0 = static_cast<int64_t>(dims[0] * 0.5f);
   const int64_t halfDim1 = static_cast<int64_t>(dims[1] * 0.5f);
 
-  // Loop over the Z Direction
-  for(int64_t iter = 1; iter < dims[2]; iter++)
-  {
-    progInt = ((float)iter / dims[2]) * 100.0f;
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(progInt);
-    notifyStatusMessage(ss);
-    if(getCancel())
-    {
-      return;
-    }
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
+  std::vector<int64_t> pairXShifts(dims[2], 0);
+  std::vector<int64_t> pairYShifts(dims[2], 0);
 
-    misorientsPtr->initializeWithValue(false); // Initialize everything to false
+  notifyStatusMessage("Aligning Sections || Determining Shifts");
 
-    float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_PiOver180D;
-    float* currentQuatPtr = nullptr;
+  // The shift between a slice and the one above it only depends on those two slices, so the slice
+  // pairs are searched concurrently and only the running sum of the shifts below is sequential.
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1ULL, static_cast<size_t>(dims[2]));
+  dataAlg.setGrain(1);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    // Marks the shifts that have already been evaluated for the current slice pair; reused from slice to slice
+    std::vector<uint8_t> misorients(dims[0] * dims[1], 0);
 
-    while(newxshift != oldxshift || newyshift != oldyshift)
+    for(size_t iter = range.min(); iter < range.max(); iter++)
     {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
+      if(getCancel())
       {
-        for(int32_t k = -3; k < 4; k++)
+        return;
+      }
+      float mindisorientation = std::numeric_limits<float>::max();
+      const int64_t slice = (dims[2] - 1) - static_cast<int64_t>(iter);
+      int64_t oldxshift = -1;
+      int64_t oldyshift = -1;
+      int64_t newxshift = 0;
+      int64_t newyshift = 0;
+
+      std::fill(misorients.begin(), misorients.end(), 0);
+
+      while(newxshift != oldxshift || newyshift != oldyshift)
+      {
+        oldxshift = newxshift;
+        oldyshift = newyshift;
+        for(int32_t j = -3; j < 4; j++)
         {
-          disorientation = 0.0f;
-          count = 0.0f;
-          xIdx = k + oldxshift + halfDim0;
-          yIdx = j + oldyshift + halfDim1;
-          idx = (dims[0] * yIdx) + xIdx;
-          if(!misorients[idx] && llabs(k + oldxshift) < halfDim0 && llabs(j + oldyshift) < halfDim1)
+          for(int32_t k = -3; k < 4; k++)
           {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
+            float disorientation = 0.0f;
+            float count = 0.0f;
+            int64_t xIdx = k + oldxshift + halfDim0;
+            int64_t yIdx = j + oldyshift + halfDim1;
+            int64_t idx = (dims[0] * yIdx) + xIdx;
+            if(llabs(k + oldxshift) < halfDim0 && llabs(j + oldyshift) < halfDim1 && misorients[idx] == 0)
             {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
+              for(int64_t l = 0; l < dims[1]; l = l + 4)
               {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
+                for(int64_t n = 0; n < dims[0]; n = n + 4)
                 {
-                  count++;
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  if(!m_UseGoodVoxels || (m_GoodVoxels[refposition] && m_GoodVoxels[curposition]))
+                  if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
                   {
-                    w = std::numeric_limits<float>::max();
-                    if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
+                    count++;
+                    const int64_t refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
+                    const int64_t curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
+                    if(!m_UseGoodVoxels || (m_GoodVoxels[refposition] && m_GoodVoxels[curposition]))
                     {
-
-                      currentQuatPtr = m_Quats + refposition * 4;
-                      QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-                      phase1 = m_CrystalStructures[m_CellPhases[refposition]];
-                      currentQuatPtr = m_Quats + curposition * 4;
-                      QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-                      phase2 = m_CrystalStructures[m_CellPhases[curposition]];
-                      if(phase1 == phase2 && phase1 < static_cast<uint32_t>(m_OrientationOps.size()))
+                      bool belowTolerance = false;
+                      if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
                       {
-                        OrientationF axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-                        w = axisAngle[3];
+                        uint32_t phase1 = m_CrystalStructures[m_CellPhases[refposition]];
+                        uint32_t phase2 = m_CrystalStructures[m_CellPhases[curposition]];
+                        if(phase1 == phase2)
+                        {
+                          belowTolerance = misorientationKernel.isBelowTolerance(m_CellPhases[refposition], m_Quats + refposition * 4, m_Quats + curposition * 4);
+                        }
+                      }
+                      if(!belowTolerance)
+                      {
+                        disorientation++;
                       }
                     }
-                    if(w > misorientationTolerance)
-                    {
-                      disorientation++;
-                    }
-                  }
-                  if(m_UseGoodVoxels)
-                  {
-                    if(m_GoodVoxels[refposition] && !m_GoodVoxels[curposition])
-                    {
-                      disorientation++;
-                    }
-                    if(!m_GoodVoxels[refposition] && m_GoodVoxels[curposition])
+                    if(m_UseGoodVoxels)
                     {
-                      disorientation++;
+                      if(m_GoodVoxels[refposition] && !m_GoodVoxels[curposition])
+                      {
+                        disorientation++;
+                      }
+                      if(!m_GoodVoxels[refposition] && m_GoodVoxels[curposition])
+                      {
+                        disorientation++;
+                      }
                     }
                   }
                 }
-                else
-                {
-                }
               }
-            }
-            disorientation = disorientation / count;
-            xIdx = k + oldxshift + halfDim0;
-            yIdx = j + oldyshift + halfDim1;
-            idx = (dims[0] * yIdx) + xIdx;
-            misorients[idx] = true;
-            if(disorientation < mindisorientation || (disorientation == mindisorientation && ((llabs(k + oldxshift) < llabs(newxshift)) || (llabs(j + oldyshift) < llabs(newyshift)))))
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
+              disorientation = disorientation / count;
+              misorients[idx] = 1;
+              if(disorientation < mindisorientation || (disorientation == mindisorientation && ((llabs(k + oldxshift) < llabs(newxshift)) || (llabs(j + oldyshift) < llabs(newyshift)))))
+              {
+                newxshift = k + oldxshift;
+                newyshift = j + oldyshift;
+                mindisorientation = disorientation;
+              }
             }
           }
         }
       }
+      pairXShifts[iter] = newxshift;
+      pairYShifts[iter] = newyshift;
     }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+  });
+  if(getCancel())
+  {
+    return;
+  }
+
+  for(int64_t iter = 1; iter < dims[2]; iter++)
+  {
+    const int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + pairXShifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + pairYShifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
+      outFile << slice << "	" << slice + 1 << "	" << pairXShifts[iter] << "	" << pairYShifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
     }
   }
   if(getWriteAlignmentShifts())
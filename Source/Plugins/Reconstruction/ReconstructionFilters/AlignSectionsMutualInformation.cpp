@@ -34,7 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AlignSectionsMutualInformation.h"
 
+#include <algorithm>
 #include <fstream>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -49,6 +51,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/LaueOps/LaueOps.h"
 
@@ -230,180 +233,159 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
       static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  float** mutualinfo12 = nullptr;
-  float* mutualinfo1 = nullptr;
-  float* mutualinfo2 = nullptr;
-  int32_t featurecount1 = 0, featurecount2 = 0;
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-
-  int32_t refgnum = 0, curgnum = 0;
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-
   form_features_sections();
 
-  std::vector<std::vector<float>> misorients;
-  misorients.resize(dims[0]);
-  for(int64_t a = 0; a < dims[0]; a++)
-  {
-    misorients[a].assign(dims[1], 0.0f);
-  }
+  std::vector<int64_t> pairXShifts(dims[2], 0);
+  std::vector<int64_t> pairYShifts(dims[2], 0);
 
-  for(int64_t iter = 1; iter < dims[2]; iter++)
-  {
-    float prog = ((float)iter / dims[2]) * 100;
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(QString::number(prog, 'f', 0));
-    notifyStatusMessage(ss);
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    featurecount1 = featurecounts[slice];
-    featurecount2 = featurecounts[slice + 1];
-    mutualinfo12 = new float*[featurecount1];
-    mutualinfo1 = new float[featurecount1];
-    mutualinfo2 = new float[featurecount2];
-
-    for(int32_t a = 0; a < featurecount1; a++)
-    {
-      mutualinfo1[a] = 0.0f;
-      mutualinfo12[a] = new float[featurecount2];
-      for(int32_t b = 0; b < featurecount2; b++)
-      {
-        mutualinfo12[a][b] = 0.0f;
-        mutualinfo2[b] = 0.0f;
-      }
-    }
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for(int64_t a = 0; a < dims[0]; a++)
+  notifyStatusMessage("Aligning Sections || Determining Shifts");
+
+  // The shift between a slice and the one above it only depends on those two slices, so the slice
+  // pairs are searched concurrently and only the running sum of the shifts below is sequential.
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1ULL, static_cast<size_t>(dims[2]));
+  dataAlg.setGrain(1);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    // Caches the score of every shift already evaluated for the current slice pair; reused from slice to slice
+    std::vector<float> misorients(dims[0] * dims[1], 0.0f);
+    std::vector<float> mutualinfo12;
+    std::vector<float> mutualinfo1;
+    std::vector<float> mutualinfo2;
+
+    for(size_t iter = range.min(); iter < range.max(); iter++)
     {
-      for(int64_t b = 0; b < dims[1]; b++)
+      if(getCancel())
       {
-        misorients[a][b] = 0;
+        return;
       }
-    }
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
+      float mindisorientation = std::numeric_limits<float>::max();
+      const int64_t slice = (dims[2] - 1) - static_cast<int64_t>(iter);
+      const int32_t featurecount1 = featurecounts[slice];
+      const int32_t featurecount2 = featurecounts[slice + 1];
+      mutualinfo12.assign(static_cast<size_t>(featurecount1) * featurecount2, 0.0f);
+      mutualinfo1.assign(featurecount1, 0.0f);
+      mutualinfo2.assign(featurecount2, 0.0f);
+
+      int64_t oldxshift = -1;
+      int64_t oldyshift = -1;
+      int64_t newxshift = 0;
+      int64_t newyshift = 0;
+      std::fill(misorients.begin(), misorients.end(), 0.0f);
+
+      while(newxshift != oldxshift || newyshift != oldyshift)
       {
-        for(int32_t k = -3; k < 4; k++)
+        oldxshift = newxshift;
+        oldyshift = newyshift;
+        for(int32_t j = -3; j < 4; j++)
         {
-          disorientation = 0;
-          count = 0;
-          if(misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] == 0 && llabs(k + oldxshift) < (dims[0] / 2) && (j + oldyshift) < (dims[1] / 2))
+          for(int32_t k = -3; k < 4; k++)
           {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
+            float disorientation = 0.0f;
+            float count = 0.0f;
+            // The search has only ever bounded the y shift from above, so y shifts below -dims[1] / 2 are still
+            // scored but have no slot in the cache and are scored again whenever they come up.
+            const int64_t yCacheIndex = j + oldyshift + dims[1] / 2;
+            const int64_t misorientIndex = (k + oldxshift + dims[0] / 2) * dims[1] + yCacheIndex;
+            if(llabs(k + oldxshift) < (dims[0] / 2) && (j + oldyshift) < (dims[1] / 2) && (yCacheIndex < 0 || misorients[misorientIndex] == 0))
             {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
+              for(int64_t l = 0; l < dims[1]; l = l + 4)
               {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
+                for(int64_t n = 0; n < dims[0]; n = n + 4)
                 {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  refgnum = miFeatureIds[refposition];
-                  curgnum = miFeatureIds[curposition];
-                  if(curgnum >= 0 && refgnum >= 0)
+                  if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
                   {
-                    mutualinfo12[curgnum][refgnum]++;
-                    mutualinfo1[curgnum]++;
-                    mutualinfo2[refgnum]++;
-                    count++;
+                    const int64_t refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
+                    const int64_t curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
+                    const int32_t refgnum = miFeatureIds[refposition];
+                    const int32_t curgnum = miFeatureIds[curposition];
+                    if(curgnum >= 0 && refgnum >= 0)
+                    {
+                      mutualinfo12[curgnum * featurecount2 + refgnum]++;
+                      mutualinfo1[curgnum]++;
+                      mutualinfo2[refgnum]++;
+                      count++;
+                    }
+                  }
+                  else
+                  {
+                    mutualinfo12[0]++;
+                    mutualinfo1[0]++;
+                    mutualinfo2[0]++;
                   }
                 }
-                else
-                {
-                  mutualinfo12[0][0]++;
-                  mutualinfo1[0]++;
-                  mutualinfo2[0]++;
-                }
-              }
-            }
-            float ha = 0.0f;
-            float hb = 0.0f;
-            float hab = 0.0f;
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              mutualinfo1[b] = mutualinfo1[b] / count;
-              if(mutualinfo1[b] != 0)
-              {
-                ha = ha + mutualinfo1[b] * logf(mutualinfo1[b]);
               }
-            }
-            for(int32_t c = 0; c < featurecount2; c++)
-            {
-              mutualinfo2[c] = mutualinfo2[c] / float(count);
-              if(mutualinfo2[c] != 0)
+              float ha = 0.0f;
+              float hb = 0.0f;
+              float hab = 0.0f;
+              for(int32_t b = 0; b < featurecount1; b++)
               {
-                hb = hb + mutualinfo2[c] * logf(mutualinfo2[c]);
+                mutualinfo1[b] = mutualinfo1[b] / count;
+                if(mutualinfo1[b] != 0)
+                {
+                  ha = ha + mutualinfo1[b] * logf(mutualinfo1[b]);
+                }
               }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
               for(int32_t c = 0; c < featurecount2; c++)
               {
-                mutualinfo12[b][c] = mutualinfo12[b][c] / count;
-                if(mutualinfo12[b][c] != 0)
+                mutualinfo2[c] = mutualinfo2[c] / float(count);
+                if(mutualinfo2[c] != 0)
                 {
-                  hab = hab + mutualinfo12[b][c] * logf(mutualinfo12[b][c]);
+                  hb = hb + mutualinfo2[c] * logf(mutualinfo2[c]);
                 }
-                float value = 0.0f;
-                if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
-                {
-                  value = (mutualinfo12[b][c] / (mutualinfo1[b] * mutualinfo2[c]));
-                }
-                if(value != 0)
+              }
+              for(int32_t b = 0; b < featurecount1; b++)
+              {
+                for(int32_t c = 0; c < featurecount2; c++)
                 {
-                  disorientation = disorientation + (mutualinfo12[b][c] * logf(value));
+                  float& joint = mutualinfo12[b * featurecount2 + c];
+                  joint = joint / count;
+                  if(joint != 0)
+                  {
+                    hab = hab + joint * logf(joint);
+                  }
+                  float value = 0.0f;
+                  if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
+                  {
+                    value = (joint / (mutualinfo1[b] * mutualinfo2[c]));
+                  }
+                  if(value != 0)
+                  {
+                    disorientation = disorientation + (joint * logf(value));
+                  }
                 }
               }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
+              std::fill(mutualinfo12.begin(), mutualinfo12.end(), 0.0f);
+              std::fill(mutualinfo1.begin(), mutualinfo1.end(), 0.0f);
+              std::fill(mutualinfo2.begin(), mutualinfo2.end(), 0.0f);
+              disorientation = 1.0f / disorientation;
+              if(yCacheIndex >= 0)
               {
-                mutualinfo12[b][c] = 0.0f;
-                mutualinfo1[b] = 0.0f;
-                mutualinfo2[c] = 0.0f;
+                misorients[misorientIndex] = disorientation;
+              }
+              if(disorientation < mindisorientation)
+              {
+                newxshift = k + oldxshift;
+                newyshift = j + oldyshift;
+                mindisorientation = disorientation;
               }
-            }
-            disorientation = 1.0f / disorientation;
-            misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] = disorientation;
-            if(disorientation < mindisorientation)
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
             }
           }
         }
       }
+      pairXShifts[iter] = newxshift;
+      pairYShifts[iter] = newyshift;
     }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+  });
+
+  for(int64_t iter = 1; iter < dims[2] && !getCancel(); iter++)
+  {
+    const int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + pairXShifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + pairYShifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
-    }
-    delete[] mutualinfo1;
-    delete[] mutualinfo2;
-    for(int32_t i = 0; i < featurecount1; i++)
-    {
-      delete mutualinfo12[i];
+      outFile << slice << "	" << slice + 1 << "	" << pairXShifts[iter] << "	" << pairYShifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
     }
-    delete[] mutualinfo12;
-    mutualinfo1 = nullptr;
-    mutualinfo2 = nullptr;
-    mutualinfo12 = nullptr;
   }
 
   m->getAttributeMatrix(getCellAttributeMatrixName())->removeAttributeArray(SIMPL::CellData::FeatureIds);
@@ -44,6 +44,7 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -106,6 +107,7 @@ void CAxisSegmentFeatures::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("C-Axis Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Category::Parameter, CAxisSegmentFeatures));
   std::vector<QString> linkedProps = {"GoodVoxelsArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Category::Parameter, CAxisSegmentFeatures, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Labeling", UseParallelLabeling, FilterParameter::Category::Parameter, CAxisSegmentFeatures));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -148,6 +150,7 @@ void CAxisSegmentFeatures::readFilterParameters(AbstractFilterParametersReader*
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseParallelLabeling(reader->readValue("UseParallelLabeling", getUseParallelLabeling()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
   reader->closeFilterGroup();
 }
@@ -311,8 +314,6 @@ int64_t CAxisSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
   // start with the next voxel after the last seed
@@ -321,7 +322,7 @@ int64_t CAxisSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   {
     if(m_FeatureIds[randpoint] == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
     {
-      if((!m_UseGoodVoxels || m_GoodVoxels[randpoint]) && m_CellPhases[randpoint] > 0)
+      if(isSeedCandidate(randpoint))
       {
         seed = randpoint;
       }
@@ -338,9 +339,7 @@ int64_t CAxisSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
+    ensureFeatureCapacity(gnum + 1);
   }
   return seed;
 }
@@ -350,8 +349,31 @@ int64_t CAxisSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 // -----------------------------------------------------------------------------
 bool CAxisSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
 {
-  bool group = false;
-  float w = std::numeric_limits<float>::max();
+  if(m_FeatureIds[neighborpoint] == 0 && isSeedCandidate(neighborpoint) && areNeighborsSimilar(referencepoint, neighborpoint))
+  {
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CAxisSegmentFeatures::isSeedCandidate(int64_t point) const
+{
+  return (!m_UseGoodVoxels || m_GoodVoxels[point]) && m_CellPhases[point] > 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CAxisSegmentFeatures::areNeighborsSimilar(int64_t referencepoint, int64_t neighborpoint) const
+{
+  if(m_CellPhases[referencepoint] != m_CellPhases[neighborpoint])
+  {
+    return false;
+  }
 
   float g1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
   float g2[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
@@ -360,42 +382,50 @@ bool CAxisSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t nei
   float caxis[3] = {0.0f, 0.0f, 1.0f};
   float c1[3] = {0.0f, 0.0f, 0.0f};
   float c2[3] = {0.0f, 0.0f, 0.0f};
-  float* currentQuatPtr = nullptr;
-  if(m_FeatureIds[neighborpoint] == 0 && (!m_UseGoodVoxels || m_GoodVoxels[neighborpoint]))
-  {
-    currentQuatPtr = m_Quats + referencepoint * 4;
-    QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-    currentQuatPtr = m_Quats + neighborpoint * 4;
-    QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
 
-    if(m_CellPhases[referencepoint] == m_CellPhases[neighborpoint])
-    {
-      OrientationTransformation::qu2om<QuatF, Orientation<float>>(q1).toGMatrix(g1);
-      OrientationTransformation::qu2om<QuatF, Orientation<float>>(q2).toGMatrix(g2);
-
-      // transpose the g matricies so when caxis is multiplied by it
-      // it will give the sample direction that the caxis is along
-      MatrixMath::Transpose3x3(g1, g1t);
-      MatrixMath::Transpose3x3(g2, g2t);
-      MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
-      MatrixMath::Multiply3x3with3x1(g2t, caxis, c2);
-
-      // normalize so that the dot product can be taken below without
-      // dividing by the magnitudes (they would be 1)
-      MatrixMath::Normalize3x1(c1);
-      MatrixMath::Normalize3x1(c2);
-
-      // Validate value of w falls between [-1, 1] to ensure that acos returns a valid value
-      w = std::clamp(((c1[0] * c2[0]) + (c1[1] * c2[1]) + (c1[2] * c2[2])), -1.0F, 1.0F);
-      w = acosf(w);
-      if(w <= m_MisoTolerance || (SIMPLib::Constants::k_PiD - w) <= m_MisoTolerance)
-      {
-        group = true;
-        m_FeatureIds[neighborpoint] = gnum;
-      }
-    }
-  }
-  return group;
+  const float* currentQuatPtr = m_Quats + referencepoint * 4;
+  QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
+  currentQuatPtr = m_Quats + neighborpoint * 4;
+  QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
+
+  OrientationTransformation::qu2om<QuatF, Orientation<float>>(q1).toGMatrix(g1);
+  OrientationTransformation::qu2om<QuatF, Orientation<float>>(q2).toGMatrix(g2);
+
+  // transpose the g matricies so when caxis is multiplied by it
+  // it will give the sample direction that the caxis is along
+  MatrixMath::Transpose3x3(g1, g1t);
+  MatrixMath::Transpose3x3(g2, g2t);
+  MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
+  MatrixMath::Multiply3x3with3x1(g2t, caxis, c2);
+
+  // normalize so that the dot product can be taken below without
+  // dividing by the magnitudes (they would be 1)
+  MatrixMath::Normalize3x1(c1);
+  MatrixMath::Normalize3x1(c2);
+
+  // Validate value of w falls between [-1, 1] to ensure that acos returns a valid value
+  float w = std::clamp(((c1[0] * c2[0]) + (c1[1] * c2[1]) + (c1[2] * c2[2])), -1.0F, 1.0F);
+  w = acosf(w);
+  return w <= m_MisoTolerance || (SIMPLib::Constants::k_PiD - w) <= m_MisoTolerance;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CAxisSegmentFeatures::resizeFeatureAttributeMatrix(size_t numTuples)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  std::vector<size_t> tDims(1, numTuples);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Int32ArrayType::Pointer CAxisSegmentFeatures::getFeatureIdsArray() const
+{
+  return m_FeatureIdsPtr.lock();
 }
 
 // -----------------------------------------------------------------------------
@@ -35,16 +35,16 @@
 
 #include "EBSDSegmentFeatures.h"
 
-#include <chrono>
-
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -52,11 +52,16 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
-#include "EbsdLib/LaueOps/LaueOps.h"
-
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+namespace
+{
+// Random stream of this filter, see PhiloxRandom::StreamId()
+constexpr uint64_t k_RandomStreamFilterId = 4;
+constexpr uint64_t k_RandomizeFeatureIdsStream = 0;
+} // namespace
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -69,10 +74,7 @@ enum createdPathID : RenameDataPath::DataID_t
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-EBSDSegmentFeatures::EBSDSegmentFeatures()
-{
-  m_OrientationOps = LaueOps::GetAllOrientationOps();
-}
+EBSDSegmentFeatures::EBSDSegmentFeatures() = default;
 
 // -----------------------------------------------------------------------------
 //
@@ -89,6 +91,10 @@ void EBSDSegmentFeatures::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Category::Parameter, EBSDSegmentFeatures));
   std::vector<QString> linkedProps = {"GoodVoxelsArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Category::Parameter, EBSDSegmentFeatures, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Labeling", UseParallelLabeling, FilterParameter::Category::Parameter, EBSDSegmentFeatures));
+  std::vector<QString> seedProps = {"SeedValue"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Fixed Seed", UseSeed, FilterParameter::Category::Parameter, EBSDSegmentFeatures, seedProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Seed Value", SeedValue, FilterParameter::Category::Parameter, EBSDSegmentFeatures));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -131,6 +137,9 @@ void EBSDSegmentFeatures::readFilterParameters(AbstractFilterParametersReader* r
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseParallelLabeling(reader->readValue("UseParallelLabeling", getUseParallelLabeling()));
+  setUseSeed(reader->readValue("UseSeed", getUseSeed()));
+  setSeedValue(reader->readValue("SeedValue", getSeedValue()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
   reader->closeFilterGroup();
 }
@@ -269,7 +278,7 @@ void EBSDSegmentFeatures::randomizeFeatureIds(int64_t totalPoints, int64_t total
   //--- Shuffle elements by randomly exchanging each with one other.
   for(int64_t i = 1; i < totalFeatures; i++)
   {
-    r = m_Distribution(m_Generator); // Random remaining position.
+    r = m_RangeMin + static_cast<int64_t>(m_Generator.genrand_index(static_cast<uint64_t>(m_RangeMax - m_RangeMin + 1))); // Random remaining position.
     if(r >= totalFeatures)
     {
       continue;
@@ -293,8 +302,6 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
   // start with the next voxel after the last seed
@@ -303,7 +310,7 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   {
     if(m_FeatureIds[randpoint] == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
     {
-      if((!m_UseGoodVoxels || m_GoodVoxels[randpoint]) && m_CellPhases[randpoint] > 0)
+      if(isSeedCandidate(randpoint))
       {
         seed = randpoint;
       }
@@ -320,9 +327,7 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
+    ensureFeatureCapacity(gnum + 1);
   }
   return seed;
 }
@@ -332,38 +337,52 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 // -----------------------------------------------------------------------------
 bool EBSDSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
 {
-  bool group = false;
-
-  // Get the phases for each voxel
-  int32_t phase1 = m_CrystalStructures[m_CellPhases[referencepoint]];
-  int32_t phase2 = m_CrystalStructures[m_CellPhases[neighborpoint]];
-  // If either of the phases is 999 then we bail out now.
-  if(phase1 >= m_OrientationOps.size() || phase2 >= m_OrientationOps.size())
+  if(m_FeatureIds[neighborpoint] == 0 && isSeedCandidate(neighborpoint) && areNeighborsSimilar(referencepoint, neighborpoint))
   {
-    return group;
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
   }
-  float* currentQuatPtr = nullptr;
+  return false;
+}
 
-  if(m_FeatureIds[neighborpoint] == 0 && (!m_UseGoodVoxels || m_GoodVoxels[neighborpoint]))
-  {
-    float w = std::numeric_limits<float>::max();
-    currentQuatPtr = m_Quats + referencepoint * 4;
-    QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-    currentQuatPtr = m_Quats + neighborpoint * 4;
-    QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EBSDSegmentFeatures::isSeedCandidate(int64_t point) const
+{
+  return (!m_UseGoodVoxels || m_GoodVoxels[point]) && m_CellPhases[point] > 0;
+}
 
-    if(m_CellPhases[referencepoint] == m_CellPhases[neighborpoint])
-    {
-      OrientationF axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-      w = axisAngle[3];
-    }
-    if(w < m_MisoTolerance)
-    {
-      group = true;
-      m_FeatureIds[neighborpoint] = gnum;
-    }
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EBSDSegmentFeatures::areNeighborsSimilar(int64_t referencepoint, int64_t neighborpoint) const
+{
+  if(m_CellPhases[referencepoint] != m_CellPhases[neighborpoint])
+  {
+    return false;
   }
-  return group;
+  // Unknown crystal structures (999) are rejected by the kernel
+  return m_MisorientationKernel.isBelowTolerance(m_CellPhases[referencepoint], m_Quats + referencepoint * 4, m_Quats + neighborpoint * 4);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EBSDSegmentFeatures::resizeFeatureAttributeMatrix(size_t numTuples)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  std::vector<size_t> tDims(1, numTuples);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Int32ArrayType::Pointer EBSDSegmentFeatures::getFeatureIdsArray() const
+{
+  return m_FeatureIdsPtr.lock();
 }
 
 // -----------------------------------------------------------------------------
@@ -371,9 +390,10 @@ bool EBSDSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neig
 // -----------------------------------------------------------------------------
 void EBSDSegmentFeatures::initializeVoxelSeedGenerator(const int64_t rangeMin, const int64_t rangeMax)
 {
-  std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-  m_Generator.seed(seed);
-  m_Distribution = std::uniform_int_distribution<int64_t>(rangeMin, rangeMax);
+  const uint64_t seed = PhiloxRandom::ResolveSeed(m_UseSeed, static_cast<uint64_t>(m_SeedValue));
+  m_Generator = PhiloxRandom(seed, PhiloxRandom::StreamId(k_RandomStreamFilterId, k_RandomizeFeatureIdsStream, 0));
+  m_RangeMin = rangeMin;
+  m_RangeMax = rangeMax;
 }
 
 // -----------------------------------------------------------------------------
@@ -396,6 +416,7 @@ void EBSDSegmentFeatures::execute()
 
   // Convert user defined tolerance to radians.
   m_MisoTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_PiOver180D;
+  m_MisorientationKernel = MisorientationKernel(m_CrystalStructures, m_CrystalStructuresPtr.lock()->getNumberOfTuples(), m_MisoTolerance);
 
   // Generate the random voxel indices that will be used for the seed points to start a new grain growth/agglomeration
   const int64_t rangeMin = 0;
@@ -567,6 +588,30 @@ bool EBSDSegmentFeatures::getUseGoodVoxels() const
   return m_UseGoodVoxels;
 }
 
+// -----------------------------------------------------------------------------
+void EBSDSegmentFeatures::setUseSeed(bool value)
+{
+  m_UseSeed = value;
+}
+
+// -----------------------------------------------------------------------------
+bool EBSDSegmentFeatures::getUseSeed() const
+{
+  return m_UseSeed;
+}
+
+// -----------------------------------------------------------------------------
+void EBSDSegmentFeatures::setSeedValue(int value)
+{
+  m_SeedValue = value;
+}
+
+// -----------------------------------------------------------------------------
+int EBSDSegmentFeatures::getSeedValue() const
+{
+  return m_SeedValue;
+}
+
 // -----------------------------------------------------------------------------
 void EBSDSegmentFeatures::setGoodVoxelsArrayPath(const DataArrayPath& value)
 {
@@ -36,20 +36,18 @@
 #pragma once
 
 #include <memory>
-#include <random>
 #include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 
+#include "Common/MisorientationKernel.hpp"
+#include "Common/PhiloxRandom.hpp"
+
 #include "Reconstruction/ReconstructionDLLExport.h"
 #include "Reconstruction/ReconstructionFilters/SegmentFeatures.h"
 
-class LaueOps;
-using LaueOpsShPtrType = std::shared_ptr<LaueOps>;
-using LaueOpsContainer = std::vector<LaueOpsShPtrType>;
-
 /**
  * @brief The EBSDSegmentFeatures class. See [Filter documentation](@ref ebsdsegmentfeatures) for details.
  */
@@ -65,6 +63,8 @@ class Reconstruction_EXPORT EBSDSegmentFeatures : public SegmentFeatures
   PYB11_PROPERTY(QString CellFeatureAttributeMatrixName READ getCellFeatureAttributeMatrixName WRITE setCellFeatureAttributeMatrixName)
   PYB11_PROPERTY(float MisorientationTolerance READ getMisorientationTolerance WRITE setMisorientationTolerance)
   PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
+  PYB11_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+  PYB11_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
   PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
   PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
   PYB11_PROPERTY(DataArrayPath CrystalStructuresArrayPath READ getCrystalStructuresArrayPath WRITE setCrystalStructuresArrayPath)
@@ -147,6 +147,28 @@ public:
   bool getUseGoodVoxels() const;
   Q_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
 
+  /**
+   * @brief Setter property for UseSeed
+   */
+  void setUseSeed(bool value);
+  /**
+   * @brief Getter property for UseSeed
+   * @return Value of UseSeed
+   */
+  bool getUseSeed() const;
+  Q_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+
+  /**
+   * @brief Setter property for SeedValue
+   */
+  void setSeedValue(int value);
+  /**
+   * @brief Getter property for SeedValue
+   * @return Value of SeedValue
+   */
+  int getSeedValue() const;
+  Q_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
+
   /**
    * @brief Setter property for GoodVoxelsArrayPath
    */
@@ -295,6 +317,26 @@ protected:
    */
   bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum) override;
 
+  /**
+   * @brief isSeedCandidate Reimplemented from @see SegmentFeatures class
+   */
+  bool isSeedCandidate(int64_t point) const override;
+
+  /**
+   * @brief areNeighborsSimilar Reimplemented from @see SegmentFeatures class
+   */
+  bool areNeighborsSimilar(int64_t referencepoint, int64_t neighborpoint) const override;
+
+  /**
+   * @brief resizeFeatureAttributeMatrix Reimplemented from @see SegmentFeatures class
+   */
+  void resizeFeatureAttributeMatrix(size_t numTuples) override;
+
+  /**
+   * @brief getFeatureIdsArray Reimplemented from @see SegmentFeatures class
+   */
+  Int32ArrayType::Pointer getFeatureIdsArray() const override;
+
 private:
   std::weak_ptr<DataArray<float>> m_QuatsPtr;
   float* m_Quats = nullptr;
@@ -313,6 +355,8 @@ private:
   float m_MisorientationTolerance = {5.0f};
   bool m_RandomizeFeatureIds = {true};
   bool m_UseGoodVoxels = {true};
+  bool m_UseSeed = {false};
+  int m_SeedValue = {0};
   DataArrayPath m_GoodVoxelsArrayPath = DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask);
   DataArrayPath m_CellPhasesArrayPath = DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases);
   DataArrayPath m_CrystalStructuresArrayPath = DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures);
@@ -320,13 +364,13 @@ private:
   QString m_FeatureIdsArrayName = {SIMPL::CellData::FeatureIds};
   QString m_ActiveArrayName = {SIMPL::FeatureData::Active};
 
-  std::random_device m_RandomDevice;
-  std::mt19937_64 m_Generator;
-  std::uniform_int_distribution<int64_t> m_Distribution;
+  PhiloxRandom m_Generator = {0, 0};
+  int64_t m_RangeMin = 0;
+  int64_t m_RangeMax = 0;
 
   float m_MisoTolerance = 0.0f;
 
-  LaueOpsContainer m_OrientationOps;
+  MisorientationKernel m_MisorientationKernel;
 
   /**
    * @brief randomizeGrainIds Randomizes Feature Ids
@@ -336,7 +380,7 @@ private:
   void randomizeFeatureIds(int64_t totalPoints, int64_t totalFeatures);
 
   /**
-   * @brief initializeVoxelSeedGenerator Initializes the boost random number generators
+   * @brief initializeVoxelSeedGenerator Initializes the random number generator used to shuffle the Feature Ids
    * @param rangeMin Minimum range for random number selection
    * @param rangeMax Maximum range for random number selection
    */
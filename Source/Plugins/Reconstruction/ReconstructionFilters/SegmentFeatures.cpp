@@ -34,12 +34,16 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "SegmentFeatures.h"
 
+#include <algorithm>
+#include <thread>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
@@ -97,6 +101,248 @@ bool SegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighbor
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentFeatures::isSeedCandidate(int64_t point) const
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentFeatures::areNeighborsSimilar(int64_t referencepoint, int64_t neighborpoint) const
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SegmentFeatures::resizeFeatureAttributeMatrix(size_t numTuples)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Int32ArrayType::Pointer SegmentFeatures::getFeatureIdsArray() const
+{
+  return Int32ArrayType::NullPointer();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SegmentFeatures::ensureFeatureCapacity(size_t numTuples)
+{
+  if(numTuples <= m_FeatureCapacity)
+  {
+    return;
+  }
+  m_FeatureCapacity = std::max(numTuples, m_FeatureCapacity * 2);
+  resizeFeatureAttributeMatrix(m_FeatureCapacity);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SegmentFeatures::executeParallelLabeling(const int64_t dims[3])
+{
+  Int32ArrayType::Pointer featureIdsPtr = getFeatureIdsArray();
+  if(nullptr == featureIdsPtr.get())
+  {
+    QString ss = QObject::tr("%1 does not support parallel labeling").arg(getHumanLabel());
+    setErrorCondition(-87001, ss);
+    return;
+  }
+  int32_t* featureIds = featureIdsPtr->getPointer(0);
+
+  const int64_t sliceStride = dims[0] * dims[1];
+  const int64_t totalPoints = sliceStride * dims[2];
+  const int64_t numRows = dims[1] * dims[2];
+
+  // An empty geometry has no rows to split into slabs; like the serial path it finds no Features
+  if(numRows <= 0 || totalPoints <= 0)
+  {
+    resizeFeatureAttributeMatrix(1);
+    return;
+  }
+
+  // Split the volume into contiguous slabs of whole rows. Any slab count gives the same
+  // final partition; a few slabs per core just keeps the load balanced.
+  const int64_t numCores = std::max<int64_t>(1, static_cast<int64_t>(std::thread::hardware_concurrency()));
+  const int64_t numSlabs = std::min<int64_t>(numRows, numCores * 4);
+  std::vector<int64_t> slabStart(numSlabs + 1, 0);
+  for(int64_t s = 0; s <= numSlabs; s++)
+  {
+    slabStart[s] = ((numRows * s) / numSlabs) * dims[0];
+  }
+  std::vector<int32_t> slabFeatureCounts(numSlabs, 0);
+
+  notifyStatusMessage("Labeling slabs");
+
+  // Pass 1: run the burn algorithm inside each slab, writing slab local labels 1..n
+  ParallelDataAlgorithm slabAlg;
+  slabAlg.setRange(0, numSlabs);
+  slabAlg.setGrain(1);
+  slabAlg.execute([&](const SIMPLRange& range) {
+    const int64_t neighpoints[6] = {-sliceStride, -dims[0], -1, 1, dims[0], sliceStride};
+    std::vector<int64_t> voxelslist;
+    for(size_t s = range.min(); s < range.max(); s++)
+    {
+      const int64_t start = slabStart[s];
+      const int64_t end = slabStart[s + 1];
+      std::fill(featureIds + start, featureIds + end, 0);
+
+      int32_t label = 0;
+      for(int64_t seed = start; seed < end; seed++)
+      {
+        if(featureIds[seed] != 0 || !isSeedCandidate(seed))
+        {
+          continue;
+        }
+        label++;
+        featureIds[seed] = label;
+        voxelslist.push_back(seed);
+        while(!voxelslist.empty())
+        {
+          int64_t currentpoint = voxelslist.back();
+          voxelslist.pop_back();
+          int64_t col = currentpoint % dims[0];
+          int64_t row = (currentpoint / dims[0]) % dims[1];
+          int64_t plane = currentpoint / sliceStride;
+          bool good[6] = {plane > 0, row > 0, col > 0, col < dims[0] - 1, row < dims[1] - 1, plane < dims[2] - 1};
+          for(int32_t i = 0; i < 6; i++)
+          {
+            int64_t neighbor = currentpoint + neighpoints[i];
+            if(!good[i] || neighbor < start || neighbor >= end || featureIds[neighbor] != 0)
+            {
+              continue;
+            }
+            if(isSeedCandidate(neighbor) && areNeighborsSimilar(currentpoint, neighbor))
+            {
+              featureIds[neighbor] = label;
+              voxelslist.push_back(neighbor);
+            }
+          }
+        }
+      }
+      slabFeatureCounts[s] = label;
+    }
+  });
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  // Convert the slab local labels into globally unique provisional labels. Because slabs are
+  // ordered by voxel index, provisional labels are ordered by the index of their seed voxel.
+  std::vector<int32_t> slabOffsets(numSlabs, 0);
+  int32_t numProvisional = 0;
+  for(int64_t s = 0; s < numSlabs; s++)
+  {
+    slabOffsets[s] = numProvisional;
+    numProvisional += slabFeatureCounts[s];
+  }
+
+  ParallelDataAlgorithm offsetAlg;
+  offsetAlg.setRange(0, numSlabs);
+  offsetAlg.setGrain(1);
+  offsetAlg.execute([&](const SIMPLRange& range) {
+    for(size_t s = range.min(); s < range.max(); s++)
+    {
+      const int32_t offset = slabOffsets[s];
+      for(int64_t i = slabStart[s]; i < slabStart[s + 1]; i++)
+      {
+        if(featureIds[i] > 0)
+        {
+          featureIds[i] += offset;
+        }
+      }
+    }
+  });
+
+  // Pass 2: union the provisional labels that touch across slab boundaries. The root of each
+  // set is always its smallest label, i.e. the label whose seed comes first in the volume.
+  std::vector<int32_t> parent(static_cast<size_t>(numProvisional) + 1);
+  for(size_t i = 0; i < parent.size(); i++)
+  {
+    parent[i] = static_cast<int32_t>(i);
+  }
+  auto findRoot = [&parent](int32_t label) {
+    while(parent[label] != label)
+    {
+      parent[label] = parent[parent[label]];
+      label = parent[label];
+    }
+    return label;
+  };
+
+  notifyStatusMessage("Merging slab boundaries");
+  for(int64_t s = 1; s < numSlabs; s++)
+  {
+    const int64_t start = slabStart[s];
+    const int64_t end = std::min(slabStart[s] + sliceStride, slabStart[s + 1]);
+    for(int64_t point = start; point < end; point++)
+    {
+      if(featureIds[point] == 0)
+      {
+        continue;
+      }
+      int64_t row = (point / dims[0]) % dims[1];
+      int64_t plane = point / sliceStride;
+      int64_t candidates[2] = {row > 0 ? point - dims[0] : -1, plane > 0 ? point - sliceStride : -1};
+      for(int64_t neighbor : candidates)
+      {
+        if(neighbor < 0 || neighbor >= start || featureIds[neighbor] == 0)
+        {
+          continue;
+        }
+        int32_t rootA = findRoot(featureIds[point]);
+        int32_t rootB = findRoot(featureIds[neighbor]);
+        if(rootA != rootB && areNeighborsSimilar(neighbor, point))
+        {
+          if(rootA < rootB)
+          {
+            parent[rootB] = rootA;
+          }
+          else
+          {
+            parent[rootA] = rootB;
+          }
+        }
+      }
+    }
+  }
+
+  // Pass 3: renumber the merged sets in order of their first voxel, which is the order in
+  // which the serial burn algorithm discovers its seeds
+  std::vector<int32_t> finalIds(parent.size(), 0);
+  int32_t gnum = 1;
+  for(int32_t label = 1; label <= numProvisional; label++)
+  {
+    int32_t root = findRoot(label);
+    finalIds[label] = (root == label) ? gnum++ : finalIds[root];
+  }
+
+  ParallelDataAlgorithm relabelAlg;
+  relabelAlg.setRange(0, totalPoints);
+  relabelAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      featureIds[i] = finalIds[featureIds[i]];
+    }
+  });
+
+  resizeFeatureAttributeMatrix(static_cast<size_t>(gnum));
+
+  QString ss = QObject::tr("Total Features: %1").arg(gnum);
+  notifyStatusMessage(ss);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -120,6 +366,12 @@ void SegmentFeatures::execute()
       static_cast<int64_t>(udims[2]),
   };
 
+  if(m_UseParallelLabeling)
+  {
+    executeParallelLabeling(dims);
+    return;
+  }
+
   int32_t gnum = 1;
   int64_t seed = 0;
   int64_t neighbor = 0;
@@ -136,6 +388,7 @@ void SegmentFeatures::execute()
   neighpoints[4] = dims[0];
   neighpoints[5] = (dims[0] * dims[1]);
   int64_t nextSeed = 0;
+  m_FeatureCapacity = 0;
 
   while(seed >= 0)
   {
@@ -218,6 +471,10 @@ void SegmentFeatures::execute()
       break;
     }
   }
+
+  // Trim the over allocated Feature Attribute Matrix down to the Features actually found
+  resizeFeatureAttributeMatrix(static_cast<size_t>(gnum));
+  m_FeatureCapacity = static_cast<size_t>(gnum);
 }
 
 // -----------------------------------------------------------------------------
@@ -331,3 +588,15 @@ QString SegmentFeatures::getDataContainerName() const
 {
   return m_DataContainerName;
 }
+
+// -----------------------------------------------------------------------------
+void SegmentFeatures::setUseParallelLabeling(bool value)
+{
+  m_UseParallelLabeling = value;
+}
+
+// -----------------------------------------------------------------------------
+bool SegmentFeatures::getUseParallelLabeling() const
+{
+  return m_UseParallelLabeling;
+}
@@ -39,6 +39,7 @@
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
@@ -59,6 +60,7 @@ class Reconstruction_EXPORT SegmentFeatures : public AbstractFilter
   PYB11_SHARED_POINTERS(SegmentFeatures)
   PYB11_FILTER_NEW_MACRO(SegmentFeatures)
   PYB11_PROPERTY(QString DataContainerName READ getDataContainerName WRITE setDataContainerName)
+  PYB11_PROPERTY(bool UseParallelLabeling READ getUseParallelLabeling WRITE setUseParallelLabeling)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -104,6 +106,17 @@ public:
 
   Q_PROPERTY(QString DataContainerName READ getDataContainerName WRITE setDataContainerName)
 
+  /**
+   * @brief Setter property for UseParallelLabeling
+   */
+  void setUseParallelLabeling(bool value);
+  /**
+   * @brief Getter property for UseParallelLabeling
+   * @return Value of UseParallelLabeling
+   */
+  bool getUseParallelLabeling() const;
+  Q_PROPERTY(bool UseParallelLabeling READ getUseParallelLabeling WRITE setUseParallelLabeling)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -188,6 +201,44 @@ protected:
    */
   virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+  /**
+   * @brief isSeedCandidate Determines if a voxel may be part of any Feature. This must not
+   * depend on the current Feature Ids since it is also used by the parallel labeling path.
+   * @param point Voxel index to check
+   * @return Boolean check for whether the voxel can be segmented
+   */
+  virtual bool isSeedCandidate(int64_t point) const;
+
+  /**
+   * @brief areNeighborsSimilar Side effect free grouping predicate shared by the serial burn
+   * algorithm and the parallel labeling path. Must be symmetric and safe to call concurrently.
+   * @param referencepoint Point of growing seed
+   * @param neighborpoint Point to be compared for adding
+   * @return Boolean check for whether the two voxels belong to the same Feature
+   */
+  virtual bool areNeighborsSimilar(int64_t referencepoint, int64_t neighborpoint) const;
+
+  /**
+   * @brief resizeFeatureAttributeMatrix Resizes the Feature Attribute Matrix the subclass creates
+   * and updates any cached Feature level pointers
+   * @param numTuples New number of tuples, including the zero Feature
+   */
+  virtual void resizeFeatureAttributeMatrix(size_t numTuples);
+
+  /**
+   * @brief getFeatureIdsArray Returns the Feature Ids array the subclass segments into
+   * @return Feature Ids array or a null pointer
+   */
+  virtual Int32ArrayType::Pointer getFeatureIdsArray() const;
+
+  /**
+   * @brief ensureFeatureCapacity Makes sure the Feature Attribute Matrix holds at least the given
+   * number of tuples. The capacity is doubled when it runs out so that creating a new Feature is
+   * amortized O(1); execute() trims the matrix to the final Feature count when the burn is done.
+   * @param numTuples Required number of tuples, including the zero Feature
+   */
+  void ensureFeatureCapacity(size_t numTuples);
+
 public:
   SegmentFeatures(const SegmentFeatures&) = delete;            // Copy Constructor Not Implemented
   SegmentFeatures(SegmentFeatures&&) = delete;                 // Move Constructor Not Implemented
@@ -196,4 +247,14 @@ public:
 
 private:
   QString m_DataContainerName = {SIMPL::Defaults::ImageDataContainerName};
+  bool m_UseParallelLabeling = {false};
+  size_t m_FeatureCapacity = 0;
+
+  /**
+   * @brief executeParallelLabeling Labels contiguous slabs of the volume concurrently, merges the
+   * provisional labels across slab boundaries with a union-find and renumbers the Features so the
+   * result is identical to the serial burn algorithm
+   * @param dims Dimensions of the grid geometry
+   */
+  void executeParallelLabeling(const int64_t dims[3]);
 };
@@ -42,6 +42,7 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -83,6 +84,7 @@ void SineParamsSegmentFeatures::setupFilterParameters()
 
   std::vector<QString> linkedProps = {"GoodVoxelsArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Good Voxels Array", UseGoodVoxels, FilterParameter::Category::Parameter, SineParamsSegmentFeatures, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Labeling", UseParallelLabeling, FilterParameter::Category::Parameter, SineParamsSegmentFeatures));
 
   {
     DataArraySelectionFilterParameter::RequirementType req;
@@ -111,6 +113,7 @@ void SineParamsSegmentFeatures::readFilterParameters(AbstractFilterParametersRea
   setFeatureIdsArrayName(reader->readString("FeatureIdsArrayName", getFeatureIdsArrayName()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseParallelLabeling(reader->readValue("UseParallelLabeling", getUseParallelLabeling()));
   setSineParamsArrayPath(reader->readDataArrayPath("SineParamsArrayPath", getSineParamsArrayPath()));
   // setAngleTolerance( reader->readValue("AngleTolerance", getAngleTolerance()) );
   reader->closeFilterGroup();
@@ -310,8 +313,6 @@ int64_t SineParamsSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
   // start with the next voxel after the last seed
@@ -320,7 +321,7 @@ int64_t SineParamsSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   {
     if(m_FeatureIds[randpoint] == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
     {
-      if(!m_UseGoodVoxels || m_GoodVoxels[randpoint])
+      if(isSeedCandidate(randpoint))
       {
         seed = randpoint;
       }
@@ -337,9 +338,7 @@ int64_t SineParamsSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
+    ensureFeatureCapacity(gnum + 1);
   }
   return seed;
 }
@@ -349,30 +348,60 @@ int64_t SineParamsSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 // -----------------------------------------------------------------------------
 bool SineParamsSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
 {
-  bool group = false;
+  if(m_FeatureIds[neighborpoint] == 0 && isSeedCandidate(neighborpoint) && areNeighborsSimilar(referencepoint, neighborpoint))
+  {
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SineParamsSegmentFeatures::isSeedCandidate(int64_t point) const
+{
+  return !m_UseGoodVoxels || m_GoodVoxels[point];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SineParamsSegmentFeatures::areNeighborsSimilar(int64_t referencepoint, int64_t neighborpoint) const
+{
   float v1;
   float v2;
   float shift;
   float step = 45.0f * SIMPLib::Constants::k_PiOver180D;
   float avgDiff = 0;
-  if(m_FeatureIds[neighborpoint] == 0 && (!m_UseGoodVoxels || m_GoodVoxels[neighborpoint]))
+  for(int i = 0; i < 8; i++)
   {
-    for(int i = 0; i < 8; i++)
-    {
-      shift = float(i) * step;
-      v1 = m_SineParams[3 * referencepoint] * sin(2.0 * (shift + m_SineParams[3 * referencepoint + 2])) + m_SineParams[3 * referencepoint + 1];
-      v2 = m_SineParams[3 * neighborpoint] * sin(2.0 * (shift + m_SineParams[3 * neighborpoint + 2])) + m_SineParams[3 * neighborpoint + 1];
-      avgDiff += fabs(v1 - v2);
-    }
-    avgDiff /= 8.0;
-    if(avgDiff < 7)
-    {
-      group = true;
-      m_FeatureIds[neighborpoint] = gnum;
-    }
+    shift = float(i) * step;
+    v1 = m_SineParams[3 * referencepoint] * sin(2.0 * (shift + m_SineParams[3 * referencepoint + 2])) + m_SineParams[3 * referencepoint + 1];
+    v2 = m_SineParams[3 * neighborpoint] * sin(2.0 * (shift + m_SineParams[3 * neighborpoint + 2])) + m_SineParams[3 * neighborpoint + 1];
+    avgDiff += fabs(v1 - v2);
   }
+  avgDiff /= 8.0;
+  return avgDiff < 7;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SineParamsSegmentFeatures::resizeFeatureAttributeMatrix(size_t numTuples)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  std::vector<size_t> tDims(1, numTuples);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
+}
 
-  return group;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Int32ArrayType::Pointer SineParamsSegmentFeatures::getFeatureIdsArray() const
+{
+  return m_FeatureIdsPtr.lock();
 }
 
 // -----------------------------------------------------------------------------
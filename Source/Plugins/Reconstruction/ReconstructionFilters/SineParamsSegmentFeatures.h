@@ -262,6 +262,26 @@ protected:
   int64_t getSeed(int32_t gnum, int64_t nextSeed) override;
   bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum) override;
 
+  /**
+   * @brief isSeedCandidate Reimplemented from @see SegmentFeatures class
+   */
+  bool isSeedCandidate(int64_t point) const override;
+
+  /**
+   * @brief areNeighborsSimilar Reimplemented from @see SegmentFeatures class
+   */
+  bool areNeighborsSimilar(int64_t referencepoint, int64_t neighborpoint) const override;
+
+  /**
+   * @brief resizeFeatureAttributeMatrix Reimplemented from @see SegmentFeatures class
+   */
+  void resizeFeatureAttributeMatrix(size_t numTuples) override;
+
+  /**
+   * @brief getFeatureIdsArray Reimplemented from @see SegmentFeatures class
+   */
+  Int32ArrayType::Pointer getFeatureIdsArray() const override;
+
 private:
   std::weak_ptr<DataArray<float>> m_SineParamsPtr;
   float* m_SineParams = nullptr;
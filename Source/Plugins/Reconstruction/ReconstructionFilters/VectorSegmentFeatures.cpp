@@ -42,6 +42,7 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -84,6 +85,7 @@ void VectorSegmentFeatures::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Angle Tolerance", AngleTolerance, FilterParameter::Category::Parameter, VectorSegmentFeatures));
   std::vector<QString> linkedProps = {"GoodVoxelsArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Category::Parameter, VectorSegmentFeatures, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Labeling", UseParallelLabeling, FilterParameter::Category::Parameter, VectorSegmentFeatures));
 
   {
     DataArraySelectionFilterParameter::RequirementType req;
@@ -112,6 +114,7 @@ void VectorSegmentFeatures::readFilterParameters(AbstractFilterParametersReader*
   setFeatureIdsArrayName(reader->readString("FeatureIdsArrayName", getFeatureIdsArrayName()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseParallelLabeling(reader->readValue("UseParallelLabeling", getUseParallelLabeling()));
   setSelectedVectorArrayPath(reader->readDataArrayPath("SelectedVectorArrayPath", getSelectedVectorArrayPath()));
   setAngleTolerance(reader->readValue("AngleTolerance", getAngleTolerance()));
   reader->closeFilterGroup();
@@ -263,8 +266,6 @@ int64_t VectorSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
   // start with the next voxel after the last seed
@@ -273,7 +274,7 @@ int64_t VectorSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   {
     if(m_FeatureIds[randpoint] == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
     {
-      if(!m_UseGoodVoxels || m_GoodVoxels[randpoint])
+      if(isSeedCandidate(randpoint))
       {
         seed = randpoint;
       }
@@ -290,9 +291,7 @@ int64_t VectorSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
+    ensureFeatureCapacity(gnum + 1);
   }
   return seed;
 }
@@ -302,38 +301,63 @@ int64_t VectorSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 // -----------------------------------------------------------------------------
 bool VectorSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
 {
-  bool group = false;
-  float v1[3] = {0.0f, 0.0f, 0.0f};
-  float v2[3] = {0.0f, 0.0f, 0.0f};
-  if(m_FeatureIds[neighborpoint] == 0 && (!m_UseGoodVoxels || m_GoodVoxels[neighborpoint]))
+  if(m_FeatureIds[neighborpoint] == 0 && isSeedCandidate(neighborpoint) && areNeighborsSimilar(referencepoint, neighborpoint))
   {
-    v1[0] = m_Vectors[3 * referencepoint + 0];
-    v1[1] = m_Vectors[3 * referencepoint + 1];
-    v1[2] = m_Vectors[3 * referencepoint + 2];
-    v2[0] = m_Vectors[3 * neighborpoint + 0];
-    v2[1] = m_Vectors[3 * neighborpoint + 1];
-    v2[2] = m_Vectors[3 * neighborpoint + 2];
-    if(v1[2] < 0)
-    {
-      MatrixMath::Multiply3x1withConstant(v1, -1.0f);
-    }
-    if(v2[2] < 0)
-    {
-      MatrixMath::Multiply3x1withConstant(v2, -1.0f);
-    }
-    float w = GeometryMath::CosThetaBetweenVectors(v1, v2);
-    w = acosf(w);
-    if(w > SIMPLib::Constants::k_PiOver2D)
-    {
-      w = SIMPLib::Constants::k_PiD - w;
-    }
-    if(w < m_AngleToleranceRad)
-    {
-      group = true;
-      m_FeatureIds[neighborpoint] = gnum;
-    }
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
   }
-  return group;
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VectorSegmentFeatures::isSeedCandidate(int64_t point) const
+{
+  return !m_UseGoodVoxels || m_GoodVoxels[point];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VectorSegmentFeatures::areNeighborsSimilar(int64_t referencepoint, int64_t neighborpoint) const
+{
+  float v1[3] = {m_Vectors[3 * referencepoint + 0], m_Vectors[3 * referencepoint + 1], m_Vectors[3 * referencepoint + 2]};
+  float v2[3] = {m_Vectors[3 * neighborpoint + 0], m_Vectors[3 * neighborpoint + 1], m_Vectors[3 * neighborpoint + 2]};
+  if(v1[2] < 0)
+  {
+    MatrixMath::Multiply3x1withConstant(v1, -1.0f);
+  }
+  if(v2[2] < 0)
+  {
+    MatrixMath::Multiply3x1withConstant(v2, -1.0f);
+  }
+  float w = GeometryMath::CosThetaBetweenVectors(v1, v2);
+  w = acosf(w);
+  if(w > SIMPLib::Constants::k_PiOver2D)
+  {
+    w = SIMPLib::Constants::k_PiD - w;
+  }
+  return w < m_AngleToleranceRad;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VectorSegmentFeatures::resizeFeatureAttributeMatrix(size_t numTuples)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  std::vector<size_t> tDims(1, numTuples);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Int32ArrayType::Pointer VectorSegmentFeatures::getFeatureIdsArray() const
+{
+  return m_FeatureIdsPtr.lock();
 }
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,307 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <fstream>
+#include <vector>
+
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "ReconstructionTestFileLocations.h"
+
+/**
+ * @brief The AlignSectionsListTest class checks that shifting the sections moves every Cell array exactly as the
+ * original per tuple IDataArray::copyTuple() loop did: each Cell takes the values of the Cell it is shifted onto,
+ * Cells shifted in from outside of the section are zeroed and ignored arrays are left alone.
+ */
+class AlignSectionsListTest
+{
+  const QString k_DataContainerName = QString("DataContainer");
+  const QString k_CellAttrMatName = QString("CellData");
+  const QString k_FeatureIdsName = QString("FeatureIds");
+  const QString k_IndexName = QString("Index");
+  const QString k_VectorName = QString("Vector");
+  const QString k_UInt8Name = QString("UInt8");
+  const QString k_MaskName = QString("Mask");
+  const QString k_IgnoredName = QString("Ignored");
+  static constexpr size_t k_XPoints = 7;
+  static constexpr size_t k_YPoints = 6;
+  static constexpr size_t k_ZPoints = 4;
+  static constexpr int64_t k_KeepTuple = -1;
+  static constexpr int64_t k_ZeroTuple = -2;
+
+public:
+  AlignSectionsListTest() = default;
+  virtual ~AlignSectionsListTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::AlignSectionsListTest::ShiftsFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the AlignSectionsList Filter from the FilterManager
+    QString filtName = "AlignSectionsList";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The AlignSectionsListTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Reconstruction Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void setProperty(const AbstractFilter::Pointer& filter, const char* name, const QVariant& value)
+  {
+    bool propWasSet = filter->setProperty(name, value);
+    if(!propWasSet)
+    {
+      qDebug() << "Unable to set property " << name;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  size_t cellIndex(size_t x, size_t y, size_t z)
+  {
+    return (z * k_XPoints * k_YPoints) + (y * k_XPoints) + x;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createVolume()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    std::vector<size_t> tDims = {k_XPoints, k_YPoints, k_ZPoints};
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(tDims.data());
+    image->setSpacing(FloatVec3Type(1.0f, 1.0f, 1.0f));
+    image->setOrigin(FloatVec3Type(0.0f, 0.0f, 0.0f));
+    dc->setGeometry(image);
+
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, k_CellAttrMatName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+
+    // Every array encodes the Cell it started in so that the Cell each value ends up in can be traced back
+    const size_t totalPoints = k_XPoints * k_YPoints * k_ZPoints;
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, k_FeatureIdsName, true);
+    Int64ArrayType::Pointer indices = Int64ArrayType::CreateArray(totalPoints, k_IndexName, true);
+    FloatArrayType::Pointer vectors = FloatArrayType::CreateArray(tDims, std::vector<size_t>(1, 3), k_VectorName, true);
+    UInt8ArrayType::Pointer bytes = UInt8ArrayType::CreateArray(totalPoints, k_UInt8Name, true);
+    BoolArrayType::Pointer mask = BoolArrayType::CreateArray(totalPoints, k_MaskName, true);
+    DoubleArrayType::Pointer ignored = DoubleArrayType::CreateArray(totalPoints, k_IgnoredName, true);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      featureIds->setValue(i, static_cast<int32_t>(i + 1));
+      indices->setValue(i, static_cast<int64_t>(i) + 1000);
+      vectors->setComponent(i, 0, static_cast<float>(i) * 0.5f);
+      vectors->setComponent(i, 1, static_cast<float>(i % k_XPoints));
+      vectors->setComponent(i, 2, -static_cast<float>(i) - 1.0f);
+      bytes->setValue(i, static_cast<uint8_t>(1 + i % 250));
+      mask->setValue(i, i % 3 != 0);
+      ignored->setValue(i, static_cast<double>(i) * 0.25 + 1.0);
+    }
+    cellAttrMat->insertOrAssign(featureIds);
+    cellAttrMat->insertOrAssign(indices);
+    cellAttrMat->insertOrAssign(vectors);
+    cellAttrMat->insertOrAssign(bytes);
+    cellAttrMat->insertOrAssign(mask);
+    cellAttrMat->insertOrAssign(ignored);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void checkTuples(const IDataArray::Pointer& original, const IDataArray::Pointer& shifted, const std::vector<int64_t>& sources)
+  {
+    typename DataArray<T>::Pointer input = std::dynamic_pointer_cast<DataArray<T>>(original);
+    typename DataArray<T>::Pointer output = std::dynamic_pointer_cast<DataArray<T>>(shifted);
+    DREAM3D_REQUIRE_VALID_POINTER(input.get())
+    DREAM3D_REQUIRE_VALID_POINTER(output.get())
+    DREAM3D_REQUIRE_EQUAL(output->getNumberOfTuples(), sources.size())
+    const size_t numComps = input->getNumberOfComponents();
+    for(size_t i = 0; i < sources.size(); i++)
+    {
+      for(size_t c = 0; c < numComps; c++)
+      {
+        T expected = static_cast<T>(0);
+        if(sources[i] == k_KeepTuple)
+        {
+          expected = input->getValue(i * numComps + c);
+        }
+        else if(sources[i] >= 0)
+        {
+          expected = input->getValue(static_cast<size_t>(sources[i]) * numComps + c);
+        }
+        DREAM3D_REQUIRE_EQUAL(output->getValue(i * numComps + c), expected)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Shifts the sections by both positive and negative offsets so that sources are
+  // read from either side of the Cell that is being overwritten
+  // -----------------------------------------------------------------------------
+  int TestShiftedCellArrays()
+  {
+    // Relative shifts for sections 1 to k_ZPoints - 1, which accumulate
+    const std::vector<int64_t> relativeXShifts = {1, -2, 0};
+    const std::vector<int64_t> relativeYShifts = {0, 1, -1};
+    {
+      std::ofstream outFile(UnitTest::AlignSectionsListTest::ShiftsFile.toStdString());
+      for(size_t iter = 1; iter < k_ZPoints; iter++)
+      {
+        outFile << iter << " " << relativeXShifts[iter - 1] << " " << relativeYShifts[iter - 1] << "\n";
+      }
+    }
+    std::vector<int64_t> xshifts(k_ZPoints, 0);
+    std::vector<int64_t> yshifts(k_ZPoints, 0);
+    for(size_t iter = 1; iter < k_ZPoints; iter++)
+    {
+      xshifts[iter] = xshifts[iter - 1] + relativeXShifts[iter - 1];
+      yshifts[iter] = yshifts[iter - 1] + relativeYShifts[iter - 1];
+    }
+
+    // Shift iter is applied to section (k_ZPoints - 1 - iter)
+    std::vector<int64_t> sources(k_XPoints * k_YPoints * k_ZPoints, k_KeepTuple);
+    for(size_t iter = 1; iter < k_ZPoints; iter++)
+    {
+      const size_t z = k_ZPoints - 1 - iter;
+      if(xshifts[iter] == 0 && yshifts[iter] == 0)
+      {
+        continue;
+      }
+      for(size_t y = 0; y < k_YPoints; y++)
+      {
+        for(size_t x = 0; x < k_XPoints; x++)
+        {
+          const int64_t sourceX = static_cast<int64_t>(x) + xshifts[iter];
+          const int64_t sourceY = static_cast<int64_t>(y) + yshifts[iter];
+          if(sourceX >= 0 && sourceX < static_cast<int64_t>(k_XPoints) && sourceY >= 0 && sourceY < static_cast<int64_t>(k_YPoints))
+          {
+            sources[cellIndex(x, y, z)] = static_cast<int64_t>(cellIndex(static_cast<size_t>(sourceX), static_cast<size_t>(sourceY), z));
+          }
+          else
+          {
+            sources[cellIndex(x, y, z)] = k_ZeroTuple;
+          }
+        }
+      }
+    }
+
+    DataContainerArray::Pointer dca = createVolume();
+    AttributeMatrix::Pointer original = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttrMatName)->deepCopy(false);
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("AlignSectionsList");
+    DREAM3D_REQUIRE_VALID_POINTER(factory.get())
+    AbstractFilter::Pointer filter = factory->create();
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(DataArrayPath(k_DataContainerName, k_CellAttrMatName, ""));
+    setProperty(filter, "CellAttributeMatrixPath", var);
+    setProperty(filter, "InputFile", UnitTest::AlignSectionsListTest::ShiftsFile);
+    setProperty(filter, "DREAM3DAlignmentFile", false);
+    setProperty(filter, "WriteAlignmentShifts", false);
+    QVector<DataArrayPath> ignoredPaths = {DataArrayPath(k_DataContainerName, k_CellAttrMatName, k_IgnoredName)};
+    var.setValue(ignoredPaths);
+    setProperty(filter, "IgnoredDataArrayPaths", var);
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCode() >= 0)
+
+    AttributeMatrix::Pointer cellAttrMat = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttrMatName);
+    checkTuples<int32_t>(original->getAttributeArray(k_FeatureIdsName), cellAttrMat->getAttributeArray(k_FeatureIdsName), sources);
+    checkTuples<int64_t>(original->getAttributeArray(k_IndexName), cellAttrMat->getAttributeArray(k_IndexName), sources);
+    checkTuples<float>(original->getAttributeArray(k_VectorName), cellAttrMat->getAttributeArray(k_VectorName), sources);
+    checkTuples<uint8_t>(original->getAttributeArray(k_UInt8Name), cellAttrMat->getAttributeArray(k_UInt8Name), sources);
+    checkTuples<bool>(original->getAttributeArray(k_MaskName), cellAttrMat->getAttributeArray(k_MaskName), sources);
+
+    // The ignored array is never touched
+    std::vector<int64_t> keepAll(sources.size(), k_KeepTuple);
+    checkTuples<double>(original->getAttributeArray(k_IgnoredName), cellAttrMat->getAttributeArray(k_IgnoredName), keepAll);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestShiftedCellArrays())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  AlignSectionsListTest(const AlignSectionsListTest&) = delete;            // Copy Constructor Not Implemented
+  AlignSectionsListTest(AlignSectionsListTest&&) = delete;                 // Move Constructor Not Implemented
+  AlignSectionsListTest& operator=(const AlignSectionsListTest&) = delete; // Copy Assignment Not Implemented
+  AlignSectionsListTest& operator=(AlignSectionsListTest&&) = delete;      // Move Assignment Not Implemented
+};
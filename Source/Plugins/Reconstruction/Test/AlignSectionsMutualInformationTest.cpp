@@ -0,0 +1,348 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#endif
+
+#include "UnitTestSupport.hpp"
+
+#include "ReconstructionTestFileLocations.h"
+
+/**
+ * @brief The AlignSectionsMutualInformationTest class checks that searching the slice pairs concurrently finds the
+ * same shifts as searching them one after the other.
+ *
+ * Every section is a window onto the same 2D microstructure, a Voronoi tessellation of a jittered lattice of sites,
+ * moved by a known offset. Neighboring sites get one of five orientations rotated about [001] by multiples of 9
+ * degrees, so every Voronoi cell is segmented as its own Feature and the best shift of each slice pair is the
+ * difference of the two offsets.
+ */
+class AlignSectionsMutualInformationTest
+{
+  const QString k_DataContainerName = QString("DataContainer");
+  const QString k_CellAttrMatName = QString("CellData");
+  const QString k_EnsembleAttrMatName = QString("CellEnsembleData");
+  const QString k_QuatsName = QString("Quats");
+  const QString k_PhasesName = QString("Phases");
+  const QString k_CrystalStructuresName = QString("CrystalStructures");
+  static constexpr int64_t k_XPoints = 48;
+  static constexpr int64_t k_YPoints = 40;
+  static constexpr int64_t k_ZPoints = 5;
+  static constexpr int64_t k_SiteSpacing = 12;
+  // Cubic_High in the EbsdLib crystal structure enumeration
+  static constexpr uint32_t k_CubicHigh = 1;
+  static constexpr uint32_t k_UnknownCrystalStructure = 999;
+
+public:
+  AlignSectionsMutualInformationTest() = default;
+  virtual ~AlignSectionsMutualInformationTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::AlignSectionsMutualInformationTest::SerialShiftsFile);
+    QFile::remove(UnitTest::AlignSectionsMutualInformationTest::ParallelShiftsFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QString filtName = "AlignSectionsMutualInformation";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The AlignSectionsMutualInformationTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Reconstruction Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void setProperty(const AbstractFilter::Pointer& filter, const char* name, const QVariant& value)
+  {
+    bool propWasSet = filter->setProperty(name, value);
+    if(!propWasSet)
+    {
+      qDebug() << "Unable to set property " << name;
+    }
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+  }
+
+  // -----------------------------------------------------------------------------
+  // Offsets of each section into the microstructure
+  // -----------------------------------------------------------------------------
+  std::vector<int64_t> sectionXOffsets()
+  {
+    return {0, 2, 1, -1, -1};
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<int64_t> sectionYOffsets()
+  {
+    return {0, -1, 1, 3, 0};
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createVolume()
+  {
+    // Sites on a jittered lattice that covers every section and its offset with a margin of two sites. Sites one
+    // step apart along a row, a column or a diagonal never share (2 * i + j) % 5, so neighboring Voronoi cells
+    // always get different orientations.
+    struct Site
+    {
+      int64_t x;
+      int64_t y;
+      int32_t orientation;
+    };
+    std::vector<Site> sites;
+    for(int64_t j = 0; j < k_YPoints / k_SiteSpacing + 5; j++)
+    {
+      for(int64_t i = 0; i < k_XPoints / k_SiteSpacing + 5; i++)
+      {
+        const int64_t jitterX = ((i * 37 + j * 91) % 7) - 3;
+        const int64_t jitterY = ((i * 53 + j * 29) % 7) - 3;
+        sites.push_back({(i - 2) * k_SiteSpacing + jitterX, (j - 2) * k_SiteSpacing + jitterY, static_cast<int32_t>((2 * i + j) % 5)});
+      }
+    }
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    std::vector<size_t> tDims = {static_cast<size_t>(k_XPoints), static_cast<size_t>(k_YPoints), static_cast<size_t>(k_ZPoints)};
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(tDims.data());
+    image->setSpacing(FloatVec3Type(1.0f, 1.0f, 1.0f));
+    image->setOrigin(FloatVec3Type(0.0f, 0.0f, 0.0f));
+    dc->setGeometry(image);
+
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, k_CellAttrMatName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+    const size_t totalPoints = static_cast<size_t>(k_XPoints * k_YPoints * k_ZPoints);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(tDims, std::vector<size_t>(1, 4), k_QuatsName, true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, k_PhasesName, true);
+    phases->initializeWithValue(1);
+    cellAttrMat->insertOrAssign(quats);
+    cellAttrMat->insertOrAssign(phases);
+
+    const std::vector<int64_t> xOffsets = sectionXOffsets();
+    const std::vector<int64_t> yOffsets = sectionYOffsets();
+    for(int64_t z = 0; z < k_ZPoints; z++)
+    {
+      for(int64_t y = 0; y < k_YPoints; y++)
+      {
+        for(int64_t x = 0; x < k_XPoints; x++)
+        {
+          const int64_t px = x + xOffsets[z];
+          const int64_t py = y + yOffsets[z];
+          size_t nearest = 0;
+          int64_t nearestDistance = std::numeric_limits<int64_t>::max();
+          for(size_t s = 0; s < sites.size(); s++)
+          {
+            const int64_t distance = (px - sites[s].x) * (px - sites[s].x) + (py - sites[s].y) * (py - sites[s].y);
+            if(distance < nearestDistance)
+            {
+              nearestDistance = distance;
+              nearest = s;
+            }
+          }
+          // Rotations about [001] by less than 45 degrees, so the cubic misorientation between two of them is the
+          // difference of their angles, at least 9 degrees
+          const double halfAngle = 0.5 * 9.0 * sites[nearest].orientation * SIMPLib::Constants::k_PiOver180D;
+          const size_t index = static_cast<size_t>((z * k_YPoints + y) * k_XPoints + x);
+          quats->setComponent(index, 0, 0.0f);
+          quats->setComponent(index, 1, 0.0f);
+          quats->setComponent(index, 2, static_cast<float>(std::sin(halfAngle)));
+          quats->setComponent(index, 3, static_cast<float>(std::cos(halfAngle)));
+        }
+      }
+    }
+
+    AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New({2}, k_EnsembleAttrMatName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAttrMat);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, k_CrystalStructuresName, true);
+    crystalStructures->setValue(0, k_UnknownCrystalStructure);
+    crystalStructures->setValue(1, k_CubicHigh);
+    ensembleAttrMat->insertOrAssign(crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void alignSections(const QString& shiftsFile, int threadCount)
+  {
+    DataContainerArray::Pointer dca = createVolume();
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("AlignSectionsMutualInformation");
+    DREAM3D_REQUIRE_VALID_POINTER(factory.get())
+    AbstractFilter::Pointer filter = factory->create();
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    setProperty(filter, "MisorientationTolerance", 5.0f);
+    setProperty(filter, "UseGoodVoxels", false);
+    var.setValue(DataArrayPath(k_DataContainerName, k_CellAttrMatName, k_QuatsName));
+    setProperty(filter, "QuatsArrayPath", var);
+    var.setValue(DataArrayPath(k_DataContainerName, k_CellAttrMatName, k_PhasesName));
+    setProperty(filter, "CellPhasesArrayPath", var);
+    var.setValue(DataArrayPath(k_DataContainerName, k_EnsembleAttrMatName, k_CrystalStructuresName));
+    setProperty(filter, "CrystalStructuresArrayPath", var);
+    setProperty(filter, "WriteAlignmentShifts", true);
+    setProperty(filter, "AlignmentShiftFileName", shiftsFile);
+
+    auto align = [&]() { filter->execute(); };
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_arena arena(threadCount);
+    arena.execute(align);
+#else
+    (void)threadCount;
+    align();
+#endif
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<std::string> readLines(const QString& filePath)
+  {
+    std::vector<std::string> lines;
+    std::ifstream inFile(filePath.toStdString());
+    std::string line;
+    while(std::getline(inFile, line))
+    {
+      lines.push_back(line);
+    }
+    return lines;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSerialAndParallelShifts()
+  {
+    alignSections(UnitTest::AlignSectionsMutualInformationTest::SerialShiftsFile, 1);
+    alignSections(UnitTest::AlignSectionsMutualInformationTest::ParallelShiftsFile, 4);
+
+    const std::vector<std::string> serialLines = readLines(UnitTest::AlignSectionsMutualInformationTest::SerialShiftsFile);
+    const std::vector<std::string> parallelLines = readLines(UnitTest::AlignSectionsMutualInformationTest::ParallelShiftsFile);
+    DREAM3D_REQUIRE_EQUAL(serialLines.size(), static_cast<size_t>(k_ZPoints - 1))
+    DREAM3D_REQUIRE_EQUAL(parallelLines.size(), serialLines.size())
+
+    // Each line holds the slice pair, the shift between the two slices and the accumulated shift
+    const std::vector<int64_t> xOffsets = sectionXOffsets();
+    const std::vector<int64_t> yOffsets = sectionYOffsets();
+    int64_t xShift = 0;
+    int64_t yShift = 0;
+    for(size_t i = 0; i < serialLines.size(); i++)
+    {
+      DREAM3D_REQUIRE(serialLines[i] == parallelLines[i])
+
+      const int64_t expectedSlice = k_ZPoints - 2 - static_cast<int64_t>(i);
+      const int64_t expectedXShift = xOffsets[expectedSlice + 1] - xOffsets[expectedSlice];
+      const int64_t expectedYShift = yOffsets[expectedSlice + 1] - yOffsets[expectedSlice];
+      xShift += expectedXShift;
+      yShift += expectedYShift;
+
+      std::istringstream line(serialLines[i]);
+      std::vector<int64_t> values;
+      int64_t value = 0;
+      while(line >> value)
+      {
+        values.push_back(value);
+      }
+      const std::vector<int64_t> expected = {expectedSlice, expectedSlice + 1, expectedXShift, expectedYShift, xShift, yShift};
+      DREAM3D_REQUIRE(values == expected)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestSerialAndParallelShifts())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  AlignSectionsMutualInformationTest(const AlignSectionsMutualInformationTest&) = delete;            // Copy Constructor Not Implemented
+  AlignSectionsMutualInformationTest(AlignSectionsMutualInformationTest&&) = delete;                 // Move Constructor Not Implemented
+  AlignSectionsMutualInformationTest& operator=(const AlignSectionsMutualInformationTest&) = delete; // Copy Assignment Not Implemented
+  AlignSectionsMutualInformationTest& operator=(AlignSectionsMutualInformationTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,202 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <map>
+
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "ReconstructionTestFileLocations.h"
+
+class ScalarSegmentFeaturesTest
+{
+
+public:
+  ScalarSegmentFeaturesTest() = default;
+  virtual ~ScalarSegmentFeaturesTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the ScalarSegmentFeatures Filter from the FilterManager
+    QString filtName = "ScalarSegmentFeatures";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The ScalarSegmentFeaturesTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Reconstruction Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("Test");
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer igeom = ImageGeom::New();
+    size_t dims_in[3] = {23, 17, 31};
+    igeom->setDimensions(dims_in);
+    dc->setGeometry(igeom);
+    std::vector<size_t> dims = {dims_in[0], dims_in[1], dims_in[2]};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, "CellData", AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+
+    // Blocky regions with a few winding channels so that Features cross many slab boundaries
+    size_t totalPoints = dims_in[0] * dims_in[1] * dims_in[2];
+    Int32ArrayType::Pointer scalars = Int32ArrayType::CreateArray(totalPoints, std::string("Scalars"), true);
+    for(size_t z = 0; z < dims_in[2]; z++)
+    {
+      for(size_t y = 0; y < dims_in[1]; y++)
+      {
+        for(size_t x = 0; x < dims_in[0]; x++)
+        {
+          size_t index = (z * dims_in[1] + y) * dims_in[0] + x;
+          int32_t value = static_cast<int32_t>(((x / 5) + 3 * (y / 4) + 7 * (z / 6)) % 4) * 10;
+          if((x + z) % 9 == 0 || (y * z) % 13 == 1)
+          {
+            value = 100;
+          }
+          scalars->setValue(index, value);
+        }
+      }
+    }
+    cellAM->insertOrAssign(scalars);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  Int32ArrayType::Pointer RunSegmentation(bool useParallelLabeling, size_t& numFeatures)
+  {
+    DataContainerArray::Pointer dca = CreateTestData();
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("ScalarSegmentFeatures");
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant variant;
+    variant.setValue(DataArrayPath("Test", "CellData", "Scalars"));
+    bool ok = filter->setProperty("ScalarArrayPath", variant);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = filter->setProperty("ScalarTolerance", 0.0f);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = filter->setProperty("UseGoodVoxels", false);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = filter->setProperty("UseParallelLabeling", useParallelLabeling);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    filter->execute();
+    int err = filter->getErrorCode();
+    DREAM3D_REQUIRE(err >= 0)
+
+    numFeatures = dca->getAttributeMatrix(DataArrayPath("Test", "CellFeatureData", ""))->getNumberOfTuples();
+    return dca->getAttributeMatrix(DataArrayPath("Test", "CellData", ""))->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestParallelLabeling()
+  {
+    size_t serialFeatures = 0;
+    size_t parallelFeatures = 0;
+    Int32ArrayType::Pointer serialIds = RunSegmentation(false, serialFeatures);
+    Int32ArrayType::Pointer parallelIds = RunSegmentation(true, parallelFeatures);
+
+    DREAM3D_REQUIRE_VALID_POINTER(serialIds.get())
+    DREAM3D_REQUIRE_VALID_POINTER(parallelIds.get())
+    DREAM3D_REQUIRE_EQUAL(serialFeatures, parallelFeatures)
+
+    // Feature Ids are randomized by the filter, so compare the partitions through a one to one map
+    std::map<int32_t, int32_t> serialToParallel;
+    std::map<int32_t, int32_t> parallelToSerial;
+    size_t totalPoints = serialIds->getNumberOfTuples();
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      int32_t serialId = serialIds->getValue(i);
+      int32_t parallelId = parallelIds->getValue(i);
+      auto iter = serialToParallel.emplace(serialId, parallelId).first;
+      DREAM3D_REQUIRE_EQUAL(iter->second, parallelId)
+      iter = parallelToSerial.emplace(parallelId, serialId).first;
+      DREAM3D_REQUIRE_EQUAL(iter->second, serialId)
+    }
+    DREAM3D_REQUIRE_EQUAL(serialToParallel.size(), serialFeatures - 1)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestParallelLabeling())
+  }
+
+public:
+  ScalarSegmentFeaturesTest(const ScalarSegmentFeaturesTest&) = delete;            // Copy Constructor Not Implemented
+  ScalarSegmentFeaturesTest(ScalarSegmentFeaturesTest&&) = delete;                 // Move Constructor Not Implemented
+  ScalarSegmentFeaturesTest& operator=(const ScalarSegmentFeaturesTest&) = delete; // Copy Assignment Not Implemented
+  ScalarSegmentFeaturesTest& operator=(ScalarSegmentFeaturesTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -34,8 +34,13 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "SampleSurfaceMesh.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
@@ -62,6 +67,158 @@
 #include <tbb/partitioner.h>
 #endif
 
+namespace
+{
+/**
+ * @brief The SamplePointGrid class buckets the sampling points into a uniform grid of cells spanning
+ * their bounding box. The point ids are stored per cell in a single compressed array so that all
+ * points inside an axis aligned box can be found by only visiting the cells that the box overlaps.
+ */
+class SamplePointGrid
+{
+public:
+  static constexpr size_t k_PointsPerCell = 4;
+
+  explicit SamplePointGrid(const VertexGeom::Pointer& points)
+  {
+    const int64_t numPoints = points->getNumberOfVertices();
+    if(numPoints <= 0)
+    {
+      m_Offsets.assign(2, 0);
+      return;
+    }
+
+    m_Min.fill(std::numeric_limits<float>::max());
+    std::array<float, 3> max = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      const float* point = points->getVertexPointer(i);
+      for(size_t d = 0; d < 3; d++)
+      {
+        m_Min[d] = std::min(m_Min[d], point[d]);
+        max[d] = std::max(max[d], point[d]);
+      }
+    }
+
+    // Size the cells so that the non degenerate extents hold about k_PointsPerCell points per cell
+    const double targetCells = std::max(1.0, static_cast<double>(numPoints) / static_cast<double>(k_PointsPerCell));
+    double volume = 1.0;
+    int32_t usedDims = 0;
+    for(size_t d = 0; d < 3; d++)
+    {
+      if(max[d] > m_Min[d])
+      {
+        volume *= static_cast<double>(max[d] - m_Min[d]);
+        usedDims++;
+      }
+    }
+    double cellSize = usedDims > 0 ? std::pow(volume / targetCells, 1.0 / usedDims) : 1.0;
+    // A very thin extent shrinks the cells in the other directions, so grow them until the cell count stays bounded
+    while(true)
+    {
+      double numCells = 1.0;
+      for(size_t d = 0; d < 3; d++)
+      {
+        const double extent = static_cast<double>(max[d] - m_Min[d]);
+        m_Dims[d] = 1;
+        m_InvCellSize[d] = 0.0;
+        if(extent > 0.0 && cellSize > 0.0)
+        {
+          m_Dims[d] = std::max<size_t>(static_cast<size_t>(std::min(std::ceil(extent / cellSize), targetCells)), 1);
+          m_InvCellSize[d] = static_cast<double>(m_Dims[d]) / extent;
+        }
+        numCells *= static_cast<double>(m_Dims[d]);
+      }
+      if(numCells <= 8.0 * targetCells)
+      {
+        break;
+      }
+      cellSize *= 2.0;
+    }
+
+    // Counting sort of the point ids by cell
+    const size_t numCells = m_Dims[0] * m_Dims[1] * m_Dims[2];
+    std::vector<size_t> pointCells(numPoints);
+    m_Offsets.assign(numCells + 1, 0);
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      const float* point = points->getVertexPointer(i);
+      const size_t cell = (cellIndex(2, point[2]) * m_Dims[1] + cellIndex(1, point[1])) * m_Dims[0] + cellIndex(0, point[0]);
+      pointCells[i] = cell;
+      m_Offsets[cell + 1]++;
+    }
+    for(size_t cell = 0; cell < numCells; cell++)
+    {
+      m_Offsets[cell + 1] += m_Offsets[cell];
+    }
+    std::vector<size_t> cursor(m_Offsets.begin(), m_Offsets.end() - 1);
+    m_PointIds.resize(numPoints);
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      m_PointIds[cursor[pointCells[i]]++] = i;
+    }
+  }
+
+  /**
+   * @brief findPointsInBox Appends the ids of all points in the cells overlapped by the box [lowerLeft, upperRight]
+   * to pointIds. The result is a superset of the points inside the box, sorted by cell and then by point id.
+   */
+  void findPointsInBox(const float* lowerLeft, const float* upperRight, std::vector<int64_t>& pointIds) const
+  {
+    pointIds.clear();
+    if(m_PointIds.empty())
+    {
+      return;
+    }
+    std::array<size_t, 3> lower = {0, 0, 0};
+    std::array<size_t, 3> upper = {0, 0, 0};
+    for(size_t d = 0; d < 3; d++)
+    {
+      // Empty boxes and boxes entirely outside the points cannot contain anything
+      if(lowerLeft[d] > upperRight[d] || upperRight[d] < m_Min[d] || cellCoordinate(d, lowerLeft[d]) > static_cast<double>(m_Dims[d]))
+      {
+        return;
+      }
+      lower[d] = cellIndex(d, lowerLeft[d]);
+      upper[d] = cellIndex(d, upperRight[d]);
+    }
+    for(size_t z = lower[2]; z <= upper[2]; z++)
+    {
+      for(size_t y = lower[1]; y <= upper[1]; y++)
+      {
+        const size_t rowStart = (z * m_Dims[1] + y) * m_Dims[0];
+        pointIds.insert(pointIds.end(), m_PointIds.begin() + m_Offsets[rowStart + lower[0]], m_PointIds.begin() + m_Offsets[rowStart + upper[0] + 1]);
+      }
+    }
+  }
+
+private:
+  std::array<float, 3> m_Min = {0.0F, 0.0F, 0.0F};
+  std::array<size_t, 3> m_Dims = {1, 1, 1};
+  std::array<double, 3> m_InvCellSize = {0.0, 0.0, 0.0};
+  std::vector<size_t> m_Offsets;
+  std::vector<int64_t> m_PointIds;
+
+  double cellCoordinate(size_t dim, float value) const
+  {
+    return (static_cast<double>(value) - static_cast<double>(m_Min[dim])) * m_InvCellSize[dim];
+  }
+
+  size_t cellIndex(size_t dim, float value) const
+  {
+    const double coord = cellCoordinate(dim, value);
+    if(coord <= 0.0)
+    {
+      return 0;
+    }
+    return std::min(static_cast<size_t>(coord), m_Dims[dim] - 1);
+  }
+};
+
+/**
+ * @brief The SampleSurfaceMeshImplByPoints class implements a threaded algorithm that tests the candidate points
+ * of a single feature against that feature's polyhedron.
+ */
 class SampleSurfaceMeshImplByPoints
 {
   SampleSurfaceMesh* m_Filter = nullptr;
@@ -69,18 +226,27 @@ class SampleSurfaceMeshImplByPoints
   Int32Int32DynamicListArray::Pointer m_FaceIds;
   VertexGeom::Pointer m_FaceBBs;
   VertexGeom::Pointer m_Points;
+  const std::vector<int64_t>& m_Candidates;
   size_t m_FeatureId = 0;
+  std::array<float, 3> m_LowerLeft = {0.0F, 0.0F, 0.0F};
+  std::array<float, 3> m_UpperRight = {0.0F, 0.0F, 0.0F};
+  float m_Radius = 0.0f;
   int32_t* m_PolyIds = nullptr;
 
 public:
   SampleSurfaceMeshImplByPoints(SampleSurfaceMesh* filter, TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, VertexGeom::Pointer faceBBs, VertexGeom::Pointer points,
-                                size_t featureId, int32_t* polyIds)
+                                const std::vector<int64_t>& candidates, size_t featureId, const std::array<float, 3>& lowerLeft, const std::array<float, 3>& upperRight, float radius,
+                                int32_t* polyIds)
   : m_Filter(filter)
   , m_Faces(faces)
   , m_FaceIds(faceIds)
   , m_FaceBBs(faceBBs)
   , m_Points(points)
+  , m_Candidates(candidates)
   , m_FeatureId(featureId)
+  , m_LowerLeft(lowerLeft)
+  , m_UpperRight(upperRight)
+  , m_Radius(radius)
   , m_PolyIds(polyIds)
   {
   }
@@ -88,27 +254,23 @@ public:
 
   void checkPoints(size_t start, size_t end) const
   {
-    float radius = 0.0f;
     float distToBoundary = 0.0f;
-    int64_t numPoints = m_Points->getNumberOfVertices();
-    std::array<float, 3> lowerLeft = {0.0F, 0.0F, 0.0F};
-    std::array<float, 3> upperRight = {0.0F, 0.0F, 0.0F};
+    std::array<float, 3> lowerLeft = m_LowerLeft;
+    std::array<float, 3> upperRight = m_UpperRight;
     float* point = nullptr;
     char code = ' ';
 
     size_t iter = m_FeatureId;
 
-    // find bounding box for current feature
-    GeometryMath::FindBoundingBoxOfFaces(m_Faces.get(), m_FaceIds->getElementList(iter), lowerLeft.data(), upperRight.data());
-    GeometryMath::FindDistanceBetweenPoints(lowerLeft.data(), upperRight.data(), radius);
     int64_t pointsVisited = 0;
-    // check points in vertex array to see if they are in the bounding box of the feature
-    for(int64_t i = static_cast<int64_t>(start); i < static_cast<int64_t>(end); i++)
+    // check the candidate points to see if they are in the bounding box of the feature
+    for(size_t c = start; c < end; c++)
     {
+      int64_t i = m_Candidates[c];
       point = m_Points->getVertexPointer(i);
       if(m_PolyIds[i] == 0 && GeometryMath::PointInBox(point, lowerLeft.data(), upperRight.data()))
       {
-        code = GeometryMath::PointInPolyhedron(m_Faces.get(), m_FaceIds->getElementList(iter), m_FaceBBs.get(), point, lowerLeft.data(), upperRight.data(), radius, distToBoundary);
+        code = GeometryMath::PointInPolyhedron(m_Faces.get(), m_FaceIds->getElementList(iter), m_FaceBBs.get(), point, lowerLeft.data(), upperRight.data(), m_Radius, distToBoundary);
         if(code == 'i' || code == 'V' || code == 'E' || code == 'F')
         {
           m_PolyIds[i] = iter;
@@ -119,7 +281,7 @@ public:
       // Send some feedback
       if(pointsVisited % 1000 == 0)
       {
-        m_Filter->sendThreadSafeProgressMessage(m_FeatureId, 1000, numPoints);
+        m_Filter->sendThreadSafeProgressMessage(m_FeatureId, 1000, m_Candidates.size());
       }
       // Check for the filter being cancelled.
       if(m_Filter->getCancel())
@@ -140,6 +302,7 @@ private:
 
 /**
  * @brief The SampleSurfaceMeshImpl class implements a threaded algorithm that samples a surface mesh based on points passed from subclassed Filters.
+ * Each feature only visits the points found by the point grid inside its bounding box.
  */
 class SampleSurfaceMeshImpl
 {
@@ -148,15 +311,18 @@ class SampleSurfaceMeshImpl
   Int32Int32DynamicListArray::Pointer m_FaceIds;
   VertexGeom::Pointer m_FaceBBs;
   VertexGeom::Pointer m_Points;
+  const SamplePointGrid& m_PointGrid;
   int32_t* m_PolyIds = nullptr;
 
 public:
-  SampleSurfaceMeshImpl(SampleSurfaceMesh* filter, TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, VertexGeom::Pointer faceBBs, VertexGeom::Pointer points, int32_t* polyIds)
+  SampleSurfaceMeshImpl(SampleSurfaceMesh* filter, TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, VertexGeom::Pointer faceBBs, VertexGeom::Pointer points,
+                        const SamplePointGrid& pointGrid, int32_t* polyIds)
   : m_Filter(filter)
   , m_Faces(faces)
   , m_FaceIds(faceIds)
   , m_FaceBBs(faceBBs)
   , m_Points(points)
+  , m_PointGrid(pointGrid)
   , m_PolyIds(polyIds)
   {
   }
@@ -166,27 +332,28 @@ public:
   {
     float radius = 0.0f;
     float distToBoundary = 0.0f;
-    int64_t numPoints = m_Points->getNumberOfVertices();
     std::array<float, 3> lowerLeft = {0.0F, 0.0F, 0.0F};
     std::array<float, 3> upperRight = {0.0F, 0.0F, 0.0F};
     float* point = nullptr;
     char code = ' ';
+    std::vector<int64_t> candidates;
 
     for(size_t iter = start; iter < end; iter++)
     {
+      // Check for the filter being cancelled.
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+
       // find bounding box for current feature
       GeometryMath::FindBoundingBoxOfFaces(m_Faces.get(), m_FaceIds->getElementList(iter), lowerLeft.data(), upperRight.data());
       GeometryMath::FindDistanceBetweenPoints(lowerLeft.data(), upperRight.data(), radius);
 
-      // check points in vertex array to see if they are in the bounding box of the feature
-      for(int64_t i = 0; i < numPoints; i++)
+      // check the points near the bounding box of the feature to see if they are inside it
+      m_PointGrid.findPointsInBox(lowerLeft.data(), upperRight.data(), candidates);
+      for(int64_t i : candidates)
       {
-        // Check for the filter being cancelled.
-        if(m_Filter->getCancel())
-        {
-          return;
-        }
-
         point = m_Points->getVertexPointer(i);
         if(m_PolyIds[i] == 0 && GeometryMath::PointInBox(point, lowerLeft.data(), upperRight.data()))
         {
@@ -208,6 +375,7 @@ public:
 #endif
 private:
 };
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -434,37 +602,62 @@ void SampleSurfaceMesh::execute()
   iArray->initializeWithZeros();
   int32_t* polyIds = iArray->getPointer(0);
 
+  notifyStatusMessage("Bucketing sampling points ...");
+
+  // bucket the sampling points so each feature only has to visit the points near its bounding box
+  SamplePointGrid pointGrid(points);
+
+  // Check for user canceled flag.
+  if(getCancel())
+  {
+    return;
+  }
+
   notifyStatusMessage("Sampling triangle geometry ...");
 
   // C++11 RIGHT HERE....
   int32_t nthreads = static_cast<int32_t>(std::thread::hardware_concurrency()); // Returns ZERO if not defined on this platform
   // If the number of features is larger than the number of cores to do the work then parallelize over the number of features
-  // otherwise parallelize over the number of triangle points.
+  // otherwise parallelize over the candidate points of each feature.
   if(numFeatures > nthreads)
   {
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), SampleSurfaceMeshImpl(this, triangleGeom, faceLists, faceBBs, points, polyIds), tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), SampleSurfaceMeshImpl(this, triangleGeom, faceLists, faceBBs, points, pointGrid, polyIds), tbb::auto_partitioner());
 #else
-    SampleSurfaceMeshImpl serial(this, triangleGeom, faceLists, faceBBs, points, polyIds);
+    SampleSurfaceMeshImpl serial(this, triangleGeom, faceLists, faceBBs, points, pointGrid, polyIds);
     serial.checkPoints(0, numFeatures);
 #endif
   }
   else
   {
+    std::vector<int64_t> candidates;
+    std::array<float, 3> lowerLeft = {0.0F, 0.0F, 0.0F};
+    std::array<float, 3> upperRight = {0.0F, 0.0F, 0.0F};
+    float radius = 0.0f;
     for(int featureId = 0; featureId < numFeatures; featureId++)
     {
       m_NumCompleted = 0;
       m_StartMillis = QDateTime::currentMSecsSinceEpoch();
       m_Millis = m_StartMillis;
-      size_t numPoints = points->getNumberOfVertices();
+
+      // find bounding box for current feature and the points that may fall inside it
+      GeometryMath::FindBoundingBoxOfFaces(triangleGeom.get(), faceLists->getElementList(featureId), lowerLeft.data(), upperRight.data());
+      GeometryMath::FindDistanceBetweenPoints(lowerLeft.data(), upperRight.data(), radius);
+      pointGrid.findPointsInBox(lowerLeft.data(), upperRight.data(), candidates);
+      size_t numCandidates = candidates.size();
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, numPoints), SampleSurfaceMeshImplByPoints(this, triangleGeom, faceLists, faceBBs, points, featureId, polyIds), tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numCandidates),
+                        SampleSurfaceMeshImplByPoints(this, triangleGeom, faceLists, faceBBs, points, candidates, featureId, lowerLeft, upperRight, radius, polyIds), tbb::auto_partitioner());
 
 #else
-      SampleSurfaceMeshImplByPoints serial(this, triangleGeom, faceLists, faceBBs, points, featureId, polyIds);
-      serial.checkPoints(0, numPoints);
+      SampleSurfaceMeshImplByPoints serial(this, triangleGeom, faceLists, faceBBs, points, candidates, featureId, lowerLeft, upperRight, radius, polyIds);
+      serial.checkPoints(0, numCandidates);
 #endif
+      if(getCancel())
+      {
+        return;
+      }
     }
   }
   assign_points(iArray);
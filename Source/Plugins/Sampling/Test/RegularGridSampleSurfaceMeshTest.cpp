@@ -0,0 +1,268 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "Sampling/SamplingFilters/RegularGridSampleSurfaceMesh.h"
+#include "SamplingTestFileLocations.h"
+
+/**
+ * @brief The RegularGridSampleSurfaceMeshTest class samples the surface mesh of a block of box shaped Features,
+ * where the Feature each cell center falls in is known exactly. The sampling grid reaches past the mesh on every
+ * side so the points outside of all polyhedra must keep Feature Id 0.
+ */
+class RegularGridSampleSurfaceMeshTest
+{
+  const QString k_TriangleDataContainerName = QString("TriangleDataContainer");
+  const QString k_ImageDataContainerName = QString("ImageDataContainer");
+  const QString k_FaceAttrMatName = QString("FaceData");
+  const QString k_CellAttrMatName = QString("CellData");
+  const QString k_FaceLabelsName = QString("FaceLabels");
+  const QString k_FeatureIdsName = QString("FeatureIds");
+  // Edge length of each box shaped Feature, in sampling cells
+  static constexpr int32_t k_BoxSize = 3;
+  // Sampling cells between the mesh and the sides of the sampling grid
+  static constexpr int32_t k_Margin = 2;
+
+public:
+  RegularGridSampleSurfaceMeshTest() = default;
+  virtual ~RegularGridSampleSurfaceMeshTest() = default;
+
+  // -----------------------------------------------------------------------------
+  // A numBoxes^3 block of boxes on a shared vertex lattice. Every lattice face is written once, labeled with the
+  // Features on either side of it or -1 on the outside of the block, the way a surface mesh of a volume is.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateBlockMesh(int32_t numBoxes)
+  {
+    const int32_t numSide = numBoxes + 1;
+    const size_t numVerts = static_cast<size_t>(numSide * numSide * numSide);
+    const size_t numTris = static_cast<size_t>(3 * numSide * numBoxes * numBoxes * 2);
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    SharedVertexList::Pointer vertexList = TriangleGeom::CreateSharedVertexList(numVerts);
+    TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(numTris, vertexList, SIMPL::Geometry::TriangleGeometry);
+    dc->setGeometry(triangleGeom);
+    float* vertices = triangleGeom->getVertexPointer(0);
+    MeshIndexType* tris = triangleGeom->getTriPointer(0);
+
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New({numTris}, k_FaceAttrMatName, AttributeMatrix::Type::Face);
+    dc->addOrReplaceAttributeMatrix(faceAttrMat);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(numTris, std::vector<size_t>(1, 2), k_FaceLabelsName, true);
+    faceAttrMat->insertOrAssign(faceLabels);
+
+    auto vertexIndex = [numSide](const std::array<int32_t, 3>& v) { return static_cast<MeshIndexType>((v[2] * numSide + v[1]) * numSide + v[0]); };
+    auto boxId = [numBoxes](const std::array<int32_t, 3>& b) {
+      for(int32_t c = 0; c < 3; c++)
+      {
+        if(b[c] < 0 || b[c] >= numBoxes)
+        {
+          return -1;
+        }
+      }
+      return 1 + b[0] + numBoxes * (b[1] + numBoxes * b[2]);
+    };
+
+    for(int32_t k = 0; k < numSide; k++)
+    {
+      for(int32_t j = 0; j < numSide; j++)
+      {
+        for(int32_t i = 0; i < numSide; i++)
+        {
+          MeshIndexType v = vertexIndex({i, j, k});
+          vertices[3 * v] = static_cast<float>(i * k_BoxSize);
+          vertices[3 * v + 1] = static_cast<float>(j * k_BoxSize);
+          vertices[3 * v + 2] = static_cast<float>(k * k_BoxSize);
+        }
+      }
+    }
+
+    size_t t = 0;
+    for(int32_t normal = 0; normal < 3; normal++)
+    {
+      const int32_t u = (normal + 1) % 3;
+      const int32_t w = (normal + 2) % 3;
+      for(int32_t plane = 0; plane < numSide; plane++)
+      {
+        for(int32_t a = 0; a < numBoxes; a++)
+        {
+          for(int32_t b = 0; b < numBoxes; b++)
+          {
+            std::array<int32_t, 3> corner = {0, 0, 0};
+            corner[normal] = plane;
+            std::array<std::array<int32_t, 3>, 4> quad = {corner, corner, corner, corner};
+            quad[0][u] = a;
+            quad[0][w] = b;
+            quad[1][u] = a + 1;
+            quad[1][w] = b;
+            quad[2][u] = a + 1;
+            quad[2][w] = b + 1;
+            quad[3][u] = a;
+            quad[3][w] = b + 1;
+
+            std::array<int32_t, 3> lowBox = quad[0];
+            lowBox[normal] = plane - 1;
+            std::array<int32_t, 3> highBox = quad[0];
+            const int32_t labels[2] = {boxId(lowBox), boxId(highBox)};
+
+            const size_t triCorners[2][3] = {{0, 1, 2}, {0, 2, 3}};
+            for(const auto& tri : triCorners)
+            {
+              for(size_t c = 0; c < 3; c++)
+              {
+                tris[3 * t + c] = vertexIndex(quad[tri[c]]);
+              }
+              faceLabels->setComponent(t, 0, labels[0]);
+              faceLabels->setComponent(t, 1, labels[1]);
+              t++;
+            }
+          }
+        }
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(t, numTris)
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int32_t ExpectedFeatureId(int32_t numBoxes, int32_t i, int32_t j, int32_t k)
+  {
+    // Cell centers sit half a cell off the lattice planes, so no point lies on a face
+    const int32_t cell[3] = {i - k_Margin, j - k_Margin, k - k_Margin};
+    int32_t box[3] = {0, 0, 0};
+    for(int32_t c = 0; c < 3; c++)
+    {
+      if(cell[c] < 0 || cell[c] >= numBoxes * k_BoxSize)
+      {
+        return 0;
+      }
+      box[c] = cell[c] / k_BoxSize;
+    }
+    return 1 + box[0] + numBoxes * (box[1] + numBoxes * box[2]);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int SampleBlock(int32_t numBoxes)
+  {
+    DataContainerArray::Pointer dca = CreateBlockMesh(numBoxes);
+    const int32_t dim = numBoxes * k_BoxSize + 2 * k_Margin;
+
+    RegularGridSampleSurfaceMesh::Pointer filter = RegularGridSampleSurfaceMesh::New();
+    filter->setDataContainerArray(dca);
+    filter->setSurfaceMeshFaceLabelsArrayPath(DataArrayPath(k_TriangleDataContainerName, k_FaceAttrMatName, k_FaceLabelsName));
+    filter->setDataContainerName(DataArrayPath(k_ImageDataContainerName, "", ""));
+    filter->setCellAttributeMatrixName(k_CellAttrMatName);
+    filter->setFeatureIdsArrayName(k_FeatureIdsName);
+    filter->setDimensions(IntVec3Type(dim, dim, dim));
+    filter->setSpacing(FloatVec3Type(1.0f, 1.0f, 1.0f));
+    filter->setOrigin(FloatVec3Type(static_cast<float>(-k_Margin), static_cast<float>(-k_Margin), static_cast<float>(-k_Margin)));
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    Int32ArrayType::Pointer featureIds =
+        dca->getAttributeMatrix(DataArrayPath(k_ImageDataContainerName, k_CellAttrMatName, ""))->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsName);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+    DREAM3D_REQUIRE_EQUAL(featureIds->getNumberOfTuples(), static_cast<size_t>(dim * dim * dim))
+
+    for(int32_t k = 0; k < dim; k++)
+    {
+      for(int32_t j = 0; j < dim; j++)
+      {
+        for(int32_t i = 0; i < dim; i++)
+        {
+          const size_t index = static_cast<size_t>((k * dim + j) * dim + i);
+          DREAM3D_REQUIRE_EQUAL(featureIds->getValue(index), ExpectedFeatureId(numBoxes, i, j, k))
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Few Features: each Feature's candidate points are split over the threads
+  // -----------------------------------------------------------------------------
+  int TestFewFeatures()
+  {
+    return SampleBlock(1);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Many Features: the Features themselves are split over the threads. Which path runs depends on the core count,
+  // so the two block sizes sit on either side of it on most machines.
+  // -----------------------------------------------------------------------------
+  int TestManyFeatures()
+  {
+    return SampleBlock(5);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFewFeatures())
+    DREAM3D_REGISTER_TEST(TestManyFeatures())
+  }
+
+public:
+  RegularGridSampleSurfaceMeshTest(const RegularGridSampleSurfaceMeshTest&) = delete;            // Copy Constructor Not Implemented
+  RegularGridSampleSurfaceMeshTest(RegularGridSampleSurfaceMeshTest&&) = delete;                 // Move Constructor Not Implemented
+  RegularGridSampleSurfaceMeshTest& operator=(const RegularGridSampleSurfaceMeshTest&) = delete; // Copy Assignment Not Implemented
+  RegularGridSampleSurfaceMeshTest& operator=(RegularGridSampleSurfaceMeshTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -34,6 +34,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindAvgScalarValueForFeatures.h"
 
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -44,6 +46,8 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
+#include "Common/FeatureReduction.hpp"
+
 #include "StatsToolbox/StatsToolboxConstants.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
 
@@ -157,26 +161,36 @@ void findAverage(IDataArray::Pointer inDataPtr, FloatArrayType::Pointer averageA
   size_t numPoints = inputDataPtr->getNumberOfTuples();
   size_t numFeatures = averageArray->getNumberOfTuples();
 
-  std::vector<float> counts(numFeatures, 0.0f);
-
-  int32_t feature = 0;
-  float value = 0.0f;
-  for(size_t i = 0; i < numPoints; i++)
+  struct FeatureSum
+  {
+    CompensatedSum sum;
+    size_t count = 0;
+  };
+  std::vector<FeatureSum> sums = FeatureReduction::Reduce<FeatureSum>(
+      numPoints, numFeatures,
+      [cPtr, fIds](FeatureSum* featureSums, size_t i) {
+        featureSums[fIds[i]].sum.add(static_cast<double>(float(cPtr[i])));
+        featureSums[fIds[i]].count++;
+      },
+      [](FeatureSum& into, const FeatureSum& from) {
+        into.sum.merge(from.sum);
+        into.count += from.count;
+      });
+
+  // Feature 0 keeps its plain sum
+  if(numFeatures > 0)
   {
-    value = float(cPtr[i]);
-    feature = fIds[i];
-    aPtr[feature] += value;
-    counts[feature] += 1.0f;
+    aPtr[0] += static_cast<float>(sums[0].sum.value());
   }
   for(size_t i = 1; i < numFeatures; i++)
   {
-    if(counts[i] == 0)
+    if(sums[i].count == 0)
     {
       aPtr[i] = 0;
     }
     else
     {
-      aPtr[i] /= counts[i];
+      aPtr[i] = static_cast<float>((static_cast<double>(aPtr[i]) + sums[i].sum.value()) / static_cast<double>(sums[i].count));
     }
   }
 }
@@ -42,6 +42,10 @@
 #include <tbb/tick_count.h>
 #endif
 
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -56,6 +60,7 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "StatsToolbox/StatsToolboxConstants.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
@@ -83,17 +88,20 @@ class ComputeDistanceMapImpl
   int32_t* m_FeatureIds;
   int32_t* m_NearestNeighbors;
   bool m_CalcManhattanDist;
+  bool m_CalcExactEuclideanDist;
   T* m_GBManhattanDistances;
   T* m_TJManhattanDistances;
   T* m_QPManhattanDistances;
   FindEuclideanDistMap::MapType m_MapType;
 
 public:
-  ComputeDistanceMapImpl(DataContainer::Pointer datacontainer, int32_t* fIds, int32_t* nearNeighs, bool calcManhattanDist, T* gbDists, T* tjDists, T* qpDists, FindEuclideanDistMap::MapType mapType)
+  ComputeDistanceMapImpl(DataContainer::Pointer datacontainer, int32_t* fIds, int32_t* nearNeighs, bool calcManhattanDist, bool calcExactEuclideanDist, T* gbDists, T* tjDists, T* qpDists,
+                         FindEuclideanDistMap::MapType mapType)
   : m_DataContainer(datacontainer)
   , m_FeatureIds(fIds)
   , m_NearestNeighbors(nearNeighs)
   , m_CalcManhattanDist(calcManhattanDist)
+  , m_CalcExactEuclideanDist(calcExactEuclideanDist)
   , m_GBManhattanDistances(gbDists)
   , m_TJManhattanDistances(tjDists)
   , m_QPManhattanDistances(qpDists)
@@ -103,8 +111,164 @@ public:
 
   virtual ~ComputeDistanceMapImpl() = default;
 
+  /**
+   * @brief computeExactEuclideanDistances Computes the exact Euclidean distance (including the Cell spacing)
+   * from every Cell to the nearest marked Cell with a separable distance transform. Each axis is swept
+   * once: the nearest site found so far for every Cell on a line is refined with the lower envelope of
+   * the parabolas centered on the line positions (Felzenszwalb & Huttenlocher, which gives the same
+   * result as the Saito/Maurer transforms). Lines are independent, so every sweep runs in parallel.
+   * Unlike the propagation in operator(), the distance is measured straight through Cells with a
+   * Feature Id of 0.
+   */
+  void computeExactEuclideanDistances() const
+  {
+    ImageGeom::Pointer imageGeom = m_DataContainer->getGeometryAs<ImageGeom>();
+    const int64_t totalPoints = static_cast<int64_t>(imageGeom->getNumberOfElements());
+    const int64_t dims[3] = {static_cast<int64_t>(imageGeom->getXPoints()), static_cast<int64_t>(imageGeom->getYPoints()), static_cast<int64_t>(imageGeom->getZPoints())};
+    FloatVec3Type spacing = imageGeom->getSpacing();
+    const uint32_t mapIndex = static_cast<uint32_t>(m_MapType);
+
+    auto distanceSquared = [&dims, &spacing](int64_t a, int64_t b) {
+      const double dx = static_cast<double>(a % dims[0] - b % dims[0]) * spacing[0];
+      const double dy = static_cast<double>((a / dims[0]) % dims[1] - (b / dims[0]) % dims[1]) * spacing[1];
+      const double dz = static_cast<double>(a / (dims[0] * dims[1]) - b / (dims[0] * dims[1])) * spacing[2];
+      return dx * dx + dy * dy + dz * dz;
+    };
+
+    // Nearest site of every Cell; the sites are the marked Cells that belong to a Feature
+    std::vector<int32_t> voxNN(totalPoints, -1);
+    for(int64_t a = 0; a < totalPoints; ++a)
+    {
+      if(m_FeatureIds[a] > 0 && m_NearestNeighbors[a * 3 + mapIndex] >= 0)
+      {
+        voxNN[a] = static_cast<int32_t>(a);
+      }
+    }
+
+    const int64_t strides[3] = {1, dims[0], dims[0] * dims[1]};
+    for(int32_t axis = 0; axis < 3; axis++)
+    {
+      const int64_t length = dims[axis];
+      const int64_t stride = strides[axis];
+      const double axisSpacing = static_cast<double>(spacing[axis]);
+      const int64_t numLines = totalPoints / length;
+
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numLines);
+      dataAlg.execute([&](const SIMPLRange& range) {
+        std::vector<int32_t> lineSites(length, -1);
+        std::vector<double> lineValues(length, 0.0);
+        std::vector<int64_t> envelope(length, 0);
+        std::vector<double> boundaries(length + 1, 0.0);
+        for(size_t line = range.min(); line < range.max(); line++)
+        {
+          // First Cell of the line: lines along X are rows, along Y they step through the XZ plane
+          // and along Z through the XY plane
+          int64_t base = static_cast<int64_t>(line) * length;
+          if(axis == 1)
+          {
+            base = (static_cast<int64_t>(line) / dims[0]) * strides[2] + static_cast<int64_t>(line) % dims[0];
+          }
+          else if(axis == 2)
+          {
+            base = static_cast<int64_t>(line);
+          }
+
+          // Lower envelope of f_q(p) = h_q + (p - p_q)^2 over the positions q that have a site
+          int64_t k = -1;
+          for(int64_t q = 0; q < length; q++)
+          {
+            const int64_t cell = base + q * stride;
+            lineSites[q] = voxNN[cell];
+            if(lineSites[q] < 0)
+            {
+              continue;
+            }
+            const double pq = static_cast<double>(q) * axisSpacing;
+            lineValues[q] = distanceSquared(cell, lineSites[q]) + pq * pq;
+            double intersection = -std::numeric_limits<double>::max();
+            while(k >= 0)
+            {
+              const int64_t r = envelope[k];
+              const double pr = static_cast<double>(r) * axisSpacing;
+              intersection = (lineValues[q] - lineValues[r]) / (2.0 * (pq - pr));
+              if(intersection > boundaries[k])
+              {
+                break;
+              }
+              k--;
+            }
+            if(k < 0)
+            {
+              intersection = -std::numeric_limits<double>::max();
+            }
+            k++;
+            envelope[k] = q;
+            boundaries[k] = intersection;
+            boundaries[k + 1] = std::numeric_limits<double>::max();
+          }
+          if(k < 0)
+          {
+            continue;
+          }
+
+          int64_t j = 0;
+          for(int64_t q = 0; q < length; q++)
+          {
+            const double pq = static_cast<double>(q) * axisSpacing;
+            while(boundaries[j + 1] < pq)
+            {
+              j++;
+            }
+            voxNN[base + q * stride] = lineSites[envelope[j]];
+          }
+        }
+      });
+    }
+
+    T* distances = m_GBManhattanDistances;
+    if(m_MapType == FindEuclideanDistMap::MapType::TripleJunction)
+    {
+      distances = m_TJManhattanDistances;
+    }
+    else if(m_MapType == FindEuclideanDistMap::MapType::QuadPoint)
+    {
+      distances = m_QPManhattanDistances;
+    }
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, totalPoints);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      for(size_t a = range.min(); a < range.max(); a++)
+      {
+        const int64_t cell = static_cast<int64_t>(a);
+        if(m_FeatureIds[a] <= 0)
+        {
+          // Same as the propagation: unassigned Cells that were not cleared by the marking step are their own nearest Cell
+          if(m_NearestNeighbors[a * 3 + mapIndex] >= 0)
+          {
+            m_NearestNeighbors[a * 3 + mapIndex] = static_cast<int32_t>(a);
+            distances[a] = static_cast<T>(0);
+          }
+          continue;
+        }
+        m_NearestNeighbors[a * 3 + mapIndex] = voxNN[a];
+        if(voxNN[a] >= 0)
+        {
+          distances[a] = static_cast<T>(std::sqrt(distanceSquared(cell, voxNN[a])));
+        }
+      }
+    });
+  }
+
   void operator()() const
   {
+    if(!m_CalcManhattanDist && m_CalcExactEuclideanDist)
+    {
+      computeExactEuclideanDistances();
+      return;
+    }
+
     ImageGeom::Pointer imageGeom = m_DataContainer->getGeometryAs<ImageGeom>();
     size_t totalPoints = imageGeom->getNumberOfElements();
     double Distance = 0.0;
@@ -305,6 +469,7 @@ void FindEuclideanDistMap::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Calculate Manhattan Distance", CalcManhattanDist, FilterParameter::Category::Parameter, FindEuclideanDistMap));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Calculate Exact Euclidean Distance", CalcExactEuclideanDist, FilterParameter::Category::Parameter, FindEuclideanDistMap));
   std::vector<QString> linkedProps = {"GBDistancesArrayName"};
 
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Calculate Distance to Boundaries", DoBoundaries, FilterParameter::Category::Parameter, FindEuclideanDistMap, linkedProps));
@@ -353,6 +518,7 @@ void FindEuclideanDistMap::readFilterParameters(AbstractFilterParametersReader*
   setDoQuadPoints(reader->readValue("DoQuadPoints", getDoQuadPoints()));
   setSaveNearestNeighbors(reader->readValue("SaveNearestNeighbors", getSaveNearestNeighbors()));
   setCalcManhattanDist(reader->readValue("CalcOnlyManhattanDist", getCalcManhattanDist()));
+  setCalcExactEuclideanDist(reader->readValue("CalcExactEuclideanDist", getCalcExactEuclideanDist()));
   reader->closeFilterGroup();
 }
 
@@ -665,13 +831,13 @@ void FindEuclideanDistMap::findDistanceMap()
     {
       if(m_CalcManhattanDist)
       {
-        g->run(ComputeDistanceMapImpl<int32_t>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBManhattanDistances, m_TJManhattanDistances, m_QPManhattanDistances,
+        g->run(ComputeDistanceMapImpl<int32_t>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_CalcExactEuclideanDist, m_GBManhattanDistances, m_TJManhattanDistances, m_QPManhattanDistances,
                                                MapType::FeatureBoundary));
       }
       else
       {
         g->run(
-            ComputeDistanceMapImpl<float>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, MapType::FeatureBoundary));
+            ComputeDistanceMapImpl<float>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_CalcExactEuclideanDist, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, MapType::FeatureBoundary));
       }
     }
     if(m_DoTripleLines)
@@ -679,23 +845,23 @@ void FindEuclideanDistMap::findDistanceMap()
       if(m_CalcManhattanDist)
       {
         g->run(
-            ComputeDistanceMapImpl<int32_t>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBManhattanDistances, m_TJManhattanDistances, m_QPManhattanDistances, MapType::TripleJunction));
+            ComputeDistanceMapImpl<int32_t>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_CalcExactEuclideanDist, m_GBManhattanDistances, m_TJManhattanDistances, m_QPManhattanDistances, MapType::TripleJunction));
       }
       else
       {
         g->run(
-            ComputeDistanceMapImpl<float>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, MapType::TripleJunction));
+            ComputeDistanceMapImpl<float>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_CalcExactEuclideanDist, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, MapType::TripleJunction));
       }
     }
     if(m_DoQuadPoints)
     {
       if(m_CalcManhattanDist)
       {
-        g->run(ComputeDistanceMapImpl<int32_t>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBManhattanDistances, m_TJManhattanDistances, m_QPManhattanDistances, MapType::QuadPoint));
+        g->run(ComputeDistanceMapImpl<int32_t>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_CalcExactEuclideanDist, m_GBManhattanDistances, m_TJManhattanDistances, m_QPManhattanDistances, MapType::QuadPoint));
       }
       else
       {
-        g->run(ComputeDistanceMapImpl<float>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, MapType::QuadPoint));
+        g->run(ComputeDistanceMapImpl<float>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_CalcExactEuclideanDist, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, MapType::QuadPoint));
       }
     }
     g->wait();
@@ -719,12 +885,12 @@ void FindEuclideanDistMap::findDistanceMap()
       {
         if(m_CalcManhattanDist)
         {
-          ComputeDistanceMapImpl<int32_t> f(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBManhattanDistances, m_TJManhattanDistances, m_QPManhattanDistances, mapType);
+          ComputeDistanceMapImpl<int32_t> f(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_CalcExactEuclideanDist, m_GBManhattanDistances, m_TJManhattanDistances, m_QPManhattanDistances, mapType);
           f();
         }
         else
         {
-          ComputeDistanceMapImpl<float> f(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, mapType);
+          ComputeDistanceMapImpl<float> f(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_CalcExactEuclideanDist, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, mapType);
           f();
         }
       }
@@ -972,3 +1138,15 @@ bool FindEuclideanDistMap::getCalcManhattanDist() const
 {
   return m_CalcManhattanDist;
 }
+
+// -----------------------------------------------------------------------------
+void FindEuclideanDistMap::setCalcExactEuclideanDist(bool value)
+{
+  m_CalcExactEuclideanDist = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindEuclideanDistMap::getCalcExactEuclideanDist() const
+{
+  return m_CalcExactEuclideanDist;
+}
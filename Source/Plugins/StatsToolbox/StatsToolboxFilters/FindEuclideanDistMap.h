@@ -65,6 +65,7 @@ class StatsToolbox_EXPORT FindEuclideanDistMap : public AbstractFilter
   PYB11_PROPERTY(bool DoQuadPoints READ getDoQuadPoints WRITE setDoQuadPoints)
   PYB11_PROPERTY(bool SaveNearestNeighbors READ getSaveNearestNeighbors WRITE setSaveNearestNeighbors)
   PYB11_PROPERTY(bool CalcManhattanDist READ getCalcManhattanDist WRITE setCalcManhattanDist)
+  PYB11_PROPERTY(bool CalcExactEuclideanDist READ getCalcExactEuclideanDist WRITE setCalcExactEuclideanDist)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -217,6 +218,17 @@ public:
   bool getCalcManhattanDist() const;
   Q_PROPERTY(bool CalcManhattanDist READ getCalcManhattanDist WRITE setCalcManhattanDist)
 
+  /**
+   * @brief Setter property for CalcExactEuclideanDist
+   */
+  void setCalcExactEuclideanDist(bool value);
+  /**
+   * @brief Getter property for CalcExactEuclideanDist
+   * @return Value of CalcExactEuclideanDist
+   */
+  bool getCalcExactEuclideanDist() const;
+  Q_PROPERTY(bool CalcExactEuclideanDist READ getCalcExactEuclideanDist WRITE setCalcExactEuclideanDist)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -328,6 +340,7 @@ private:
   bool m_DoQuadPoints = {false};
   bool m_SaveNearestNeighbors = {false};
   bool m_CalcManhattanDist = {true};
+  bool m_CalcExactEuclideanDist = {false};
 
   // Full Euclidean Distance Arrays
 
@@ -34,7 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindFeatureClustering.h"
 
+#include <algorithm>
 #include <fstream>
+#include <utility>
 
 #include <QtCore/QTextStream>
 
@@ -44,6 +46,7 @@
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
@@ -52,8 +55,10 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/RadialDistributionFunction.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "StatsToolbox/StatsToolboxConstants.h"
+#include "StatsToolbox/StatsToolboxFilters/util/FeatureCentroidGrid.hpp"
 #include "StatsToolbox/StatsToolboxVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -84,6 +89,9 @@ void FindFeatureClustering::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Phase Index", PhaseNumber, FilterParameter::Category::Parameter, FindFeatureClustering));
   std::vector<QString> linkedProps = {"BiasedFeaturesArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Remove Biased Features", RemoveBiasedFeatures, FilterParameter::Category::Parameter, FindFeatureClustering, linkedProps));
+  linkedProps = {"MaximumDistance"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Limit Separation Distance", UseMaximumDistance, FilterParameter::Category::Parameter, FindFeatureClustering, linkedProps));
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Maximum Separation Distance", MaximumDistance, FilterParameter::Category::Parameter, FindFeatureClustering));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Feature Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -138,6 +146,8 @@ void FindFeatureClustering::readFilterParameters(AbstractFilterParametersReader*
   setPhaseNumber(reader->readValue("PhaseNumber", getPhaseNumber()));
   setBiasedFeaturesArrayPath(reader->readDataArrayPath("BiasedFeaturesArrayPath", getBiasedFeaturesArrayPath()));
   setRemoveBiasedFeatures(reader->readValue("RemoveBiasedFeatures", getRemoveBiasedFeatures()));
+  setUseMaximumDistance(reader->readValue("UseMaximumDistance", getUseMaximumDistance()));
+  setMaximumDistance(reader->readValue("MaximumDistance", getMaximumDistance()));
   reader->closeFilterGroup();
 }
 
@@ -192,6 +202,12 @@ void FindFeatureClustering::dataCheck()
     } /* Now assign the raw pointer to data from the DataArray<T> object */
   }
 
+  if(m_UseMaximumDistance && !(m_MaximumDistance > 0.0f))
+  {
+    QString ss = QObject::tr("The Maximum Separation Distance must be greater than zero");
+    setErrorCondition(-1001, ss);
+  }
+
   cDims[0] = m_NumberOfBins;
 
   tempPath.update(getCellEnsembleAttributeMatrixName().getDataContainerName(), getCellEnsembleAttributeMatrixName().getAttributeMatrixName(), getNewEnsembleArrayArrayName());
@@ -276,36 +292,85 @@ void FindFeatureClustering::find_clustering()
 
   clusteringlist.resize(totalFeatures);
 
-  for(size_t i = 1; i < totalFeatures; i++)
+  if(m_UseMaximumDistance)
   {
-    if(m_FeaturePhases[i] == m_PhaseNumber)
+    // Only the pairs closer than the cutoff are kept, so each Feature only needs the Features in the
+    // grid cells around it. The lists stay ordered by partner id exactly as the full search orders them.
+    FeatureCentroidGrid grid(m_Centroids, totalFeatures, [this](size_t i) { return i > 0 && m_FeaturePhases[i] == m_PhaseNumber; }, m_MaximumDistance);
+    std::vector<std::vector<std::pair<int32_t, float>>> partners(totalFeatures);
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(1ULL, totalFeatures);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      for(size_t i = range.min(); i < range.max(); i++)
+      {
+        if(m_FeaturePhases[i] != m_PhaseNumber)
+        {
+          continue;
+        }
+        const float* centroid = m_Centroids + 3 * i;
+        grid.forEachWithinRadius({centroid[0], centroid[1], centroid[2]}, m_MaximumDistance, [&](size_t j) {
+          if(j == i)
+          {
+            return;
+          }
+          const float* other = m_Centroids + 3 * j;
+          const float dist = sqrtf((centroid[0] - other[0]) * (centroid[0] - other[0]) + (centroid[1] - other[1]) * (centroid[1] - other[1]) + (centroid[2] - other[2]) * (centroid[2] - other[2]));
+          if(dist <= m_MaximumDistance)
+          {
+            partners[i].emplace_back(static_cast<int32_t>(j), dist);
+          }
+        });
+        std::sort(partners[i].begin(), partners[i].end());
+      }
+    });
+
+    for(size_t i = 1; i < totalFeatures; i++)
     {
-      if(i % 1000 == 0)
+      clusteringlist[i].reserve(partners[i].size());
+      for(const auto& partner : partners[i])
       {
-        QString ss = QObject::tr("Working on Feature %1 of %2").arg(i).arg(totalPPTfeatures);
-        notifyStatusMessage(ss);
+        clusteringlist[i].push_back(partner.second);
+        if(writeErrorFile && partner.first > static_cast<int32_t>(i) && m_FeaturePhases[partner.first] == 2)
+        {
+          outFile << partner.second << "\n" << partner.second << "\n";
+        }
       }
+    }
+  }
+  else
+  {
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      if(m_FeaturePhases[i] == m_PhaseNumber)
+      {
+        if(i % 1000 == 0)
+        {
+          QString ss = QObject::tr("Working on Feature %1 of %2").arg(i).arg(totalPPTfeatures);
+          notifyStatusMessage(ss);
+        }
 
-      x = m_Centroids[3 * i];
-      y = m_Centroids[3 * i + 1];
-      z = m_Centroids[3 * i + 2];
+        x = m_Centroids[3 * i];
+        y = m_Centroids[3 * i + 1];
+        z = m_Centroids[3 * i + 2];
 
-      for(size_t j = i + 1; j < totalFeatures; j++)
-      {
-        if(m_FeaturePhases[i] == m_FeaturePhases[j])
+        for(size_t j = i + 1; j < totalFeatures; j++)
         {
-          xn = m_Centroids[3 * j];
-          yn = m_Centroids[3 * j + 1];
-          zn = m_Centroids[3 * j + 2];
+          if(m_FeaturePhases[i] == m_FeaturePhases[j])
+          {
+            xn = m_Centroids[3 * j];
+            yn = m_Centroids[3 * j + 1];
+            zn = m_Centroids[3 * j + 2];
 
-          r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+            r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
 
-          clusteringlist[i].push_back(r);
-          clusteringlist[j].push_back(r);
+            clusteringlist[i].push_back(r);
+            clusteringlist[j].push_back(r);
 
-          if(writeErrorFile && m_FeaturePhases[j] == 2)
-          {
-            outFile << r << "\n" << r << "\n";
+            if(writeErrorFile && m_FeaturePhases[j] == 2)
+            {
+              outFile << r << "\n" << r << "\n";
+            }
           }
         }
       }
@@ -584,6 +649,30 @@ bool FindFeatureClustering::getRemoveBiasedFeatures() const
   return m_RemoveBiasedFeatures;
 }
 
+// -----------------------------------------------------------------------------
+void FindFeatureClustering::setUseMaximumDistance(bool value)
+{
+  m_UseMaximumDistance = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindFeatureClustering::getUseMaximumDistance() const
+{
+  return m_UseMaximumDistance;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureClustering::setMaximumDistance(float value)
+{
+  m_MaximumDistance = value;
+}
+
+// -----------------------------------------------------------------------------
+float FindFeatureClustering::getMaximumDistance() const
+{
+  return m_MaximumDistance;
+}
+
 // -----------------------------------------------------------------------------
 void FindFeatureClustering::setBiasedFeaturesArrayPath(const DataArrayPath& value)
 {
@@ -60,6 +60,8 @@ class StatsToolbox_EXPORT FindFeatureClustering : public AbstractFilter
   PYB11_PROPERTY(int PhaseNumber READ getPhaseNumber WRITE setPhaseNumber)
   PYB11_PROPERTY(DataArrayPath CellEnsembleAttributeMatrixName READ getCellEnsembleAttributeMatrixName WRITE setCellEnsembleAttributeMatrixName)
   PYB11_PROPERTY(bool RemoveBiasedFeatures READ getRemoveBiasedFeatures WRITE setRemoveBiasedFeatures)
+  PYB11_PROPERTY(bool UseMaximumDistance READ getUseMaximumDistance WRITE setUseMaximumDistance)
+  PYB11_PROPERTY(float MaximumDistance READ getMaximumDistance WRITE setMaximumDistance)
   PYB11_PROPERTY(DataArrayPath BiasedFeaturesArrayPath READ getBiasedFeaturesArrayPath WRITE setBiasedFeaturesArrayPath)
   PYB11_PROPERTY(DataArrayPath EquivalentDiametersArrayPath READ getEquivalentDiametersArrayPath WRITE setEquivalentDiametersArrayPath)
   PYB11_PROPERTY(DataArrayPath FeaturePhasesArrayPath READ getFeaturePhasesArrayPath WRITE setFeaturePhasesArrayPath)
@@ -154,6 +156,28 @@ public:
   bool getRemoveBiasedFeatures() const;
   Q_PROPERTY(bool RemoveBiasedFeatures READ getRemoveBiasedFeatures WRITE setRemoveBiasedFeatures)
 
+  /**
+   * @brief Setter property for UseMaximumDistance
+   */
+  void setUseMaximumDistance(bool value);
+  /**
+   * @brief Getter property for UseMaximumDistance
+   * @return Value of UseMaximumDistance
+   */
+  bool getUseMaximumDistance() const;
+  Q_PROPERTY(bool UseMaximumDistance READ getUseMaximumDistance WRITE setUseMaximumDistance)
+
+  /**
+   * @brief Setter property for MaximumDistance
+   */
+  void setMaximumDistance(float value);
+  /**
+   * @brief Getter property for MaximumDistance
+   * @return Value of MaximumDistance
+   */
+  float getMaximumDistance() const;
+  Q_PROPERTY(float MaximumDistance READ getMaximumDistance WRITE setMaximumDistance)
+
   /**
    * @brief Setter property for BiasedFeaturesArrayPath
    */
@@ -327,6 +351,8 @@ private:
   int m_PhaseNumber = {1};
   DataArrayPath m_CellEnsembleAttributeMatrixName = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, ""};
   bool m_RemoveBiasedFeatures = {false};
+  bool m_UseMaximumDistance = {false};
+  float m_MaximumDistance = {1.0f};
   DataArrayPath m_BiasedFeaturesArrayPath = {};
   DataArrayPath m_EquivalentDiametersArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::EquivalentDiameters};
   DataArrayPath m_FeaturePhasesArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Phases};
@@ -0,0 +1,838 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FindFeatureMorphology.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/FilterParameters/StringFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+
+#include "Common/BiasedFeatures.hpp"
+#include "Common/FeatureReduction.hpp"
+
+#include "StatsToolbox/StatsToolboxConstants.h"
+#include "StatsToolbox/StatsToolboxFilters/util/TripletSort.hpp"
+#include "StatsToolbox/StatsToolboxVersion.h"
+
+namespace
+{
+/**
+ * @brief The VoxelSums struct holds the exact integer sums of the voxel indices of one Feature. Every
+ * quantity the individual filters accumulate per voxel (count, centroid, second moments) is a closed form
+ * of these sums, so the Feature Ids only have to be swept once.
+ */
+struct VoxelSums
+{
+  uint64_t count = 0;
+  std::array<uint64_t, 3> first = {0, 0, 0};           // x, y, z
+  std::array<uint64_t, 6> second = {0, 0, 0, 0, 0, 0}; // xx, yy, zz, xy, yz, xz
+  bool surface = false;
+};
+
+} // namespace
+
+/* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
+enum createdPathID : RenameDataPath::DataID_t
+{
+  DataArrayID30 = 30,
+  DataArrayID31 = 31,
+  DataArrayID32 = 32,
+  DataArrayID33 = 33,
+  DataArrayID34 = 34,
+  DataArrayID35 = 35,
+  DataArrayID36 = 36,
+  DataArrayID37 = 37,
+  DataArrayID38 = 38,
+  DataArrayID39 = 39,
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FindFeatureMorphology::FindFeatureMorphology() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FindFeatureMorphology::~FindFeatureMorphology() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setupFilterParameters()
+{
+  FilterParameterVectorType parameters;
+  std::vector<QString> linkedProps = {"PhasesArrayPath"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Apply Phase by Phase", CalcByPhase, FilterParameter::Category::Parameter, FindFeatureMorphology, linkedProps));
+  parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Feature Ids", FeatureIdsArrayPath, FilterParameter::Category::RequiredArray, FindFeatureMorphology, req));
+  }
+  parameters.push_back(SeparatorFilterParameter::Create("Cell Feature Data", FilterParameter::Category::RequiredArray));
+  {
+    AttributeMatrixSelectionFilterParameter::RequirementType req = AttributeMatrixSelectionFilterParameter::CreateRequirement(AttributeMatrix::Type::CellFeature, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_AM_SELECTION_FP("Cell Feature Attribute Matrix", CellFeatureAttributeMatrixName, FilterParameter::Category::RequiredArray, FindFeatureMorphology, req));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::CellFeature, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Phases", PhasesArrayPath, FilterParameter::Category::RequiredArray, FindFeatureMorphology, req));
+  }
+  parameters.push_back(SeparatorFilterParameter::Create("Cell Feature Data", FilterParameter::Category::CreatedArray));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Centroids", CentroidsArrayName, CellFeatureAttributeMatrixName, CellFeatureAttributeMatrixName, FilterParameter::Category::CreatedArray,
+                                                      FindFeatureMorphology));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Volumes", VolumesArrayName, CellFeatureAttributeMatrixName, CellFeatureAttributeMatrixName, FilterParameter::Category::CreatedArray,
+                                                      FindFeatureMorphology));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Equivalent Diameters", EquivalentDiametersArrayName, CellFeatureAttributeMatrixName, CellFeatureAttributeMatrixName, FilterParameter::Category::CreatedArray,
+                                                      FindFeatureMorphology));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Number of Elements", NumElementsArrayName, CellFeatureAttributeMatrixName, CellFeatureAttributeMatrixName, FilterParameter::Category::CreatedArray,
+                                                      FindFeatureMorphology));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Omega3s", Omega3sArrayName, CellFeatureAttributeMatrixName, CellFeatureAttributeMatrixName, FilterParameter::Category::CreatedArray,
+                                                      FindFeatureMorphology));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Axis Lengths", AxisLengthsArrayName, CellFeatureAttributeMatrixName, CellFeatureAttributeMatrixName, FilterParameter::Category::CreatedArray,
+                                                      FindFeatureMorphology));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Axis Euler Angles", AxisEulerAnglesArrayName, CellFeatureAttributeMatrixName, CellFeatureAttributeMatrixName, FilterParameter::Category::CreatedArray,
+                                                      FindFeatureMorphology));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Aspect Ratios", AspectRatiosArrayName, CellFeatureAttributeMatrixName, CellFeatureAttributeMatrixName, FilterParameter::Category::CreatedArray,
+                                                      FindFeatureMorphology));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Surface Features", SurfaceFeaturesArrayName, CellFeatureAttributeMatrixName, CellFeatureAttributeMatrixName, FilterParameter::Category::CreatedArray,
+                                                      FindFeatureMorphology));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Biased Features", BiasedFeaturesArrayName, CellFeatureAttributeMatrixName, CellFeatureAttributeMatrixName, FilterParameter::Category::CreatedArray,
+                                                      FindFeatureMorphology));
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
+  setCellFeatureAttributeMatrixName(reader->readDataArrayPath("CellFeatureAttributeMatrixName", getCellFeatureAttributeMatrixName()));
+  setCalcByPhase(reader->readValue("CalcByPhase", getCalcByPhase()));
+  setPhasesArrayPath(reader->readDataArrayPath("PhasesArrayPath", getPhasesArrayPath()));
+  setCentroidsArrayName(reader->readString("CentroidsArrayName", getCentroidsArrayName()));
+  setVolumesArrayName(reader->readString("VolumesArrayName", getVolumesArrayName()));
+  setEquivalentDiametersArrayName(reader->readString("EquivalentDiametersArrayName", getEquivalentDiametersArrayName()));
+  setNumElementsArrayName(reader->readString("NumElementsArrayName", getNumElementsArrayName()));
+  setOmega3sArrayName(reader->readString("Omega3sArrayName", getOmega3sArrayName()));
+  setAxisLengthsArrayName(reader->readString("AxisLengthsArrayName", getAxisLengthsArrayName()));
+  setAxisEulerAnglesArrayName(reader->readString("AxisEulerAnglesArrayName", getAxisEulerAnglesArrayName()));
+  setAspectRatiosArrayName(reader->readString("AspectRatiosArrayName", getAspectRatiosArrayName()));
+  setSurfaceFeaturesArrayName(reader->readString("SurfaceFeaturesArrayName", getSurfaceFeaturesArrayName()));
+  setBiasedFeaturesArrayName(reader->readString("BiasedFeaturesArrayName", getBiasedFeaturesArrayName()));
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::initialize()
+{
+  m_ScaleFactor = 1.0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::dataCheck()
+{
+  clearErrorCode();
+  clearWarningCode();
+  initialize();
+  DataArrayPath tempPath;
+
+  ImageGeom::Pointer imageGeom = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getFeatureIdsArrayPath().getDataContainerName());
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  if(imageGeom->getXPoints() <= 1 || imageGeom->getYPoints() <= 1 || imageGeom->getZPoints() <= 1)
+  {
+    QString ss = QObject::tr("The Image Geometry must have more than one cell along every axis (it is %1 x %2 x %3). Use the individual Find Feature Sizes, Find Feature Centroids, Find Feature "
+                             "Shapes, Find Surface Features and Find Biased Features (Bounding Box) filters for 2D data")
+                     .arg(imageGeom->getXPoints())
+                     .arg(imageGeom->getYPoints())
+                     .arg(imageGeom->getZPoints());
+    setErrorCondition(-11000, ss);
+    return;
+  }
+
+  QVector<DataArrayPath> dataArrayPaths;
+
+  std::vector<size_t> cDims = {1};
+  m_FeatureIdsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>>(this, getFeatureIdsArrayPath(), cDims);
+
+  DataArrayPath featurePath = getCellFeatureAttributeMatrixName();
+  tempPath.update(featurePath.getDataContainerName(), featurePath.getAttributeMatrixName(), getVolumesArrayName());
+  m_VolumesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims, "", DataArrayID31);
+  if(getErrorCode() >= 0)
+  {
+    dataArrayPaths.push_back(tempPath);
+  }
+
+  tempPath.update(featurePath.getDataContainerName(), featurePath.getAttributeMatrixName(), getEquivalentDiametersArrayName());
+  m_EquivalentDiametersPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims, "", DataArrayID32);
+
+  tempPath.update(featurePath.getDataContainerName(), featurePath.getAttributeMatrixName(), getNumElementsArrayName());
+  m_NumElementsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>>(this, tempPath, 0, cDims, "", DataArrayID33);
+
+  tempPath.update(featurePath.getDataContainerName(), featurePath.getAttributeMatrixName(), getOmega3sArrayName());
+  m_Omega3sPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims, "", DataArrayID34);
+
+  tempPath.update(featurePath.getDataContainerName(), featurePath.getAttributeMatrixName(), getSurfaceFeaturesArrayName());
+  m_SurfaceFeaturesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<bool>>(this, tempPath, false, cDims, "", DataArrayID35);
+
+  tempPath.update(featurePath.getDataContainerName(), featurePath.getAttributeMatrixName(), getBiasedFeaturesArrayName());
+  m_BiasedFeaturesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<bool>>(this, tempPath, false, cDims, "", DataArrayID36);
+
+  if(getCalcByPhase())
+  {
+    m_PhasesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>>(this, getPhasesArrayPath(), cDims);
+    if(getErrorCode() >= 0)
+    {
+      dataArrayPaths.push_back(getPhasesArrayPath());
+    }
+  }
+
+  cDims[0] = 3;
+  tempPath.update(featurePath.getDataContainerName(), featurePath.getAttributeMatrixName(), getCentroidsArrayName());
+  m_CentroidsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims, "", DataArrayID30);
+
+  tempPath.update(featurePath.getDataContainerName(), featurePath.getAttributeMatrixName(), getAxisLengthsArrayName());
+  m_AxisLengthsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims, "", DataArrayID37);
+
+  tempPath.update(featurePath.getDataContainerName(), featurePath.getAttributeMatrixName(), getAxisEulerAnglesArrayName());
+  m_AxisEulerAnglesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims, "", DataArrayID38);
+
+  cDims[0] = 2;
+  tempPath.update(featurePath.getDataContainerName(), featurePath.getAttributeMatrixName(), getAspectRatiosArrayName());
+  m_AspectRatiosPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims, "", DataArrayID39);
+
+  getDataContainerArray()->validateNumberOfTuples(this, dataArrayPaths);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::find_shape(size_t featureId, const double moments[6], size_t numElements, const FloatVec3Type& spacing)
+{
+  FloatArrayType& omega3s = *(m_Omega3sPtr.lock());
+  FloatArrayType& axisLengths = *(m_AxisLengthsPtr.lock());
+  FloatArrayType& axisEulerAngles = *(m_AxisEulerAnglesPtr.lock());
+  FloatArrayType& aspectRatios = *(m_AspectRatiosPtr.lock());
+
+  float modXRes = spacing[0] * static_cast<float>(m_ScaleFactor);
+  float modYRes = spacing[1] * static_cast<float>(m_ScaleFactor);
+  float modZRes = spacing[2] * static_cast<float>(m_ScaleFactor);
+
+  double sphere = (2000.0 * M_PI * M_PI) / 9.0;
+  // constant for moments because voxels are broken into smaller voxels
+  double konst1 = static_cast<double>((modXRes / 2.0) * (modYRes / 2.0) * (modZRes / 2.0));
+  double konst3 = static_cast<double>((modXRes) * (modYRes) * (modZRes));
+
+  // calculating the modified volume for the omega3 value
+  double vol5 = static_cast<double>(numElements) * konst3;
+  std::array<double, 6> featureMoments = {moments[0] * konst1, moments[1] * konst1, moments[2] * konst1, -moments[3] * konst1, -moments[4] * konst1, -moments[5] * konst1};
+
+  // Now store the 3x3 Matrix for the Eigen Value/Vectors
+  Eigen::Matrix3f moment;
+  // clang-format off
+  moment <<
+    featureMoments[0], featureMoments[3], featureMoments[5],
+    featureMoments[3], featureMoments[1], featureMoments[4],
+    featureMoments[5], featureMoments[4], featureMoments[2];
+  // clang-format on
+  Eigen::EigenSolver<Eigen::Matrix3f> es(moment);
+  Eigen::EigenSolver<Eigen::Matrix3f>::EigenvalueType eigenValues = es.eigenvalues();
+  Eigen::EigenSolver<Eigen::Matrix3f>::EigenvectorsType eigenVectors = es.eigenvectors();
+
+  // Returns the argument order sorted high to low
+  std::array<size_t, 3> idxs = ::TripletSort(eigenValues[0].real(), eigenValues[1].real(), eigenValues[2].real(), false);
+
+  // Principal axes as the columns of the Feature reference frame, smallest Eigen Value first
+  // (Note that the 3 direction is actually the long axis and the 1 direction is actually the short axis)
+  float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+  for(size_t c = 0; c < 3; c++)
+  {
+    auto col = eigenVectors.col(idxs[2 - c]);
+    g[c][0] = col(0).real();
+    g[c][1] = col(1).real();
+    g[c][2] = col(2).real();
+  }
+
+  // Adjust to ABC of ellipsoid volume
+  constexpr double multiplier = 1.0 / (4.0 * M_PI);
+  double I1 = (15.0 * static_cast<double>(eigenValues[idxs[0]].real())) * multiplier;
+  double I2 = (15.0 * static_cast<double>(eigenValues[idxs[1]].real())) * multiplier;
+  double I3 = (15.0 * static_cast<double>(eigenValues[idxs[2]].real())) * multiplier;
+  double A = (I1 + I2 - I3) * 0.5;
+  double B = (I1 + I3 - I2) * 0.5;
+  double C = (I2 + I3 - I1) * 0.5;
+  double a = (A * A * A * A) / (B * C);
+  a = std::pow(a, 0.1);
+  double b = B / A;
+  b = std::sqrt(b) * a;
+  double c = A / (a * a * a * b);
+
+  axisLengths[3 * featureId] = static_cast<float>(a / m_ScaleFactor);
+  axisLengths[3 * featureId + 1] = static_cast<float>(b / m_ScaleFactor);
+  axisLengths[3 * featureId + 2] = static_cast<float>(c / m_ScaleFactor);
+  double bovera = b / a;
+  double covera = c / a;
+  if(A == 0.0 || B == 0.0 || C == 0.0)
+  {
+    bovera = 0.0f;
+    covera = 0.0f;
+  }
+  aspectRatios[2 * featureId] = bovera;
+  aspectRatios[2 * featureId + 1] = covera;
+
+  // check for right-handedness
+  OrientationTransformation::ResultType result = OrientationTransformation::om_check(OrientationF(g));
+  if(result.result == 0)
+  {
+    g[2][0] *= -1.0f;
+    g[2][1] *= -1.0f;
+    g[2][2] *= -1.0f;
+  }
+
+  OrientationF eu = OrientationTransformation::om2eu<OrientationF, OrientationF>(OrientationF(g));
+
+  axisEulerAngles[3 * featureId] = eu[0];
+  axisEulerAngles[3 * featureId + 1] = eu[1];
+  axisEulerAngles[3 * featureId + 2] = eu[2];
+
+  float u200 = static_cast<float>((featureMoments[1] + featureMoments[2] - featureMoments[0]) / 2.0f);
+  float u020 = static_cast<float>((featureMoments[0] + featureMoments[2] - featureMoments[1]) / 2.0f);
+  float u002 = static_cast<float>((featureMoments[0] + featureMoments[1] - featureMoments[2]) / 2.0f);
+  float u110 = static_cast<float>(-featureMoments[3]);
+  float u011 = static_cast<float>(-featureMoments[4]);
+  float u101 = static_cast<float>(-featureMoments[5]);
+  double o3 = static_cast<double>((u200 * u020 * u002) + (2.0f * u110 * u101 * u011) - (u200 * u011 * u011) - (u020 * u101 * u101) - (u002 * u110 * u110));
+  vol5 = pow(vol5, 5.0);
+  double omega3 = vol5 / o3;
+  omega3 = omega3 / sphere;
+  if(omega3 > 1)
+  {
+    omega3 = 1.0;
+  }
+  if(vol5 == 0.0)
+  {
+    omega3 = 0.0;
+  }
+  omega3s[featureId] = static_cast<float>(omega3);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::find_biased_features()
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
+  float boundbox[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  m->getGeometryAs<ImageGeom>()->getBoundingBox(boundbox);
+
+  int32_t* phases = m_CalcByPhase ? m_PhasesPtr.lock()->getPointer(0) : nullptr;
+  FindBiasedFeatures(boundbox, m_CentroidsPtr.lock()->getPointer(0), m_SurfaceFeaturesPtr.lock()->getPointer(0), phases, m_CentroidsPtr.lock()->getNumberOfTuples(),
+                     m_BiasedFeaturesPtr.lock()->getPointer(0), [this](int32_t phase, int32_t numPhases) {
+                       QString ss = QObject::tr("Working on Phase %1 of %2").arg(phase).arg(numPhases);
+                       notifyStatusMessage(ss);
+                     });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::execute()
+{
+  dataCheck();
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
+
+  size_t xPoints = imageGeom->getXPoints();
+  size_t yPoints = imageGeom->getYPoints();
+  size_t zPoints = imageGeom->getZPoints();
+  FloatVec3Type spacing = imageGeom->getSpacing();
+  FloatVec3Type origin = imageGeom->getOrigin();
+
+  m_ScaleFactor = static_cast<double>(1.0f / spacing[0]);
+  if(spacing[1] > spacing[0] && spacing[1] > spacing[2])
+  {
+    m_ScaleFactor = static_cast<double>(1.0f / spacing[1]);
+  }
+  if(spacing[2] > spacing[0] && spacing[2] > spacing[1])
+  {
+    m_ScaleFactor = static_cast<double>(1.0f / spacing[2]);
+  }
+
+  Int32ArrayType& featureIds = *(m_FeatureIdsPtr.lock());
+  size_t totalPoints = featureIds.getNumberOfTuples();
+  size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
+
+  // The products of voxel indices are summed exactly, so the whole volume has to fit the 64 bit sums
+  size_t maxPoints = std::max({xPoints, yPoints, zPoints});
+  if(totalPoints > std::numeric_limits<uint64_t>::max() / (maxPoints * maxPoints))
+  {
+    QString ss = QObject::tr("The Image Geometry (%1 x %2 x %3) is too large for the exact voxel index sums").arg(xPoints).arg(yPoints).arg(zPoints);
+    setErrorCondition(-11001, ss);
+    return;
+  }
+
+  const size_t sliceStride = xPoints * yPoints;
+
+  // Single sweep over the Feature Ids: voxel index sums for the sizes, centroids and moments plus the surface flag
+  std::vector<VoxelSums> sums = FeatureReduction::Reduce<VoxelSums>(
+      totalPoints, numfeatures,
+      [&](VoxelSums* featureSums, size_t voxelIndex) {
+        uint64_t k = voxelIndex % xPoints;
+        uint64_t j = (voxelIndex / xPoints) % yPoints;
+        uint64_t i = voxelIndex / sliceStride;
+        VoxelSums& featureSum = featureSums[featureIds[voxelIndex]];
+        featureSum.count++;
+        featureSum.first[0] += k;
+        featureSum.first[1] += j;
+        featureSum.first[2] += i;
+        featureSum.second[0] += k * k;
+        featureSum.second[1] += j * j;
+        featureSum.second[2] += i * i;
+        featureSum.second[3] += k * j;
+        featureSum.second[4] += j * i;
+        featureSum.second[5] += k * i;
+        if(!featureSum.surface)
+        {
+          if(k == 0 || k == xPoints - 1 || j == 0 || j == yPoints - 1 || i == 0 || i == zPoints - 1)
+          {
+            featureSum.surface = true;
+          }
+          else if(featureIds[voxelIndex - 1] == 0 || featureIds[voxelIndex + 1] == 0 || featureIds[voxelIndex - xPoints] == 0 || featureIds[voxelIndex + xPoints] == 0 ||
+                  featureIds[voxelIndex - sliceStride] == 0 || featureIds[voxelIndex + sliceStride] == 0)
+          {
+            featureSum.surface = true;
+          }
+        }
+      },
+      [](VoxelSums& into, const VoxelSums& from) {
+        into.count += from.count;
+        for(size_t idx = 0; idx < 3; idx++)
+        {
+          into.first[idx] += from.first[idx];
+        }
+        for(size_t idx = 0; idx < 6; idx++)
+        {
+          into.second[idx] += from.second[idx];
+        }
+        into.surface = into.surface || from.surface;
+      });
+
+  for(size_t featureId = 1; featureId < numfeatures; featureId++)
+  {
+    if(sums[featureId].count > 9007199254740992ULL)
+    {
+      QString ss = QObject::tr("Number of voxels belonging to feature %1 (%2) is greater than 9007199254740992").arg(featureId).arg(sums[featureId].count);
+      setErrorCondition(-11002, ss);
+      return;
+    }
+  }
+
+  FloatArrayType& centroids = *(m_CentroidsPtr.lock());
+  FloatArrayType& volumes = *(m_VolumesPtr.lock());
+  FloatArrayType& equivalentDiameters = *(m_EquivalentDiametersPtr.lock());
+  Int32ArrayType& numElements = *(m_NumElementsPtr.lock());
+  BoolArrayType& surfaceFeatures = *(m_SurfaceFeaturesPtr.lock());
+
+  float res_scalar = spacing[0] * spacing[1] * spacing[2];
+  float vol_term = (4.0f / 3.0f) * SIMPLib::Constants::k_PiD;
+  float scale = static_cast<float>(m_ScaleFactor);
+  // using a modified resolution to keep the moment calculations "small" and prevent exceeding numerical bounds.
+  std::array<double, 3> modRes = {spacing[0] * scale, spacing[1] * scale, spacing[2] * scale};
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numfeatures);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t featureId = range.min(); featureId < range.max(); featureId++)
+    {
+      const VoxelSums& featureSum = sums[featureId];
+      surfaceFeatures[featureId] = featureSum.surface;
+      double count = static_cast<double>(featureSum.count);
+      if(featureSum.count > 0)
+      {
+        for(size_t d = 0; d < 3; d++)
+        {
+          centroids[featureId * 3 + d] = origin[d] + (static_cast<double>(featureSum.first[d]) / count + 0.5) * spacing[d];
+        }
+      }
+      if(featureId == 0)
+      {
+        continue;
+      }
+
+      numElements[featureId] = static_cast<int32_t>(featureSum.count);
+      volumes[featureId] = count * static_cast<double>(res_scalar);
+      float rad = volumes[featureId] / vol_term;
+      equivalentDiameters[featureId] = 2.0f * powf(rad, 0.3333333333f);
+
+      // Offset of the voxel at index 0 from the centroid in the scaled frame; each voxel lies at offset + index * modRes
+      std::array<double, 3> offset = {0.0, 0.0, 0.0};
+      for(size_t d = 0; d < 3; d++)
+      {
+        offset[d] = static_cast<double>(origin[d] * scale) - static_cast<double>(centroids[featureId * 3 + d] * scale);
+      }
+      // Sum over the Feature of (offset_a + index_a * modRes_a) * (offset_b + index_b * modRes_b)
+      auto centralSum = [&](size_t a, size_t b, uint64_t indexProductSum) {
+        return modRes[a] * modRes[b] * static_cast<double>(indexProductSum) + modRes[a] * offset[b] * static_cast<double>(featureSum.first[a]) +
+               modRes[b] * offset[a] * static_cast<double>(featureSum.first[b]) + count * offset[a] * offset[b];
+      };
+      double sxx = centralSum(0, 0, featureSum.second[0]);
+      double syy = centralSum(1, 1, featureSum.second[1]);
+      double szz = centralSum(2, 2, featureSum.second[2]);
+      // Each voxel is split into 8 sub-voxels offset by a quarter voxel along every axis, which adds a constant
+      // to the squared terms and cancels out of the cross terms
+      std::array<double, 3> quarter = {0.0, 0.0, 0.0};
+      for(size_t d = 0; d < 3; d++)
+      {
+        quarter[d] = count * (modRes[d] / 4.0) * (modRes[d] / 4.0);
+      }
+      double moments[6] = {8.0 * (syy + szz + quarter[1] + quarter[2]),
+                           8.0 * (sxx + szz + quarter[0] + quarter[2]),
+                           8.0 * (sxx + syy + quarter[0] + quarter[1]),
+                           8.0 * centralSum(0, 1, featureSum.second[3]),
+                           8.0 * centralSum(1, 2, featureSum.second[4]),
+                           8.0 * centralSum(0, 2, featureSum.second[5])};
+      find_shape(featureId, moments, featureSum.count, spacing);
+    }
+  });
+
+  find_biased_features();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer FindFeatureMorphology::newFilterInstance(bool copyFilterParameters) const
+{
+  FindFeatureMorphology::Pointer filter = FindFeatureMorphology::New();
+  if(copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getCompiledLibraryName() const
+{
+  return StatsToolboxConstants::StatsToolboxBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getBrandingString() const
+{
+  return "Statistics";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getFilterVersion() const
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream << StatsToolbox::Version::Major() << "." << StatsToolbox::Version::Minor() << "." << StatsToolbox::Version::Patch();
+  return version;
+}
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getGroupName() const
+{
+  return SIMPL::FilterGroups::StatisticsFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QUuid FindFeatureMorphology::getUuid() const
+{
+  return QUuid("{4b2ca3c0-6a8f-5d7e-9c1b-2f7a5e3d8b61}");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getSubGroupName() const
+{
+  return SIMPL::FilterSubGroups::MorphologicalFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getHumanLabel() const
+{
+  return "Find Feature Morphology";
+}
+
+// -----------------------------------------------------------------------------
+FindFeatureMorphology::Pointer FindFeatureMorphology::NullPointer()
+{
+  return Pointer(static_cast<Self*>(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+std::shared_ptr<FindFeatureMorphology> FindFeatureMorphology::New()
+{
+  struct make_shared_enabler : public FindFeatureMorphology
+  {
+  };
+  std::shared_ptr<make_shared_enabler> val = std::make_shared<make_shared_enabler>();
+  val->setupFilterParameters();
+  return val;
+}
+
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getNameOfClass() const
+{
+  return QString("FindFeatureMorphology");
+}
+
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::ClassName()
+{
+  return QString("FindFeatureMorphology");
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setFeatureIdsArrayPath(const DataArrayPath& value)
+{
+  m_FeatureIdsArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath FindFeatureMorphology::getFeatureIdsArrayPath() const
+{
+  return m_FeatureIdsArrayPath;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setCellFeatureAttributeMatrixName(const DataArrayPath& value)
+{
+  m_CellFeatureAttributeMatrixName = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath FindFeatureMorphology::getCellFeatureAttributeMatrixName() const
+{
+  return m_CellFeatureAttributeMatrixName;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setCalcByPhase(bool value)
+{
+  m_CalcByPhase = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindFeatureMorphology::getCalcByPhase() const
+{
+  return m_CalcByPhase;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setPhasesArrayPath(const DataArrayPath& value)
+{
+  m_PhasesArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath FindFeatureMorphology::getPhasesArrayPath() const
+{
+  return m_PhasesArrayPath;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setCentroidsArrayName(const QString& value)
+{
+  m_CentroidsArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getCentroidsArrayName() const
+{
+  return m_CentroidsArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setVolumesArrayName(const QString& value)
+{
+  m_VolumesArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getVolumesArrayName() const
+{
+  return m_VolumesArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setEquivalentDiametersArrayName(const QString& value)
+{
+  m_EquivalentDiametersArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getEquivalentDiametersArrayName() const
+{
+  return m_EquivalentDiametersArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setNumElementsArrayName(const QString& value)
+{
+  m_NumElementsArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getNumElementsArrayName() const
+{
+  return m_NumElementsArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setOmega3sArrayName(const QString& value)
+{
+  m_Omega3sArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getOmega3sArrayName() const
+{
+  return m_Omega3sArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setAxisLengthsArrayName(const QString& value)
+{
+  m_AxisLengthsArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getAxisLengthsArrayName() const
+{
+  return m_AxisLengthsArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setAxisEulerAnglesArrayName(const QString& value)
+{
+  m_AxisEulerAnglesArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getAxisEulerAnglesArrayName() const
+{
+  return m_AxisEulerAnglesArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setAspectRatiosArrayName(const QString& value)
+{
+  m_AspectRatiosArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getAspectRatiosArrayName() const
+{
+  return m_AspectRatiosArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setSurfaceFeaturesArrayName(const QString& value)
+{
+  m_SurfaceFeaturesArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getSurfaceFeaturesArrayName() const
+{
+  return m_SurfaceFeaturesArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureMorphology::setBiasedFeaturesArrayName(const QString& value)
+{
+  m_BiasedFeaturesArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindFeatureMorphology::getBiasedFeaturesArrayName() const
+{
+  return m_BiasedFeaturesArrayName;
+}
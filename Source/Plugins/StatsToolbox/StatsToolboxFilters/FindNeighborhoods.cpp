@@ -34,7 +34,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindNeighborhoods.h"
 
-#include <mutex>
+#include <algorithm>
+#include <cmath>
 
 #include <QtCore/QTextStream>
 
@@ -49,16 +50,12 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "StatsToolbox/StatsToolboxConstants.h"
+#include "StatsToolbox/StatsToolboxFilters/util/FeatureCentroidGrid.hpp"
 #include "StatsToolbox/StatsToolboxVersion.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#endif
-
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -66,92 +63,6 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
-class FindNeighborhoodsImpl
-{
-public:
-  FindNeighborhoodsImpl(FindNeighborhoods* filter, size_t totalFeatures, float* centroids, const std::vector<int64_t>& bins, const std::vector<float>& criticalDistance)
-  : m_Filter(filter)
-  , m_TotalFeatures(totalFeatures)
-  , m_Centroids(centroids)
-  , m_Bins(bins)
-  , m_CriticalDistance(criticalDistance)
-  {
-  }
-
-  void convert(size_t start, size_t end) const
-  {
-    float x = 0.0f, y = 0.0f, z = 0.0f;
-    int64_t bin1x = 0, bin2x = 0, bin1y = 0, bin2y = 0, bin1z = 0, bin2z = 0;
-    float dBinX = 0, dBinY = 0, dBinZ = 0;
-    float criticalDistance1 = 0, criticalDistance2 = 0;
-
-    size_t increment = (end - start) / 100;
-    size_t incCount = 0;
-    // NEVER start at 0.
-    if(start == 0)
-    {
-      start = 1;
-    }
-    for(size_t i = start; i < end; i++)
-    {
-      incCount++;
-      if(incCount == increment || i == end - 1)
-      {
-        incCount = 0;
-        m_Filter->updateProgress(increment, m_TotalFeatures);
-      }
-      if(m_Filter->getCancel())
-      {
-        break;
-      }
-      x = m_Centroids[3 * i];
-      y = m_Centroids[3 * i + 1];
-      z = m_Centroids[3 * i + 2];
-      bin1x = m_Bins[3 * i];
-      bin1y = m_Bins[3 * i + 1];
-      bin1z = m_Bins[3 * i + 2];
-      criticalDistance1 = m_CriticalDistance[i];
-
-      for(size_t j = i + 1; j < m_TotalFeatures; j++)
-      {
-        bin2x = m_Bins[3 * j];
-        bin2y = m_Bins[3 * j + 1];
-        bin2z = m_Bins[3 * j + 2];
-        criticalDistance2 = m_CriticalDistance[j];
-        // Use the llabs version of the "C" abs function because we are using int64_t
-        // do NOT try to use the std::abs() function as this is C++11 ONLY
-        dBinX = llabs(bin2x - bin1x);
-        dBinY = llabs(bin2y - bin1y);
-        dBinZ = llabs(bin2z - bin1z);
-
-        if(dBinX < criticalDistance1 && dBinY < criticalDistance1 && dBinZ < criticalDistance1)
-        {
-          m_Filter->updateNeighborHood(i, j);
-        }
-
-        if(dBinX < criticalDistance2 && dBinY < criticalDistance2 && dBinZ < criticalDistance2)
-        {
-          m_Filter->updateNeighborHood(j, i);
-        }
-      }
-    }
-  }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
-  {
-    convert(r.begin(), r.end());
-  }
-#endif
-
-private:
-  FindNeighborhoods* m_Filter = nullptr;
-  size_t m_TotalFeatures = 0;
-  float* m_Centroids = nullptr;
-  const std::vector<int64_t>& m_Bins;
-  const std::vector<float>& m_CriticalDistance;
-};
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -302,17 +213,13 @@ void FindNeighborhoods::execute()
   {
     return;
   }
-  m_IncCount = 0;
-
   float x = 0.0f, y = 0.0f, z = 0.0f;
-  m_NumCompleted = 0;
   std::vector<float> criticalDistance;
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_EquivalentDiametersArrayPath.getDataContainerName());
   size_t totalFeatures = m_EquivalentDiametersPtr.lock()->getNumberOfTuples();
 
-  m_ProgIncrement = totalFeatures / 100;
-
+  m_LocalNeighborhoodList.clear();
   m_LocalNeighborhoodList.resize(totalFeatures);
   criticalDistance.resize(totalFeatures);
 
@@ -347,16 +254,47 @@ void FindNeighborhoods::execute()
     bins[3 * i + 2] = static_cast<int64_t>(zbin);
   }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(true)
-  {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalFeatures), FindNeighborhoodsImpl(this, totalFeatures, m_Centroids, bins, criticalDistance), tbb::auto_partitioner());
-  }
-  else
-#endif
+  // Feature j is in the neighborhood of Feature i when every bin offset between them is below the
+  // critical distance of i. The offsets are integers, so only the bins within ceil(criticalDistance) of
+  // i can pass and the grid hands back just those candidates for the exact test.
+  FeatureCentroidGrid grid(bins.data(), totalFeatures, [](size_t i) { return i > 0; }, std::max(1.0, static_cast<double>(m_MultiplesOfAverage)));
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1ULL, totalFeatures);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      if(getCancel())
+      {
+        return;
+      }
+      const int64_t bin1x = bins[3 * i];
+      const int64_t bin1y = bins[3 * i + 1];
+      const int64_t bin1z = bins[3 * i + 2];
+      const float criticalDistance1 = criticalDistance[i];
+      const double radius = std::ceil(static_cast<double>(criticalDistance1));
+      std::vector<int32_t>& neighborhood = m_LocalNeighborhoodList[i];
+      grid.forEachWithinRadius({static_cast<double>(bin1x), static_cast<double>(bin1y), static_cast<double>(bin1z)}, radius, [&](size_t j) {
+        if(j == i)
+        {
+          return;
+        }
+        // Use the llabs version of the "C" abs function because we are using int64_t
+        float dBinX = llabs(bins[3 * j] - bin1x);
+        float dBinY = llabs(bins[3 * j + 1] - bin1y);
+        float dBinZ = llabs(bins[3 * j + 2] - bin1z);
+        if(dBinX < criticalDistance1 && dBinY < criticalDistance1 && dBinZ < criticalDistance1)
+        {
+          neighborhood.push_back(static_cast<int32_t>(j));
+        }
+      });
+      std::sort(neighborhood.begin(), neighborhood.end());
+      m_Neighborhoods[i] = static_cast<int32_t>(neighborhood.size());
+    }
+  });
+  if(getCancel())
   {
-    FindNeighborhoodsImpl serial(this, totalFeatures, m_Centroids, bins, criticalDistance);
-    serial.convert(0, totalFeatures);
+    return;
   }
 
   for(size_t i = 1; i < totalFeatures; i++)
@@ -368,34 +306,6 @@ void FindNeighborhoods::execute()
   }
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void FindNeighborhoods::updateNeighborHood(size_t sourceIndex, size_t destIndex)
-{
-  static std::mutex mutex;
-  std::lock_guard<std::mutex> lock(mutex);
-  m_Neighborhoods[sourceIndex]++;
-  m_LocalNeighborhoodList[sourceIndex].push_back(static_cast<int32_t>(destIndex));
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void FindNeighborhoods::updateProgress(size_t numCompleted, size_t totalFeatures)
-{
-  static std::mutex mutex;
-  std::lock_guard<std::mutex> lock(mutex);
-  m_IncCount += numCompleted;
-  m_NumCompleted = m_NumCompleted + numCompleted;
-  if(m_IncCount > m_ProgIncrement)
-  {
-    m_IncCount = 0;
-    QString ss = QObject::tr("Working on Feature %1 of %2").arg(m_NumCompleted).arg(totalFeatures);
-    notifyStatusMessage(ss);
-  }
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -35,8 +35,10 @@
 #include "FindNeighbors.h"
 
 #include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
 
-#include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -50,10 +52,31 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "StatsToolbox/StatsToolboxConstants.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
 
+namespace
+{
+constexpr size_t k_VoxelsPerChunk = 1048576;
+
+/**
+ * @brief The ContactChunk struct holds the face contacts counted in one slab of rows, keyed by
+ * (feature, neighbor), and the Features of the slab that touch the outside of the volume.
+ */
+struct ContactChunk
+{
+  std::unordered_map<uint64_t, int32_t> contacts;
+  std::vector<int32_t> surfaceFeatures;
+};
+
+uint64_t ContactKey(int32_t feature, int32_t neighbor)
+{
+  return (static_cast<uint64_t>(feature) << 32) | static_cast<uint32_t>(neighbor);
+}
+} // namespace
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -251,183 +274,205 @@ void FindNeighbors::execute()
   neighpoints[4] = dims[0];
   neighpoints[5] = dims[0] * dims[1];
 
-  int64_t column = 0, row = 0, plane = 0;
-  int32_t feature = 0;
-  int32_t nnum = 0;
-  int8_t onsurf = 0;
-  bool good = false;
-  int64_t neighbor = 0;
-
-  std::vector<std::vector<int32_t>> neighborlist;
-  std::vector<std::vector<float>> neighborsurfacearealist;
-
-  int32_t nListSize = 100;
-  neighborlist.resize(totalFeatures);
-  neighborsurfacearealist.resize(totalFeatures);
-
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
-
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
+    m_NumNeighbors[i] = 0;
+    if(m_StoreSurfaceFeatures)
     {
-      QString ss = QObject::tr("Finding Neighbors || Initializing Neighbor Lists || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
+      m_SurfaceFeatures[i] = false;
     }
+  }
 
-    if(getCancel())
+  // Count the face contacts of each slab of rows into its own table
+  notifyStatusMessage("Finding Neighbors || Determining Neighbor Lists");
+  const bool is2D = (dims[2] == 1);
+  const int64_t totalRows = dims[1] * dims[2];
+  const int64_t rowsPerChunk = std::max(static_cast<int64_t>(1), static_cast<int64_t>(k_VoxelsPerChunk) / dims[0]);
+  std::vector<ContactChunk> chunks(static_cast<size_t>((totalRows + rowsPerChunk - 1) / rowsPerChunk));
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, chunks.size());
+  dataAlg.setGrain(1);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t c = range.min(); c < range.max(); c++)
     {
-      return;
+      if(getCancel())
+      {
+        return;
+      }
+      ContactChunk& chunk = chunks[c];
+      const int64_t rowEnd = std::min(totalRows, static_cast<int64_t>(c + 1) * rowsPerChunk);
+      for(int64_t rowIndex = static_cast<int64_t>(c) * rowsPerChunk; rowIndex < rowEnd; rowIndex++)
+      {
+        const int64_t row = rowIndex % dims[1];
+        const int64_t plane = rowIndex / dims[1];
+        const bool surfaceRow = row == 0 || row == dims[1] - 1 || (!is2D && (plane == 0 || plane == dims[2] - 1));
+        for(int64_t column = 0; column < dims[0]; column++)
+        {
+          const int64_t j = rowIndex * dims[0] + column;
+          int8_t onsurf = 0;
+          int32_t feature = m_FeatureIds[j];
+          if(feature > 0)
+          {
+            if(m_StoreSurfaceFeatures && (surfaceRow || column == 0 || column == dims[0] - 1) && (chunk.surfaceFeatures.empty() || chunk.surfaceFeatures.back() != feature))
+            {
+              chunk.surfaceFeatures.push_back(feature);
+            }
+            for(int32_t k = 0; k < 6; k++)
+            {
+              bool good = true;
+              if(k == 0 && plane == 0)
+              {
+                good = false;
+              }
+              if(k == 5 && plane == (dims[2] - 1))
+              {
+                good = false;
+              }
+              if(k == 1 && row == 0)
+              {
+                good = false;
+              }
+              if(k == 4 && row == (dims[1] - 1))
+              {
+                good = false;
+              }
+              if(k == 2 && column == 0)
+              {
+                good = false;
+              }
+              if(k == 3 && column == (dims[0] - 1))
+              {
+                good = false;
+              }
+              if(!good)
+              {
+                continue;
+              }
+              int32_t neighborFeature = m_FeatureIds[j + neighpoints[k]];
+              if(neighborFeature != feature && neighborFeature > 0)
+              {
+                onsurf++;
+                chunk.contacts[ContactKey(feature, neighborFeature)]++;
+              }
+            }
+          }
+          if(m_StoreBoundaryCells)
+          {
+            m_BoundaryCells[j] = onsurf;
+          }
+        }
+      }
     }
+  });
 
-    m_NumNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-    neighborsurfacearealist[i].assign(nListSize, -1.0f);
-    if(m_StoreSurfaceFeatures)
-    {
-      m_SurfaceFeatures[i] = false;
-    }
+  if(getCancel())
+  {
+    return;
   }
 
-  for(size_t j = 0; j < totalPoints; j++)
+  // Merge the chunk tables into rows of (neighbor, face count) per Feature. A contact that
+  // crosses chunks shows up once per chunk and is combined when the row is sorted.
+  notifyStatusMessage("Finding Neighbors || Merging Neighbor Lists");
+  std::vector<size_t> rowOffsets(totalFeatures + 1, 0);
+  for(const ContactChunk& chunk : chunks)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
+    for(const auto& contact : chunk.contacts)
     {
-      QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(j) / totalPoints) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
+      rowOffsets[(contact.first >> 32) + 1]++;
     }
+    if(m_StoreSurfaceFeatures)
+    {
+      for(const int32_t& feature : chunk.surfaceFeatures)
+      {
+        m_SurfaceFeatures[feature] = true;
+      }
+    }
+  }
+  std::partial_sum(rowOffsets.begin(), rowOffsets.end(), rowOffsets.begin());
 
-    if(getCancel())
+  std::vector<std::pair<int32_t, int32_t>> contacts(rowOffsets.back());
+  {
+    std::vector<size_t> cursor(rowOffsets.begin(), rowOffsets.end() - 1);
+    for(ContactChunk& chunk : chunks)
     {
-      return;
+      for(const auto& contact : chunk.contacts)
+      {
+        size_t feature = static_cast<size_t>(contact.first >> 32);
+        contacts[cursor[feature]++] = {static_cast<int32_t>(contact.first & 0xFFFFFFFFULL), contact.second};
+      }
+      ContactChunk().contacts.swap(chunk.contacts);
     }
+  }
 
-    onsurf = 0;
-    feature = m_FeatureIds[j];
-    if(feature > 0 && feature < neighborlist.size())
+  std::vector<size_t> neighborCounts(totalFeatures, 0);
+  dataAlg.setRange(1ULL, totalFeatures);
+  dataAlg.setGrain(1024);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      column = static_cast<int64_t>(j % m->getGeometryAs<ImageGeom>()->getXPoints());
-      row = static_cast<int64_t>((j / m->getGeometryAs<ImageGeom>()->getXPoints()) % m->getGeometryAs<ImageGeom>()->getYPoints());
-      plane = static_cast<int64_t>(j / (m->getGeometryAs<ImageGeom>()->getXPoints() * m->getGeometryAs<ImageGeom>()->getYPoints()));
-      if(m_StoreSurfaceFeatures)
+      auto first = contacts.begin() + rowOffsets[i];
+      auto last = contacts.begin() + rowOffsets[i + 1];
+      if(first == last)
       {
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints()) - 1) || plane == 0 || plane == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getZPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() != 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
+        continue;
       }
-      for(int32_t k = 0; k < 6; k++)
+      std::sort(first, last);
+      auto unique = first;
+      for(auto iter = first + 1; iter != last; ++iter)
       {
-        good = true;
-        neighbor = static_cast<int64_t>(j + neighpoints[k]);
-        if(k == 0 && plane == 0)
+        if(iter->first == unique->first)
         {
-          good = false;
+          unique->second += iter->second;
         }
-        if(k == 5 && plane == (m->getGeometryAs<ImageGeom>()->getZPoints() - 1))
+        else
         {
-          good = false;
-        }
-        if(k == 1 && row == 0)
-        {
-          good = false;
-        }
-        if(k == 4 && row == (m->getGeometryAs<ImageGeom>()->getYPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 2 && column == 0)
-        {
-          good = false;
-        }
-        if(k == 3 && column == (m->getGeometryAs<ImageGeom>()->getXPoints() - 1))
-        {
-          good = false;
-        }
-        if(good && m_FeatureIds[neighbor] != feature && m_FeatureIds[neighbor] > 0)
-        {
-          onsurf++;
-          nnum = m_NumNeighbors[feature];
-          neighborlist[feature].push_back(m_FeatureIds[neighbor]);
-          nnum++;
-          m_NumNeighbors[feature] = nnum;
+          *(++unique) = *iter;
         }
       }
+      neighborCounts[i] = static_cast<size_t>(unique - first) + 1;
     }
-    if(m_StoreBoundaryCells)
-    {
-      m_BoundaryCells[j] = onsurf;
-    }
-  }
+  });
 
+  // Compress into the final CSR arrays of neighbor ids and shared surface areas
   FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
-
-  // We do this to create new set of NeighborList objects
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Calculating Surface Areas || %1% Complete").arg(((float)i / totalFeatures) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
+  const float faceArea = spacing[0] * spacing[1];
+
+  std::vector<size_t> neighborOffsets(totalFeatures + 1, 0);
+  std::partial_sum(neighborCounts.begin(), neighborCounts.end(), neighborOffsets.begin() + 1);
+  std::vector<int32_t> neighborIds(neighborOffsets.back());
+  std::vector<float> sharedAreas(neighborOffsets.back());
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      return;
-    }
-
-    QMap<int32_t, int32_t> neighToCount;
-    int32_t numneighs = static_cast<int32_t>(neighborlist[i].size());
-
-    // this increments the voxel counts for each feature
-    for(int32_t j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
+      for(size_t n = 0; n < neighborCounts[i]; n++)
+      {
+        const std::pair<int32_t, int32_t>& contact = contacts[rowOffsets[i] + n];
+        neighborIds[neighborOffsets[i] + n] = contact.first;
+        sharedAreas[neighborOffsets[i] + n] = static_cast<float>(contact.second) * faceArea;
+      }
     }
+  });
+  std::vector<std::pair<int32_t, int32_t>>().swap(contacts);
 
-    QMap<int32_t, int32_t>::Iterator neighiter = neighToCount.find(0);
-    neighToCount.erase(neighiter);
-    neighiter = neighToCount.find(-1);
-    neighToCount.erase(neighiter);
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-    neighborsurfacearealist[i].resize(0);
-
-    for(QMap<int32_t, int32_t>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
-    {
-      int32_t neigh = iter.key();    // get the neighbor feature
-      int32_t number = iter.value(); // get the number of voxels
-      float area = float(number) * spacing[0] * spacing[1];
+  if(getCancel())
+  {
+    return;
+  }
 
-      // Push the neighbor feature id back onto the list so we stay synced up
-      neighborlist[i].push_back(neigh);
-      neighborsurfacearealist[i].push_back(area);
-    }
-    m_NumNeighbors[i] = int32_t(neighborlist[i].size());
+  notifyStatusMessage("Finding Neighbors || Storing Neighbor Lists");
+  NeighborList<int32_t>& neighborList = *(m_NeighborList.lock());
+  NeighborList<float>& sharedSurfaceAreaList = *(m_SharedSurfaceAreaList.lock());
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    m_NumNeighbors[i] = static_cast<int32_t>(neighborCounts[i]);
 
     // Set the vector for each list into the NeighborList Object
-    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
-    m_NeighborList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
+    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>(neighborIds.begin() + neighborOffsets[i], neighborIds.begin() + neighborOffsets[i + 1]));
+    neighborList.setList(static_cast<int32_t>(i), sharedNeiLst);
 
-    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>);
-    sharedSAL->assign(neighborsurfacearealist[i].begin(), neighborsurfacearealist[i].end());
-    m_SharedSurfaceAreaList.lock()->setList(static_cast<int32_t>(i), sharedSAL);
+    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>(sharedAreas.begin() + neighborOffsets[i], sharedAreas.begin() + neighborOffsets[i + 1]));
+    sharedSurfaceAreaList.setList(static_cast<int32_t>(i), sharedSAL);
   }
 }
 
@@ -38,6 +38,7 @@
 #include <array>
 #include <cmath>
 #include <utility>
+#include <vector>
 
 #include <Eigen/Core>
 
@@ -57,87 +58,12 @@
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 
+#include "Common/FeatureReduction.hpp"
+
 #include "StatsToolbox/StatsToolboxConstants.h"
+#include "StatsToolbox/StatsToolboxFilters/util/TripletSort.hpp"
 #include "StatsToolbox/StatsToolboxVersion.h"
 
-namespace
-{
-/**
- * @brief Sorts the 3 values
- * @param a First Value
- * @param b Second Value
- * @param c Third Value
- * @return The indices in their sorted order
- */
-template <typename T>
-std::array<size_t, 3> TripletSort(T a, T b, T c, bool lowToHigh)
-{
-  constexpr size_t A = 0;
-  constexpr size_t B = 1;
-  constexpr size_t C = 2;
-  std::array<size_t, 3> idx = {0, 1, 2};
-  if(a > b && a > c)
-  {
-    // sorted[2] = a;
-    if(b > c)
-    {
-      // sorted[1] = b;
-      // sorted[0] = c;
-      idx = {C, B, A};
-    }
-    else
-    {
-      // sorted[1] = c;
-      // sorted[0] = b;
-      idx = {B, C, A};
-    }
-  }
-  else if(b > a && b > c)
-  {
-    // sorted[2] = b;
-    if(a > c)
-    {
-      // sorted[1] = a;
-      // sorted[0] = c;
-      idx = {C, A, B};
-    }
-    else
-    {
-      // sorted[1] = c;
-      // sorted[0] = a;
-      idx = {A, C, B};
-    }
-  }
-  else if(a > b)
-  {
-    // sorted[1] = a;
-    // sorted[0] = b;
-    // sorted[2] = c;
-    idx = {B, A, C};
-  }
-  else if(a >= c && b >= c)
-  {
-    // sorted[0] = c;
-    // sorted[1] = a;
-    // sorted[2] = b;
-    idx = {C, A, B};
-  }
-  else
-  {
-    // sorted[0] = a;
-    // sorted[1] = b;
-    // sorted[2] = c;
-    idx = {A, B, C};
-  }
-
-  if(!lowToHigh)
-  {
-    std::swap(idx[0], idx[2]);
-  }
-  return idx;
-}
-
-} // namespace
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -281,7 +207,6 @@ void FindShapes::find_moments()
   float u110 = 0.0f;
   float u011 = 0.0f;
   float u101 = 0.0f;
-  float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
 
   size_t xPoints = imageGeom->getXPoints();
   size_t yPoints = imageGeom->getYPoints();
@@ -297,30 +222,25 @@ void FindShapes::find_moments()
 
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
-  for(size_t i = 0; i < numfeatures; i++)
+  struct MomentSum
   {
-    featureMoments[6 * i + 0] = 0.0;
-    featureMoments[6 * i + 1] = 0.0;
-    featureMoments[6 * i + 2] = 0.0;
-    featureMoments[6 * i + 3] = 0.0;
-    featureMoments[6 * i + 4] = 0.0;
-    featureMoments[6 * i + 5] = 0.0;
-  }
+    std::array<CompensatedSum, 6> moments;
+    uint64_t count = 0;
+  };
 
-  float x = 0.0f, y = 0.0f, z = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f, z1 = 0.0f, z2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f, xdist5 = 0.0f, xdist6 = 0.0f, xdist7 = 0.0f, xdist8 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f, ydist5 = 0.0f, ydist6 = 0.0f, ydist7 = 0.0f, ydist8 = 0.0f;
-  float zdist1 = 0.0f, zdist2 = 0.0f, zdist3 = 0.0f, zdist4 = 0.0f, zdist5 = 0.0f, zdist6 = 0.0f, zdist7 = 0.0f, zdist8 = 0.0f;
-  size_t zStride = 0, yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = featureIds[zStride + yStride + k];
+  // Each voxel is split into 8 sub-voxels whose second moments about the Feature centroid are summed
+  std::vector<MomentSum> sums = FeatureReduction::Reduce<MomentSum>(
+      xPoints * yPoints * zPoints, numfeatures,
+      [&](MomentSum* featureSums, size_t voxelIndex) {
+        size_t k = voxelIndex % xPoints;
+        size_t j = (voxelIndex / xPoints) % yPoints;
+        size_t i = voxelIndex / (xPoints * yPoints);
+        int32_t gnum = featureIds[voxelIndex];
+        float x = 0.0f, y = 0.0f, z = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f, z1 = 0.0f, z2 = 0.0f;
+        float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f, xdist5 = 0.0f, xdist6 = 0.0f, xdist7 = 0.0f, xdist8 = 0.0f;
+        float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f, ydist5 = 0.0f, ydist6 = 0.0f, ydist7 = 0.0f, ydist8 = 0.0f;
+        float zdist1 = 0.0f, zdist2 = 0.0f, zdist3 = 0.0f, zdist4 = 0.0f, zdist5 = 0.0f, zdist6 = 0.0f, zdist7 = 0.0f, zdist8 = 0.0f;
+        float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
         x = float(k * modXRes) + (origin[0] * static_cast<float>(m_ScaleFactor));
         y = float(j * modYRes) + (origin[1] * static_cast<float>(m_ScaleFactor));
         z = float(i * modZRes) + (origin[2] * static_cast<float>(m_ScaleFactor));
@@ -371,15 +291,30 @@ void FindShapes::find_moments()
         xz = ((xdist1) * (zdist1)) + ((xdist2) * (zdist2)) + ((xdist3) * (zdist3)) + ((xdist4) * (zdist4)) + ((xdist5) * (zdist5)) + ((xdist6) * (zdist6)) + ((xdist7) * (zdist7)) +
              ((xdist8) * (zdist8));
 
-        featureMoments[gnum * 6 + 0] = featureMoments[gnum * 6 + 0] + static_cast<double>(xx);
-        featureMoments[gnum * 6 + 1] = featureMoments[gnum * 6 + 1] + static_cast<double>(yy);
-        featureMoments[gnum * 6 + 2] = featureMoments[gnum * 6 + 2] + static_cast<double>(zz);
-        featureMoments[gnum * 6 + 3] = featureMoments[gnum * 6 + 3] + static_cast<double>(xy);
-        featureMoments[gnum * 6 + 4] = featureMoments[gnum * 6 + 4] + static_cast<double>(yz);
-        featureMoments[gnum * 6 + 5] = featureMoments[gnum * 6 + 5] + static_cast<double>(xz);
-        volumes[gnum] = volumes[gnum] + 1.0;
-      }
+        MomentSum& featureSum = featureSums[gnum];
+        featureSum.moments[0].add(static_cast<double>(xx));
+        featureSum.moments[1].add(static_cast<double>(yy));
+        featureSum.moments[2].add(static_cast<double>(zz));
+        featureSum.moments[3].add(static_cast<double>(xy));
+        featureSum.moments[4].add(static_cast<double>(yz));
+        featureSum.moments[5].add(static_cast<double>(xz));
+        featureSum.count++;
+      },
+      [](MomentSum& into, const MomentSum& from) {
+        for(size_t idx = 0; idx < 6; idx++)
+        {
+          into.moments[idx].merge(from.moments[idx]);
+        }
+        into.count += from.count;
+      });
+
+  for(size_t featureId = 0; featureId < numfeatures; featureId++)
+  {
+    for(size_t idx = 0; idx < 6; idx++)
+    {
+      featureMoments[featureId * 6 + idx] = sums[featureId].moments[idx].value();
     }
+    volumes[featureId] = volumes[featureId] + static_cast<float>(sums[featureId].count);
   }
   double sphere = (2000.0 * M_PI * M_PI) / 9.0;
   // constant for moments because voxels are broken into smaller voxels
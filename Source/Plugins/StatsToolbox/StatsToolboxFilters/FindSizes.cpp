@@ -34,6 +34,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindSizes.h"
 
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -48,6 +50,8 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#include "Common/FeatureReduction.hpp"
+
 #include "StatsToolbox/StatsToolboxConstants.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
 
@@ -189,20 +193,13 @@ void FindSizes::findSizesImage(ImageGeom::Pointer image)
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
 
-  DataArray<uint64_t>::Pointer m_FeatureCounts = DataArray<uint64_t>::CreateArray(numfeatures, std::string("_INTERNAL_USE_ONLY_FeatureCounts"), true);
-  m_FeatureCounts->initializeWithZeros();
-  uint64_t* featurecounts = m_FeatureCounts->getPointer(0);
+  std::vector<uint64_t> featurecounts = FeatureReduction::Reduce<uint64_t>(
+      totalPoints, numfeatures, [this](uint64_t* counts, size_t j) { counts[m_FeatureIds[j]]++; }, [](uint64_t& into, const uint64_t& from) { into += from; });
 
   float rad = 0.0f;
   float diameter = 0.0f;
   float res_scalar = 0.0f;
 
-  for(size_t j = 0; j < totalPoints; j++)
-  {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-  }
-
   FloatVec3Type spacing = image->getSpacing();
 
   if(image->getXPoints() == 1 || image->getYPoints() == 1 || image->getZPoints() == 1)
@@ -295,23 +292,34 @@ void FindSizes::findSizesUnstructured(IGeometry::Pointer igeom)
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
 
-  DataArray<float>::Pointer m_FeatureCounts = DataArray<float>::CreateArray(numfeatures, std::string("_INTERNAL_USE_ONLY_FeatureCounts"), true);
-  m_FeatureCounts->initializeWithZeros();
-  float* featurecounts = m_FeatureCounts->getPointer(0);
+  struct FeatureSize
+  {
+    uint64_t count = 0;
+    CompensatedSum volume;
+  };
+  std::vector<FeatureSize> featureSizes = FeatureReduction::Reduce<FeatureSize>(
+      totalPoints, numfeatures,
+      [this, sizes](FeatureSize* featureSize, size_t j) {
+        FeatureSize& size = featureSize[m_FeatureIds[j]];
+        size.count++;
+        size.volume.add(sizes[j]);
+      },
+      [](FeatureSize& into, const FeatureSize& from) {
+        into.count += from.count;
+        into.volume.merge(from.volume);
+      });
 
   float rad = 0.0f;
   float diameter = 0.0f;
 
-  for(size_t j = 0; j < totalPoints; j++)
+  for(size_t i = 0; i < numfeatures; i++)
   {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-    m_Volumes[gnum] += sizes[j];
+    m_Volumes[i] += static_cast<float>(featureSizes[i].volume.value());
   }
   float vol_term = (4.0f / 3.0f) * SIMPLib::Constants::k_PiF;
   for(size_t i = 1; i < numfeatures; i++)
   {
-    m_NumElements[i] = static_cast<int32_t>(featurecounts[i]);
+    m_NumElements[i] = static_cast<int32_t>(featureSizes[i].count);
     rad = m_Volumes[i] / vol_term;
     diameter = 2.0f * powf(rad, 0.3333333333f);
     m_EquivalentDiameters[i] = diameter;
@@ -23,6 +23,7 @@ set(_PublicFilters
   FindDifferenceMap
   FindEuclideanDistMap
   FindFeatureClustering
+  FindFeatureMorphology
   FindLargestCrossSections
   FindNeighborhoods
   FindNeighbors
@@ -70,6 +71,8 @@ foreach(f ${_PrivateFilters} )
 endforeach()
 
 ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/MomentInvariants2D.h)
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/FeatureCentroidGrid.hpp)
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/TripletSort.hpp)
 ADD_SIMPL_SUPPORT_SOURCE(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/MomentInvariants2D.cpp)
 
 
@@ -0,0 +1,194 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief The FeatureCentroidGrid class buckets a set of Feature centroids (or any other 3D points)
+ * into a uniform grid so that fixed-radius and box queries only visit the points stored in the
+ * cells that overlap the query instead of every other Feature.
+ *
+ * The points are stored in compressed sparse row form: one offset per cell into a single array of
+ * point indices. Within a cell the points keep ascending index order.
+ */
+class FeatureCentroidGrid
+{
+public:
+  /**
+   * @brief FeatureCentroidGrid Buckets the points
+   * @param coords Interleaved x, y, z coordinates, one triple per point index
+   * @param numPoints Number of point indices (the length of coords divided by 3)
+   * @param include Returns true for the point indices that take part in the queries
+   * @param cellSize Preferred edge length of a grid cell, typically the common query radius. The cell size
+   * is doubled as long as the grid would have many more cells than points.
+   */
+  template <typename T, typename Predicate>
+  FeatureCentroidGrid(const T* coords, size_t numPoints, Predicate include, double cellSize)
+  {
+    std::vector<size_t> points;
+    points.reserve(numPoints);
+    m_Min = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+    std::array<double, 3> max = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      if(!include(i))
+      {
+        continue;
+      }
+      points.push_back(i);
+      for(size_t d = 0; d < 3; d++)
+      {
+        m_Min[d] = std::min(m_Min[d], static_cast<double>(coords[3 * i + d]));
+        max[d] = std::max(max[d], static_cast<double>(coords[3 * i + d]));
+      }
+    }
+    if(points.empty())
+    {
+      m_CellOffsets.assign(2, 0);
+      return;
+    }
+
+    m_CellSize = (cellSize > 0.0 && std::isfinite(cellSize)) ? cellSize : 1.0;
+    const double maxCells = 8.0 * static_cast<double>(points.size()) + 64.0;
+    while(true)
+    {
+      double totalCells = 1.0;
+      for(size_t d = 0; d < 3; d++)
+      {
+        m_Dims[d] = static_cast<int64_t>(std::floor((max[d] - m_Min[d]) / m_CellSize)) + 1;
+        totalCells *= static_cast<double>(m_Dims[d]);
+      }
+      if(totalCells <= maxCells)
+      {
+        break;
+      }
+      m_CellSize *= 2.0;
+    }
+
+    std::vector<size_t> pointCells(points.size());
+    m_CellOffsets.assign(static_cast<size_t>(m_Dims[0] * m_Dims[1] * m_Dims[2]) + 1, 0);
+    for(size_t p = 0; p < points.size(); p++)
+    {
+      const size_t index = points[p];
+      pointCells[p] = cellIndex(cellCoord(coords[3 * index], 0), cellCoord(coords[3 * index + 1], 1), cellCoord(coords[3 * index + 2], 2));
+      m_CellOffsets[pointCells[p] + 1]++;
+    }
+    for(size_t c = 1; c < m_CellOffsets.size(); c++)
+    {
+      m_CellOffsets[c] += m_CellOffsets[c - 1];
+    }
+    m_Points.resize(points.size());
+    std::vector<size_t> cursor(m_CellOffsets.begin(), m_CellOffsets.end() - 1);
+    for(size_t p = 0; p < points.size(); p++)
+    {
+      m_Points[cursor[pointCells[p]]++] = points[p];
+    }
+  }
+
+  /**
+   * @brief forEachCandidate Calls callback(pointIndex) for every point stored in the cells that overlap
+   * the box [low, high]. Points outside the box may be visited; the caller applies the exact test.
+   */
+  template <typename Callback>
+  void forEachCandidate(const std::array<double, 3>& low, const std::array<double, 3>& high, Callback&& callback) const
+  {
+    if(m_Points.empty())
+    {
+      return;
+    }
+    std::array<int64_t, 3> first = {0, 0, 0};
+    std::array<int64_t, 3> last = {0, 0, 0};
+    for(size_t d = 0; d < 3; d++)
+    {
+      first[d] = cellCoord(low[d], d);
+      last[d] = cellCoord(high[d], d);
+      if(high[d] < m_Min[d] || first[d] > last[d])
+      {
+        return;
+      }
+    }
+    for(int64_t z = first[2]; z <= last[2]; z++)
+    {
+      for(int64_t y = first[1]; y <= last[1]; y++)
+      {
+        const size_t rowStart = cellIndex(first[0], y, z);
+        const size_t rowEnd = cellIndex(last[0], y, z) + 1;
+        for(size_t p = m_CellOffsets[rowStart]; p < m_CellOffsets[rowEnd]; p++)
+        {
+          callback(m_Points[p]);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief forEachWithinRadius Calls callback(pointIndex) for every candidate within the cube of half
+   * width radius around center. The caller applies the exact distance test.
+   */
+  template <typename Callback>
+  void forEachWithinRadius(const std::array<double, 3>& center, double radius, Callback&& callback) const
+  {
+    forEachCandidate({center[0] - radius, center[1] - radius, center[2] - radius}, {center[0] + radius, center[1] + radius, center[2] + radius}, std::forward<Callback>(callback));
+  }
+
+private:
+  std::array<double, 3> m_Min = {0.0, 0.0, 0.0};
+  std::array<int64_t, 3> m_Dims = {1, 1, 1};
+  double m_CellSize = 1.0;
+  std::vector<size_t> m_CellOffsets;
+  std::vector<size_t> m_Points;
+
+  template <typename T>
+  int64_t cellCoord(T value, size_t dim) const
+  {
+    double cell = std::floor((static_cast<double>(value) - m_Min[dim]) / m_CellSize);
+    if(!(cell > 0.0))
+    {
+      return 0;
+    }
+    return std::min(static_cast<int64_t>(std::min(cell, static_cast<double>(m_Dims[dim] - 1))), m_Dims[dim] - 1);
+  }
+
+  size_t cellIndex(int64_t x, int64_t y, int64_t z) const
+  {
+    return static_cast<size_t>((z * m_Dims[1] + y) * m_Dims[0] + x);
+  }
+};
@@ -0,0 +1,96 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief TripletSort Sorts 3 values, typically the eigenvalues of a Feature's second moment matrix
+ * @param a First Value
+ * @param b Second Value
+ * @param c Third Value
+ * @param lowToHigh Sort in ascending order if true, otherwise the first and last indices are swapped
+ * @return The indices of the values in their sorted order
+ */
+template <typename T>
+std::array<size_t, 3> TripletSort(T a, T b, T c, bool lowToHigh)
+{
+  constexpr size_t A = 0;
+  constexpr size_t B = 1;
+  constexpr size_t C = 2;
+  std::array<size_t, 3> idx = {0, 1, 2};
+  if(a > b && a > c)
+  {
+    if(b > c)
+    {
+      idx = {C, B, A};
+    }
+    else
+    {
+      idx = {B, C, A};
+    }
+  }
+  else if(b > a && b > c)
+  {
+    if(a > c)
+    {
+      idx = {C, A, B};
+    }
+    else
+    {
+      idx = {A, C, B};
+    }
+  }
+  else if(a > b)
+  {
+    idx = {B, A, C};
+  }
+  else if(a >= c && b >= c)
+  {
+    idx = {C, A, B};
+  }
+  else
+  {
+    idx = {A, B, C};
+  }
+
+  if(!lowToHigh)
+  {
+    std::swap(idx[0], idx[2]);
+  }
+  return idx;
+}
@@ -0,0 +1,310 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#endif
+
+#include "UnitTestSupport.hpp"
+
+#include "Common/FeatureReduction.hpp"
+
+#include "StatsToolboxTestFileLocations.h"
+
+class FeatureReductionTest
+{
+  // Large enough to be split into several blocks
+  static constexpr size_t k_NumElements = 1000003;
+  static constexpr size_t k_NumFeatures = 64;
+
+public:
+  FeatureReductionTest() = default;
+  virtual ~FeatureReductionTest() = default;
+
+  // -----------------------------------------------------------------------------
+  // A value that cancels almost entirely against its neighbors so that a plain
+  // running sum loses everything but the rounding error
+  // -----------------------------------------------------------------------------
+  double illConditionedValue(size_t i)
+  {
+    const uint64_t hash = (static_cast<uint64_t>(i) + 1) * 0x9E3779B97F4A7C15ULL;
+    const double small = static_cast<double>(hash >> 44) * 1.0e-3;
+    return (i % 2 == 0 ? 1.0e12 : -1.0e12) + small;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Feature 1 owns most elements, feature 2 a single element and the rest share the remainder
+  // -----------------------------------------------------------------------------
+  std::vector<int32_t> skewedFeatureIds()
+  {
+    std::vector<int32_t> featureIds(k_NumElements, 0);
+    for(size_t i = 0; i < k_NumElements; i++)
+    {
+      const uint64_t hash = (static_cast<uint64_t>(i) + 7) * 0xC2B2AE3D27D4EB4FULL;
+      featureIds[i] = (hash >> 54) < 700 ? 1 : static_cast<int32_t>(3 + (hash >> 32) % (k_NumFeatures - 3));
+    }
+    featureIds[k_NumElements / 2] = 2;
+    return featureIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every feature the same size, laid out in contiguous runs that straddle the block boundaries
+  // -----------------------------------------------------------------------------
+  std::vector<int32_t> uniformFeatureIds()
+  {
+    std::vector<int32_t> featureIds(k_NumElements, 0);
+    const size_t runLength = k_NumElements / (k_NumFeatures - 1) + 1;
+    for(size_t i = 0; i < k_NumElements; i++)
+    {
+      featureIds[i] = static_cast<int32_t>(1 + i / runLength);
+    }
+    return featureIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<double> reduceSums(const std::vector<int32_t>& featureIds, int threadCount)
+  {
+    std::vector<CompensatedSum> sums;
+    auto reduce = [&] {
+      sums = FeatureReduction::Reduce<CompensatedSum>(
+          k_NumElements, k_NumFeatures, [&](CompensatedSum* featureSums, size_t i) { featureSums[featureIds[i]].add(illConditionedValue(i)); },
+          [](CompensatedSum& into, const CompensatedSum& from) { into.merge(from); });
+    };
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(threadCount > 0)
+    {
+      tbb::task_arena arena(threadCount);
+      arena.execute(reduce);
+    }
+    else
+    {
+      reduce();
+    }
+#else
+    (void)threadCount;
+    reduce();
+#endif
+    std::vector<double> values(sums.size(), 0.0);
+    for(size_t featureId = 0; featureId < sums.size(); featureId++)
+    {
+      values[featureId] = sums[featureId].value();
+    }
+    return values;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Sums the elements of every block in order and then merges the blocks in order,
+  // without any threading
+  // -----------------------------------------------------------------------------
+  std::vector<double> serialBlockSums(const std::vector<int32_t>& featureIds)
+  {
+    const size_t numBlocks = FeatureReduction::NumberOfBlocks(k_NumElements, k_NumFeatures, sizeof(CompensatedSum));
+    std::vector<CompensatedSum> result(k_NumFeatures);
+    for(size_t block = 0; block < numBlocks; block++)
+    {
+      std::vector<CompensatedSum> blockSums(k_NumFeatures);
+      const size_t begin = k_NumElements / numBlocks * block + std::min(block, k_NumElements % numBlocks);
+      const size_t end = k_NumElements / numBlocks * (block + 1) + std::min(block + 1, k_NumElements % numBlocks);
+      for(size_t i = begin; i < end; i++)
+      {
+        blockSums[featureIds[i]].add(illConditionedValue(i));
+      }
+      for(size_t featureId = 0; featureId < k_NumFeatures; featureId++)
+      {
+        if(block == 0)
+        {
+          result[featureId] = blockSums[featureId];
+        }
+        else
+        {
+          result[featureId].merge(blockSums[featureId]);
+        }
+      }
+    }
+    std::vector<double> values(k_NumFeatures, 0.0);
+    for(size_t featureId = 0; featureId < k_NumFeatures; featureId++)
+    {
+      values[featureId] = result[featureId].value();
+    }
+    return values;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void requireBitIdentical(const std::vector<double>& expected, const std::vector<double>& actual)
+  {
+    DREAM3D_REQUIRE_EQUAL(expected.size(), actual.size())
+    DREAM3D_REQUIRE_EQUAL(std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(double)), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestCompensatedSumIllConditioned()
+  {
+    // Each group of four adds exactly 1.25, but the 1.0 and the 0.25 are below half an ulp of 1.0e16
+    std::vector<double> series;
+    for(size_t i = 0; i < 1000; i++)
+    {
+      series.push_back(1.0e16);
+      series.push_back(1.0);
+      series.push_back(-1.0e16);
+      series.push_back(0.25);
+    }
+    const double exact = 1250.0;
+
+    double naive = 0.0;
+    CompensatedSum sum;
+    for(double value : series)
+    {
+      naive += value;
+      sum.add(value);
+    }
+    DREAM3D_REQUIRE(naive != exact)
+    DREAM3D_REQUIRE_EQUAL(sum.value(), exact)
+
+    // Splitting the series anywhere and merging the two halves keeps the sum exact
+    for(size_t split : {size_t(1), size_t(2), size_t(3), size_t(1001), series.size() / 2, series.size() - 1})
+    {
+      CompensatedSum first;
+      CompensatedSum second;
+      for(size_t i = 0; i < series.size(); i++)
+      {
+        (i < split ? first : second).add(series[i]);
+      }
+      first.merge(second);
+      DREAM3D_REQUIRE_EQUAL(first.value(), exact)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestReduceIsIndependentOfThreadCount()
+  {
+    DREAM3D_REQUIRE(FeatureReduction::NumberOfBlocks(k_NumElements, k_NumFeatures, sizeof(CompensatedSum)) > 1)
+
+    using FeatureIdGenerator = std::function<std::vector<int32_t>()>;
+    std::vector<FeatureIdGenerator> generators = {[this] { return skewedFeatureIds(); }, [this] { return uniformFeatureIds(); }};
+    for(const auto& generator : generators)
+    {
+      std::vector<int32_t> featureIds = generator();
+      std::vector<double> expected = serialBlockSums(featureIds);
+      for(int threadCount : {1, 2, 3, 4, 8, 0})
+      {
+        requireBitIdentical(expected, reduceSums(featureIds, threadCount));
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestOrderedFoldVisitsElementsInOrder()
+  {
+    std::vector<int32_t> featureIds = skewedFeatureIds();
+    // A plain running sum depends on the order the elements are added in, so it only matches when every
+    // feature is folded in ascending element order
+    std::vector<double> expected(k_NumFeatures, 0.0);
+    for(size_t i = 0; i < k_NumElements; i++)
+    {
+      expected[featureIds[i]] += illConditionedValue(i);
+    }
+    for(int threadCount : {1, 2, 4, 0})
+    {
+      std::vector<double> actual(k_NumFeatures, 0.0);
+      auto fold = [&] {
+        FeatureReduction::OrderedFold(featureIds.data(), k_NumElements, k_NumFeatures, [&](size_t featureId, const size_t* elements, size_t numElements) {
+          double sum = 0.0;
+          for(size_t e = 0; e < numElements; e++)
+          {
+            sum += illConditionedValue(elements[e]);
+          }
+          actual[featureId] = sum;
+        });
+      };
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      if(threadCount > 0)
+      {
+        tbb::task_arena arena(threadCount);
+        arena.execute(fold);
+      }
+      else
+      {
+        fold();
+      }
+#else
+      (void)threadCount;
+      fold();
+#endif
+      requireBitIdentical(expected, actual);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestCompensatedSumIllConditioned())
+    DREAM3D_REGISTER_TEST(TestReduceIsIndependentOfThreadCount())
+    DREAM3D_REGISTER_TEST(TestOrderedFoldVisitsElementsInOrder())
+  }
+
+public:
+  FeatureReductionTest(const FeatureReductionTest&) = delete;            // Copy Constructor Not Implemented
+  FeatureReductionTest(FeatureReductionTest&&) = delete;                 // Move Constructor Not Implemented
+  FeatureReductionTest& operator=(const FeatureReductionTest&) = delete; // Copy Assignment Not Implemented
+  FeatureReductionTest& operator=(FeatureReductionTest&&) = delete;      // Move Assignment Not Implemented
+};
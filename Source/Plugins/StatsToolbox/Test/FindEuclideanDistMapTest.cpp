@@ -33,6 +33,9 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <cmath>
+#include <set>
+
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 
@@ -323,6 +326,157 @@ public:
     return EXIT_SUCCESS;
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<float> computeExactReference(const Int32ArrayType::Pointer& featureIds, const std::vector<size_t>& tDims, const FloatVec3Type& spacing, size_t minNeighborFeatures)
+  {
+    const int64_t dims[3] = {static_cast<int64_t>(tDims[0]), static_cast<int64_t>(tDims[1]), static_cast<int64_t>(tDims[2])};
+    const int64_t totalPoints = dims[0] * dims[1] * dims[2];
+
+    // Cells touching at least minNeighborFeatures other Features are the sites
+    std::vector<int64_t> sites;
+    for(int64_t z = 0; z < dims[2]; z++)
+    {
+      for(int64_t y = 0; y < dims[1]; y++)
+      {
+        for(int64_t x = 0; x < dims[0]; x++)
+        {
+          const int64_t index = (z * dims[1] + y) * dims[0] + x;
+          const int32_t feature = featureIds->getValue(index);
+          if(feature <= 0)
+          {
+            continue;
+          }
+          const int64_t offsets[6][3] = {{0, 0, -1}, {0, -1, 0}, {-1, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+          std::set<int32_t> neighborFeatures;
+          for(const auto& offset : offsets)
+          {
+            const int64_t nx = x + offset[0];
+            const int64_t ny = y + offset[1];
+            const int64_t nz = z + offset[2];
+            if(nx < 0 || ny < 0 || nz < 0 || nx >= dims[0] || ny >= dims[1] || nz >= dims[2])
+            {
+              continue;
+            }
+            const int32_t neighborFeature = featureIds->getValue((nz * dims[1] + ny) * dims[0] + nx);
+            if(neighborFeature != feature && neighborFeature >= 0)
+            {
+              neighborFeatures.insert(neighborFeature);
+            }
+          }
+          if(neighborFeatures.size() >= minNeighborFeatures)
+          {
+            sites.push_back(index);
+          }
+        }
+      }
+    }
+
+    std::vector<float> reference(totalPoints, -1.0f);
+    for(int64_t i = 0; i < totalPoints; i++)
+    {
+      if(featureIds->getValue(i) <= 0)
+      {
+        reference[i] = 0.0f;
+        continue;
+      }
+      for(int64_t site : sites)
+      {
+        const float distance = cellDistance(i, site, dims, spacing);
+        if(reference[i] < 0.0f || distance < reference[i])
+        {
+          reference[i] = distance;
+        }
+      }
+    }
+    return reference;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  float cellDistance(int64_t a, int64_t b, const int64_t dims[3], const FloatVec3Type& spacing)
+  {
+    const float dx = static_cast<float>(a % dims[0] - b % dims[0]) * spacing[0];
+    const float dy = static_cast<float>((a / dims[0]) % dims[1] - (b / dims[0]) % dims[1]) * spacing[1];
+    const float dz = static_cast<float>(a / (dims[0] * dims[1]) - b / (dims[0] * dims[1])) * spacing[2];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunExactTest()
+  {
+    std::vector<size_t> tDims = {10, 6, 1};
+    DataContainerArray::Pointer dca = initializeDataContainerArray(tDims);
+    FloatVec3Type spacing = dca->getDataContainer(k_FeatureIdsArrayPath.getDataContainerName())->getGeometryAs<ImageGeom>()->getSpacing();
+
+    QString filtName = "FindEuclideanDistMap";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(k_FeatureIdsArrayPath);
+    bool propWasSet = filter->setProperty("FeatureIdsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(QString("GBExactDistance"));
+    propWasSet = filter->setProperty("GBDistancesArrayName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(true);
+    propWasSet = filter->setProperty("DoTripleLines", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(QString("TJExactDistance"));
+    propWasSet = filter->setProperty("TJDistancesArrayName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(true);
+    propWasSet = filter->setProperty("SaveNearestNeighbors", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(false);
+    propWasSet = filter->setProperty("CalcManhattanDist", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(true);
+    propWasSet = filter->setProperty("CalcExactEuclideanDist", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCode() >= 0);
+
+    AttributeMatrix::Pointer am = dca->getAttributeMatrix(k_FeatureIdsArrayPath);
+    Int32ArrayType::Pointer featureIds = am->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsArrayPath.getDataArrayName());
+    Int32ArrayType::Pointer nearestNeighbors = am->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::NearestNeighbors);
+    DREAM3D_REQUIRE_VALID_POINTER(nearestNeighbors.get())
+
+    const int64_t dims[3] = {static_cast<int64_t>(tDims[0]), static_cast<int64_t>(tDims[1]), static_cast<int64_t>(tDims[2])};
+    const QString arrayNames[2] = {"GBExactDistance", "TJExactDistance"};
+    for(size_t mapType = 0; mapType < 2; mapType++)
+    {
+      FloatArrayType::Pointer distances = am->getAttributeArrayAs<FloatArrayType>(arrayNames[mapType]);
+      DREAM3D_REQUIRE_VALID_POINTER(distances.get())
+      std::vector<float> reference = computeExactReference(featureIds, tDims, spacing, mapType + 1);
+      for(size_t i = 0; i < reference.size(); i++)
+      {
+        float computedValue = distances->getValue(i);
+        DREAM3D_COMPARE_FLOATS(&computedValue, &reference[i], 1);
+
+        // The stored nearest Cell has to be at exactly that distance
+        int32_t nearest = nearestNeighbors->getComponent(i, static_cast<int>(mapType));
+        DREAM3D_REQUIRE(nearest >= 0)
+        float nearestDistance = cellDistance(static_cast<int64_t>(i), nearest, dims, spacing);
+        DREAM3D_COMPARE_FLOATS(&nearestDistance, &reference[i], 1);
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -334,6 +488,7 @@ public:
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
     DREAM3D_REGISTER_TEST(RunTest())
+    DREAM3D_REGISTER_TEST(RunExactTest())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
@@ -0,0 +1,382 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "StatsToolboxTestFileLocations.h"
+
+class FindFeatureMorphologyTest
+{
+  const QString k_IndividualDataContainerName = QString("IndividualFilters");
+  const QString k_FusedDataContainerName = QString("FusedFilter");
+  static constexpr size_t k_NumFeatures = 24;
+
+public:
+  FindFeatureMorphologyTest() = default;
+  virtual ~FindFeatureMorphologyTest() = default;
+
+#define DREAM3D_CLOSE_ENOUGH(L, R, eps)                                                                                                                                                                \
+  if(false == SIMPLibMath::closeEnough<>(L, R, eps))                                                                                                                                                   \
+  {                                                                                                                                                                                                    \
+    QString buf;                                                                                                                                                                                       \
+    QTextStream ss(&buf);                                                                                                                                                                              \
+    ss << "Your test required the following\n            '";                                                                                                                                           \
+    ss << "SIMPLibMath::closeEnough<>(" << #L << ", " << #R << ", " << #eps << "'\n             but this condition was not met with eps=" << eps << "\n";                                              \
+    ss << "             " << L << "==" << R;                                                                                                                                                           \
+    DREAM3D_TEST_THROW_EXCEPTION(buf.toStdString())                                                                                                                                                    \
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::FindFeatureMorphologyTest::TestFile1);
+    QFile::remove(UnitTest::FindFeatureMorphologyTest::TestFile2);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindFeatureMorphology Filter from the FilterManager
+    // Also test for the individual filters it is compared against
+    FilterManager* fm = FilterManager::Instance();
+    QStringList filtNames = {"FindFeatureMorphology", "FindSizes", "FindShapes", "FindFeatureCentroids", "FindSurfaceFeatures", "FindBoundingBoxFeatures"};
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The FindFeatureMorphologyTest Requires the use of the " << filtName.toStdString() << " filter";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Adds a Data Container holding a Voronoi style set of Features with a few unassigned Cells
+  // -----------------------------------------------------------------------------
+  void addDataContainer(const DataContainerArray::Pointer& dca, const QString& name)
+  {
+    DataContainer::Pointer dc = DataContainer::New(name);
+    dca->addOrReplaceDataContainer(dc);
+
+    std::vector<size_t> tDims = {40, 30, 20};
+    size_t dims[3] = {tDims[0], tDims[1], tDims[2]};
+    FloatVec3Type res = {0.75f, 0.5f, 0.25f};
+    FloatVec3Type origin = {-3.0f, 12.0f, 0.5f};
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(dims);
+    image->setSpacing(res);
+    image->setOrigin(origin);
+    dc->setGeometry(image);
+
+    AttributeMatrix::Pointer attrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(attrMat);
+    AttributeMatrix::Pointer featAttrMat = AttributeMatrix::New({k_NumFeatures}, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featAttrMat);
+
+    std::vector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims[0] * tDims[1] * tDims[2], cDims, SIMPL::CellData::FeatureIds, true);
+    attrMat->insertOrAssign(featureIds);
+
+    // Fixed pseudo random seed points so both Data Containers hold identical Feature Ids
+    std::vector<size_t> seeds(3 * k_NumFeatures);
+    uint32_t state = 12345;
+    for(size_t i = 0; i < seeds.size(); i++)
+    {
+      state = state * 1103515245u + 12345u;
+      seeds[i] = (state >> 16) % tDims[i % 3];
+    }
+    for(size_t z = 0; z < tDims[2]; z++)
+    {
+      for(size_t y = 0; y < tDims[1]; y++)
+      {
+        for(size_t x = 0; x < tDims[0]; x++)
+        {
+          size_t index = (z * tDims[1] + y) * tDims[0] + x;
+          int32_t closest = 1;
+          int64_t closestDist = std::numeric_limits<int64_t>::max();
+          for(size_t f = 1; f < k_NumFeatures; f++)
+          {
+            int64_t dx = static_cast<int64_t>(x) - static_cast<int64_t>(seeds[3 * f]);
+            int64_t dy = static_cast<int64_t>(y) - static_cast<int64_t>(seeds[3 * f + 1]);
+            int64_t dz = static_cast<int64_t>(z) - static_cast<int64_t>(seeds[3 * f + 2]);
+            int64_t dist = dx * dx + dy * dy + dz * dz;
+            if(dist < closestDist)
+            {
+              closestDist = dist;
+              closest = static_cast<int32_t>(f);
+            }
+          }
+          featureIds->setValue(index, index % 97 == 0 ? 0 : closest);
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer createFilter(const DataContainerArray::Pointer& dca, const QString& filtName)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == factory.get())
+    {
+      return AbstractFilter::NullPointer();
+    }
+    AbstractFilter::Pointer filter = factory->create();
+    filter->setDataContainerArray(dca);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void setProperty(const AbstractFilter::Pointer& filter, const char* name, const QVariant& value)
+  {
+    bool propWasSet = filter->setProperty(name, value);
+    if(!propWasSet)
+    {
+      qDebug() << "Unable to set property " << name;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QVariant featurePath(const QString& dcName, const QString& arrayName)
+  {
+    QVariant var;
+    var.setValue(DataArrayPath(dcName, SIMPL::Defaults::CellFeatureAttributeMatrixName, arrayName));
+    return var;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int runIndividualFilters(const DataContainerArray::Pointer& dca)
+  {
+    QVariant featureIdsPath;
+    featureIdsPath.setValue(DataArrayPath(k_IndividualDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+
+    AbstractFilter::Pointer filter = createFilter(dca, "FindSizes");
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    setProperty(filter, "FeatureIdsArrayPath", featureIdsPath);
+    setProperty(filter, "FeatureAttributeMatrixName", featurePath(k_IndividualDataContainerName, ""));
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    filter = createFilter(dca, "FindFeatureCentroids");
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    setProperty(filter, "FeatureIdsArrayPath", featureIdsPath);
+    setProperty(filter, "CentroidsArrayPath", featurePath(k_IndividualDataContainerName, SIMPL::FeatureData::Centroids));
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    // FindSizes already created the Volumes array
+    filter = createFilter(dca, "FindShapes");
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    setProperty(filter, "FeatureIdsArrayPath", featureIdsPath);
+    setProperty(filter, "CellFeatureAttributeMatrixName", featurePath(k_IndividualDataContainerName, ""));
+    setProperty(filter, "CentroidsArrayPath", featurePath(k_IndividualDataContainerName, SIMPL::FeatureData::Centroids));
+    setProperty(filter, "VolumesArrayName", QString("ShapeVolumes"));
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    filter = createFilter(dca, "FindSurfaceFeatures");
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    setProperty(filter, "FeatureIdsArrayPath", featureIdsPath);
+    setProperty(filter, "SurfaceFeaturesArrayPath", featurePath(k_IndividualDataContainerName, SIMPL::FeatureData::SurfaceFeatures));
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    filter = createFilter(dca, "FindBoundingBoxFeatures");
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    setProperty(filter, "CalcByPhase", false);
+    setProperty(filter, "CentroidsArrayPath", featurePath(k_IndividualDataContainerName, SIMPL::FeatureData::Centroids));
+    setProperty(filter, "SurfaceFeaturesArrayPath", featurePath(k_IndividualDataContainerName, SIMPL::FeatureData::SurfaceFeatures));
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  typename DataArray<T>::Pointer getFeatureArray(const DataContainerArray::Pointer& dca, const QString& dcName, const QString& arrayName)
+  {
+    return dca->getDataContainer(dcName)->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName)->getAttributeArrayAs<DataArray<T>>(arrayName);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  int compareFloatArrays(const DataContainerArray::Pointer& dca, const QString& arrayName, const QString& individualArrayName, float eps)
+  {
+    typename DataArray<T>::Pointer individual = getFeatureArray<T>(dca, k_IndividualDataContainerName, individualArrayName);
+    typename DataArray<T>::Pointer fused = getFeatureArray<T>(dca, k_FusedDataContainerName, arrayName);
+    DREAM3D_REQUIRE_VALID_POINTER(individual.get())
+    DREAM3D_REQUIRE_VALID_POINTER(fused.get())
+    DREAM3D_REQUIRE_EQUAL(individual->getSize(), fused->getSize())
+    // Feature 0 is not a real Feature and the individual filters disagree about it
+    size_t numComps = fused->getNumberOfComponents();
+    for(size_t i = numComps; i < fused->getSize(); i++)
+    {
+      DREAM3D_CLOSE_ENOUGH(fused->getValue(i), individual->getValue(i), eps);
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  int compareExactArrays(const DataContainerArray::Pointer& dca, const QString& arrayName)
+  {
+    typename DataArray<T>::Pointer individual = getFeatureArray<T>(dca, k_IndividualDataContainerName, arrayName);
+    typename DataArray<T>::Pointer fused = getFeatureArray<T>(dca, k_FusedDataContainerName, arrayName);
+    DREAM3D_REQUIRE_VALID_POINTER(individual.get())
+    DREAM3D_REQUIRE_VALID_POINTER(fused.get())
+    DREAM3D_REQUIRE_EQUAL(individual->getSize(), fused->getSize())
+    for(size_t i = 1; i < fused->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(fused->getValue(i), individual->getValue(i))
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFindFeatureMorphologyTest()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    addDataContainer(dca, k_IndividualDataContainerName);
+    addDataContainer(dca, k_FusedDataContainerName);
+
+    int err = runIndividualFilters(dca);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+
+    AbstractFilter::Pointer filter = createFilter(dca, "FindFeatureMorphology");
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    QVariant featureIdsPath;
+    featureIdsPath.setValue(DataArrayPath(k_FusedDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+    setProperty(filter, "FeatureIdsArrayPath", featureIdsPath);
+    setProperty(filter, "CellFeatureAttributeMatrixName", featurePath(k_FusedDataContainerName, ""));
+    setProperty(filter, "CalcByPhase", false);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    compareExactArrays<int32_t>(dca, SIMPL::FeatureData::NumElements);
+    compareExactArrays<bool>(dca, SIMPL::FeatureData::SurfaceFeatures);
+    compareExactArrays<bool>(dca, SIMPL::FeatureData::BiasedFeatures);
+    compareFloatArrays<float>(dca, SIMPL::FeatureData::Centroids, SIMPL::FeatureData::Centroids, 0.0001f);
+    compareFloatArrays<float>(dca, SIMPL::FeatureData::Volumes, SIMPL::FeatureData::Volumes, 0.0001f);
+    compareFloatArrays<float>(dca, SIMPL::FeatureData::EquivalentDiameters, SIMPL::FeatureData::EquivalentDiameters, 0.0001f);
+    compareFloatArrays<float>(dca, SIMPL::FeatureData::Omega3s, SIMPL::FeatureData::Omega3s, 0.001f);
+    compareFloatArrays<float>(dca, SIMPL::FeatureData::AxisLengths, SIMPL::FeatureData::AxisLengths, 0.001f);
+    compareFloatArrays<float>(dca, SIMPL::FeatureData::AspectRatios, SIMPL::FeatureData::AspectRatios, 0.001f);
+    compareFloatArrays<float>(dca, SIMPL::FeatureData::AxisEulerAngles, SIMPL::FeatureData::AxisEulerAngles, 0.001f);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFindFeatureMorphology2DRejected()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    addDataContainer(dca, k_FusedDataContainerName);
+    ImageGeom::Pointer image = dca->getDataContainer(k_FusedDataContainerName)->getGeometryAs<ImageGeom>();
+    size_t dims[3] = {40, 30, 1};
+    image->setDimensions(dims);
+
+    AbstractFilter::Pointer filter = createFilter(dca, "FindFeatureMorphology");
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    QVariant featureIdsPath;
+    featureIdsPath.setValue(DataArrayPath(k_FusedDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+    setProperty(filter, "FeatureIdsArrayPath", featureIdsPath);
+    setProperty(filter, "CellFeatureAttributeMatrixName", featurePath(k_FusedDataContainerName, ""));
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -11000);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestFindFeatureMorphologyTest())
+    DREAM3D_REGISTER_TEST(TestFindFeatureMorphology2DRejected())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  FindFeatureMorphologyTest(const FindFeatureMorphologyTest&) = delete;            // Copy Constructor Not Implemented
+  FindFeatureMorphologyTest(FindFeatureMorphologyTest&&) = delete;                 // Move Constructor Not Implemented
+  FindFeatureMorphologyTest& operator=(const FindFeatureMorphologyTest&) = delete; // Copy Assignment Not Implemented
+  FindFeatureMorphologyTest& operator=(FindFeatureMorphologyTest&&) = delete;      // Move Assignment Not Implemented
+};
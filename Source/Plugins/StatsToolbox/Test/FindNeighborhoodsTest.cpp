@@ -0,0 +1,396 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <QtCore/QDebug>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "StatsToolbox/StatsToolboxFilters/util/FeatureCentroidGrid.hpp"
+
+#include "StatsToolboxTestFileLocations.h"
+
+/**
+ * @brief The FindNeighborhoodsTest class checks the FeatureCentroidGrid queries and the grid based FindNeighborhoods
+ * against brute force searches over every pair of Features.
+ *
+ * Both data sets place most centroids in a compact cluster and a few far outside of it. The outliers stretch the
+ * bounding box so far that the grid only stays under its limit of 8 cells per point (plus 64) by doubling the cell
+ * size several times, and the queries around the edges of the cluster and the outliers reach past the grid extent.
+ */
+class FindNeighborhoodsTest
+{
+  const QString k_DataContainerName = QString("ImageDataContainer");
+  const QString k_FeatureAttrMatName = QString("CellFeatureData");
+  const QString k_EquivalentDiametersName = QString("EquivalentDiameters");
+  const QString k_PhasesName = QString("Phases");
+  const QString k_CentroidsName = QString("Centroids");
+  const QString k_NeighborhoodsName = QString("Neighborhoods");
+  const QString k_NeighborhoodListName = QString("NeighborhoodList");
+  static constexpr uint64_t k_Seed = 5489;
+  static constexpr size_t k_NumFeatures = 400;
+  static constexpr float k_OutlierDistance = 5.0E4f;
+
+public:
+  FindNeighborhoodsTest() = default;
+  virtual ~FindNeighborhoodsTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QString filtName = "FindNeighborhoods";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindNeighborhoodsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the StatsToolbox Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Random centroids in a cluster of edge length 60, with every 50th centroid moved out along one or more axes
+  // -----------------------------------------------------------------------------
+  std::vector<float> CreateCentroids(std::mt19937_64& generator, float offset)
+  {
+    std::uniform_real_distribution<float> coord(0.0f, 60.0f);
+    std::vector<float> centroids(3 * k_NumFeatures, 0.0f);
+    for(size_t i = 1; i < k_NumFeatures; i++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        centroids[3 * i + d] = offset + coord(generator);
+      }
+      if(i % 50 == 0)
+      {
+        const size_t axes = (i / 50) % 8;
+        for(size_t d = 0; d < 3; d++)
+        {
+          if((axes & (1ULL << d)) != 0 || axes == 0)
+          {
+            centroids[3 * i + d] += k_OutlierDistance;
+          }
+        }
+      }
+    }
+    // A few Features right next to the last outlier so that the far cells hold neighborhoods too
+    for(size_t i = k_NumFeatures - 5; i < k_NumFeatures; i++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        centroids[3 * i + d] = centroids[3 * 350 + d] + static_cast<float>(i + 6 - k_NumFeatures);
+      }
+    }
+    return centroids;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestGridQueries()
+  {
+    std::mt19937_64 generator(k_Seed);
+    std::vector<float> centroids = CreateCentroids(generator, 0.0f);
+    auto include = [](size_t i) { return i > 0 && i % 7 != 0; };
+
+    for(double cellSize : {0.5, 1.0, 4.0})
+    {
+      FeatureCentroidGrid grid(centroids.data(), k_NumFeatures, include, cellSize);
+
+      std::uniform_real_distribution<double> center(-100.0, 100.0 + static_cast<double>(k_OutlierDistance));
+      std::uniform_real_distribution<double> halfWidth(0.0, 30.0);
+      std::uniform_int_distribution<size_t> pick(1, k_NumFeatures - 1);
+      for(size_t q = 0; q < 500; q++)
+      {
+        std::array<double, 3> low = {0.0, 0.0, 0.0};
+        std::array<double, 3> high = {0.0, 0.0, 0.0};
+        // Alternate between boxes around a centroid, random boxes (mostly in the empty space between the cluster
+        // and the outliers) and boxes that lie partially or entirely outside of the grid extent
+        const size_t anchor = pick(generator);
+        for(size_t d = 0; d < 3; d++)
+        {
+          double c = center(generator);
+          if(q % 3 == 0)
+          {
+            c = static_cast<double>(centroids[3 * anchor + d]);
+          }
+          else if(q % 3 == 1)
+          {
+            c = (q % 2 == 0) ? -c - 100.0 : c + static_cast<double>(k_OutlierDistance);
+          }
+          const double w = (q % 3 == 1) ? 2.0 * static_cast<double>(k_OutlierDistance) * halfWidth(generator) / 30.0 : halfWidth(generator);
+          low[d] = c - w;
+          high[d] = c + w;
+        }
+
+        std::vector<int32_t> visits(k_NumFeatures, 0);
+        grid.forEachCandidate(low, high, [&](size_t j) { visits[j]++; });
+        for(size_t j = 0; j < k_NumFeatures; j++)
+        {
+          // Every point is handed back at most once and only points that take part in the queries are handed back
+          DREAM3D_REQUIRED(visits[j], <=, 1)
+          if(!include(j))
+          {
+            DREAM3D_REQUIRE_EQUAL(visits[j], 0)
+            continue;
+          }
+          bool inside = true;
+          for(size_t d = 0; d < 3; d++)
+          {
+            const double value = static_cast<double>(centroids[3 * j + d]);
+            inside = inside && value >= low[d] && value <= high[d];
+          }
+          if(inside)
+          {
+            DREAM3D_REQUIRE_EQUAL(visits[j], 1)
+          }
+        }
+      }
+    }
+
+    // No included points at all
+    FeatureCentroidGrid empty(centroids.data(), k_NumFeatures, [](size_t) { return false; }, 1.0);
+    size_t emptyVisits = 0;
+    empty.forEachWithinRadius({0.0, 0.0, 0.0}, 1.0E6, [&](size_t) { emptyVisits++; });
+    DREAM3D_REQUIRE(emptyVisits == 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateFeatures(const std::vector<float>& centroids, const std::vector<float>& diameters, const FloatVec3Type& origin)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(10, 10, 10));
+    imageGeom->setSpacing(FloatVec3Type(1.0f, 1.0f, 1.0f));
+    imageGeom->setOrigin(origin);
+    dc->setGeometry(imageGeom);
+
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New({k_NumFeatures}, k_FeatureAttrMatName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAM);
+
+    FloatArrayType::Pointer diametersArray = FloatArrayType::CreateArray(k_NumFeatures, k_EquivalentDiametersName, true);
+    std::copy(diameters.begin(), diameters.end(), diametersArray->getPointer(0));
+    featureAM->insertOrAssign(diametersArray);
+
+    Int32ArrayType::Pointer phasesArray = Int32ArrayType::CreateArray(k_NumFeatures, k_PhasesName, true);
+    phasesArray->initializeWithValue(1);
+    phasesArray->setValue(0, 0);
+    featureAM->insertOrAssign(phasesArray);
+
+    FloatArrayType::Pointer centroidsArray = FloatArrayType::CreateArray(k_NumFeatures, std::vector<size_t>(1, 3), k_CentroidsName, true);
+    std::copy(centroids.begin(), centroids.end(), centroidsArray->getPointer(0));
+    featureAM->insertOrAssign(centroidsArray);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void setProperty(const AbstractFilter::Pointer& filter, const char* name, const QVariant& value)
+  {
+    bool propWasSet = filter->setProperty(name, value);
+    if(!propWasSet)
+    {
+      qDebug() << "Unable to set property " << name;
+    }
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RunFindNeighborhoods(const DataContainerArray::Pointer& dca, float multiplesOfAverage)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("FindNeighborhoods");
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant variant;
+    setProperty(filter, "MultiplesOfAverage", multiplesOfAverage);
+    variant.setValue(DataArrayPath(k_DataContainerName, k_FeatureAttrMatName, k_EquivalentDiametersName));
+    setProperty(filter, "EquivalentDiametersArrayPath", variant);
+    variant.setValue(DataArrayPath(k_DataContainerName, k_FeatureAttrMatName, k_PhasesName));
+    setProperty(filter, "FeaturePhasesArrayPath", variant);
+    variant.setValue(DataArrayPath(k_DataContainerName, k_FeatureAttrMatName, k_CentroidsName));
+    setProperty(filter, "CentroidsArrayPath", variant);
+    setProperty(filter, "NeighborhoodsArrayName", k_NeighborhoodsName);
+    setProperty(filter, "NeighborhoodListArrayName", k_NeighborhoodListName);
+
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  // The all pairs search FindNeighborhoods used before the centroid grid, including its float arithmetic
+  // -----------------------------------------------------------------------------
+  std::vector<std::vector<int32_t>> ComputeReference(const std::vector<float>& centroids, const std::vector<float>& diameters, const FloatVec3Type& origin, float multiplesOfAverage)
+  {
+    std::vector<float> criticalDistance(k_NumFeatures, 0.0f);
+    float aveDiam = 0.0f;
+    for(size_t i = 1; i < k_NumFeatures; i++)
+    {
+      aveDiam += diameters[i];
+      criticalDistance[i] = diameters[i] * multiplesOfAverage;
+    }
+    aveDiam /= k_NumFeatures;
+    for(size_t i = 1; i < k_NumFeatures; i++)
+    {
+      criticalDistance[i] /= aveDiam;
+    }
+
+    std::vector<int64_t> bins(3 * k_NumFeatures, 0);
+    for(size_t i = 1; i < k_NumFeatures; i++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        bins[3 * i + d] = static_cast<int64_t>(static_cast<size_t>((centroids[3 * i + d] - origin[d]) / aveDiam));
+      }
+    }
+
+    std::vector<std::vector<int32_t>> neighborhoods(k_NumFeatures);
+    for(size_t i = 1; i < k_NumFeatures; i++)
+    {
+      for(size_t j = 1; j < k_NumFeatures; j++)
+      {
+        if(j == i)
+        {
+          continue;
+        }
+        float dBinX = llabs(bins[3 * j] - bins[3 * i]);
+        float dBinY = llabs(bins[3 * j + 1] - bins[3 * i + 1]);
+        float dBinZ = llabs(bins[3 * j + 2] - bins[3 * i + 2]);
+        if(dBinX < criticalDistance[i] && dBinY < criticalDistance[i] && dBinZ < criticalDistance[i])
+        {
+          neighborhoods[i].push_back(static_cast<int32_t>(j));
+        }
+      }
+    }
+    return neighborhoods;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFindNeighborhoods()
+  {
+    std::mt19937_64 generator(k_Seed + 1);
+    const FloatVec3Type origin(-2.5f, 0.0f, 1.0f);
+    std::vector<float> centroids = CreateCentroids(generator, 1.0f);
+    std::uniform_real_distribution<float> diameter(0.5f, 6.0f);
+    std::vector<float> diameters(k_NumFeatures, 0.0f);
+    for(size_t i = 1; i < k_NumFeatures; i++)
+    {
+      diameters[i] = diameter(generator);
+    }
+
+    for(float multiplesOfAverage : {0.5f, 1.0f, 3.5f})
+    {
+      DataContainerArray::Pointer dca = CreateFeatures(centroids, diameters, origin);
+      RunFindNeighborhoods(dca, multiplesOfAverage);
+      std::vector<std::vector<int32_t>> expected = ComputeReference(centroids, diameters, origin, multiplesOfAverage);
+
+      AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix(DataArrayPath(k_DataContainerName, k_FeatureAttrMatName, ""));
+      Int32ArrayType::Pointer neighborhoods = featureAM->getAttributeArrayAs<Int32ArrayType>(k_NeighborhoodsName);
+      NeighborList<int32_t>::Pointer neighborhoodList = featureAM->getAttributeArrayAs<NeighborList<int32_t>>(k_NeighborhoodListName);
+      DREAM3D_REQUIRE_VALID_POINTER(neighborhoods.get())
+      DREAM3D_REQUIRE_VALID_POINTER(neighborhoodList.get())
+
+      size_t totalNeighbors = 0;
+      for(size_t i = 1; i < k_NumFeatures; i++)
+      {
+        const std::vector<int32_t>& list = neighborhoodList->getListReference(static_cast<int32_t>(i));
+        DREAM3D_REQUIRE_EQUAL(neighborhoods->getValue(i), static_cast<int32_t>(expected[i].size()))
+        DREAM3D_REQUIRE_EQUAL(list.size(), expected[i].size())
+        for(size_t n = 0; n < list.size(); n++)
+        {
+          DREAM3D_REQUIRE_EQUAL(list[n], expected[i][n])
+        }
+        totalNeighbors += list.size();
+      }
+      // Make sure the comparison is not between two sets of empty lists
+      DREAM3D_REQUIRED(totalNeighbors, >, 0)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestGridQueries())
+    DREAM3D_REGISTER_TEST(TestFindNeighborhoods())
+  }
+
+public:
+  FindNeighborhoodsTest(const FindNeighborhoodsTest&) = delete;            // Copy Constructor Not Implemented
+  FindNeighborhoodsTest(FindNeighborhoodsTest&&) = delete;                 // Move Constructor Not Implemented
+  FindNeighborhoodsTest& operator=(const FindNeighborhoodsTest&) = delete; // Copy Assignment Not Implemented
+  FindNeighborhoodsTest& operator=(FindNeighborhoodsTest&&) = delete;      // Move Assignment Not Implemented
+};
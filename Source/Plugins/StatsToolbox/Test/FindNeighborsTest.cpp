@@ -0,0 +1,296 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include <QtCore/QDebug>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "StatsToolboxTestFileLocations.h"
+
+/**
+ * @brief The FindNeighborsTest class runs FindNeighbors on a small labeled volume whose neighbor lists, shared
+ * surface areas, boundary cell counts and surface Features were worked out by hand.
+ *
+ * The 4 x 4 x 3 volume, listed one z plane at a time with x running along each row:
+ * @code
+ *   z = 0          z = 1          z = 2
+ *   1 1 1 1        3 3 3 4        2 2 2 2
+ *   1 1 1 1        3 5 5 4        2 2 2 2
+ *   1 1 1 1        3 3 3 4        2 2 2 2
+ *   1 1 1 0        3 3 3 4        2 2 2 2
+ * @endcode
+ * Feature 5 is the only Feature that does not reach the outside of the volume. The spacing is (0.5, 3, 1), so every
+ * shared face counts as 1.5, the x times y face area the filter uses for all directions.
+ */
+class FindNeighborsTest
+{
+  const QString k_DataContainerName = QString("ImageDataContainer");
+  const QString k_CellAttrMatName = QString("CellData");
+  const QString k_FeatureAttrMatName = QString("CellFeatureData");
+  const QString k_FeatureIdsName = QString("FeatureIds");
+  const QString k_NeighborListName = QString("NeighborList");
+  const QString k_SharedSurfaceAreaListName = QString("SharedSurfaceAreaList");
+  const QString k_NumNeighborsName = QString("NumNeighbors");
+  const QString k_BoundaryCellsName = QString("BoundaryCells");
+  const QString k_SurfaceFeaturesName = QString("SurfaceFeatures");
+  static constexpr size_t k_NumFeatures = 6;
+
+public:
+  FindNeighborsTest() = default;
+  virtual ~FindNeighborsTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QString filtName = "FindNeighbors";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindNeighborsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the StatsToolbox Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateVolume(const std::vector<size_t>& dims, const std::vector<int32_t>& featureIds)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(dims[0], dims[1], dims[2]));
+    imageGeom->setSpacing(FloatVec3Type(0.5f, 3.0f, 1.0f));
+    dc->setGeometry(imageGeom);
+
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, k_CellAttrMatName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    Int32ArrayType::Pointer featureIdsArray = Int32ArrayType::CreateArray(featureIds.size(), k_FeatureIdsName, true);
+    std::copy(featureIds.begin(), featureIds.end(), featureIdsArray->getPointer(0));
+    cellAM->insertOrAssign(featureIdsArray);
+
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New({k_NumFeatures}, k_FeatureAttrMatName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAM);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void setProperty(const AbstractFilter::Pointer& filter, const char* name, const QVariant& value)
+  {
+    bool propWasSet = filter->setProperty(name, value);
+    if(!propWasSet)
+    {
+      qDebug() << "Unable to set property " << name;
+    }
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RunFindNeighbors(const DataContainerArray::Pointer& dca)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("FindNeighbors");
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant variant;
+    variant.setValue(DataArrayPath(k_DataContainerName, k_CellAttrMatName, k_FeatureIdsName));
+    setProperty(filter, "FeatureIdsArrayPath", variant);
+    variant.setValue(DataArrayPath(k_DataContainerName, k_FeatureAttrMatName, ""));
+    setProperty(filter, "CellFeatureAttributeMatrixPath", variant);
+    setProperty(filter, "NeighborListArrayName", k_NeighborListName);
+    setProperty(filter, "SharedSurfaceAreaListArrayName", k_SharedSurfaceAreaListName);
+    setProperty(filter, "NumNeighborsArrayName", k_NumNeighborsName);
+    setProperty(filter, "BoundaryCellsArrayName", k_BoundaryCellsName);
+    setProperty(filter, "SurfaceFeaturesArrayName", k_SurfaceFeaturesName);
+    setProperty(filter, "StoreBoundaryCells", true);
+    setProperty(filter, "StoreSurfaceFeatures", true);
+
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareFeatureData(const DataContainerArray::Pointer& dca, const std::vector<std::vector<int32_t>>& expectedNeighbors, const std::vector<std::vector<float>>& expectedAreas,
+                          const std::vector<bool>& expectedSurfaceFeatures)
+  {
+    AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix(DataArrayPath(k_DataContainerName, k_FeatureAttrMatName, ""));
+    NeighborList<int32_t>::Pointer neighborList = featureAM->getAttributeArrayAs<NeighborList<int32_t>>(k_NeighborListName);
+    NeighborList<float>::Pointer sharedSurfaceAreaList = featureAM->getAttributeArrayAs<NeighborList<float>>(k_SharedSurfaceAreaListName);
+    Int32ArrayType::Pointer numNeighbors = featureAM->getAttributeArrayAs<Int32ArrayType>(k_NumNeighborsName);
+    BoolArrayType::Pointer surfaceFeatures = featureAM->getAttributeArrayAs<BoolArrayType>(k_SurfaceFeaturesName);
+    DREAM3D_REQUIRE_VALID_POINTER(neighborList.get())
+    DREAM3D_REQUIRE_VALID_POINTER(sharedSurfaceAreaList.get())
+    DREAM3D_REQUIRE_VALID_POINTER(numNeighbors.get())
+    DREAM3D_REQUIRE_VALID_POINTER(surfaceFeatures.get())
+
+    for(size_t i = 1; i < k_NumFeatures; i++)
+    {
+      const std::vector<int32_t>& neighbors = neighborList->getListReference(static_cast<int32_t>(i));
+      const std::vector<float>& areas = sharedSurfaceAreaList->getListReference(static_cast<int32_t>(i));
+      DREAM3D_REQUIRE_EQUAL(numNeighbors->getValue(i), static_cast<int32_t>(expectedNeighbors[i].size()))
+      DREAM3D_REQUIRE_EQUAL(neighbors.size(), expectedNeighbors[i].size())
+      DREAM3D_REQUIRE_EQUAL(areas.size(), expectedAreas[i].size())
+      for(size_t n = 0; n < neighbors.size(); n++)
+      {
+        DREAM3D_REQUIRE_EQUAL(neighbors[n], expectedNeighbors[i][n])
+        DREAM3D_REQUIRE(std::fabs(areas[n] - expectedAreas[i][n]) < 1.0E-6f)
+      }
+      DREAM3D_REQUIRE_EQUAL(surfaceFeatures->getValue(i), expectedSurfaceFeatures[i])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareBoundaryCells(const DataContainerArray::Pointer& dca, const std::vector<int8_t>& expectedBoundaryCells)
+  {
+    Int8ArrayType::Pointer boundaryCells = dca->getAttributeMatrix(DataArrayPath(k_DataContainerName, k_CellAttrMatName, ""))->getAttributeArrayAs<Int8ArrayType>(k_BoundaryCellsName);
+    DREAM3D_REQUIRE_VALID_POINTER(boundaryCells.get())
+    DREAM3D_REQUIRE_EQUAL(boundaryCells->getNumberOfTuples(), expectedBoundaryCells.size())
+    for(size_t i = 0; i < expectedBoundaryCells.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(boundaryCells->getValue(i), expectedBoundaryCells[i])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestVolume()
+  {
+    // clang-format off
+    const std::vector<int32_t> featureIds = {
+      1, 1, 1, 1,   1, 1, 1, 1,   1, 1, 1, 1,   1, 1, 1, 0,
+      3, 3, 3, 4,   3, 5, 5, 4,   3, 3, 3, 4,   3, 3, 3, 4,
+      2, 2, 2, 2,   2, 2, 2, 2,   2, 2, 2, 2,   2, 2, 2, 2,
+    };
+    // The number of face neighbors of each cell that belong to another, non zero, Feature
+    const std::vector<int8_t> boundaryCells = {
+      1, 1, 1, 1,   1, 1, 1, 1,   1, 1, 1, 1,   1, 1, 1, 0,
+      2, 3, 4, 3,   3, 5, 5, 3,   2, 3, 4, 3,   2, 2, 3, 2,
+      1, 1, 1, 1,   1, 1, 1, 1,   1, 1, 1, 1,   1, 1, 1, 1,
+    };
+    // clang-format on
+
+    // Shared faces: 1-3 10, 1-4 3, 1-5 2, 2-3 10, 2-4 4, 2-5 2, 3-4 3, 3-5 5 and 4-5 1
+    const std::vector<std::vector<int32_t>> neighbors = {{}, {3, 4, 5}, {3, 4, 5}, {1, 2, 4, 5}, {1, 2, 3, 5}, {1, 2, 3, 4}};
+    const std::vector<std::vector<float>> areas = {{}, {15.0f, 4.5f, 3.0f}, {15.0f, 6.0f, 3.0f}, {15.0f, 15.0f, 4.5f, 7.5f}, {4.5f, 6.0f, 4.5f, 1.5f}, {3.0f, 3.0f, 7.5f, 1.5f}};
+    const std::vector<bool> surfaceFeatures = {false, true, true, true, true, false};
+
+    DataContainerArray::Pointer dca = CreateVolume({4, 4, 3}, featureIds);
+    RunFindNeighbors(dca);
+    CompareFeatureData(dca, neighbors, areas, surfaceFeatures);
+    CompareBoundaryCells(dca, boundaryCells);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The middle plane on its own. In 2D only the x and y sides of the image are outside, and Features 1 and 2 have
+  // no Cells at all.
+  // -----------------------------------------------------------------------------
+  int TestImage()
+  {
+    // clang-format off
+    const std::vector<int32_t> featureIds = {
+      3, 3, 3, 4,   3, 5, 5, 4,   3, 3, 3, 4,   3, 3, 3, 4,
+    };
+    const std::vector<int8_t> boundaryCells = {
+      0, 1, 2, 1,   1, 3, 3, 1,   0, 1, 2, 1,   0, 0, 1, 1,
+    };
+    // clang-format on
+
+    // Shared faces: 3-4 3, 3-5 5 and 4-5 1
+    const std::vector<std::vector<int32_t>> neighbors = {{}, {}, {}, {4, 5}, {3, 5}, {3, 4}};
+    const std::vector<std::vector<float>> areas = {{}, {}, {}, {4.5f, 7.5f}, {4.5f, 1.5f}, {7.5f, 1.5f}};
+    const std::vector<bool> surfaceFeatures = {false, false, false, true, true, false};
+
+    DataContainerArray::Pointer dca = CreateVolume({4, 4, 1}, featureIds);
+    RunFindNeighbors(dca);
+    CompareFeatureData(dca, neighbors, areas, surfaceFeatures);
+    CompareBoundaryCells(dca, boundaryCells);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestVolume())
+    DREAM3D_REGISTER_TEST(TestImage())
+  }
+
+public:
+  FindNeighborsTest(const FindNeighborsTest&) = delete;            // Copy Constructor Not Implemented
+  FindNeighborsTest(FindNeighborsTest&&) = delete;                 // Move Constructor Not Implemented
+  FindNeighborsTest& operator=(const FindNeighborsTest&) = delete; // Copy Assignment Not Implemented
+  FindNeighborsTest& operator=(FindNeighborsTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -35,7 +35,9 @@
 #include "LaplacianSmoothing.h"
 
 #include <cstdio>
+#include <limits>
 #include <sstream>
+#include <vector>
 
 #include <QtCore/QDebug>
 #include <QtCore/QTextStream>
@@ -44,16 +46,224 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
+namespace
+{
+/**
+ * @brief The VertexAdjacency class holds the neighbors of every vertex in compressed row (CSR) form. The neighbors of
+ * vertex i are m_Neighbors[m_Offsets[i]] ... m_Neighbors[m_Offsets[i + 1] - 1]. The valence of each vertex is fixed
+ * for the life of the mesh so its reciprocal is cached here instead of being recounted every iteration.
+ */
+template <typename IndexType>
+class VertexAdjacency
+{
+public:
+  VertexAdjacency(const MeshIndexType* uedges, MeshIndexType nedges, MeshIndexType nvert)
+  : m_Offsets(nvert + 1, 0)
+  , m_Neighbors(2 * nedges)
+  , m_InvValence(nvert, 0.0)
+  {
+    for(MeshIndexType i = 0; i < nedges; i++)
+    {
+      m_Offsets[uedges[2 * i] + 1]++;
+      m_Offsets[uedges[2 * i + 1] + 1]++;
+    }
+    for(MeshIndexType i = 0; i < nvert; i++)
+    {
+      m_Offsets[i + 1] += m_Offsets[i];
+    }
+
+    std::vector<MeshIndexType> cursor(m_Offsets.begin(), m_Offsets.end() - 1);
+    for(MeshIndexType i = 0; i < nedges; i++)
+    {
+      MeshIndexType in1 = uedges[2 * i];
+      MeshIndexType in2 = uedges[2 * i + 1];
+      m_Neighbors[cursor[in1]++] = static_cast<IndexType>(in2);
+      m_Neighbors[cursor[in2]++] = static_cast<IndexType>(in1);
+    }
+
+    for(MeshIndexType i = 0; i < nvert; i++)
+    {
+      MeshIndexType valence = m_Offsets[i + 1] - m_Offsets[i];
+      m_InvValence[i] = valence > 0 ? 1.0 / static_cast<double>(valence) : 0.0;
+    }
+  }
+
+  std::vector<MeshIndexType> m_Offsets;
+  std::vector<IndexType> m_Neighbors;
+  std::vector<double> m_InvValence;
+};
+
+/**
+ * @brief The ComputeDeltaImpl class gathers the umbrella operator for a range of vertices. Each vertex only writes
+ * its own delta so no synchronization is needed between threads.
+ */
+template <typename IndexType, typename AccumType>
+class ComputeDeltaImpl
+{
+public:
+  ComputeDeltaImpl(const VertexAdjacency<IndexType>& adjacency, const float* verts, AccumType* delta)
+  : m_Adjacency(adjacency)
+  , m_Verts(verts)
+  , m_Delta(delta)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const MeshIndexType* offsets = m_Adjacency.m_Offsets.data();
+    const IndexType* neighbors = m_Adjacency.m_Neighbors.data();
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      const float* p = m_Verts + 3 * i;
+      AccumType sum[3] = {0, 0, 0};
+      for(MeshIndexType k = offsets[i]; k < offsets[i + 1]; k++)
+      {
+        const float* q = m_Verts + 3 * static_cast<size_t>(neighbors[k]);
+        sum[0] += static_cast<AccumType>(q[0] - p[0]);
+        sum[1] += static_cast<AccumType>(q[1] - p[1]);
+        sum[2] += static_cast<AccumType>(q[2] - p[2]);
+      }
+      const AccumType invValence = static_cast<AccumType>(m_Adjacency.m_InvValence[i]);
+      m_Delta[3 * i] = sum[0] * invValence;
+      m_Delta[3 * i + 1] = sum[1] * invValence;
+      m_Delta[3 * i + 2] = sum[2] * invValence;
+    }
+  }
+
+private:
+  const VertexAdjacency<IndexType>& m_Adjacency;
+  const float* m_Verts = nullptr;
+  AccumType* m_Delta = nullptr;
+};
+
+/**
+ * @brief The MoveVerticesImpl class applies the previously gathered deltas scaled by the per vertex lambda value.
+ */
+template <typename AccumType>
+class MoveVerticesImpl
+{
+public:
+  MoveVerticesImpl(float* verts, const float* lambda, float scale, const AccumType* delta)
+  : m_Verts(verts)
+  , m_Lambda(lambda)
+  , m_Scale(scale)
+  , m_Delta(delta)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      const float ll = m_Lambda[i] * m_Scale;
+      for(size_t j = 0; j < 3; j++)
+      {
+        m_Verts[3 * i + j] += ll * m_Delta[3 * i + j];
+      }
+    }
+  }
+
+private:
+  float* m_Verts = nullptr;
+  const float* m_Lambda = nullptr;
+  float m_Scale = 1.0f;
+  const AccumType* m_Delta = nullptr;
+};
+
+/**
+ * @brief The VertexSmoother class runs the Jacobi style smoothing iterations over a prebuilt adjacency table. The
+ * delta buffer is allocated once and reused for every pass.
+ */
+template <typename IndexType, typename AccumType>
+class VertexSmoother
+{
+public:
+  VertexSmoother(const VertexAdjacency<IndexType>& adjacency, float* verts, const float* lambda, MeshIndexType nvert)
+  : m_Adjacency(adjacency)
+  , m_Verts(verts)
+  , m_Lambda(lambda)
+  , m_NumVerts(nvert)
+  , m_Delta(3 * nvert, 0)
+  {
+  }
+
+  void smooth(float scale)
+  {
+    ParallelDataAlgorithm deltaAlg;
+    deltaAlg.setRange(0, m_NumVerts);
+    deltaAlg.execute(ComputeDeltaImpl<IndexType, AccumType>(m_Adjacency, m_Verts, m_Delta.data()));
+
+    ParallelDataAlgorithm moveAlg;
+    moveAlg.setRange(0, m_NumVerts);
+    moveAlg.execute(MoveVerticesImpl<AccumType>(m_Verts, m_Lambda, scale, m_Delta.data()));
+  }
+
+private:
+  const VertexAdjacency<IndexType>& m_Adjacency;
+  float* m_Verts = nullptr;
+  const float* m_Lambda = nullptr;
+  MeshIndexType m_NumVerts = 0;
+  std::vector<AccumType> m_Delta;
+};
+
+/**
+ * @brief Runs all of the smoothing iterations for one adjacency index type. Returns -1 if the filter was canceled.
+ */
+template <typename IndexType, typename AccumType>
+int32_t RunVertexSmoothing(LaplacianSmoothing* filter, const VertexAdjacency<IndexType>& adjacency, float* verts, const float* lambda, MeshIndexType nvert)
+{
+  VertexSmoother<IndexType, AccumType> smoother(adjacency, verts, lambda, nvert);
+  const int32_t iterationSteps = filter->getIterationSteps();
+  for(int32_t q = 0; q < iterationSteps; q++)
+  {
+    if(filter->getCancel())
+    {
+      return -1;
+    }
+    QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(iterationSteps);
+    filter->notifyStatusMessage(ss);
+    smoother.smooth(1.0f);
+
+    // Taubin's shrink free smoothing applies a second, negative lambda pass
+    if(filter->getUseTaubinSmoothing())
+    {
+      if(filter->getCancel())
+      {
+        return -1;
+      }
+      smoother.smooth(filter->getMuFactor());
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Dispatches on the accumulation precision requested by the user.
+ */
+template <typename IndexType>
+int32_t RunVertexSmoothing(LaplacianSmoothing* filter, const MeshIndexType* uedges, MeshIndexType nedges, float* verts, const float* lambda, MeshIndexType nvert)
+{
+  VertexAdjacency<IndexType> adjacency(uedges, nedges, nvert);
+  if(filter->getUseFloatAccumulation())
+  {
+    return RunVertexSmoothing<IndexType, float>(filter, adjacency, verts, lambda, nvert);
+  }
+  return RunVertexSmoothing<IndexType, double>(filter, adjacency, verts, lambda, nvert);
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -83,6 +293,8 @@ void LaplacianSmoothing::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Outer Points Lambda", SurfacePointLambda, FilterParameter::Category::Parameter, LaplacianSmoothing));
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Outer Triple Line Lambda", SurfaceTripleLineLambda, FilterParameter::Category::Parameter, LaplacianSmoothing));
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Outer Quadruple Points Lambda", SurfaceQuadPointLambda, FilterParameter::Category::Parameter, LaplacianSmoothing));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Smoothing", UseParallelSmoothing, FilterParameter::Category::Parameter, LaplacianSmoothing));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Single Precision Accumulation", UseFloatAccumulation, FilterParameter::Category::Parameter, LaplacianSmoothing));
   parameters.push_back(SeparatorFilterParameter::Create("Vertex Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int8, 1, AttributeMatrix::Type::Vertex, IGeometry::Type::Triangle);
@@ -113,6 +325,8 @@ void LaplacianSmoothing::readFilterParameters(AbstractFilterParametersReader* re
   setSurfaceMeshFaceLabelsArrayPath(reader->readDataArrayPath("SurfaceMeshFaceLabelsArrayPath", getSurfaceMeshFaceLabelsArrayPath()));
   setUseTaubinSmoothing(reader->readValue("UseTaubinSmoothing", getUseTaubinSmoothing()));
   setMuFactor(reader->readValue("MuFactor", getMuFactor()));
+  setUseParallelSmoothing(reader->readValue("UseParallelSmoothing", getUseParallelSmoothing()));
+  setUseFloatAccumulation(reader->readValue("UseFloatAccumulation", getUseFloatAccumulation()));
   reader->closeFilterGroup();
 }
 
@@ -181,7 +395,7 @@ void LaplacianSmoothing::execute()
     return;
   }
 
-  int err = edgeBasedSmoothing();
+  int err = m_UseParallelSmoothing ? vertexBasedSmoothing() : edgeBasedSmoothing();
 
   if(err < 0)
   {
@@ -373,6 +587,48 @@ int32_t LaplacianSmoothing::edgeBasedSmoothing()
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t LaplacianSmoothing::vertexBasedSmoothing()
+{
+  int32_t err = 0;
+  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
+  IGeometry2D::Pointer surfaceMesh = sm->getGeometryAs<IGeometry2D>();
+  float* verts = surfaceMesh->getVertexPointer(0);
+  MeshIndexType nvert = surfaceMesh->getNumberOfVertices();
+
+  // Generate the Lambda Array
+  err = generateLambdaArray();
+  if(err < 0)
+  {
+    setErrorCondition(-557, "Error generating the lambda array");
+    return err;
+  }
+  float* lambda = getLambdaArray()->getPointer(0);
+
+  //  Generate the Unique Edges
+  if(nullptr == surfaceMesh->getEdges().get())
+  {
+    err = surfaceMesh->findEdges();
+  }
+  if(err < 0)
+  {
+    setErrorCondition(-560, "Error retrieving the shared edge list");
+    return getErrorCode();
+  }
+
+  MeshIndexType* uedges = surfaceMesh->getEdgePointer(0);
+  MeshIndexType nedges = surfaceMesh->getNumberOfEdges();
+
+  // Halve the size of the neighbor table whenever the vertex indices fit in 32 bits
+  if(nvert <= static_cast<MeshIndexType>(std::numeric_limits<uint32_t>::max()))
+  {
+    return RunVertexSmoothing<uint32_t>(this, uedges, nedges, verts, lambda, nvert);
+  }
+  return RunVertexSmoothing<MeshIndexType>(this, uedges, nedges, verts, lambda, nvert);
+}
+
 // -----------------------------------------------------------------------------
 // This is just here for some debugging issues.
 // -----------------------------------------------------------------------------
@@ -737,6 +993,30 @@ float LaplacianSmoothing::getMuFactor() const
   return m_MuFactor;
 }
 
+// -----------------------------------------------------------------------------
+void LaplacianSmoothing::setUseParallelSmoothing(bool value)
+{
+  m_UseParallelSmoothing = value;
+}
+
+// -----------------------------------------------------------------------------
+bool LaplacianSmoothing::getUseParallelSmoothing() const
+{
+  return m_UseParallelSmoothing;
+}
+
+// -----------------------------------------------------------------------------
+void LaplacianSmoothing::setUseFloatAccumulation(bool value)
+{
+  m_UseFloatAccumulation = value;
+}
+
+// -----------------------------------------------------------------------------
+bool LaplacianSmoothing::getUseFloatAccumulation() const
+{
+  return m_UseFloatAccumulation;
+}
+
 // -----------------------------------------------------------------------------
 void LaplacianSmoothing::setLambdaArray(const DataArray<float>::Pointer& value)
 {
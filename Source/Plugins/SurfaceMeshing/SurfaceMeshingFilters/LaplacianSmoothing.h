@@ -69,6 +69,8 @@ class SurfaceMeshing_EXPORT LaplacianSmoothing : public AbstractFilter
   PYB11_PROPERTY(float SurfaceQuadPointLambda READ getSurfaceQuadPointLambda WRITE setSurfaceQuadPointLambda)
   PYB11_PROPERTY(bool UseTaubinSmoothing READ getUseTaubinSmoothing WRITE setUseTaubinSmoothing)
   PYB11_PROPERTY(float MuFactor READ getMuFactor WRITE setMuFactor)
+  PYB11_PROPERTY(bool UseParallelSmoothing READ getUseParallelSmoothing WRITE setUseParallelSmoothing)
+  PYB11_PROPERTY(bool UseFloatAccumulation READ getUseFloatAccumulation WRITE setUseFloatAccumulation)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -234,6 +236,28 @@ public:
   float getMuFactor() const;
   Q_PROPERTY(float MuFactor READ getMuFactor WRITE setMuFactor)
 
+  /**
+   * @brief Setter property for UseParallelSmoothing
+   */
+  void setUseParallelSmoothing(bool value);
+  /**
+   * @brief Getter property for UseParallelSmoothing
+   * @return Value of UseParallelSmoothing
+   */
+  bool getUseParallelSmoothing() const;
+  Q_PROPERTY(bool UseParallelSmoothing READ getUseParallelSmoothing WRITE setUseParallelSmoothing)
+
+  /**
+   * @brief Setter property for UseFloatAccumulation
+   */
+  void setUseFloatAccumulation(bool value);
+  /**
+   * @brief Getter property for UseFloatAccumulation
+   * @return Value of UseFloatAccumulation
+   */
+  bool getUseFloatAccumulation() const;
+  Q_PROPERTY(bool UseFloatAccumulation READ getUseFloatAccumulation WRITE setUseFloatAccumulation)
+
   /* This class is designed to be subclassed so that thoes subclasses can add
    * more functionality such as constrained surface nodes or Triple Lines. We use
    * this array to assign each vertex a specific Lambda value. Subclasses can set
@@ -334,6 +358,13 @@ protected:
    */
   virtual int32_t edgeBasedSmoothing();
 
+  /**
+   * @brief vertexBasedSmoothing Parallel version of the smoothing algorithm. The vertex neighbors are
+   * gathered once into a compressed row (CSR) table so each iteration is a data parallel sweep over the vertices
+   * @return Integer error code
+   */
+  virtual int32_t vertexBasedSmoothing();
+
 private:
   DataArrayPath m_SurfaceDataContainerName = {SIMPL::Defaults::TriangleDataContainerName, "", ""};
   DataArrayPath m_SurfaceMeshNodeTypeArrayPath = {SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::VertexAttributeMatrixName, SIMPL::VertexData::SurfaceMeshNodeType};
@@ -347,6 +378,8 @@ private:
   float m_SurfaceQuadPointLambda = {0.0f};
   bool m_UseTaubinSmoothing = {false};
   float m_MuFactor = {-1.03f};
+  bool m_UseParallelSmoothing = {false};
+  bool m_UseFloatAccumulation = {false};
   DataArray<float>::Pointer m_LambdaArray = {};
   std::weak_ptr<DataArray<int8_t>> m_SurfaceMeshNodeTypePtr;
   int8_t* m_SurfaceMeshNodeType = nullptr;
@@ -53,10 +53,13 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include <QtCore/QTextStream>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <random>
 #include <set>
 #include <unordered_map>
@@ -110,6 +113,260 @@ struct EdgeHasher
 
 using VertexMap = std::unordered_map<Vertex, MeshIndexType, VertexHasher>;
 using EdgeMap = std::unordered_map<Edge, MeshIndexType, EdgeHasher>;
+
+/**
+ * @brief The NodeOwners class is a compact stand in for a std::set<int32_t> of the Features that share a node. The
+ * node type saturates at a quadruple point so only the first four distinct Feature Ids are kept, and the -1 that marks
+ * the outer surface of the volume is stored as a flag.
+ */
+class NodeOwners
+{
+public:
+  void insert(int32_t featureId)
+  {
+    if(featureId == -1)
+    {
+      m_OnSurface = true;
+      return;
+    }
+    for(uint8_t i = 0; i < m_Count; i++)
+    {
+      if(m_FeatureIds[i] == featureId)
+      {
+        return;
+      }
+    }
+    if(m_Count < m_FeatureIds.size())
+    {
+      m_FeatureIds[m_Count++] = featureId;
+    }
+  }
+
+  int8_t nodeType() const
+  {
+    int8_t type = static_cast<int8_t>(std::min(m_Count + (m_OnSurface ? 1 : 0), 4));
+    return m_OnSurface ? static_cast<int8_t>(type + 10) : type;
+  }
+
+private:
+  std::array<int32_t, 4> m_FeatureIds = {{0, 0, 0, 0}};
+  uint8_t m_Count = 0;
+  bool m_OnSurface = false;
+};
+
+/**
+ * @brief The VoxelFace struct describes one quad emitted by the meshing loop. The nodes are indices into the
+ * (xP + 1) * (yP + 1) * (zP + 1) node lattice listed in the order the serial algorithm visits them. A face is split
+ * into the triangles (0, 1, 2) and (1, 3, 2), or (0, 2, 1) and (1, 2, 3) when the winding is reversed.
+ */
+struct VoxelFace
+{
+  std::array<MeshIndexType, 4> nodes = {{0, 0, 0, 0}};
+  MeshIndexType firstCell = 0;
+  MeshIndexType secondCell = 0;
+  std::array<int32_t, 2> labels = {{0, 0}};
+  bool reverseWinding = false;
+  bool boundary = false;
+};
+
+/**
+ * @brief Visits every face generated by the cells in z layer k, in exactly the order that
+ * QuickSurfaceMesh::createNodesAndTriangles() emits them.
+ */
+template <typename Visitor>
+void ForEachLayerFace(const int32_t* featureIds, MeshIndexType xP, MeshIndexType yP, MeshIndexType zP, MeshIndexType k, Visitor&& visitor)
+{
+  const MeshIndexType nodesPerPlane = (xP + 1) * (yP + 1);
+  auto node = [&](MeshIndexType x, MeshIndexType y, MeshIndexType z) { return z * nodesPerPlane + y * (xP + 1) + x; };
+
+  VoxelFace face;
+  auto boundaryFace = [&](MeshIndexType point, bool reverseWinding) {
+    face.firstCell = point;
+    face.secondCell = point;
+    face.labels = {{-1, featureIds[point]}};
+    face.reverseWinding = reverseWinding;
+    face.boundary = true;
+    visitor(face);
+  };
+  auto interiorFace = [&](MeshIndexType point, MeshIndexType neighbor, bool reverseWinding) {
+    face.firstCell = neighbor;
+    face.secondCell = point;
+    face.labels = {{featureIds[neighbor], featureIds[point]}};
+    face.reverseWinding = reverseWinding;
+    face.boundary = false;
+    if(featureIds[point] < featureIds[neighbor])
+    {
+      face.labels = {{featureIds[point], featureIds[neighbor]}};
+      face.reverseWinding = !reverseWinding;
+    }
+    visitor(face);
+  };
+
+  for(MeshIndexType j = 0; j < yP; j++)
+  {
+    for(MeshIndexType i = 0; i < xP; i++)
+    {
+      MeshIndexType point = (k * xP * yP) + (j * xP) + i;
+      if(i == 0)
+      {
+        face.nodes = {{node(i, j, k), node(i, j + 1, k), node(i, j, k + 1), node(i, j + 1, k + 1)}};
+        boundaryFace(point, true);
+      }
+      if(j == 0)
+      {
+        face.nodes = {{node(i, j, k), node(i + 1, j, k), node(i, j, k + 1), node(i + 1, j, k + 1)}};
+        boundaryFace(point, false);
+      }
+      if(k == 0)
+      {
+        face.nodes = {{node(i, j, k), node(i + 1, j, k), node(i, j + 1, k), node(i + 1, j + 1, k)}};
+        boundaryFace(point, true);
+      }
+      if(i == (xP - 1))
+      {
+        face.nodes = {{node(i + 1, j, k), node(i + 1, j + 1, k), node(i + 1, j, k + 1), node(i + 1, j + 1, k + 1)}};
+        boundaryFace(point, false);
+      }
+      else if(featureIds[point] != featureIds[point + 1])
+      {
+        face.nodes = {{node(i + 1, j, k), node(i + 1, j + 1, k), node(i + 1, j, k + 1), node(i + 1, j + 1, k + 1)}};
+        interiorFace(point, point + 1, false);
+      }
+      if(j == (yP - 1))
+      {
+        face.nodes = {{node(i + 1, j + 1, k), node(i, j + 1, k), node(i + 1, j + 1, k + 1), node(i, j + 1, k + 1)}};
+        boundaryFace(point, false);
+      }
+      else if(featureIds[point] != featureIds[point + xP])
+      {
+        face.nodes = {{node(i + 1, j + 1, k), node(i, j + 1, k), node(i + 1, j + 1, k + 1), node(i, j + 1, k + 1)}};
+        interiorFace(point, point + xP, true);
+      }
+      if(k == (zP - 1))
+      {
+        face.nodes = {{node(i + 1, j, k + 1), node(i, j, k + 1), node(i + 1, j + 1, k + 1), node(i, j + 1, k + 1)}};
+        boundaryFace(point, true);
+      }
+      else if(featureIds[point] != featureIds[point + xP * yP])
+      {
+        face.nodes = {{node(i + 1, j, k + 1), node(i, j, k + 1), node(i + 1, j + 1, k + 1), node(i, j + 1, k + 1)}};
+        interiorFace(point, point + xP * yP, false);
+      }
+    }
+  }
+}
+
+const std::array<std::array<size_t, 3>, 2> k_FaceTriangles = {{{0, 1, 2}, {1, 3, 2}}};
+const std::array<std::array<size_t, 3>, 2> k_ReversedFaceTriangles = {{{0, 2, 1}, {1, 2, 3}}};
+
+constexpr MeshIndexType k_UnassignedNode = std::numeric_limits<MeshIndexType>::max();
+
+/**
+ * @brief Numbers the nodes first touched by z layer k in the order the serial algorithm would. lowerPlane holds the
+ * nodes of plane k and must already contain the ids of nodes touched by layer k - 1, upperPlane holds plane k + 1.
+ * The visitor is called with every face and the ids of its four nodes.
+ * @return The number of nodes numbered by this layer
+ */
+template <typename Visitor>
+MeshIndexType NumberLayerNodes(const int32_t* featureIds, MeshIndexType xP, MeshIndexType yP, MeshIndexType zP, MeshIndexType k, MeshIndexType firstId, std::vector<MeshIndexType>& lowerPlane,
+                               std::vector<MeshIndexType>& upperPlane, Visitor&& visitor)
+{
+  const MeshIndexType nodesPerPlane = (xP + 1) * (yP + 1);
+  const MeshIndexType lowerStart = k * nodesPerPlane;
+  const MeshIndexType upperStart = lowerStart + nodesPerPlane;
+  MeshIndexType nextId = firstId;
+  std::array<MeshIndexType, 4> ids = {{0, 0, 0, 0}};
+  ForEachLayerFace(featureIds, xP, yP, zP, k, [&](const VoxelFace& face) {
+    for(size_t n = 0; n < 4; n++)
+    {
+      MeshIndexType& id = face.nodes[n] >= upperStart ? upperPlane[face.nodes[n] - upperStart] : lowerPlane[face.nodes[n] - lowerStart];
+      if(id == k_UnassignedNode)
+      {
+        id = nextId++;
+      }
+      ids[n] = id;
+    }
+    visitor(face, ids);
+  });
+  return nextId - firstId;
+}
+
+/**
+ * @brief Computes the node type of the node at lattice position (x, y, z) directly from the (up to) eight cells that
+ * share it. A cell owns the node if one of the faces through the node separates it from a different Feature or from
+ * the outside of the volume, which is the same set the serial algorithm accumulates face by face.
+ */
+int8_t FindNodeType(const int32_t* featureIds, MeshIndexType xP, MeshIndexType yP, MeshIndexType zP, MeshIndexType x, MeshIndexType y, MeshIndexType z)
+{
+  const bool onSurface = (x == 0 || y == 0 || z == 0 || x == xP || y == yP || z == zP);
+  const MeshIndexType xMin = (x == 0) ? 0 : x - 1;
+  const MeshIndexType yMin = (y == 0) ? 0 : y - 1;
+  const MeshIndexType zMin = (z == 0) ? 0 : z - 1;
+  const MeshIndexType xMax = std::min(x, xP - 1);
+  const MeshIndexType yMax = std::min(y, yP - 1);
+  const MeshIndexType zMax = std::min(z, zP - 1);
+
+  NodeOwners owners;
+  for(MeshIndexType cz = zMin; cz <= zMax; cz++)
+  {
+    for(MeshIndexType cy = yMin; cy <= yMax; cy++)
+    {
+      for(MeshIndexType cx = xMin; cx <= xMax; cx++)
+      {
+        const int32_t featureId = featureIds[(cz * xP * yP) + (cy * xP) + cx];
+        if(onSurface)
+        {
+          // Every cell around a surface node has an outer face through the node
+          owners.insert(featureId);
+          continue;
+        }
+        const MeshIndexType ox = (cx == x) ? x - 1 : x;
+        const MeshIndexType oy = (cy == y) ? y - 1 : y;
+        const MeshIndexType oz = (cz == z) ? z - 1 : z;
+        if(featureId != featureIds[(cz * xP * yP) + (cy * xP) + ox] || featureId != featureIds[(cz * xP * yP) + (oy * xP) + cx] || featureId != featureIds[(oz * xP * yP) + (cy * xP) + cx])
+        {
+          owners.insert(featureId);
+        }
+      }
+    }
+  }
+  if(onSurface)
+  {
+    owners.insert(-1);
+  }
+  return owners.nodeType();
+}
+
+/**
+ * @brief The ScratchMemoryTracker class records the high water mark of the temporary buffers that are alive at the
+ * same time across all threads.
+ */
+class ScratchMemoryTracker
+{
+public:
+  void acquire(size_t bytes)
+  {
+    size_t current = m_Current.fetch_add(bytes) + bytes;
+    size_t peak = m_Peak.load();
+    while(current > peak && !m_Peak.compare_exchange_weak(peak, current))
+    {
+    }
+  }
+
+  void release(size_t bytes)
+  {
+    m_Current.fetch_sub(bytes);
+  }
+
+  size_t peak() const
+  {
+    return m_Peak.load();
+  }
+
+private:
+  std::atomic<size_t> m_Current = {0};
+  std::atomic<size_t> m_Peak = {0};
+};
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -129,6 +386,7 @@ void QuickSurfaceMesh::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Attempt to Fix Problem Voxels", FixProblemVoxels, FilterParameter::Category::Parameter, QuickSurfaceMesh));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Slab Meshing", UseParallelMeshing, FilterParameter::Category::Parameter, QuickSurfaceMesh));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Any);
@@ -608,8 +866,6 @@ void QuickSurfaceMesh::determineActiveNodes(std::vector<MeshIndexType>& nodeIds,
   MeshIndexType yP = udims[1];
   MeshIndexType zP = udims[2];
 
-  std::vector<std::set<int32_t>> ownerLists;
-
   MeshIndexType point = 0, neigh1 = 0, neigh2 = 0, neigh3 = 0;
 
   MeshIndexType nodeId1 = 0, nodeId2 = 0, nodeId3 = 0, nodeId4 = 0;
@@ -896,9 +1152,8 @@ void QuickSurfaceMesh::determineActiveNodes(std::vector<MeshIndexType>& nodeIds,
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType> m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount)
+void QuickSurfaceMesh::resizeMeshArrays(MeshIndexType nodeCount, MeshIndexType triangleCount)
 {
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
 
   AttributeMatrix::Pointer featAttrMat = sm->getAttributeMatrix(m_FeatureAttributeMatrixName);
@@ -915,6 +1170,25 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType> m_Node
   std::vector<size_t> featDims(1, numFeatures + 1);
   featAttrMat->setTupleDimensions(featDims);
 
+  std::vector<size_t> tDims(1, nodeCount);
+  sm->getAttributeMatrix(getVertexAttributeMatrixName())->resizeAttributeArrays(tDims);
+  tDims[0] = triangleCount;
+  sm->getAttributeMatrix(getFaceAttributeMatrixName())->resizeAttributeArrays(tDims);
+
+  updateVertexInstancePointers();
+  updateFaceInstancePointers();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void QuickSurfaceMesh::createNodesAndTriangles(const std::vector<MeshIndexType>& m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
+
+  resizeMeshArrays(nodeCount, triangleCount);
+
   IGeometryGrid::Pointer grid = m->getGeometryAs<IGeometryGrid>();
 
   SizeVec3Type udims = grid->getDimensions();
@@ -923,7 +1197,7 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType> m_Node
   MeshIndexType yP = udims[1];
   MeshIndexType zP = udims[2];
 
-  std::vector<std::set<int32_t>> ownerLists;
+  std::vector<NodeOwners> ownerLists(nodeCount);
 
   MeshIndexType point = 0, neigh1 = 0, neigh2 = 0, neigh3 = 0;
 
@@ -936,16 +1210,6 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType> m_Node
   float* vertex = triangleGeom->getVertexPointer(0);
   MeshIndexType* triangle = triangleGeom->getTriPointer(0);
 
-  std::vector<size_t> tDims(1, nodeCount);
-  sm->getAttributeMatrix(getVertexAttributeMatrixName())->resizeAttributeArrays(tDims);
-  tDims[0] = triangleCount;
-  sm->getAttributeMatrix(getFaceAttributeMatrixName())->resizeAttributeArrays(tDims);
-
-  updateVertexInstancePointers();
-  updateFaceInstancePointers();
-
-  ownerLists.resize(nodeCount);
-
   // Cycle through again assigning coordinates to each node and assigning node numbers and feature labels to each triangle
   MeshIndexType triangleIndex = 0;
   for(MeshIndexType k = 0; k < zP; k++)
@@ -1490,16 +1754,166 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType> m_Node
 
   for(size_t i = 0; i < nodeCount; i++)
   {
-    m_NodeTypes[i] = static_cast<int8_t>(ownerLists[i].size());
-    if(m_NodeTypes[i] > 4)
+    m_NodeTypes[i] = ownerLists[i].nodeType();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void QuickSurfaceMesh::createNodesAndTrianglesInSlabs()
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
+
+  IGeometryGrid::Pointer grid = m->getGeometryAs<IGeometryGrid>();
+
+  SizeVec3Type udims = grid->getDimensions();
+
+  const MeshIndexType xP = udims[0];
+  const MeshIndexType yP = udims[1];
+  const MeshIndexType zP = udims[2];
+  const MeshIndexType nodesPerPlane = (xP + 1) * (yP + 1);
+  const size_t planeBytes = nodesPerPlane * sizeof(MeshIndexType);
+  const int32_t* featureIds = m_FeatureIds;
+
+  ScratchMemoryTracker scratchMemory;
+
+  // Count the nodes each z layer numbers first and the triangles it creates. A node on plane k that is already used
+  // by layer k - 1 belongs to that layer, so only the top plane of layer k - 1 needs to be marked.
+  std::vector<MeshIndexType> layerNodeCounts(zP + 1, 0);
+  std::vector<MeshIndexType> layerTriangleCounts(zP + 1, 0);
+  ParallelDataAlgorithm countAlg;
+  countAlg.setRange(0, zP);
+  countAlg.setGrain(1);
+  countAlg.execute([&](const SIMPLRange& range) {
+    scratchMemory.acquire(2 * planeBytes);
+    std::vector<MeshIndexType> lowerPlane(nodesPerPlane);
+    std::vector<MeshIndexType> upperPlane(nodesPerPlane);
+    for(size_t k = range.min(); k < range.max(); k++)
     {
-      m_NodeTypes[i] = 4;
+      std::fill(lowerPlane.begin(), lowerPlane.end(), k_UnassignedNode);
+      std::fill(upperPlane.begin(), upperPlane.end(), k_UnassignedNode);
+      if(k > 0)
+      {
+        ForEachLayerFace(featureIds, xP, yP, zP, k - 1, [&](const VoxelFace& face) {
+          for(MeshIndexType node : face.nodes)
+          {
+            if(node >= k * nodesPerPlane)
+            {
+              lowerPlane[node - k * nodesPerPlane] = 0;
+            }
+          }
+        });
+      }
+      MeshIndexType triangleCount = 0;
+      layerNodeCounts[k + 1] = NumberLayerNodes(featureIds, xP, yP, zP, k, 0, lowerPlane, upperPlane, [&](const VoxelFace&, const std::array<MeshIndexType, 4>&) { triangleCount += 2; });
+      layerTriangleCounts[k + 1] = triangleCount;
     }
-    if(ownerLists[i].find(-1) != ownerLists[i].end())
+    scratchMemory.release(2 * planeBytes);
+  });
+
+  for(MeshIndexType k = 0; k < zP; k++)
+  {
+    layerNodeCounts[k + 1] += layerNodeCounts[k];
+    layerTriangleCounts[k + 1] += layerTriangleCounts[k];
+  }
+  const MeshIndexType nodeCount = layerNodeCounts[zP];
+  const MeshIndexType triangleCount = layerTriangleCounts[zP];
+
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
+  triangleGeom->resizeTriList(triangleCount);
+  triangleGeom->resizeVertexList(nodeCount);
+  resizeMeshArrays(nodeCount, triangleCount);
+
+  float* vertex = triangleGeom->getVertexPointer(0);
+  MeshIndexType* triangle = triangleGeom->getTriPointer(0);
+  int32_t* faceLabels = m_FaceLabels;
+  int8_t* nodeTypes = m_NodeTypes;
+
+  std::vector<IDataArray::Pointer> selectedArrays;
+  std::vector<IDataArray::Pointer> createdArrays;
+  for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+  {
+    selectedArrays.push_back(m_SelectedWeakPtrVector[i].lock());
+    createdArrays.push_back(m_CreatedWeakPtrVector[i].lock());
+  }
+
+  // Each layer replays the numbering of the layer below it to recover the ids of the nodes it shares with that layer,
+  // then writes its own triangles, vertices and node types into the ranges computed above
+  ParallelDataAlgorithm meshAlg;
+  meshAlg.setRange(0, zP);
+  meshAlg.setGrain(1);
+  meshAlg.execute([&](const SIMPLRange& range) {
+    scratchMemory.acquire(3 * planeBytes);
+    std::vector<MeshIndexType> belowPlane(nodesPerPlane);
+    std::vector<MeshIndexType> lowerPlane(nodesPerPlane);
+    std::vector<MeshIndexType> upperPlane(nodesPerPlane);
+    for(size_t k = range.min(); k < range.max(); k++)
     {
-      m_NodeTypes[i] += 10;
+      std::fill(belowPlane.begin(), belowPlane.end(), k_UnassignedNode);
+      std::fill(lowerPlane.begin(), lowerPlane.end(), k_UnassignedNode);
+      std::fill(upperPlane.begin(), upperPlane.end(), k_UnassignedNode);
+      if(k > 1)
+      {
+        ForEachLayerFace(featureIds, xP, yP, zP, k - 2, [&](const VoxelFace& face) {
+          for(MeshIndexType node : face.nodes)
+          {
+            if(node >= (k - 1) * nodesPerPlane)
+            {
+              belowPlane[node - (k - 1) * nodesPerPlane] = 0;
+            }
+          }
+        });
+      }
+      if(k > 0)
+      {
+        NumberLayerNodes(featureIds, xP, yP, zP, k - 1, layerNodeCounts[k - 1], belowPlane, lowerPlane, [](const VoxelFace&, const std::array<MeshIndexType, 4>&) {});
+      }
+
+      MeshIndexType triangleIndex = layerTriangleCounts[k];
+      NumberLayerNodes(featureIds, xP, yP, zP, k, layerNodeCounts[k], lowerPlane, upperPlane, [&](const VoxelFace& face, const std::array<MeshIndexType, 4>& ids) {
+        for(const std::array<size_t, 3>& tri : (face.reverseWinding ? k_ReversedFaceTriangles : k_FaceTriangles))
+        {
+          triangle[triangleIndex * 3 + 0] = ids[tri[0]];
+          triangle[triangleIndex * 3 + 1] = ids[tri[1]];
+          triangle[triangleIndex * 3 + 2] = ids[tri[2]];
+          faceLabels[triangleIndex * 2] = face.labels[0];
+          faceLabels[triangleIndex * 2 + 1] = face.labels[1];
+          for(size_t dataVectorIndex = 0; dataVectorIndex < selectedArrays.size(); dataVectorIndex++)
+          {
+            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, selectedArrays[dataVectorIndex], triangleIndex, face.firstCell, face.secondCell, selectedArrays[dataVectorIndex],
+                                      createdArrays[dataVectorIndex], face.boundary)
+          }
+          triangleIndex++;
+        }
+      });
+
+      // Only this layer writes the nodes it numbered
+      for(size_t p = 0; p < 2; p++)
+      {
+        const std::vector<MeshIndexType>& plane = (p == 0) ? lowerPlane : upperPlane;
+        const MeshIndexType z = k + p;
+        for(MeshIndexType n = 0; n < nodesPerPlane; n++)
+        {
+          const MeshIndexType id = plane[n];
+          if(id < layerNodeCounts[k] || id >= layerNodeCounts[k + 1])
+          {
+            continue;
+          }
+          const MeshIndexType x = n % (xP + 1);
+          const MeshIndexType y = n / (xP + 1);
+          getGridCoordinates(grid, x, y, z, vertex + (id * 3));
+          nodeTypes[id] = FindNodeType(featureIds, xP, yP, zP, x, y, z);
+        }
+      }
     }
-  }
+    scratchMemory.release(3 * planeBytes);
+  });
+
+  const size_t meshBytes = nodeCount * (3 * sizeof(float) + sizeof(int8_t)) + triangleCount * (3 * sizeof(MeshIndexType) + 2 * sizeof(int32_t));
+  QString ss = QObject::tr("Peak meshing scratch memory: %1 MB (output mesh: %2 MB)").arg(scratchMemory.peak() / (1024.0 * 1024.0), 0, 'f', 2).arg(meshBytes / (1024.0 * 1024.0), 0, 'f', 2);
+  notifyStatusMessage(ss);
 }
 
 // -----------------------------------------------------------------------------
@@ -1536,27 +1950,33 @@ void QuickSurfaceMesh::execute()
   size_t yP = udims[1];
   size_t zP = udims[2];
 
-  std::vector<std::set<int32_t>> ownerLists;
-
-  size_t possibleNumNodes = (xP + 1) * (yP + 1) * (zP + 1);
-  std::vector<size_t> m_NodeIds(possibleNumNodes, std::numeric_limits<size_t>::max());
-
-  size_t nodeCount = 0;
-  size_t triangleCount = 0;
-
   if(getFixProblemVoxels())
   {
     correctProblemVoxels();
   }
 
-  determineActiveNodes(m_NodeIds, nodeCount, triangleCount);
-
-  // now create node and triangle arrays knowing the number that will be needed
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
-  triangleGeom->resizeTriList(triangleCount);
-  triangleGeom->resizeVertexList(nodeCount);
+  if(m_UseParallelMeshing)
+  {
+    createNodesAndTrianglesInSlabs();
+  }
+  else
+  {
+    size_t possibleNumNodes = (xP + 1) * (yP + 1) * (zP + 1);
+    std::vector<size_t> m_NodeIds(possibleNumNodes, std::numeric_limits<size_t>::max());
 
-  createNodesAndTriangles(m_NodeIds, nodeCount, triangleCount);
+    size_t nodeCount = 0;
+    size_t triangleCount = 0;
+
+    determineActiveNodes(m_NodeIds, nodeCount, triangleCount);
+
+    // now create node and triangle arrays knowing the number that will be needed
+    triangleGeom->resizeTriList(triangleCount);
+    triangleGeom->resizeVertexList(nodeCount);
+
+    createNodesAndTriangles(m_NodeIds, nodeCount, triangleCount);
+  }
+  MeshIndexType triangleCount = triangleGeom->getNumberOfTris();
 
   MeshIndexType* triangle = triangleGeom->getTriPointer(0);
 
@@ -2047,3 +2467,15 @@ bool QuickSurfaceMesh::getFixProblemVoxels() const
 {
   return m_FixProblemVoxels;
 }
+
+// -----------------------------------------------------------------------------
+void QuickSurfaceMesh::setUseParallelMeshing(bool value)
+{
+  m_UseParallelMeshing = value;
+}
+
+// -----------------------------------------------------------------------------
+bool QuickSurfaceMesh::getUseParallelMeshing() const
+{
+  return m_UseParallelMeshing;
+}
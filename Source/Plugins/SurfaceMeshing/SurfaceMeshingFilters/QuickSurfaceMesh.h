@@ -65,6 +65,7 @@ class SurfaceMeshing_EXPORT QuickSurfaceMesh : public AbstractFilter
   PYB11_PROPERTY(QString NodeTypesArrayName READ getNodeTypesArrayName WRITE setNodeTypesArrayName)
   PYB11_PROPERTY(QString FeatureAttributeMatrixName READ getFeatureAttributeMatrixName WRITE setFeatureAttributeMatrixName)
   PYB11_PROPERTY(bool FixProblemVoxels READ getFixProblemVoxels WRITE setFixProblemVoxels)
+  PYB11_PROPERTY(bool UseParallelMeshing READ getUseParallelMeshing WRITE setUseParallelMeshing)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -208,6 +209,17 @@ public:
   bool getFixProblemVoxels() const;
   Q_PROPERTY(bool FixProblemVoxels READ getFixProblemVoxels WRITE setFixProblemVoxels)
 
+  /**
+   * @brief Setter property for UseParallelMeshing
+   */
+  void setUseParallelMeshing(bool value);
+  /**
+   * @brief Getter property for UseParallelMeshing
+   * @return Value of UseParallelMeshing
+   */
+  bool getUseParallelMeshing() const;
+  Q_PROPERTY(bool UseParallelMeshing READ getUseParallelMeshing WRITE setUseParallelMeshing)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -293,6 +305,7 @@ private:
   QString m_NodeTypesArrayName = {SIMPL::VertexData::SurfaceMeshNodeType};
   QString m_FeatureAttributeMatrixName = {SIMPL::Defaults::FaceFeatureAttributeMatrixName};
   bool m_FixProblemVoxels = true;
+  bool m_UseParallelMeshing = false;
   bool m_GenerateTripleLines = false;
 
   std::vector<IDataArray::WeakPointer> m_SelectedWeakPtrVector;
@@ -340,7 +353,20 @@ private:
 
   void determineActiveNodes(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType& nodeCount, MeshIndexType& triangleCount);
 
-  void createNodesAndTriangles(std::vector<MeshIndexType> m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount);
+  void createNodesAndTriangles(const std::vector<MeshIndexType>& m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount);
+
+  /**
+   * @brief resizeMeshArrays Sizes the vertex, face and face feature Attribute Matrices for the new mesh
+   * @param nodeCount
+   * @param triangleCount
+   */
+  void resizeMeshArrays(MeshIndexType nodeCount, MeshIndexType triangleCount);
+
+  /**
+   * @brief createNodesAndTrianglesInSlabs Meshes each z layer of cells concurrently without a node lookup table
+   * for the whole volume. Produces exactly the same mesh as determineActiveNodes() + createNodesAndTriangles()
+   */
+  void createNodesAndTrianglesInSlabs();
 
   /**
    * @brief updateFaceInstancePointers Updates raw Face pointers
@@ -0,0 +1,333 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <QtCore/QDebug>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#endif
+
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+/**
+ * @brief The LaplacianSmoothingTest class checks that the parallel (per node neighbor table) smoothing path moves
+ * every node of a rough height field mesh to the same place as the serial edge based umbrella-operator, with and
+ * without Taubin's Lambda-Mu step and for every node type lambda.
+ */
+class LaplacianSmoothingTest
+{
+  const QString k_DataContainerName = QString("TriangleDataContainer");
+  const QString k_VertexAttrMatName = QString("VertexData");
+  const QString k_FaceAttrMatName = QString("FaceData");
+  const QString k_NodeTypeName = QString("NodeType");
+  const QString k_FaceLabelsName = QString("FaceLabels");
+  // The grid has k_Cells x k_Cells squares, each split into two triangles
+  static constexpr size_t k_Cells = 24;
+  static constexpr uint64_t k_Seed = 5489;
+  // The serial path sums the neighbor offsets edge by edge, the parallel path node by node
+  const float k_Tolerance = 1.0E-4f;
+  const float k_FloatAccumulationTolerance = 1.0E-3f;
+
+public:
+  LaplacianSmoothingTest() = default;
+  virtual ~LaplacianSmoothingTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QString filtName = "LaplacianSmoothing";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The LaplacianSmoothingTest Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A noisy height field over a square grid. The border nodes are surface nodes, the two diagonals are triple
+  // lines that meet at a quadruple point in the middle and one of the corners is a surface quadruple point.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateMesh()
+  {
+    const size_t numSide = k_Cells + 1;
+    const size_t numVerts = numSide * numSide;
+    const size_t numTris = 2 * k_Cells * k_Cells;
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    SharedVertexList::Pointer vertexList = TriangleGeom::CreateSharedVertexList(numVerts);
+    TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(numTris, vertexList, SIMPL::Geometry::TriangleGeometry);
+    dc->setGeometry(triangleGeom);
+    float* vertices = triangleGeom->getVertexPointer(0);
+    MeshIndexType* tris = triangleGeom->getTriPointer(0);
+
+    AttributeMatrix::Pointer vertexAttrMat = AttributeMatrix::New({numVerts}, k_VertexAttrMatName, AttributeMatrix::Type::Vertex);
+    dc->addOrReplaceAttributeMatrix(vertexAttrMat);
+    Int8ArrayType::Pointer nodeTypes = Int8ArrayType::CreateArray(numVerts, k_NodeTypeName, true);
+    vertexAttrMat->insertOrAssign(nodeTypes);
+
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New({numTris}, k_FaceAttrMatName, AttributeMatrix::Type::Face);
+    dc->addOrReplaceAttributeMatrix(faceAttrMat);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(numTris, std::vector<size_t>(1, 2), k_FaceLabelsName, true);
+    faceAttrMat->insertOrAssign(faceLabels);
+
+    std::mt19937_64 generator(k_Seed);
+    std::uniform_real_distribution<float> noise(-0.35f, 0.35f);
+    for(size_t y = 0; y < numSide; y++)
+    {
+      for(size_t x = 0; x < numSide; x++)
+      {
+        const size_t v = y * numSide + x;
+        vertices[3 * v] = static_cast<float>(x) + noise(generator);
+        vertices[3 * v + 1] = static_cast<float>(y) + noise(generator);
+        vertices[3 * v + 2] = noise(generator);
+
+        int8_t nodeType = SIMPL::SurfaceMesh::NodeType::Default;
+        const bool border = (x == 0 || y == 0 || x == k_Cells || y == k_Cells);
+        if(x == 0 && y == 0)
+        {
+          nodeType = SIMPL::SurfaceMesh::NodeType::SurfaceQuadPoint;
+        }
+        else if(border)
+        {
+          nodeType = (x == y || x + y == k_Cells) ? SIMPL::SurfaceMesh::NodeType::SurfaceTriplePoint : SIMPL::SurfaceMesh::NodeType::SurfaceDefault;
+        }
+        else if(x == k_Cells / 2 && y == k_Cells / 2)
+        {
+          nodeType = SIMPL::SurfaceMesh::NodeType::QuadPoint;
+        }
+        else if(x == y || x + y == k_Cells)
+        {
+          nodeType = SIMPL::SurfaceMesh::NodeType::TriplePoint;
+        }
+        nodeTypes->setValue(v, nodeType);
+      }
+    }
+
+    size_t t = 0;
+    for(size_t y = 0; y < k_Cells; y++)
+    {
+      for(size_t x = 0; x < k_Cells; x++)
+      {
+        const MeshIndexType v0 = y * numSide + x;
+        const MeshIndexType v1 = v0 + 1;
+        const MeshIndexType v2 = v0 + numSide;
+        const MeshIndexType v3 = v2 + 1;
+        const MeshIndexType quad[2][3] = {{v0, v1, v3}, {v0, v3, v2}};
+        for(const auto& tri : quad)
+        {
+          tris[3 * t] = tri[0];
+          tris[3 * t + 1] = tri[1];
+          tris[3 * t + 2] = tri[2];
+          faceLabels->setComponent(t, 0, (x < k_Cells / 2) ? 1 : 2);
+          faceLabels->setComponent(t, 1, (y < k_Cells / 2) ? 3 : 4);
+          t++;
+        }
+      }
+    }
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void setProperty(const AbstractFilter::Pointer& filter, const char* name, const QVariant& value)
+  {
+    bool propWasSet = filter->setProperty(name, value);
+    if(!propWasSet)
+    {
+      qDebug() << "Unable to set property " << name;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QVariant pathVariant(const QString& amName, const QString& arrayName)
+  {
+    QVariant var;
+    var.setValue(DataArrayPath(k_DataContainerName, amName, arrayName));
+    return var;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer Smooth(bool useParallel, bool useTaubin, bool useFloatAccumulation, int threadCount)
+  {
+    DataContainerArray::Pointer dca = CreateMesh();
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("LaplacianSmoothing");
+    DREAM3D_REQUIRE_VALID_POINTER(factory.get())
+    AbstractFilter::Pointer filter = factory->create();
+    filter->setDataContainerArray(dca);
+    setProperty(filter, "SurfaceMeshNodeTypeArrayPath", pathVariant(k_VertexAttrMatName, k_NodeTypeName));
+    setProperty(filter, "SurfaceMeshFaceLabelsArrayPath", pathVariant(k_FaceAttrMatName, k_FaceLabelsName));
+    setProperty(filter, "IterationSteps", 20);
+    setProperty(filter, "Lambda", 0.25f);
+    setProperty(filter, "TripleLineLambda", 0.15f);
+    setProperty(filter, "QuadPointLambda", 0.1f);
+    setProperty(filter, "SurfacePointLambda", 0.05f);
+    setProperty(filter, "SurfaceTripleLineLambda", 0.02f);
+    setProperty(filter, "SurfaceQuadPointLambda", 0.01f);
+    setProperty(filter, "UseTaubinSmoothing", useTaubin);
+    setProperty(filter, "MuFactor", -1.03f);
+    setProperty(filter, "UseParallelSmoothing", useParallel);
+    setProperty(filter, "UseFloatAccumulation", useFloatAccumulation);
+
+    auto smooth = [&]() { filter->execute(); };
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(threadCount > 0)
+    {
+      tbb::task_arena arena(threadCount);
+      arena.execute(smooth);
+    }
+    else
+    {
+      smooth();
+    }
+#else
+    smooth();
+#endif
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareVertices(const DataContainerArray::Pointer& serialDca, const DataContainerArray::Pointer& parallelDca, float tolerance)
+  {
+    TriangleGeom::Pointer serialGeom = serialDca->getDataContainer(k_DataContainerName)->getGeometryAs<TriangleGeom>();
+    TriangleGeom::Pointer parallelGeom = parallelDca->getDataContainer(k_DataContainerName)->getGeometryAs<TriangleGeom>();
+    DREAM3D_REQUIRE_EQUAL(serialGeom->getNumberOfVertices(), parallelGeom->getNumberOfVertices())
+
+    TriangleGeom::Pointer originalGeom = CreateMesh()->getDataContainer(k_DataContainerName)->getGeometryAs<TriangleGeom>();
+    float* original = originalGeom->getVertexPointer(0);
+    float* serial = serialGeom->getVertexPointer(0);
+    float* parallel = parallelGeom->getVertexPointer(0);
+    float maxMove = 0.0f;
+    for(size_t i = 0; i < 3 * serialGeom->getNumberOfVertices(); i++)
+    {
+      DREAM3D_REQUIRE(std::fabs(serial[i] - parallel[i]) <= tolerance)
+      maxMove = std::max(maxMove, std::fabs(serial[i] - original[i]));
+    }
+    // Make sure the comparison is not between two untouched meshes
+    DREAM3D_REQUIRE(maxMove > 0.01f)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestLaplacian()
+  {
+    DataContainerArray::Pointer serialDca = Smooth(false, false, false, 0);
+    for(int threadCount : {1, 2, 4, 0})
+    {
+      CompareVertices(serialDca, Smooth(true, false, false, threadCount), k_Tolerance);
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestTaubin()
+  {
+    DataContainerArray::Pointer serialDca = Smooth(false, true, false, 0);
+    for(int threadCount : {1, 4, 0})
+    {
+      CompareVertices(serialDca, Smooth(true, true, false, threadCount), k_Tolerance);
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFloatAccumulation()
+  {
+    CompareVertices(Smooth(false, false, false, 0), Smooth(true, false, true, 0), k_FloatAccumulationTolerance);
+    CompareVertices(Smooth(false, true, false, 0), Smooth(true, true, true, 0), k_FloatAccumulationTolerance);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestLaplacian())
+    DREAM3D_REGISTER_TEST(TestTaubin())
+    DREAM3D_REGISTER_TEST(TestFloatAccumulation())
+  }
+
+public:
+  LaplacianSmoothingTest(const LaplacianSmoothingTest&) = delete;            // Copy Constructor Not Implemented
+  LaplacianSmoothingTest(LaplacianSmoothingTest&&) = delete;                 // Move Constructor Not Implemented
+  LaplacianSmoothingTest& operator=(const LaplacianSmoothingTest&) = delete; // Copy Assignment Not Implemented
+  LaplacianSmoothingTest& operator=(LaplacianSmoothingTest&&) = delete;      // Move Assignment Not Implemented
+};
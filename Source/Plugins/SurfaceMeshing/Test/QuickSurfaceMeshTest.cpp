@@ -33,6 +33,8 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <array>
+
 #include <QtCore/QDebug>
 #include <QtCore/QFile>
 
@@ -410,6 +412,115 @@ public:
 
     return EXIT_SUCCESS;
   }
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunParallelTest()
+  {
+    DataContainerArray::Pointer dca = initializeDataContainerArray();
+
+    QString filtName = "QuickSurfaceMesh";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer meshFilter = factory->create();
+    DREAM3D_REQUIRE(meshFilter.get() != nullptr)
+
+    meshFilter->setDataContainerArray(dca);
+    QVariant var;
+    bool propWasSet = false;
+    SET_FILTER_PROPERTY_WITH_CHECK(meshFilter, "UseParallelMeshing", true, 0)
+
+    // The slab mesher numbers nodes and triangles exactly like the serial algorithm
+    validateQuickSurfaceMesh(meshFilter, dca);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestParallelMeshingMatchesSerial()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer imageDC = DataContainer::New("ImageGeom3D");
+    dca->addOrReplaceDataContainer(imageDC);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    size_t dims[3] = {7, 5, 4};
+    image->setDimensions(dims);
+    imageDC->setGeometry(image);
+
+    size_t numCells = dims[0] * dims[1] * dims[2];
+    std::vector<size_t> tDims(1, numCells);
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, "CellData", AttributeMatrix::Type::Cell);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(numCells, SIMPL::CellData::FeatureIds, true);
+    for(size_t i = 0; i < numCells; i++)
+    {
+      featureIds->setValue(i, static_cast<int32_t>((i * 7 + i / 11) % 5));
+    }
+    cellAttrMat->insertOrAssign(featureIds);
+    imageDC->addOrReplaceAttributeMatrix(cellAttrMat);
+
+    QString filtName = "QuickSurfaceMesh";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    QVariant var;
+    bool propWasSet = false;
+    DataArrayPath featureIdsPath("ImageGeom3D", "CellData", SIMPL::CellData::FeatureIds);
+    std::array<QString, 2> meshNames = {"SerialMesh", "SlabMesh"};
+    for(size_t m = 0; m < meshNames.size(); m++)
+    {
+      AbstractFilter::Pointer meshFilter = factory->create();
+      meshFilter->setDataContainerArray(dca);
+      SET_FILTER_PROPERTY_WITH_CHECK(meshFilter, "FeatureIdsArrayPath", featureIdsPath, 0)
+      SET_FILTER_PROPERTY_WITH_CHECK(meshFilter, "SurfaceDataContainerName", DataArrayPath(meshNames[m], "", ""), 0)
+      SET_FILTER_PROPERTY_WITH_CHECK(meshFilter, "TripleLineDataContainerName", DataArrayPath(meshNames[m] + " TripleLines", "", ""), 0)
+      SET_FILTER_PROPERTY_WITH_CHECK(meshFilter, "FixProblemVoxels", false, 0)
+      SET_FILTER_PROPERTY_WITH_CHECK(meshFilter, "UseParallelMeshing", m == 1, 0)
+      meshFilter->execute();
+      DREAM3D_REQUIRE_EQUAL(meshFilter->getErrorCode(), 0)
+    }
+
+    DataContainer::Pointer serialDC = dca->getDataContainer(meshNames[0]);
+    DataContainer::Pointer slabDC = dca->getDataContainer(meshNames[1]);
+    TriangleGeom::Pointer serialGeom = serialDC->getGeometryAs<TriangleGeom>();
+    TriangleGeom::Pointer slabGeom = slabDC->getGeometryAs<TriangleGeom>();
+    DREAM3D_REQUIRE_EQUAL(serialGeom->getNumberOfTris(), slabGeom->getNumberOfTris())
+    DREAM3D_REQUIRE_EQUAL(serialGeom->getNumberOfVertices(), slabGeom->getNumberOfVertices())
+
+    SharedTriList::Pointer serialTris = serialGeom->getTriangles();
+    SharedTriList::Pointer slabTris = slabGeom->getTriangles();
+    for(size_t i = 0; i < serialTris->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(serialTris->getValue(i), slabTris->getValue(i))
+    }
+    SharedVertexList::Pointer serialVerts = serialGeom->getVertices();
+    SharedVertexList::Pointer slabVerts = slabGeom->getVertices();
+    for(size_t i = 0; i < serialVerts->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(serialVerts->getValue(i), slabVerts->getValue(i))
+    }
+
+    Int32ArrayType::Pointer serialLabels = serialDC->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+    Int32ArrayType::Pointer slabLabels = slabDC->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+    for(size_t i = 0; i < serialLabels->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(serialLabels->getValue(i), slabLabels->getValue(i))
+    }
+    Int8ArrayType::Pointer serialNodeTypes = serialDC->getAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName)->getAttributeArrayAs<Int8ArrayType>(SIMPL::VertexData::SurfaceMeshNodeType);
+    Int8ArrayType::Pointer slabNodeTypes = slabDC->getAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName)->getAttributeArrayAs<Int8ArrayType>(SIMPL::VertexData::SurfaceMeshNodeType);
+    for(size_t i = 0; i < serialNodeTypes->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(serialNodeTypes->getValue(i), slabNodeTypes->getValue(i))
+    }
+
+    return EXIT_SUCCESS;
+  }
+
   /**
    * @brief
    */
@@ -421,6 +532,8 @@ public:
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
     DREAM3D_REGISTER_TEST(RunTest())
+    DREAM3D_REGISTER_TEST(RunParallelTest())
+    DREAM3D_REGISTER_TEST(TestParallelMeshingMatchesSerial())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
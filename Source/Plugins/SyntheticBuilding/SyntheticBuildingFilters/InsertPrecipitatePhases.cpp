@@ -37,8 +37,11 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "InsertPrecipitatePhases.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <fstream>
+#include <limits>
 #include <random>
 
 #include <QtCore/QDir>
@@ -52,6 +55,7 @@
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedChoicesFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -68,10 +72,17 @@
 #include "EbsdLib/LaueOps/LaueOps.h"
 #include "EbsdLib/LaueOps/OrthoRhombicOps.h"
 
+#include "Common/PhiloxRandom.hpp"
+
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
 namespace
 {
 OrthoRhombicOps::Pointer m_OrthoOps;
+
+// Random streams of this filter, see PhiloxRandom::StreamId()
+constexpr uint64_t k_RandomStreamFilterId = 2;
+constexpr uint64_t k_PrecipitateGenerationStreams = 0;
+constexpr uint64_t k_PlacementStream = 1;
 }
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -113,6 +124,9 @@ void InsertPrecipitatePhases::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Periodic Boundaries", PeriodicBoundaries, FilterParameter::Category::Parameter, InsertPrecipitatePhases));
+  std::vector<QString> seedProps = {"SeedValue"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Fixed Seed", UseSeed, FilterParameter::Category::Parameter, InsertPrecipitatePhases, seedProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Seed Value", SeedValue, FilterParameter::Category::Parameter, InsertPrecipitatePhases));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Match Radial Distribution Function", MatchRDF, FilterParameter::Category::Parameter, InsertPrecipitatePhases));
   std::vector<QString> linkedProps = {"MaskArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask", UseMask, FilterParameter::Category::Parameter, InsertPrecipitatePhases, linkedProps));
@@ -247,6 +261,8 @@ void InsertPrecipitatePhases::readFilterParameters(AbstractFilterParametersReade
   setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
   setMaskArrayPath(reader->readDataArrayPath("MaskArrayPath", getMaskArrayPath()));
   setPeriodicBoundaries(reader->readValue("PeriodicBoundaries", getPeriodicBoundaries()));
+  setUseSeed(reader->readValue("UseSeed", getUseSeed()));
+  setSeedValue(reader->readValue("SeedValue", getSeedValue()));
   setMatchRDF(reader->readValue("MatchRDF", getMatchRDF()));
   setUseMask(reader->readValue("UseMask", getUseMask()));
   bool haveFeatures = reader->readValue("HaveFeatures", false);
@@ -327,7 +343,7 @@ void InsertPrecipitatePhases::initialize()
   m_PointsToAdd.clear();
   m_PointsToRemove.clear();
 
-  m_Seed = QDateTime::currentMSecsSinceEpoch();
+  m_RandomStream = 0;
 
   m_FeatureSizeDist.clear();
   m_SimFeatureSizeDist.clear();
@@ -344,6 +360,11 @@ void InsertPrecipitatePhases::initialize()
   m_CurrentSizeDistError = m_OldSizeDistError = 0.0f;
   m_rdfMax = m_rdfMin = m_StepSize = 0.0f;
   m_numRDFbins = 0;
+  m_RdfCells.clear();
+  m_RdfFeatureCell.clear();
+  m_RdfCellDims = {1, 1, 1};
+  m_RdfCellSize = 1.0f;
+  m_RdfTrackedBins = 0;
 
   m_PrecipitatePhases.clear();
   m_PrecipitatePhaseFractions.clear();
@@ -591,6 +612,8 @@ void InsertPrecipitatePhases::execute()
     return;
   }
 
+  m_RandomSeed = PhiloxRandom::ResolveSeed(m_UseSeed, static_cast<uint64_t>(m_SeedValue));
+
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
@@ -740,8 +763,8 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
 
   clearErrorCode();
   clearWarningCode();
-  m_Seed = QDateTime::currentMSecsSinceEpoch();
-  SIMPL_RANDOMNG_NEW_SEEDED(m_Seed)
+  m_RandomStream = 0;
+  PhiloxRandom rg(m_RandomSeed, PhiloxRandom::StreamId(k_RandomStreamFilterId, k_PlacementStream, 0));
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
@@ -909,7 +932,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
     while(curphasevol[j] < (factor * curphasetotalvol))
     {
       iter++;
-      m_Seed++;
+      m_RandomStream++;
       phase = m_PrecipitatePhases[j];
       generate_precipitate(phase, &precip, static_cast<ShapeType::Type>(m_ShapeTypes[phase]), m_OrthoOps.get());
       m_CurrentSizeDistError = check_sizedisterror(&precip);
@@ -1318,6 +1341,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   {
     // calculate the initial current RDF - this will change as we move particles
     // around
+    build_rdfCellList();
     for(size_t i = size_t(m_FirstPrecipitateFeature); i < numfeatures; i++)
     {
       m_oldRDFerror = check_RDFerror(int32_t(i), -1000, false);
@@ -1379,7 +1403,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
       {
         randomfeature = static_cast<int32_t>(numfeatures) - 1;
       }
-      m_Seed++;
+      m_RandomStream++;
 
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[m_FeaturePhases[randomfeature]]);
       if(nullptr == pp)
@@ -1529,7 +1553,8 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
 // -----------------------------------------------------------------------------
 void InsertPrecipitatePhases::generate_precipitate(int32_t phase, Precip_t* precip, ShapeType::Type shapeclass, const LaueOps* OrthoOps)
 {
-  SIMPL_RANDOMNG_NEW_SEEDED(m_Seed)
+  // every generated precipitate draws from its own stream
+  SIMPL_RANDOMNG_NEW_SEEDED(PhiloxRandom::StreamSeed(m_RandomSeed, PhiloxRandom::StreamId(k_RandomStreamFilterId, k_PrecipitateGenerationStreams, m_RandomStream)))
 
   StatsDataArray& statsDataArray = *(m_StatsDataArray.lock());
 
@@ -1925,6 +1950,75 @@ void InsertPrecipitatePhases::update_availablepoints(std::map<size_t, size_t>& a
   m_PointsToAdd.clear();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InsertPrecipitatePhases::build_rdfCellList()
+{
+  // Only the bins that are compared against the target distribution affect the RDF error, so
+  // pairs further apart than the last of those bins never need to be visited
+  m_RdfTrackedBins = std::min(m_RdfCurrentDist.size(), m_RdfTargetDist.size());
+  m_RdfCurrentDistNorm.resize(m_RdfCurrentDist.size());
+  float cutoff = m_rdfMin + static_cast<float>(m_RdfTrackedBins) * m_StepSize;
+
+  size_t numFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
+  size_t numPPTfeatures = numFeatures > static_cast<size_t>(m_FirstPrecipitateFeature) ? numFeatures - static_cast<size_t>(m_FirstPrecipitateFeature) : 0;
+  std::array<float, 3> boxSize = {m_SizeX, m_SizeY, m_SizeZ};
+
+  // The cells must be at least as large as the cutoff so only the 27 surrounding cells can hold
+  // contributing neighbors. They are grown further if the grid would hold far more cells than precipitates.
+  m_RdfCellSize = std::max(cutoff, std::numeric_limits<float>::min());
+  while(true)
+  {
+    size_t numCells = 1;
+    for(size_t d = 0; d < 3; d++)
+    {
+      m_RdfCellDims[d] = std::max(static_cast<size_t>(std::ceil(boxSize[d] / m_RdfCellSize)), static_cast<size_t>(1));
+      numCells *= m_RdfCellDims[d];
+    }
+    if(numCells <= std::max(8 * numPPTfeatures, static_cast<size_t>(1)))
+    {
+      break;
+    }
+    m_RdfCellSize *= 2.0f;
+  }
+
+  m_RdfCells.assign(m_RdfCellDims[0] * m_RdfCellDims[1] * m_RdfCellDims[2], std::vector<int32_t>());
+  m_RdfFeatureCell.assign(numFeatures, std::numeric_limits<size_t>::max());
+  for(size_t n = size_t(m_FirstPrecipitateFeature); n < numFeatures; n++)
+  {
+    update_rdfCell(static_cast<int32_t>(n));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InsertPrecipitatePhases::update_rdfCell(int32_t gnum)
+{
+  std::array<size_t, 3> cell = {0, 0, 0};
+  for(size_t d = 0; d < 3; d++)
+  {
+    float coord = m_Centroids[3 * gnum + d] / m_RdfCellSize;
+    cell[d] = coord > 0.0f ? std::min(static_cast<size_t>(coord), m_RdfCellDims[d] - 1) : 0;
+  }
+  size_t cellIndex = (cell[2] * m_RdfCellDims[1] + cell[1]) * m_RdfCellDims[0] + cell[0];
+  size_t& currentCell = m_RdfFeatureCell[gnum];
+  if(currentCell == cellIndex)
+  {
+    return;
+  }
+  if(currentCell < m_RdfCells.size())
+  {
+    std::vector<int32_t>& members = m_RdfCells[currentCell];
+    auto iter = std::find(members.begin(), members.end(), gnum);
+    *iter = members.back();
+    members.pop_back();
+  }
+  m_RdfCells[cellIndex].push_back(gnum);
+  currentCell = cellIndex;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1934,93 +2028,81 @@ void InsertPrecipitatePhases::determine_currentRDF(int32_t gnum, int32_t add, bo
   float xn = 0.0f, yn = 0.0f, zn = 0.0f;
   float r = 0.0f;
 
-  size_t iter = 0;
-  int32_t numPPTfeatures = 1;
   int32_t rdfBin = 0;
 
   int32_t phase = m_FeaturePhases[gnum];
-  while(phase != m_PrecipitatePhases[iter])
-  {
-    iter++;
-  }
+
+  // The precipitate may have moved since it was last binned
+  update_rdfCell(gnum);
 
   x = m_Centroids[3 * gnum];
   y = m_Centroids[3 * gnum + 1];
   z = m_Centroids[3 * gnum + 2];
-  size_t numFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  for(size_t n = size_t(m_FirstPrecipitateFeature); n < numFeatures; n++)
+  size_t cellIndex = m_RdfFeatureCell[gnum];
+  std::array<size_t, 3> cell = {cellIndex % m_RdfCellDims[0], (cellIndex / m_RdfCellDims[0]) % m_RdfCellDims[1], cellIndex / (m_RdfCellDims[0] * m_RdfCellDims[1])};
+  std::array<size_t, 3> lower = {0, 0, 0};
+  std::array<size_t, 3> upper = {0, 0, 0};
+  for(size_t d = 0; d < 3; d++)
   {
-    if(m_FeaturePhases[n] == phase && n != gnum)
+    lower[d] = cell[d] > 0 ? cell[d] - 1 : 0;
+    upper[d] = std::min(cell[d] + 1, m_RdfCellDims[d] - 1);
+  }
+
+  for(size_t k = lower[2]; k <= upper[2]; k++)
+  {
+    for(size_t j = lower[1]; j <= upper[1]; j++)
     {
-      xn = m_Centroids[3 * n];
-      yn = m_Centroids[3 * n + 1];
-      zn = m_Centroids[3 * n + 2];
-      r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+      for(size_t i = lower[0]; i <= upper[0]; i++)
+      {
+        for(int32_t n : m_RdfCells[(k * m_RdfCellDims[1] + j) * m_RdfCellDims[0] + i])
+        {
+          if(m_FeaturePhases[n] != phase || n == gnum)
+          {
+            continue;
+          }
+          xn = m_Centroids[3 * n];
+          yn = m_Centroids[3 * n + 1];
+          zn = m_Centroids[3 * n + 2];
+          r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
 
-      rdfBin = (r - m_rdfMin) / m_StepSize;
+          rdfBin = (r - m_rdfMin) / m_StepSize;
 
-      if(r < m_rdfMin)
-      {
-        rdfBin = -1;
-      }
-      // if (r < 6.0)
-      //{
-      //  int stop = 0;
-      //}
-      // if (rdfBin >= m_numRDFbins) {rdfBin = m_numRDFbins;}
-      if(double_count)
-      {
-        m_RdfCurrentDist[rdfBin + 1] += 2 * add;
-      }
-      else if(!double_count)
-      {
-        m_RdfCurrentDist[rdfBin + 1] += add;
+          if(r < m_rdfMin)
+          {
+            rdfBin = -1;
+          }
+          // Distances past the compared bins do not change the RDF error
+          if(static_cast<size_t>(rdfBin + 1) >= m_RdfTrackedBins)
+          {
+            continue;
+          }
+          if(double_count)
+          {
+            m_RdfCurrentDist[rdfBin + 1] += 2 * add;
+          }
+          else if(!double_count)
+          {
+            m_RdfCurrentDist[rdfBin + 1] += add;
+          }
+        }
       }
-
-      numPPTfeatures += 1;
     }
   }
 
-  m_RdfCurrentDistNorm = normalizeRDF(m_RdfCurrentDist, m_numRDFbins, m_StepSize, m_rdfMin, numPPTfeatures);
+  normalizeRDF(m_RdfCurrentDist, m_RdfCurrentDistNorm);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-std::vector<float> InsertPrecipitatePhases::normalizeRDF(std::vector<float> rdf, int32_t num_bins, float stepSize, float rdfmin, int32_t numPPTfeatures)
+void InsertPrecipitatePhases::normalizeRDF(const std::vector<float>& rdf, std::vector<float>& normalizedRdf) const
 {
-  //  //Normalizing the RDF by number density of particles
-  //  (4/3*pi*(r2^3-r1^3)*numPPTfeatures/volume)
-  //  float normfactor;
-  //  float r1;
-  //  float r2;
-  //  float oneovervolume = 1.0f/volume;
-  //  float finiteAdjFactor = .5;
-
-  //  r1 = 0*finiteAdjFactor;
-  //  r2 = rdfmin*finiteAdjFactor;
-  //  normfactor = 4.0f/3.0f*SIMPLib::Constants::k_Pi*((r2*r2*r2) -
-  //  (r1*r1*r1))*numPPTfeatures*oneovervolume;
-  //  rdf[0] = rdf[0];
-
-  //  for (size_t i = 1; i < num_bins+2; i++)
-  //  {
-  //    r1 = (rdfmin + (i-1)*stepSize);
-  //    r2 = (r1 + stepSize);
-  //    r1 = r1*finiteAdjFactor;
-  //    r2 = r2*finiteAdjFactor;
-  //    normfactor = 4.0f/3.0f*SIMPLib::Constants::k_Pi*((r2*r2*r2) -
-  //    (r1*r1*r1))*numPPTfeatures*oneovervolume;
-  //    rdf[i] = rdf[i]/normfactor;
-  //  }
-
+  normalizedRdf.resize(rdf.size());
   for(size_t i = 0; i < rdf.size(); i++)
   {
-    rdf[i] = rdf[i] / m_RdfRandom[i];
+    normalizedRdf[i] = rdf[i] / m_RdfRandom[i];
   }
-
-  return rdf;
 }
 
 // -----------------------------------------------------------------------------
@@ -2055,7 +2137,7 @@ float InsertPrecipitatePhases::check_RDFerror(int32_t gadd, int32_t gremove, boo
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::compare_1Ddistributions(std::vector<float> array1, std::vector<float> array2, float& bhattdist)
+void InsertPrecipitatePhases::compare_1Ddistributions(const std::vector<float>& array1, const std::vector<float>& array2, float& bhattdist)
 {
   bhattdist = 0;
   float sum_array1 = 0.0f;
@@ -2076,9 +2158,9 @@ void InsertPrecipitatePhases::compare_1Ddistributions(std::vector<float> array1,
 
   for(size_t i = 0; i < array1Size; i++)
   {
-    array1[i] = array1[i] / sum_array1;
-    array2[i] = array2[i] / sum_array2;
-    bhattdist = bhattdist + sqrtf((array1[i] * array2[i]));
+    float value1 = array1[i] / sum_array1;
+    float value2 = array2[i] / sum_array2;
+    bhattdist = bhattdist + sqrtf((value1 * value2));
   }
 }
 
@@ -2195,8 +2277,6 @@ float InsertPrecipitatePhases::check_sizedisterror(Precip_t* precip)
 // -----------------------------------------------------------------------------
 void InsertPrecipitatePhases::insert_precipitate(size_t gnum)
 {
-  SIMPL_RANDOMNG_NEW()
-
   float inside = -1.0f;
   int64_t column = 0, row = 0, plane = 0;
   int64_t centercolumn = 0, centerrow = 0, centerplane = 0;
@@ -3090,6 +3170,30 @@ bool InsertPrecipitatePhases::getPeriodicBoundaries() const
   return m_PeriodicBoundaries;
 }
 
+// -----------------------------------------------------------------------------
+void InsertPrecipitatePhases::setUseSeed(bool value)
+{
+  m_UseSeed = value;
+}
+
+// -----------------------------------------------------------------------------
+bool InsertPrecipitatePhases::getUseSeed() const
+{
+  return m_UseSeed;
+}
+
+// -----------------------------------------------------------------------------
+void InsertPrecipitatePhases::setSeedValue(int value)
+{
+  m_SeedValue = value;
+}
+
+// -----------------------------------------------------------------------------
+int InsertPrecipitatePhases::getSeedValue() const
+{
+  return m_SeedValue;
+}
+
 // -----------------------------------------------------------------------------
 void InsertPrecipitatePhases::setMatchRDF(bool value)
 {
@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 
 #include "SIMPLib/SIMPLib.h"
@@ -84,6 +85,8 @@ class SyntheticBuilding_EXPORT InsertPrecipitatePhases : public AbstractFilter
   PYB11_PROPERTY(int FeatureGeneration READ getFeatureGeneration WRITE setFeatureGeneration)
   PYB11_PROPERTY(QString PrecipInputFile READ getPrecipInputFile WRITE setPrecipInputFile)
   PYB11_PROPERTY(bool PeriodicBoundaries READ getPeriodicBoundaries WRITE setPeriodicBoundaries)
+  PYB11_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+  PYB11_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
   PYB11_PROPERTY(bool MatchRDF READ getMatchRDF WRITE setMatchRDF)
   PYB11_PROPERTY(bool WriteGoalAttributes READ getWriteGoalAttributes WRITE setWriteGoalAttributes)
   PYB11_PROPERTY(DataArrayPath InputStatsArrayPath READ getInputStatsArrayPath WRITE setInputStatsArrayPath)
@@ -223,6 +226,28 @@ public:
   bool getPeriodicBoundaries() const;
   Q_PROPERTY(bool PeriodicBoundaries READ getPeriodicBoundaries WRITE setPeriodicBoundaries)
 
+  /**
+   * @brief Setter property for UseSeed
+   */
+  void setUseSeed(bool value);
+  /**
+   * @brief Getter property for UseSeed
+   * @return Value of UseSeed
+   */
+  bool getUseSeed() const;
+  Q_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+
+  /**
+   * @brief Setter property for SeedValue
+   */
+  void setSeedValue(int value);
+  /**
+   * @brief Getter property for SeedValue
+   * @return Value of SeedValue
+   */
+  int getSeedValue() const;
+  Q_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
+
   /**
    * @brief Setter property for MatchRDF
    */
@@ -593,6 +618,18 @@ protected:
    */
   void update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
 
+  /**
+   * @brief build_rdfCellList Buckets the precipitate centroids into a grid of cells at least as large as the
+   * largest distance that contributes to the RDF error, so RDF updates only visit neighboring cells
+   */
+  void build_rdfCellList();
+
+  /**
+   * @brief update_rdfCell Moves a precipitate to the cell of its current centroid
+   * @param gnum Index for the precipitate
+   */
+  void update_rdfCell(int32_t gnum);
+
   /**
    * @brief determine_currentRDF Determines the radial distribution function about a given precipitate
    * @param featureNum Index for the precipitate to determine RDF
@@ -602,16 +639,11 @@ protected:
   void determine_currentRDF(int32_t featureNum, int32_t add, bool double_count);
 
   /**
-   * @brief normalizeRDF Normalizes a radial distribution function
+   * @brief normalizeRDF Normalizes a radial distribution function by the random distribution
    * @param rdf RDF to normalize
-   * @param num_bins Number of bins in the discretized RDF
-   * @param stepsize Bin sted size for discretized RDF
-   * @param rdfmin Minimum value for RDF
-   * @param numPPTfeatures Number of precipiate Features
-   * @param volume Volume for a given precipitate
-   * @return Normalized RDF
+   * @param normalizedRdf Normalized RDF, resized to the size of rdf
    */
-  std::vector<float> normalizeRDF(std::vector<float> rdf, int num_bins, float stepsize, float rdfmin, int32_t numPPTfeatures);
+  void normalizeRDF(const std::vector<float>& rdf, std::vector<float>& normalizedRdf) const;
 
   /**
    * @brief check_RDFerror Computes the error between the current radial distribution function
@@ -642,7 +674,7 @@ protected:
    * @brief compare_1Ddistributions Computes the 1D Bhattacharyya distance
    * @param sqrerror Float 1D Bhattacharyya distance
    */
-  void compare_1Ddistributions(std::vector<float>, std::vector<float>, float& sqrerror);
+  void compare_1Ddistributions(const std::vector<float>&, const std::vector<float>&, float& sqrerror);
 
   /**
    * @brief compare_2Ddistributions Computes the 2D Bhattacharyya distance
@@ -693,6 +725,8 @@ private:
   int m_FeatureGeneration = {0};
   QString m_PrecipInputFile = {};
   bool m_PeriodicBoundaries = {false};
+  bool m_UseSeed = {false};
+  int m_SeedValue = {0};
   bool m_MatchRDF = {false};
   bool m_WriteGoalAttributes = {false};
   DataArrayPath m_InputStatsArrayPath = {SIMPL::Defaults::StatsGenerator, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::Statistics};
@@ -747,7 +781,8 @@ private:
   std::vector<size_t> m_PointsToAdd;
   std::vector<size_t> m_PointsToRemove;
 
-  uint64_t m_Seed;
+  uint64_t m_RandomSeed = 0;
+  uint64_t m_RandomStream;
 
   std::vector<std::vector<float>> m_FeatureSizeDist;
   std::vector<std::vector<float>> m_SimFeatureSizeDist;
@@ -772,6 +807,12 @@ private:
   float m_StepSize = 0.0f;
   int32_t m_numRDFbins = 0;
 
+  std::vector<std::vector<int32_t>> m_RdfCells;
+  std::vector<size_t> m_RdfFeatureCell;
+  std::array<size_t, 3> m_RdfCellDims = {1, 1, 1};
+  float m_RdfCellSize = 1.0f;
+  size_t m_RdfTrackedBins = 0;
+
   std::vector<int32_t> m_PrecipitatePhases;
   std::vector<float> m_PrecipitatePhaseFractions;
 
@@ -35,6 +35,8 @@
 
 #include "MatchCrystallography.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 
 #include <QtCore/QTextStream>
@@ -43,15 +45,17 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
-#include "SIMPLib/Math/SIMPLibRandom.h"
 #include "SIMPLib/StatsData/PrecipitateStatsData.h"
 #include "SIMPLib/StatsData/PrimaryStatsData.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/Utilities/TimeUtilities.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
@@ -62,9 +66,122 @@
 #include "EbsdLib/LaueOps/OrthoRhombicOps.h"
 #include "EbsdLib/Texture/Texture.hpp"
 
+#include "Common/PhiloxRandom.hpp"
+
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
 
+namespace
+{
+// Random streams of this filter, see PhiloxRandom::StreamId(). Each Ensemble uses its own stream.
+constexpr uint64_t k_RandomStreamFilterId = 3;
+constexpr uint64_t k_AssignEulersStreams = 0;
+constexpr uint64_t k_MatchCrystallographyStreams = 1;
+
+constexpr size_t k_ProposalsPerBatch = 64;
+constexpr int32_t k_ErrorResyncInterval = 4096;
+
+/**
+ * @brief RandomSymmetricEquivalent Returns the orientation rotated by a symmetry operator drawn from the generator.
+ * LaueOps::randomizeEulerAngles does the same but draws the operator from its own unseeded generator.
+ */
+OrientationD RandomSymmetricEquivalent(const LaueOps& laueOp, PhiloxRandom& generator, const OrientationD& eulers)
+{
+  int32_t symOp = static_cast<int32_t>(generator.genrand_index(static_cast<uint64_t>(laueOp.getNumSymOps())));
+  QuatD quat = OrientationTransformation::eu2qu<OrientationD, QuatD>(eulers);
+  QuatD equivalent = laueOp.getQuatSymOp(symOp) * quat;
+  equivalent.positiveOrientation();
+  return OrientationTransformation::qu2eu<QuatD, OrientationD>(equivalent);
+}
+
+/**
+ * @brief The HistogramDelta class collects the bin changes of a single swap or switch so that
+ * the change of the squared error can be evaluated exactly before touching the histogram.
+ */
+class HistogramDelta
+{
+public:
+  void clear()
+  {
+    m_Bins.clear();
+    m_Amounts.clear();
+  }
+
+  void add(int32_t bin, double amount)
+  {
+    for(size_t i = 0; i < m_Bins.size(); i++)
+    {
+      if(m_Bins[i] == bin)
+      {
+        m_Amounts[i] += amount;
+        return;
+      }
+    }
+    m_Bins.push_back(bin);
+    m_Amounts.push_back(amount);
+  }
+
+  /**
+   * @brief errorReduction Returns how much the squared error against the goal histogram drops if the delta is applied
+   */
+  double errorReduction(const float* actual, const float* sim) const
+  {
+    double reduction = 0.0;
+    for(size_t i = 0; i < m_Bins.size(); i++)
+    {
+      double current = static_cast<double>(actual[m_Bins[i]]) - static_cast<double>(sim[m_Bins[i]]);
+      double updated = current - m_Amounts[i];
+      reduction += current * current - updated * updated;
+    }
+    return reduction;
+  }
+
+  void apply(float* sim) const
+  {
+    for(size_t i = 0; i < m_Bins.size(); i++)
+    {
+      sim[m_Bins[i]] = static_cast<float>(sim[m_Bins[i]] + m_Amounts[i]);
+    }
+  }
+
+private:
+  std::vector<int32_t> m_Bins;
+  std::vector<double> m_Amounts;
+};
+
+/**
+ * @brief The MatchingProposal struct holds a randomly drawn swap or switch together with the
+ * ODF bins and boundary misorientation bins the moved Features would end up in.
+ */
+struct MatchingProposal
+{
+  bool valid = false;
+  bool swap = false;
+  int32_t feature1 = 0;
+  int32_t feature2 = 0;
+  int32_t newOdfBin = 0;
+  std::array<float, 3> newEulers = {0.0f, 0.0f, 0.0f};
+  int32_t odfBin1 = 0;
+  int32_t odfBin2 = 0;
+  std::vector<int32_t> misoBins1;
+  std::vector<int32_t> misoBins2;
+};
+
+/**
+ * @brief SquaredError Returns the squared difference between the goal and simulated histograms
+ */
+double SquaredError(const float* actual, const float* sim, size_t count)
+{
+  double error = 0.0;
+  for(size_t i = 0; i < count; i++)
+  {
+    double delta = static_cast<double>(actual[i]) - static_cast<double>(sim[i]);
+    error += delta * delta;
+  }
+  return error;
+}
+} // namespace
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -83,8 +200,6 @@ MatchCrystallography::MatchCrystallography()
   m_SharedSurfaceAreaList = NeighborList<float>::NullPointer();
   m_StatsDataArray = StatsDataArray::NullPointer();
 
-  m_MdfChange = m_OdfChange = 0.0f;
-
   m_ActualOdf = FloatArrayType::NullPointer();
   m_SimOdf = FloatArrayType::NullPointer();
   m_ActualMdf = FloatArrayType::NullPointer();
@@ -103,6 +218,10 @@ void MatchCrystallography::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Maximum Number of Iterations (Swaps)", MaxIterations, FilterParameter::Category::Parameter, MatchCrystallography));
+  std::vector<QString> seedProps = {"SeedValue"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Fixed Seed", UseSeed, FilterParameter::Category::Parameter, MatchCrystallography, seedProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Seed Value", SeedValue, FilterParameter::Category::Parameter, MatchCrystallography));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Parallel Matching", UseParallelMatching, FilterParameter::Category::Parameter, MatchCrystallography));
 
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
@@ -182,6 +301,9 @@ void MatchCrystallography::readFilterParameters(AbstractFilterParametersReader*
 {
   reader->openFilterGroup(this, index);
   setMaxIterations(reader->readValue("MaxIterations", getMaxIterations()));
+  setUseSeed(reader->readValue("UseSeed", getUseSeed()));
+  setSeedValue(reader->readValue("SeedValue", getSeedValue()));
+  setUseParallelMatching(reader->readValue("UseParallelMatching", getUseParallelMatching()));
   setInputStatsArrayPath(reader->readDataArrayPath("InputStatsArrayPath", getInputStatsArrayPath()));
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
   setPhaseTypesArrayPath(reader->readDataArrayPath("PhaseTypesArrayPath", getPhaseTypesArrayPath()));
@@ -207,7 +329,6 @@ void MatchCrystallography::initialize()
   m_SharedSurfaceAreaList = NeighborList<float>::NullPointer();
   m_StatsDataArray = StatsDataArray::NullPointer();
 
-  m_MdfChange = m_OdfChange = 0.0f;
   m_UnbiasedVolume.clear();
   m_TotalSurfaceArea.clear();
 
@@ -215,7 +336,8 @@ void MatchCrystallography::initialize()
   m_SimOdf = FloatArrayType::NullPointer();
   m_ActualMdf = FloatArrayType::NullPointer();
   m_SimMdf = FloatArrayType::NullPointer();
-  m_MisorientationLists.clear();
+  m_MisorientationBins.clear();
+  m_ReverseNeighborSlots.clear();
 }
 
 // -----------------------------------------------------------------------------
@@ -335,7 +457,11 @@ void MatchCrystallography::execute()
     return;
   }
 
+  m_RandomSeed = PhiloxRandom::ResolveSeed(m_UseSeed, static_cast<uint64_t>(m_SeedValue));
+
   size_t totalEnsembles = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
+  m_OdfErrors.assign(totalEnsembles, 0.0);
+  m_MdfErrors.assign(totalEnsembles, 0.0);
 
   QString ss;
   ss = QObject::tr("Determining Volumes");
@@ -539,11 +665,7 @@ void MatchCrystallography::determine_boundary_areas()
 // -----------------------------------------------------------------------------
 void MatchCrystallography::assign_eulers(size_t ensem)
 {
-  std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-  std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
-  std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-  generator.seed(seed);
-  std::uniform_real_distribution<> distribution(0.0, 1.0);
+  PhiloxRandom generator(m_RandomSeed, PhiloxRandom::StreamId(k_RandomStreamFilterId, k_AssignEulersStreams, ensem));
   std::array<double, 3> randx3;
 
   int32_t numbins = 0;
@@ -560,7 +682,7 @@ void MatchCrystallography::assign_eulers(size_t ensem)
     phase = m_FeaturePhases[i];
     if(static_cast<size_t>(phase) == ensem)
     {
-      random = static_cast<float>(distribution(generator));
+      random = static_cast<float>(generator.genrand_res53());
       numbins = laueOps[m_CrystalStructures[phase]]->getODFSize();
 
       // If we get to here and numbins is still zero, then an unknown or unsupported crystal structure
@@ -574,11 +696,11 @@ void MatchCrystallography::assign_eulers(size_t ensem)
 
       choose = pick_euler(random, numbins);
 
-      randx3[0] = distribution(generator);
-      randx3[1] = distribution(generator);
-      randx3[2] = distribution(generator);
+      randx3[0] = generator.genrand_res53();
+      randx3[1] = generator.genrand_res53();
+      randx3[2] = generator.genrand_res53();
       OrientationD eulers = laueOps[m_CrystalStructures[ensem]]->determineEulerAngles(randx3.data(), choose);
-      eulers = laueOps[m_CrystalStructures[ensem]]->randomizeEulerAngles(eulers);
+      eulers = RandomSymmetricEquivalent(*laueOps[m_CrystalStructures[ensem]], generator, eulers);
       m_FeatureEulerAngles[3 * i] = eulers[0];
       m_FeatureEulerAngles[3 * i + 1] = eulers[1];
       m_FeatureEulerAngles[3 * i + 2] = eulers[2];
@@ -590,7 +712,11 @@ void MatchCrystallography::assign_eulers(size_t ensem)
 
       if(!m_SurfaceFeatures[i])
       {
-        m_SimOdf->setValue(choose, (m_SimOdf->getValue(choose) + m_Volumes[i] / m_UnbiasedVolume[ensem]));
+        // Bin the stored (single precision) angles, the same way a later swap or switch removes them
+        OrientationD storedEulers(m_FeatureEulerAngles[3 * i], m_FeatureEulerAngles[3 * i + 1], m_FeatureEulerAngles[3 * i + 2]);
+        OrientationD rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(storedEulers);
+        int32_t bin = static_cast<int32_t>(laueOps[m_CrystalStructures[ensem]]->getOdfBin(rod));
+        m_SimOdf->setValue(bin, (m_SimOdf->getValue(bin) + m_Volumes[i] / m_UnbiasedVolume[ensem]));
       }
     }
   }
@@ -618,86 +744,6 @@ int32_t MatchCrystallography::pick_euler(float random, int32_t numbins)
   return choose;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, const QuatF& q1, const QuatF& q2, LaueOps* ops)
-{
-  double curmiso1 = 0.0f, curmiso2 = 0.0f, curmiso3 = 0.0f;
-  size_t curmisobin = 0, newmisobin = 0;
-
-  curmiso1 = m_MisorientationLists[feature][3 * j];
-  curmiso2 = m_MisorientationLists[feature][3 * j + 1];
-  curmiso3 = m_MisorientationLists[feature][3 * j + 2];
-
-  OrientationD rod(curmiso1, curmiso2, curmiso3, 0.0);
-  double mag = std::sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
-  if(mag == 0.0)
-  {
-    rod[3] = std::numeric_limits<double>::infinity();
-  }
-  else
-  {
-    rod[3] = mag;
-    rod[0] = rod[0] / rod[3];
-    rod[1] = rod[1] / rod[3];
-    rod[2] = rod[2] / rod[3];
-  }
-
-  curmisobin = ops->getMisoBin(rod);
-  QuatD qq1(q1[0], q1[1], q1[2], q1[3]);
-  QuatD qq2(q2[0], q2[1], q2[2], q2[3]);
-  OrientationD axisAngle = ops->calculateMisorientation(q1, q2);
-
-  rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
-  newmisobin = ops->getMisoBin(rod);
-  m_MdfChange = m_MdfChange + (((m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin)) * (m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin))) -
-                               ((m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
-                                (m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])))));
-  m_MdfChange = m_MdfChange + (((m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin)) * (m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin))) -
-                               ((m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
-                                (m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])))));
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody2(int32_t feature, size_t ensem, size_t j, float neighsurfarea, QuatF& q1, QuatF& q2, LaueOps* ops)
-{
-  float curmiso1 = 0.0f, curmiso2 = 0.0f, curmiso3 = 0.0f;
-  size_t curmisobin = 0, newmisobin = 0;
-  float miso1 = 0.0f, miso2 = 0.0f, miso3 = 0.0f;
-
-  curmiso1 = m_MisorientationLists[feature][3 * j];
-  curmiso2 = m_MisorientationLists[feature][3 * j + 1];
-  curmiso3 = m_MisorientationLists[feature][3 * j + 2];
-
-  OrientationD rod(curmiso1, curmiso2, curmiso3, 0.0f);
-  float mag = sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
-  if(mag == 0.0f)
-  {
-    rod[3] = std::numeric_limits<float>::infinity();
-  }
-  else
-  {
-    rod[3] = mag;
-    rod[0] = rod[0] / rod[3];
-    rod[1] = rod[1] / rod[3];
-    rod[2] = rod[2] / rod[3];
-  }
-
-  curmisobin = ops->getMisoBin(rod);
-  OrientationD axisAngle = ops->calculateMisorientation(q1, q2);
-
-  rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
-  newmisobin = ops->getMisoBin(rod);
-  m_MisorientationLists[feature][3 * j] = miso1;
-  m_MisorientationLists[feature][3 * j + 1] = miso2;
-  m_MisorientationLists[feature][3 * j + 2] = miso3;
-  m_SimMdf->setValue(curmisobin, (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])));
-  m_SimMdf->setValue(newmisobin, (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])));
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -711,39 +757,184 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-  std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
-  std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-  generator.seed(seed);
-  std::uniform_real_distribution<> distribution(0.0, 1.0);
+  PhiloxRandom generator(m_RandomSeed, PhiloxRandom::StreamId(k_RandomStreamFilterId, k_MatchCrystallographyStreams, ensem));
   std::array<double, 3> randx3;
 
-  int32_t numbins = 0;
   int32_t iterations = 0, badtrycount = 0;
-  float random = 0.0f;
-  size_t counter = 0;
-
-  QuatF q1;
-  QuatF q2;
-  //  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
-  float ea1 = 0.0f, ea2 = 0.0f, ea3 = 0.0f;
-  float g1ea1 = 0.0f, g1ea2 = 0.0f, g1ea3 = 0.0f, g2ea1 = 0.0f, g2ea2 = 0.0f, g2ea3 = 0.0f;
-  int32_t g1odfbin = 0, g2odfbin = 0;
-  float deltaerror = 0.0f;
-  float currentodferror = 0.0f, currentmdferror = 0.0f;
-  int32_t selectedfeature1 = 0, selectedfeature2 = 0;
-  iterations = 0;
-  badtrycount = 0;
 
   std::vector<LaueOps::Pointer> laueOps = LaueOps::GetAllOrientationOps();
   uint32_t laueIndex = m_CrystalStructures[ensem];
   LaueOps::Pointer laueOp = laueOps[laueIndex];
-  numbins = laueOp->getODFSize();
+  int32_t numbins = laueOp->getODFSize();
+  size_t numMdfBins = m_ActualMdf->getSize();
+
+  float* actualOdf = m_ActualOdf->getPointer(0);
+  float* simOdf = m_SimOdf->getPointer(0);
+  float* actualMdf = m_ActualMdf->getPointer(0);
+  float* simMdf = m_SimMdf->getPointer(0);
+
+  // The errors are only updated by the change of each accepted move and are re-summed
+  // periodically so rounding does not accumulate
+  double currentodferror = SquaredError(actualOdf, simOdf, static_cast<size_t>(numbins));
+  double currentmdferror = SquaredError(actualMdf, simMdf, numMdfBins);
+
+  auto selectFeature = [&](int32_t excluded) -> int32_t {
+    size_t counter = 0;
+    int32_t feature = static_cast<int32_t>(generator.genrand_res53() * totalFeatures);
+    while((m_SurfaceFeatures[feature] || m_FeaturePhases[feature] != static_cast<int32_t>(ensem) || feature == excluded) && counter < totalFeatures)
+    {
+      feature++;
+      counter++;
+      if(feature >= static_cast<int32_t>(totalFeatures))
+      {
+        feature -= static_cast<int32_t>(totalFeatures);
+      }
+    }
+    return counter == totalFeatures ? -1 : feature;
+  };
+
+  // Draws a swap (new orientation from the goal ODF for one Feature) or a switch (two Features
+  // exchange orientations). Proposals only depend on the random stream, never on the current state.
+  auto drawProposal = [&](MatchingProposal& proposal) {
+    proposal.valid = false;
+    proposal.swap = generator.genrand_res53() < 0.5;
+    proposal.feature1 = selectFeature(-1);
+    if(proposal.feature1 < 0)
+    {
+      return;
+    }
+    if(proposal.swap)
+    {
+      float random = static_cast<float>(generator.genrand_res53());
+      proposal.newOdfBin = pick_euler(random, numbins);
+      randx3[0] = generator.genrand_res53();
+      randx3[1] = generator.genrand_res53();
+      randx3[2] = generator.genrand_res53();
+      OrientationD eulers = laueOp->determineEulerAngles(randx3.data(), proposal.newOdfBin);
+      eulers = RandomSymmetricEquivalent(*laueOp, generator, eulers);
+      proposal.newEulers = {static_cast<float>(eulers[0]), static_cast<float>(eulers[1]), static_cast<float>(eulers[2])};
+    }
+    else
+    {
+      proposal.feature2 = selectFeature(proposal.feature1);
+      if(proposal.feature2 < 0)
+      {
+        return;
+      }
+    }
+    proposal.valid = true;
+  };
+
+  auto featureQuat = [&](int32_t feature) {
+    const float* quat = m_AvgQuats + feature * 4;
+    return QuatF(quat[0], quat[1], quat[2], quat[3]);
+  };
+
+  auto featureOdfBin = [&](int32_t feature) {
+    OrientationD eu(m_FeatureEulerAngles[3 * feature], m_FeatureEulerAngles[3 * feature + 1], m_FeatureEulerAngles[3 * feature + 2]);
+    OrientationD rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
+    return static_cast<int32_t>(laueOp->getOdfBin(rod));
+  };
+
+  // Bins every counted boundary of the Feature as if it had the orientation q. For a switch the
+  // partner takes the orientation partnerQ; the boundary between the two is only binned from the
+  // side of the first Feature (countPartner) so that it is not counted twice
+  auto binBoundaries = [&](int32_t feature, const QuatF& q, int32_t partner, const QuatF& partnerQ, bool countPartner, std::vector<int32_t>& bins) {
+    const std::vector<int32_t>& cachedBins = m_MisorientationBins[feature];
+    bins.assign(cachedBins.size(), -1);
+    for(size_t j = 0; j < cachedBins.size(); j++)
+    {
+      int32_t neighbor = neighborlist[feature][j];
+      if(cachedBins[j] < 0 || (neighbor == partner && !countPartner))
+      {
+        continue;
+      }
+      QuatF q2 = neighbor == partner ? partnerQ : featureQuat(neighbor);
+      OrientationD axisAngle = feature < neighbor ? laueOp->calculateMisorientation(q, q2) : laueOp->calculateMisorientation(q2, q);
+      OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
+      bins[j] = static_cast<int32_t>(laueOp->getMisoBin(rod));
+    }
+  };
+
+  auto evaluateProposal = [&](MatchingProposal& proposal) {
+    if(!proposal.valid)
+    {
+      return;
+    }
+    proposal.odfBin1 = featureOdfBin(proposal.feature1);
+    if(proposal.swap)
+    {
+      QuatF q = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(proposal.newEulers[0], proposal.newEulers[1], proposal.newEulers[2]));
+      binBoundaries(proposal.feature1, q, -1, q, false, proposal.misoBins1);
+      proposal.misoBins2.clear();
+    }
+    else
+    {
+      proposal.odfBin2 = featureOdfBin(proposal.feature2);
+      QuatF q1 = featureQuat(proposal.feature1);
+      QuatF q2 = featureQuat(proposal.feature2);
+      binBoundaries(proposal.feature1, q2, proposal.feature2, q1, true, proposal.misoBins1);
+      binBoundaries(proposal.feature2, q1, proposal.feature1, q2, false, proposal.misoBins2);
+    }
+  };
+
+  HistogramDelta odfDelta;
+  HistogramDelta mdfDelta;
+
+  auto addBoundaryChanges = [&](int32_t feature, const std::vector<int32_t>& bins) {
+    const std::vector<int32_t>& cachedBins = m_MisorientationBins[feature];
+    for(size_t j = 0; j < bins.size(); j++)
+    {
+      if(bins[j] < 0 || bins[j] == cachedBins[j])
+      {
+        continue;
+      }
+      double area = neighborsurfacearealist[feature][j] / m_TotalSurfaceArea[ensem];
+      mdfDelta.add(cachedBins[j], -area);
+      mdfDelta.add(bins[j], area);
+    }
+  };
+
+  auto storeBoundaryBins = [&](int32_t feature, const std::vector<int32_t>& bins) {
+    for(size_t j = 0; j < bins.size(); j++)
+    {
+      if(bins[j] < 0)
+      {
+        continue;
+      }
+      m_MisorientationBins[feature][j] = bins[j];
+      int32_t slot = m_ReverseNeighborSlots[feature][j];
+      if(slot >= 0)
+      {
+        m_MisorientationBins[neighborlist[feature][j]][slot] = bins[j];
+      }
+    }
+  };
+
+  // Proposals of a batch are evaluated against the same state; the ones that touch a Feature
+  // (or a neighbor of it) changed earlier in the batch are evaluated again before they are
+  // committed, so the result matches evaluating them one at a time
+  std::vector<MatchingProposal> proposals(m_UseParallelMatching ? k_ProposalsPerBatch : 1);
+  std::vector<size_t> changedInBatch(totalFeatures, 0);
+  size_t batch = 0;
+
+  auto isStale = [&](int32_t feature) {
+    if(changedInBatch[feature] == batch)
+    {
+      return true;
+    }
+    for(const int32_t& neighbor : neighborlist[feature])
+    {
+      if(changedInBatch[neighbor] == batch)
+      {
+        return true;
+      }
+    }
+    return false;
+  };
 
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
   uint64_t startMillis = millis;
-  int32_t lastIteration = 0;
   while(badtrycount < (m_MaxIterations / 10) && iterations < m_MaxIterations)
   {
     uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
@@ -757,323 +948,112 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
       notifyStatusMessage(ss);
 
       millis = QDateTime::currentMSecsSinceEpoch();
-      lastIteration = iterations;
     }
-    currentodferror = 0;
-    currentmdferror = 0;
-    float* actualOdfPtr = m_ActualOdf->getPointer(0);
-    float* simOdfPtr = m_SimOdf->getPointer(0);
-    float delta = 0.0f;
-    for(int32_t i = 0; i < numbins; i++)
+
+    batch++;
+    size_t batchSize = std::min(proposals.size(), static_cast<size_t>(m_MaxIterations - iterations));
+    for(size_t k = 0; k < batchSize; k++)
     {
-      delta = actualOdfPtr[i] - simOdfPtr[i];
-      currentodferror = currentodferror + (delta * delta);
+      drawProposal(proposals[k]);
     }
-    for(int32_t i = 0; i < (numbins); i++)
+    if(batchSize > 1)
     {
-      currentmdferror = currentmdferror + ((m_ActualMdf->getValue(i) - m_SimMdf->getValue(i)) * (m_ActualMdf->getValue(i) - m_SimMdf->getValue(i)));
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0ULL, batchSize);
+      dataAlg.setGrain(1);
+      dataAlg.execute([&](const SIMPLRange& range) {
+        for(size_t k = range.min(); k < range.max(); k++)
+        {
+          evaluateProposal(proposals[k]);
+        }
+      });
     }
-    iterations++;
-    badtrycount++;
-    random = static_cast<float>(distribution(generator));
-
-    if(getCancel())
+    else
     {
-      return;
+      evaluateProposal(proposals[0]);
     }
 
-    if(random < 0.5) // SwapOutOrientation
+    for(size_t k = 0; k < batchSize && badtrycount < (m_MaxIterations / 10); k++)
     {
-      counter = 0;
-      selectedfeature1 = static_cast<int32_t>(distribution(generator) * totalFeatures);
-      if(selectedfeature1 >= totalFeatures)
-      {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
-      }
-      while((m_SurfaceFeatures[selectedfeature1] || m_FeaturePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
-      {
-        selectedfeature1++;
-        counter++;
-        if(selectedfeature1 >= totalFeatures)
-        {
-          selectedfeature1 -= totalFeatures;
-        }
-      }
-      if(selectedfeature1 >= totalFeatures)
+      MatchingProposal& proposal = proposals[k];
+      if(iterations % k_ErrorResyncInterval == 0)
       {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
+        currentodferror = SquaredError(actualOdf, simOdf, static_cast<size_t>(numbins));
+        currentmdferror = SquaredError(actualMdf, simMdf, numMdfBins);
       }
-      if(counter == totalFeatures)
-      {
-        badtrycount = 10 * m_NumFeatures[ensem];
-      }
-      else
-      {
-        ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-        ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-        ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-        OrientationD rod(4, 0.0);
-
-        OrientationD eu(m_FeatureEulerAngles[3 * selectedfeature1], m_FeatureEulerAngles[3 * selectedfeature1 + 1], m_FeatureEulerAngles[3 * selectedfeature1 + 2]);
-        rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
-
-        g1odfbin = laueOp->getOdfBin(rod);
-        random = static_cast<float>(distribution(generator));
-        int32_t choose = 0;
-
-        choose = pick_euler(random, numbins);
-
-        randx3[0] = distribution(generator);
-        randx3[1] = distribution(generator);
-        randx3[2] = distribution(generator);
-        OrientationD g1ea = laueOp->determineEulerAngles(randx3.data(), choose);
-        g1ea = laueOp->randomizeEulerAngles(g1ea);
-
-        q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(g1ea);
-
-        m_OdfChange = ((m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose)) * (m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose))) -
-                      ((m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                       (m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))));
-        m_OdfChange = m_OdfChange + (((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
-                                     ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                                      (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])))));
-
-        m_MdfChange = 0;
-        size_t size = 0;
-        if(!neighborlist[selectedfeature1].empty())
-        {
-          size = neighborlist[selectedfeature1].size();
-        }
-        for(size_t j = 0; j < size; j++)
-        {
-          int32_t neighbor = neighborlist[selectedfeature1][j];
-          eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
-
-          q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
-          float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-          MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, q1, q2, laueOp.get());
-        }
-
-        deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
-        if(deltaerror > 0)
-        {
-          badtrycount = 0;
-          m_FeatureEulerAngles[3 * selectedfeature1] = g1ea1;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g1ea2;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g1ea3;
-          q1.copyInto(m_AvgQuats + selectedfeature1 * 4, Quaternion<float>::Order::VectorScalar);
-          m_SimOdf->setValue(choose, (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-          m_SimOdf->setValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-          size = 0;
-          if(!neighborlist[selectedfeature1].empty())
-          {
-            size = neighborlist[selectedfeature1].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            int neighbor = neighborlist[selectedfeature1][j];
-            eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
+      iterations++;
+      badtrycount++;
 
-            q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, q1, q2, laueOp.get());
-          }
-        }
-      }
-      if(getCancel())
-      {
-        return;
-      }
-    }
-    else // SwitchOrientation
-    {
-      counter = 0;
-      selectedfeature1 = static_cast<int32_t>(distribution(generator) * totalFeatures);
-      if(selectedfeature1 >= totalFeatures)
+      if(!proposal.valid)
       {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
+        badtrycount = 10 * m_NumFeatures[ensem];
+        continue;
       }
-      while((m_SurfaceFeatures[selectedfeature1] || m_FeaturePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
+      if(isStale(proposal.feature1) || (!proposal.swap && isStale(proposal.feature2)))
       {
-        selectedfeature1++;
-        counter++;
-        if(selectedfeature1 >= totalFeatures)
-        {
-          selectedfeature1 -= totalFeatures;
-        }
+        evaluateProposal(proposal);
       }
-      if(selectedfeature1 >= totalFeatures)
+
+      int32_t feature1 = proposal.feature1;
+      int32_t feature2 = proposal.feature2;
+      double volume1 = m_Volumes[feature1] / m_UnbiasedVolume[ensem];
+      odfDelta.clear();
+      mdfDelta.clear();
+      if(proposal.swap) // SwapOutOrientation
       {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
+        odfDelta.add(proposal.odfBin1, -volume1);
+        odfDelta.add(proposal.newOdfBin, volume1);
+        addBoundaryChanges(feature1, proposal.misoBins1);
       }
-      if(counter == totalFeatures)
+      else // SwitchOrientation
       {
-        badtrycount = 10 * m_NumFeatures[ensem];
+        double volume2 = m_Volumes[feature2] / m_UnbiasedVolume[ensem];
+        odfDelta.add(proposal.odfBin1, volume2 - volume1);
+        odfDelta.add(proposal.odfBin2, volume1 - volume2);
+        addBoundaryChanges(feature1, proposal.misoBins1);
+        addBoundaryChanges(feature2, proposal.misoBins2);
       }
-      else
+
+      double odfChange = odfDelta.errorReduction(actualOdf, simOdf);
+      double mdfChange = mdfDelta.errorReduction(actualMdf, simMdf);
+      double deltaerror = (odfChange / currentodferror) + (mdfChange / currentmdferror);
+      if(deltaerror > 0)
       {
-        counter = 0;
-        selectedfeature2 = static_cast<int32_t>(distribution(generator) * totalFeatures);
-        if(selectedfeature2 >= totalFeatures)
-        {
-          selectedfeature2 = selectedfeature2 - totalFeatures;
-        }
-        while((m_SurfaceFeatures[selectedfeature2] || m_FeaturePhases[selectedfeature2] != static_cast<int32_t>(ensem) || selectedfeature2 == selectedfeature1) && counter < totalFeatures)
-        {
-          selectedfeature2++;
-          counter++;
-          if(selectedfeature2 >= totalFeatures)
-          {
-            selectedfeature2 -= totalFeatures;
-          }
-        }
-        if(selectedfeature2 >= totalFeatures)
-        {
-          selectedfeature2 = selectedfeature2 - totalFeatures;
-        }
-        if(counter == totalFeatures)
+        badtrycount = 0;
+        odfDelta.apply(simOdf);
+        mdfDelta.apply(simMdf);
+        currentodferror -= odfChange;
+        currentmdferror -= mdfChange;
+
+        if(proposal.swap)
         {
-          badtrycount = 10 * m_NumFeatures[ensem];
+          m_FeatureEulerAngles[3 * feature1] = proposal.newEulers[0];
+          m_FeatureEulerAngles[3 * feature1 + 1] = proposal.newEulers[1];
+          m_FeatureEulerAngles[3 * feature1 + 2] = proposal.newEulers[2];
+          QuatF q = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(proposal.newEulers[0], proposal.newEulers[1], proposal.newEulers[2]));
+          q.copyInto(m_AvgQuats + feature1 * 4, Quaternion<float>::Order::VectorScalar);
+          storeBoundaryBins(feature1, proposal.misoBins1);
         }
         else
         {
-          g1ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-          g1ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-          g1ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-          g2ea1 = m_FeatureEulerAngles[3 * selectedfeature2];
-          g2ea2 = m_FeatureEulerAngles[3 * selectedfeature2 + 1];
-          g2ea3 = m_FeatureEulerAngles[3 * selectedfeature2 + 2];
-          q1.copyInto(m_AvgQuats + selectedfeature1 * 4, Quaternion<float>::Order::VectorScalar);
-          OrientationD eu(m_FeatureEulerAngles[3 * selectedfeature1], m_FeatureEulerAngles[3 * selectedfeature1 + 1], m_FeatureEulerAngles[3 * selectedfeature1 + 2]);
-          OrientationD rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
-
-          g1odfbin = laueOp->getOdfBin(rod);
-          q1.copyInto(m_AvgQuats + selectedfeature2 * 4, Quaternion<float>::Order::VectorScalar);
-
-          eu = OrientationD(m_FeatureEulerAngles[3 * selectedfeature2], m_FeatureEulerAngles[3 * selectedfeature2 + 1], m_FeatureEulerAngles[3 * selectedfeature2 + 2]);
-          rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
-          g2odfbin = laueOp->getOdfBin(rod);
-
-          m_OdfChange =
-              ((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
-              ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]))) *
-               (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]))));
-          m_OdfChange =
-              m_OdfChange +
-              (((m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin)) * (m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin))) -
-               ((m_ActualOdf->getValue(g2odfbin) - (m_SimOdf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                (m_ActualOdf->getValue(g2odfbin) -
-                 (m_SimOdf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])))));
-
-          m_MdfChange = 0;
-
-          q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g2ea1, g2ea2, g2ea3));
-
-          size_t size = 0;
-          if(!neighborlist[selectedfeature1].empty())
-          {
-            size = neighborlist[selectedfeature1].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            int32_t neighbor = neighborlist[selectedfeature1][j];
-            eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
-
-            QuatF q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            if(neighbor != static_cast<int>(selectedfeature2))
-            {
-              MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, q1, q2, laueOp.get());
-            }
-          }
-
-          q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g1ea1, g1ea2, g1ea3));
-          size = 0;
-          if(!neighborlist[selectedfeature2].empty())
-          {
-            size = neighborlist[selectedfeature2].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            size_t neighbor = neighborlist[selectedfeature2][j];
-            eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
-            QuatF q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
-            float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-            if(neighbor != selectedfeature1)
-            {
-              MC_LoopBody1(selectedfeature2, ensem, j, neighsurfarea, q1, q2, laueOp.get());
-            }
-          }
-
-          deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
-          if(deltaerror > 0)
-          {
-
-            badtrycount = 0;
-            m_FeatureEulerAngles[3 * selectedfeature1] = g2ea1;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g2ea2;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g2ea3;
-            m_FeatureEulerAngles[3 * selectedfeature2] = g1ea1;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 1] = g1ea2;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 2] = g1ea3;
-            m_SimOdf->setValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-            m_SimOdf->setValue(g2odfbin, (m_SimOdf->getValue(g2odfbin) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem])));
-
-            q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g1ea1, g1ea2, g1ea3));
-            q1.copyInto(m_AvgQuats + selectedfeature1 * 4, Quaternion<float>::Order::VectorScalar);
-            size = 0;
-            if(!neighborlist[selectedfeature1].empty())
-            {
-              size = neighborlist[selectedfeature1].size();
-            }
-            for(size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature1][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(ea1, ea2, ea3));
-              float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-              if(neighbor != selectedfeature2)
-              {
-                MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, q1, q2, laueOp.get());
-              }
-            }
-
-            q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g1ea1, g1ea2, g1ea3));
-            q1.copyInto(m_AvgQuats + selectedfeature2 * 4, Quaternion<float>::Order::VectorScalar);
-            size = 0;
-            if(!neighborlist[selectedfeature2].empty())
-            {
-              size = neighborlist[selectedfeature2].size();
-            }
-            for(size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature2][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(ea1, ea2, ea3));
-              float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-              if(neighbor != selectedfeature1)
-              {
-                MC_LoopBody2(selectedfeature2, ensem, j, neighsurfarea, q1, q2, laueOp.get());
-              }
-            }
-          }
+          std::swap_ranges(m_FeatureEulerAngles + 3 * feature1, m_FeatureEulerAngles + 3 * feature1 + 3, m_FeatureEulerAngles + 3 * feature2);
+          std::swap_ranges(m_AvgQuats + 4 * feature1, m_AvgQuats + 4 * feature1 + 4, m_AvgQuats + 4 * feature2);
+          storeBoundaryBins(feature1, proposal.misoBins1);
+          storeBoundaryBins(feature2, proposal.misoBins2);
+          changedInBatch[feature2] = batch;
         }
+        changedInBatch[feature1] = batch;
       }
     }
+
     if(getCancel())
     {
       return;
     }
   }
 
-  if(getCancel())
-  {
-    return;
-  }
+  m_OdfErrors[ensem] = currentodferror;
+  m_MdfErrors[ensem] = currentmdferror;
 
   for(size_t i = 0; i < totalPoints; i++)
   {
@@ -1099,60 +1079,70 @@ void MatchCrystallography::measure_misorientations(size_t ensem)
   uint32_t laueIndex = m_CrystalStructures[ensem];
   LaueOps::Pointer laueOp = laueOps[laueIndex];
 
-  int32_t mbin = 0;
+  m_MisorientationBins.resize(totalFeatures);
+  m_ReverseNeighborSlots.resize(totalFeatures);
 
-  m_MisorientationLists.resize(totalFeatures);
+  auto hasBoundaryAreas = [&](size_t feature) { return !neighborlist[feature].empty() && neighborsurfacearealist[feature].size() == neighborlist[feature].size(); };
 
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    if(m_FeaturePhases[i] == ensem)
+  // Each boundary is binned once with the lower Feature Id first so both sides of it share the same bin
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1ULL, totalFeatures);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      if(!m_MisorientationLists[i].empty())
-      {
-        m_MisorientationLists[i].clear();
-      }
-      if(!neighborlist[i].empty())
+      std::vector<int32_t>& bins = m_MisorientationBins[i];
+      std::vector<int32_t>& reverseSlots = m_ReverseNeighborSlots[i];
+      bins.clear();
+      reverseSlots.clear();
+      if(m_FeaturePhases[i] != static_cast<int32_t>(ensem) || !hasBoundaryAreas(i))
       {
-        m_MisorientationLists[i].assign(neighborlist[i].size() * 3, 0.0f);
+        continue;
       }
 
+      size_t size = neighborlist[i].size();
+      bins.assign(size, -1);
+      reverseSlots.assign(size, -1);
+
       float* currentAvgQuatPtr = m_AvgQuats + i * 4;
       QuatF q1(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]); // Copy from the array
-
-      size_t size = 0;
-      if(!neighborlist[i].empty() && neighborsurfacearealist[i].size() == neighborlist[i].size())
-      {
-        size = neighborlist[i].size();
-      }
-
       for(size_t j = 0; j < size; j++)
       {
         int32_t nname = neighborlist[i][j];
-        if(m_FeaturePhases[nname] == ensem)
+        if(m_FeaturePhases[nname] != static_cast<int32_t>(ensem))
         {
-          currentAvgQuatPtr = m_AvgQuats + nname * 4;
-          QuatF q2(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]); // Copy into the quaternion
-          OrientationD axisAngle = laueOp->calculateMisorientation(q1, q2);
-
-          OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
-          m_MisorientationLists[i][3 * j] = rod[0];
-          m_MisorientationLists[i][3 * j + 1] = rod[1];
-          m_MisorientationLists[i][3 * j + 2] = rod[2];
-          mbin = laueOp->getMisoBin(rod);
-          if(!m_SurfaceFeatures[i] && (nname > static_cast<int32_t>(i) || m_SurfaceFeatures[nname]))
-          {
-            float neighsurfarea = neighborsurfacearealist[i][j];
-            m_SimMdf->setValue(mbin, (m_SimMdf->getValue(mbin) + (neighsurfarea / m_TotalSurfaceArea[m_FeaturePhases[i]])));
-          }
+          continue;
         }
-        else
+        currentAvgQuatPtr = m_AvgQuats + nname * 4;
+        QuatF q2(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]); // Copy into the quaternion
+        OrientationD axisAngle = nname > static_cast<int32_t>(i) ? laueOp->calculateMisorientation(q1, q2) : laueOp->calculateMisorientation(q2, q1);
+        OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
+        bins[j] = static_cast<int32_t>(laueOp->getMisoBin(rod));
+
+        if(hasBoundaryAreas(nname))
         {
-          m_MisorientationLists[i][3 * j] = -100;
-          m_MisorientationLists[i][3 * j + 1] = -100;
-          m_MisorientationLists[i][3 * j + 2] = -100;
+          auto iter = std::find(neighborlist[nname].begin(), neighborlist[nname].end(), static_cast<int32_t>(i));
+          if(iter != neighborlist[nname].end())
+          {
+            reverseSlots[j] = static_cast<int32_t>(iter - neighborlist[nname].begin());
+          }
         }
       }
     }
+  });
+
+  float* simMdf = m_SimMdf->getPointer(0);
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    const std::vector<int32_t>& bins = m_MisorientationBins[i];
+    for(size_t j = 0; j < bins.size(); j++)
+    {
+      int32_t nname = neighborlist[i][j];
+      if(bins[j] >= 0 && !m_SurfaceFeatures[i] && (nname > static_cast<int32_t>(i) || m_SurfaceFeatures[nname]))
+      {
+        float neighsurfarea = neighborsurfacearealist[i][j];
+        simMdf[bins[j]] = simMdf[bins[j]] + (neighsurfarea / m_TotalSurfaceArea[m_FeaturePhases[i]]);
+      }
+    }
   }
 }
 
@@ -1423,3 +1413,51 @@ int MatchCrystallography::getMaxIterations() const
 {
   return m_MaxIterations;
 }
+
+// -----------------------------------------------------------------------------
+void MatchCrystallography::setUseSeed(bool value)
+{
+  m_UseSeed = value;
+}
+
+// -----------------------------------------------------------------------------
+bool MatchCrystallography::getUseSeed() const
+{
+  return m_UseSeed;
+}
+
+// -----------------------------------------------------------------------------
+void MatchCrystallography::setSeedValue(int value)
+{
+  m_SeedValue = value;
+}
+
+// -----------------------------------------------------------------------------
+int MatchCrystallography::getSeedValue() const
+{
+  return m_SeedValue;
+}
+
+// -----------------------------------------------------------------------------
+void MatchCrystallography::setUseParallelMatching(bool value)
+{
+  m_UseParallelMatching = value;
+}
+
+// -----------------------------------------------------------------------------
+bool MatchCrystallography::getUseParallelMatching() const
+{
+  return m_UseParallelMatching;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<double> MatchCrystallography::getOdfErrors() const
+{
+  return m_OdfErrors;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<double> MatchCrystallography::getMdfErrors() const
+{
+  return m_MdfErrors;
+}
@@ -36,6 +36,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -77,6 +78,9 @@ class SyntheticBuilding_EXPORT MatchCrystallography : public AbstractFilter
   PYB11_PROPERTY(QString FeatureEulerAnglesArrayName READ getFeatureEulerAnglesArrayName WRITE setFeatureEulerAnglesArrayName)
   PYB11_PROPERTY(QString AvgQuatsArrayName READ getAvgQuatsArrayName WRITE setAvgQuatsArrayName)
   PYB11_PROPERTY(int MaxIterations READ getMaxIterations WRITE setMaxIterations)
+  PYB11_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+  PYB11_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
+  PYB11_PROPERTY(bool UseParallelMatching READ getUseParallelMatching WRITE setUseParallelMatching)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -267,6 +271,51 @@ public:
   int getMaxIterations() const;
   Q_PROPERTY(int MaxIterations READ getMaxIterations WRITE setMaxIterations)
 
+  /**
+   * @brief Setter property for UseSeed
+   */
+  void setUseSeed(bool value);
+  /**
+   * @brief Getter property for UseSeed
+   * @return Value of UseSeed
+   */
+  bool getUseSeed() const;
+  Q_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+
+  /**
+   * @brief Setter property for SeedValue
+   */
+  void setSeedValue(int value);
+  /**
+   * @brief Getter property for SeedValue
+   * @return Value of SeedValue
+   */
+  int getSeedValue() const;
+  Q_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
+
+  /**
+   * @brief Setter property for UseParallelMatching
+   */
+  void setUseParallelMatching(bool value);
+  /**
+   * @brief Getter property for UseParallelMatching
+   * @return Value of UseParallelMatching
+   */
+  bool getUseParallelMatching() const;
+  Q_PROPERTY(bool UseParallelMatching READ getUseParallelMatching WRITE setUseParallelMatching)
+
+  /**
+   * @brief getOdfErrors Returns the squared ODF error of each Ensemble as it was maintained
+   * during the last execution. Ensembles that were not matched hold zero
+   */
+  std::vector<double> getOdfErrors() const;
+
+  /**
+   * @brief getMdfErrors Returns the squared MDF error of each Ensemble as it was maintained
+   * during the last execution. Ensembles that were not matched hold zero
+   */
+  std::vector<double> getMdfErrors() const;
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -371,39 +420,17 @@ protected:
    */
   int32_t pick_euler(float random, int32_t numbins);
 
-  /**
-   * @brief MC_LoopBody1 Determines the misorientation change after performing a swap
-   * @param feature Feature Id of Feature that has been swapped
-   * @param ensem Ensemble index of the current phase
-   * @param j Neighbor index for the Feature
-   * @param neighsurfarea Surface area for the Feature neighbor
-   * @param sym Crystal structure index
-   * @param q1 Quaterions for the Feature
-   * @param q2 Quaterions for the Feature neighbor
-   */
-  void MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, const QuatF& q1, const QuatF& q2, LaueOps* ops);
-
-  /**
-   * @brief MC_LoopBody2 Reinserts the swapped orientation if the swap did not improve the fit
-   * @param feature Feature Id of the Feature that has been swapped
-   * @param phase Ensemble index of the current phase
-   * @param j Neighbor index for the Feature
-   * @param neighsurfarea Surface area for the Feature neighbor
-   * @param sym Crystal structure index
-   * @param q1 Quaternions for the Feature
-   * @param q2 Quaternions for the Feature neighbor
-   */
-  void MC_LoopBody2(int32_t feature, size_t phase, size_t j, float neighsurfarea, QuatF& q1, QuatF& q2, LaueOps* ops);
-
   /**
    * @brief matchCrystallography Swaps orientations for Features unitl convergence to
-   * the input statistics
+   * the input statistics. The ODF/MDF errors are maintained incrementally and each
+   * swap or switch only recomputes the boundaries of the Features it moves
    * @param ensem Ensemble index of the current phase
    */
   void matchCrystallography(size_t ensem);
 
   /**
-   * @brief measure_misorientations Determines the misorientations between each Feature
+   * @brief measure_misorientations Determines the misorientation bin of each boundary
+   * between Features of the phase and builds the simulated MDF from them
    * @param ensem Ensemle index of the current phase
    */
   void measure_misorientations(size_t ensem);
@@ -446,6 +473,9 @@ private:
   QString m_FeatureEulerAnglesArrayName = {SIMPL::FeatureData::EulerAngles};
   QString m_AvgQuatsArrayName = {SIMPL::FeatureData::AvgQuats};
   int m_MaxIterations = {1};
+  bool m_UseSeed = {false};
+  int m_SeedValue = {0};
+  bool m_UseParallelMatching = {false};
 
   // Cell Data
 
@@ -459,9 +489,7 @@ private:
   StatsDataArray::WeakPointer m_StatsDataArray;
 
   // All other private instance variables
-  float m_MdfChange;
-  float m_OdfChange;
-
+  uint64_t m_RandomSeed = 0;
   std::vector<float> m_UnbiasedVolume;
   std::vector<float> m_TotalSurfaceArea;
 
@@ -470,7 +498,13 @@ private:
   FloatArrayType::Pointer m_ActualMdf;
   FloatArrayType::Pointer m_SimMdf;
 
-  std::vector<std::vector<float>> m_MisorientationLists;
+  // Misorientation bin of each neighbor slot (-1 if the boundary is not part of the MDF), kept
+  // identical on both sides of a boundary through the slot of the Feature in its neighbor's list
+  std::vector<std::vector<int32_t>> m_MisorientationBins;
+  std::vector<std::vector<int32_t>> m_ReverseNeighborSlots;
+
+  std::vector<double> m_OdfErrors;
+  std::vector<double> m_MdfErrors;
 
 public:
   MatchCrystallography(const MatchCrystallography&) = delete;            // Copy Constructor Not Implemented
@@ -35,7 +35,10 @@
 
 #include "PackPrimaryPhases.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <limits>
 
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
@@ -54,6 +57,7 @@
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedChoicesFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
@@ -66,6 +70,7 @@
 #include "SIMPLib/Math/SIMPLibRandom.h"
 #include "SIMPLib/StatsData/PrimaryStatsData.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/Utilities/TimeUtilities.h"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
@@ -76,6 +81,8 @@
 #include "EbsdLib/Core/Quaternion.hpp"
 #include "EbsdLib/LaueOps/OrthoRhombicOps.h"
 
+#include "Common/PhiloxRandom.hpp"
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range3d.h>
 #include <tbb/parallel_for.h>
@@ -85,7 +92,143 @@
 namespace
 {
 OrthoRhombicOps::Pointer m_OrthoOps;
-}
+
+// Random streams of this filter, see PhiloxRandom::StreamId()
+constexpr uint64_t k_RandomStreamFilterId = 1;
+constexpr uint64_t k_FeatureGenerationStreams = 0;
+constexpr uint64_t k_PlacementStream = 1;
+constexpr uint64_t k_EstimateStream = 2;
+
+// Number of trial moves proposed together when the placement runs in parallel
+constexpr int32_t k_TrialMovesPerBatch = 64;
+// Edge length, in packing points, of the cells used to keep the trial moves of a batch apart
+constexpr int64_t k_ClaimCellSize = 8;
+
+/**
+ * @brief The TrialMove struct is one speculative move of a Feature evaluated during parallel placement
+ */
+struct TrialMove
+{
+  int32_t feature = 0;
+  std::array<float, 3> oldCentroid = {0.0f, 0.0f, 0.0f};
+  std::array<float, 3> newCentroid = {0.0f, 0.0f, 0.0f};
+  int64_t change = 0;
+  bool accepted = false;
+  std::vector<size_t> pointsToAdd;
+  std::vector<size_t> pointsToRemove;
+};
+
+/**
+ * @brief The PackingRegionClaims class tracks which coarse cells of the packing grid are touched by the trial
+ * moves of the current batch, so that only moves on disjoint packing points are evaluated together.
+ */
+class PackingRegionClaims
+{
+public:
+  PackingRegionClaims(const int64_t packingPoints[3], bool periodic)
+  : m_Periodic(periodic)
+  {
+    for(size_t d = 0; d < 3; d++)
+    {
+      m_PackingPoints[d] = packingPoints[d];
+      m_CellDims[d] = (packingPoints[d] + k_ClaimCellSize - 1) / k_ClaimCellSize;
+    }
+    m_Stamps.assign(static_cast<size_t>(m_CellDims[0] * m_CellDims[1] * m_CellDims[2]), 0);
+  }
+
+  /**
+   * @brief nextBatch Releases every claim made so far
+   */
+  void nextBatch()
+  {
+    m_Batch++;
+  }
+
+  /**
+   * @brief claim Claims the cells covered by the old and new bounding boxes of a move
+   * @param oldBounds Packing point bounds {minColumn, minRow, minPlane, maxColumn, maxRow, maxPlane}
+   * @param newBounds Packing point bounds {minColumn, minRow, minPlane, maxColumn, maxRow, maxPlane}
+   * @return false, without claiming anything, if one of the cells was already claimed in this batch
+   */
+  bool claim(const std::array<int64_t, 6>& oldBounds, const std::array<int64_t, 6>& newBounds)
+  {
+    m_Claimed.clear();
+    collectCells(oldBounds);
+    collectCells(newBounds);
+    for(size_t cell : m_Claimed)
+    {
+      if(m_Stamps[cell] == m_Batch)
+      {
+        return false;
+      }
+    }
+    for(size_t cell : m_Claimed)
+    {
+      m_Stamps[cell] = m_Batch;
+    }
+    return true;
+  }
+
+private:
+  void collectCells(const std::array<int64_t, 6>& bounds)
+  {
+    coveredCells(bounds[0], bounds[3], 0, m_Columns);
+    coveredCells(bounds[1], bounds[4], 1, m_Rows);
+    coveredCells(bounds[2], bounds[5], 2, m_Planes);
+    for(int64_t plane : m_Planes)
+    {
+      for(int64_t row : m_Rows)
+      {
+        for(int64_t column : m_Columns)
+        {
+          m_Claimed.push_back(static_cast<size_t>((plane * m_CellDims[1] + row) * m_CellDims[0] + column));
+        }
+      }
+    }
+  }
+
+  void coveredCells(int64_t lo, int64_t hi, size_t dim, std::vector<int64_t>& cells) const
+  {
+    cells.clear();
+    const int64_t points = m_PackingPoints[dim];
+    if(!m_Periodic)
+    {
+      lo = std::max(lo, static_cast<int64_t>(0));
+      hi = std::min(hi, points - 1);
+      for(int64_t cell = lo / k_ClaimCellSize; lo <= hi && cell <= hi / k_ClaimCellSize; cell++)
+      {
+        cells.push_back(cell);
+      }
+      return;
+    }
+    if(hi - lo + 1 >= points)
+    {
+      lo = 0;
+      hi = points - 1;
+    }
+    for(int64_t point = lo; point <= hi; point++)
+    {
+      int64_t cell = (((point % points) + points) % points) / k_ClaimCellSize;
+      if(cells.empty() || cells.back() != cell)
+      {
+        cells.push_back(cell);
+      }
+    }
+    std::sort(cells.begin(), cells.end());
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+  }
+
+  bool m_Periodic = false;
+  int64_t m_PackingPoints[3] = {0, 0, 0};
+  int64_t m_CellDims[3] = {0, 0, 0};
+  uint32_t m_Batch = 0;
+  std::vector<uint32_t> m_Stamps;
+  std::vector<size_t> m_Claimed;
+  std::vector<int64_t> m_Columns;
+  std::vector<int64_t> m_Rows;
+  std::vector<int64_t> m_Planes;
+};
+} // namespace
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -285,6 +428,9 @@ PackPrimaryPhases::PackPrimaryPhases()
 , m_FeatureInputFile("")
 , m_CsvOutputFile("")
 , m_PeriodicBoundaries(false)
+, m_UseParallelPlacement(false)
+, m_UseSeed(false)
+, m_SeedValue(0)
 , m_WriteGoalAttributes(false)
 , m_SaveGeometricDescriptions(0)
 , m_NewAttributeMatrixPath(SIMPL::Defaults::SyntheticVolumeDataContainerName, PrimaryPhaseSyntheticShapeParametersName, "")
@@ -325,14 +471,12 @@ void PackPrimaryPhases::initialize()
   m_SuperEllipsoidOps = ShapeOps::NullPointer();
   ::m_OrthoOps = OrthoRhombicOps::New();
 
-  m_ColumnList.clear();
-  m_RowList.clear();
-  m_PlaneList.clear();
-  m_EllipFuncList.clear();
+  m_Footprints.clear();
+  m_FootprintAnchors.clear();
 
   m_PointsToAdd.clear();
   m_PointsToRemove.clear();
-  m_Seed = QDateTime::currentMSecsSinceEpoch();
+  m_RandomStream = 0;
   m_FirstPrimaryFeature = 1;
   m_SizeX = m_SizeY = m_SizeZ = m_TotalVol = 0.0f;
   m_TotalVol = 1.0f;
@@ -359,6 +503,8 @@ void PackPrimaryPhases::initialize()
   m_PrimaryPhaseFractions.clear();
 
   m_AvailablePointsCount = 1;
+  m_AvailablePoints.clear();
+  m_AvailablePointSlots.clear();
   m_FillingError = m_OldFillingError = 0.0f;
   m_CurrentNeighborhoodError = m_OldNeighborhoodError = 0.0f;
   m_CurrentSizeDistError = m_OldSizeDistError = 0.0f;
@@ -371,6 +517,10 @@ void PackPrimaryPhases::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Periodic Boundaries", PeriodicBoundaries, FilterParameter::Category::Parameter, PackPrimaryPhases));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Parallel Feature Placement", UseParallelPlacement, FilterParameter::Category::Parameter, PackPrimaryPhases));
+  std::vector<QString> seedProps = {"SeedValue"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Fixed Seed", UseSeed, FilterParameter::Category::Parameter, PackPrimaryPhases, seedProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Seed Value", SeedValue, FilterParameter::Category::Parameter, PackPrimaryPhases));
   std::vector<QString> linkedProps = {"MaskArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask", UseMask, FilterParameter::Category::Parameter, PackPrimaryPhases, linkedProps));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -522,6 +672,9 @@ void PackPrimaryPhases::readFilterParameters(AbstractFilterParametersReader* rea
   setFeaturePhasesArrayName(reader->readString("FeaturePhasesArrayName", getFeaturePhasesArrayName()));
   setNumFeaturesArrayName(reader->readString("NumFeaturesArrayName", getNumFeaturesArrayName()));
   setPeriodicBoundaries(reader->readValue("PeriodicBoundaries", false));
+  setUseParallelPlacement(reader->readValue("UseParallelPlacement", getUseParallelPlacement()));
+  setUseSeed(reader->readValue("UseSeed", getUseSeed()));
+  setSeedValue(reader->readValue("SeedValue", getSeedValue()));
   setWriteGoalAttributes(reader->readValue("WriteGoalAttributes", false));
   setUseMask(reader->readValue("UseMask", getUseMask()));
 
@@ -868,6 +1021,8 @@ void PackPrimaryPhases::execute()
     return;
   }
 
+  m_RandomSeed = PhiloxRandom::ResolveSeed(m_UseSeed, static_cast<uint64_t>(m_SeedValue));
+
   if(getFeatureGeneration() == 0)
   {
     notifyStatusMessage("Packing Features || Initializing Volume");
@@ -1098,8 +1253,8 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
     writeErrorFile = outFile.is_open();
   }
 
-  m_Seed = QDateTime::currentMSecsSinceEpoch();
-  SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
+  m_RandomStream = 0;
+  PhiloxRandom rg(m_RandomSeed, PhiloxRandom::StreamId(k_RandomStreamFilterId, k_PlacementStream, 0));
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
 
@@ -1185,29 +1340,13 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   Int32ArrayType::Pointer exclusionOwnersPtr = Int32ArrayType::CreateArray(m_TotalPackingPoints, cDim, "_INTERNAL_USE_ONLY_PackPrimaryFeatures::exclusions_owners", true);
   exclusionOwnersPtr->initializeWithValue(0);
 
-  // This is the set that we are going to keep updated with the points that are not in an exclusion zone
-  std::map<size_t, size_t> availablePoints;
-  std::map<size_t, size_t> availablePointsInv;
-
   // Get a pointer to the Feature Owners that was just initialized in the initialize_packinggrid() method
   int32_t* featureOwners = featureOwnersPtr->getPointer(0);
   int32_t* exclusionOwners = exclusionOwnersPtr->getPointer(0);
   int64_t featureOwnersIdx = 0;
 
   // determine initial set of available points
-  m_AvailablePointsCount = 0;
-  for(int64_t i = 0; i < m_TotalPackingPoints; i++)
-  {
-    if((exclusionOwners[i] == 0 && !m_UseMask) || (exclusionOwners[i] == 0 && m_UseMask && m_Mask[i]))
-    {
-      availablePoints[i] = m_AvailablePointsCount;
-      availablePointsInv[m_AvailablePointsCount] = i;
-      m_AvailablePointsCount++;
-    }
-  }
-  // and clear the pointsToRemove and pointsToAdd vectors from the initial packing
-  m_PointsToRemove.clear();
-  m_PointsToAdd.clear();
+  initializeAvailablePoints(exclusionOwnersPtr);
 
   // initialize the sim and goal size distributions for the primary phases
   m_FeatureSizeDist.resize(m_PrimaryPhases.size());
@@ -1272,7 +1411,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
     while(curphasevol[j] < (factor * curphasetotalvol))
     {
       iter++;
-      m_Seed++;
+      m_RandomStream++;
       phase = m_PrimaryPhases[j];
       generateFeature(phase, &feature, m_ShapeTypes[phase]);
       m_CurrentSizeDistError = checkSizeDistError(&feature);
@@ -1319,7 +1458,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
       while(curphasevol[j] < ((1 + factor) * curphasetotalvol))
       {
         iter++;
-        m_Seed++;
+        m_RandomStream++;
         phase = m_PrimaryPhases[j];
         generateFeature(phase, &feature, m_ShapeTypes[phase]);
         m_CurrentSizeDistError = checkSizeDistError(&feature);
@@ -1416,10 +1555,8 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
     return;
   }
 
-  m_ColumnList.resize(totalFeatures);
-  m_RowList.resize(totalFeatures);
-  m_PlaneList.resize(totalFeatures);
-  m_EllipFuncList.resize(totalFeatures);
+  m_Footprints.resize(totalFeatures);
+  m_FootprintAnchors.resize(totalFeatures, {0, 0, 0});
   m_PackQualities.resize(totalFeatures);
   m_FillingError = 1.0f;
 
@@ -1516,186 +1653,281 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   int32_t totalAdjustments = static_cast<int32_t>(100 * (totalFeatures - 1));
 
   // determine initial set of available points
-  m_AvailablePointsCount = 0;
-  for(int64_t i = 0; i < m_TotalPackingPoints; i++)
-  {
-    if((exclusionOwners[i] == 0 && !m_UseMask) || (exclusionOwners[i] == 0 && m_UseMask && m_Mask[i]))
+  initializeAvailablePoints(exclusionOwnersPtr);
+
+  // picks a random feature to move, preferring one whose centroid sits on a packing point owned by more than one feature
+  auto selectRandomFeature = [&]() -> int32_t {
+    int32_t feature = m_FirstPrimaryFeature + int32_t(rg.genrand_res53() * (totalFeatures - m_FirstPrimaryFeature));
+    bool good = false;
+    count = 0;
+    while(!good && count < static_cast<int32_t>((totalFeatures - m_FirstPrimaryFeature)))
     {
-      availablePoints[i] = m_AvailablePointsCount;
-      availablePointsInv[m_AvailablePointsCount] = i;
-      m_AvailablePointsCount++;
+      xc = m_Centroids[3 * feature];
+      yc = m_Centroids[3 * feature + 1];
+      zc = m_Centroids[3 * feature + 2];
+      column = static_cast<int64_t>((xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
+      row = static_cast<int64_t>((yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
+      plane = static_cast<int64_t>((zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
+      featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + column;
+      if(featureOwners[featureOwnersIdx] > 1)
+      {
+        good = true;
+      }
+      else
+      {
+        feature++;
+      }
+      if(static_cast<size_t>(feature) >= totalFeatures)
+      {
+        feature = m_FirstPrimaryFeature;
+      }
+      count++;
     }
-  }
-
-  // and clear the pointsToRemove and pointsToAdd vectors from the initial packing
-  m_PointsToRemove.clear();
-  m_PointsToAdd.clear();
+    m_RandomStream++;
+    return feature;
+  };
 
-  millis = QDateTime::currentMSecsSinceEpoch();
-  startMillis = millis;
-  bool good = false;
+  // JUMP - picks a random available spot in the volume
   size_t key = 0;
-  float xshift = 0.0f, yshift = 0.0f, zshift = 0.0f;
-  int32_t lastIteration = 0;
-  for(int32_t iteration = 0; iteration < totalAdjustments; ++iteration)
-  {
-    uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
+  auto selectJumpTarget = [&](float& newxc, float& newyc, float& newzc) {
+    if(m_AvailablePointsCount > 0)
     {
-      QString ss = QObject::tr("Swapping/Moving/Adding/Removing Features Iteration %1/%2").arg(iteration).arg(totalAdjustments);
-      timeDiff = ((float)iteration / (float)(currentMillis - startMillis));
-      estimatedTime = (float)(totalAdjustments - iteration) / timeDiff;
-
-      ss += QObject::tr(" || Est. Time Remain: %1 || Iterations/Sec: %2").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime)).arg(timeDiff * 1000);
-      notifyStatusMessage(ss);
-
-      millis = QDateTime::currentMSecsSinceEpoch();
-      lastIteration = iteration;
+      key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
+      featureOwnersIdx = m_AvailablePoints[key];
     }
-
-    if(getCancel())
+    else
     {
-      return;
+      featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPackingPoints);
     }
 
-    int32_t option = iteration % 2;
+    // find the column row and plane of that point
+    column = static_cast<int64_t>(featureOwnersIdx % m_PackingPoints[0]);
+    row = static_cast<int64_t>(featureOwnersIdx / m_PackingPoints[0]) % m_PackingPoints[1];
+    plane = static_cast<int64_t>(featureOwnersIdx / (m_PackingPoints[0] * m_PackingPoints[1]));
+    newxc = static_cast<float>((column * m_PackingRes[0]) + (m_PackingRes[0] * 0.5));
+    newyc = static_cast<float>((row * m_PackingRes[1]) + (m_PackingRes[1] * 0.5));
+    newzc = static_cast<float>((plane * m_PackingRes[2]) + (m_PackingRes[2] * 0.5));
+  };
 
-    if(writeErrorFile && iteration % 25 == 0)
+  // NUDGE - picks a spot close to the current centroid of the feature
+  float xshift = 0.0f, yshift = 0.0f, zshift = 0.0f;
+  auto selectNudgeTarget = [&](int32_t feature, float& newxc, float& newyc, float& newzc) {
+    float curxc = m_Centroids[3 * feature];
+    float curyc = m_Centroids[3 * feature + 1];
+    float curzc = m_Centroids[3 * feature + 2];
+    xshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[0])));
+    yshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[1])));
+    zshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[2])));
+    if((curxc + xshift) < m_SizeX && (curxc + xshift) > 0)
+    {
+      newxc = curxc + xshift;
+    }
+    else
+    {
+      newxc = curxc;
+    }
+    if((curyc + yshift) < m_SizeY && (curyc + yshift) > 0)
+    {
+      newyc = curyc + yshift;
+    }
+    else
+    {
+      newyc = curyc;
+    }
+    if((curzc + zshift) < m_SizeZ && (curzc + zshift) > 0)
     {
-      outFile << iteration << " " << m_FillingError << "  " << availablePoints.size() << "  " << m_AvailablePointsCount << " " << totalFeatures << " " << acceptedmoves << "\n";
+      newzc = curzc + zshift;
     }
+    else
+    {
+      newzc = curzc;
+    }
+  };
 
-    // JUMP - this option moves one feature to a random spot in the volume
-    if(option == 0)
+  millis = QDateTime::currentMSecsSinceEpoch();
+  startMillis = millis;
+  if(m_UseParallelPlacement)
+  {
+    // The trial moves are proposed serially in batches, so the random sequence and therefore the packing does not
+    // depend on the number of threads. A move whose old and new footprints touch a region claimed earlier in its
+    // batch is dropped, so the remaining moves touch disjoint packing points and are evaluated concurrently.
+    std::vector<std::array<int64_t, 6>> footprintBounds(totalFeatures, {0, 0, 0, -1, -1, -1});
+    for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
     {
-      randomfeature = m_FirstPrimaryFeature + int32_t(rg.genrand_res53() * (totalFeatures - m_FirstPrimaryFeature));
-      good = false;
-      count = 0;
-      while(!good && count < static_cast<int32_t>((totalFeatures - m_FirstPrimaryFeature)))
-      {
-        xc = m_Centroids[3 * randomfeature];
-        yc = m_Centroids[3 * randomfeature + 1];
-        zc = m_Centroids[3 * randomfeature + 2];
-        column = static_cast<int64_t>((xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
-        row = static_cast<int64_t>((yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
-        plane = static_cast<int64_t>((zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
-        featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + column;
-        if(featureOwners[featureOwnersIdx] > 1)
-        {
-          good = true;
-        }
-        else
-        {
-          randomfeature++;
-        }
-        if(static_cast<size_t>(randomfeature) >= totalFeatures)
-        {
-          randomfeature = m_FirstPrimaryFeature;
-        }
-        count++;
+      const std::vector<FootprintVoxel>& footprint = m_Footprints[i];
+      if(footprint.empty())
+      {
+        continue;
       }
-      m_Seed++;
-
-      if(!availablePoints.empty())
+      std::array<int64_t, 6>& bounds = footprintBounds[i];
+      bounds = {footprint[0].column, footprint[0].row, footprint[0].plane, footprint[0].column, footprint[0].row, footprint[0].plane};
+      for(const FootprintVoxel& voxel : footprint)
       {
-        key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-        featureOwnersIdx = availablePointsInv[key];
+        bounds[0] = std::min(bounds[0], static_cast<int64_t>(voxel.column));
+        bounds[1] = std::min(bounds[1], static_cast<int64_t>(voxel.row));
+        bounds[2] = std::min(bounds[2], static_cast<int64_t>(voxel.plane));
+        bounds[3] = std::max(bounds[3], static_cast<int64_t>(voxel.column));
+        bounds[4] = std::max(bounds[4], static_cast<int64_t>(voxel.row));
+        bounds[5] = std::max(bounds[5], static_cast<int64_t>(voxel.plane));
       }
-      else
+    }
+    auto packingBounds = [&](int32_t feature, const std::array<float, 3>& centroid) {
+      // mirrors moveFeature, which shifts the anchor by the change in the packing point of the centroid
+      const std::array<int64_t, 3>& anchor = m_FootprintAnchors[feature];
+      const std::array<int64_t, 6>& offsets = footprintBounds[feature];
+      std::array<int64_t, 6> bounds = {0, 0, 0, 0, 0, 0};
+      for(size_t d = 0; d < 3; d++)
       {
-        featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPackingPoints);
+        int64_t oldPoint = static_cast<int64_t>((m_Centroids[3 * feature + d] - (m_HalfPackingRes[d])) * m_OneOverPackingRes[d]);
+        int64_t newPoint = static_cast<int64_t>((centroid[d] - (m_HalfPackingRes[d])) * m_OneOverPackingRes[d]);
+        bounds[d] = anchor[d] + newPoint - oldPoint + offsets[d];
+        bounds[d + 3] = anchor[d] + newPoint - oldPoint + offsets[d + 3];
       }
+      return bounds;
+    };
 
-      // find the column row and plane of that point
-      column = static_cast<int64_t>(featureOwnersIdx % m_PackingPoints[0]);
-      row = static_cast<int64_t>(featureOwnersIdx / m_PackingPoints[0]) % m_PackingPoints[1];
-      plane = static_cast<int64_t>(featureOwnersIdx / (m_PackingPoints[0] * m_PackingPoints[1]));
-      xc = static_cast<float>((column * m_PackingRes[0]) + (m_PackingRes[0] * 0.5));
-      yc = static_cast<float>((row * m_PackingRes[1]) + (m_PackingRes[1] * 0.5));
-      zc = static_cast<float>((plane * m_PackingRes[2]) + (m_PackingRes[2] * 0.5));
-      oldxc = m_Centroids[3 * randomfeature];
-      oldyc = m_Centroids[3 * randomfeature + 1];
-      oldzc = m_Centroids[3 * randomfeature + 2];
-      m_OldFillingError = m_FillingError;
-      m_FillingError = checkFillingError(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-      moveFeature(randomfeature, xc, yc, zc);
-      m_FillingError = checkFillingError(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-      m_CurrentNeighborhoodError = checkNeighborhoodError(-1000, randomfeature);
-      if(m_FillingError <= m_OldFillingError)
+    PackingRegionClaims claims(m_PackingPoints, m_PeriodicBoundaries);
+    std::vector<int32_t> proposedInBatch(totalFeatures, -1);
+    std::vector<TrialMove> trialMoves;
+    int64_t fillingErrorSum = static_cast<int64_t>(std::llround(static_cast<double>(m_FillingError) * static_cast<double>(m_TotalPackingPoints)));
+    for(int32_t iteration = 0; iteration < totalAdjustments; iteration += k_TrialMovesPerBatch)
+    {
+      uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
+      if(currentMillis - millis > 1000)
       {
-        m_OldNeighborhoodError = m_CurrentNeighborhoodError;
-        updateAvailablePoints(availablePoints, availablePointsInv);
-        acceptedmoves++;
+        QString ss = QObject::tr("Swapping/Moving/Adding/Removing Features Iteration %1/%2").arg(iteration).arg(totalAdjustments);
+        timeDiff = ((float)iteration / (float)(currentMillis - startMillis));
+        estimatedTime = (float)(totalAdjustments - iteration) / timeDiff;
+
+        ss += QObject::tr(" || Est. Time Remain: %1 || Iterations/Sec: %2").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime)).arg(timeDiff * 1000);
+        notifyStatusMessage(ss);
+
+        millis = QDateTime::currentMSecsSinceEpoch();
       }
-      else if(m_FillingError > m_OldFillingError)
+
+      if(getCancel())
       {
-        m_FillingError = checkFillingError(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-        moveFeature(randomfeature, oldxc, oldyc, oldzc);
-        m_FillingError = checkFillingError(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-        m_PointsToRemove.clear();
-        m_PointsToAdd.clear();
+        return;
       }
-    }
 
-    // NUDGE - this option moves one feature to a spot close to its current centroid
-    if(option == 1)
-    {
-      randomfeature = m_FirstPrimaryFeature + int32_t(rg.genrand_res53() * (totalFeatures - m_FirstPrimaryFeature));
-      good = false;
-      count = 0;
-      while(!good && count < static_cast<int32_t>((totalFeatures - m_FirstPrimaryFeature)))
-      {
-        xc = m_Centroids[3 * randomfeature];
-        yc = m_Centroids[3 * randomfeature + 1];
-        zc = m_Centroids[3 * randomfeature + 2];
-        column = static_cast<int64_t>((xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
-        row = static_cast<int64_t>((yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
-        plane = static_cast<int64_t>((zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
-        featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + column;
-        if(featureOwners[featureOwnersIdx] > 1)
+      if(writeErrorFile)
+      {
+        outFile << iteration << " " << m_FillingError << "  " << m_AvailablePoints.size() << "  " << m_AvailablePointsCount << " " << totalFeatures << " " << acceptedmoves << "\n";
+      }
+
+      // propose the whole batch against the packing as it was at the start of the batch
+      claims.nextBatch();
+      trialMoves.clear();
+      const int32_t batchEnd = std::min(iteration + k_TrialMovesPerBatch, totalAdjustments);
+      for(int32_t trial = iteration; trial < batchEnd; trial++)
+      {
+        TrialMove move;
+        move.feature = selectRandomFeature();
+        move.oldCentroid = {m_Centroids[3 * move.feature], m_Centroids[3 * move.feature + 1], m_Centroids[3 * move.feature + 2]};
+        if(trial % 2 == 0)
         {
-          good = true;
+          selectJumpTarget(move.newCentroid[0], move.newCentroid[1], move.newCentroid[2]);
         }
         else
         {
-          randomfeature++;
+          selectNudgeTarget(move.feature, move.newCentroid[0], move.newCentroid[1], move.newCentroid[2]);
         }
-        if(static_cast<size_t>(randomfeature) >= totalFeatures)
+        if(proposedInBatch[move.feature] != iteration && claims.claim(packingBounds(move.feature, move.oldCentroid), packingBounds(move.feature, move.newCentroid)))
         {
-          randomfeature = m_FirstPrimaryFeature;
+          proposedInBatch[move.feature] = iteration;
+          trialMoves.push_back(std::move(move));
         }
-        count++;
       }
-      m_Seed++;
-      oldxc = m_Centroids[3 * randomfeature];
-      oldyc = m_Centroids[3 * randomfeature + 1];
-      oldzc = m_Centroids[3 * randomfeature + 2];
-      xshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[0])));
-      yshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[1])));
-      zshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[2])));
-      if((oldxc + xshift) < m_SizeX && (oldxc + xshift) > 0)
+
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0ULL, trialMoves.size());
+      dataAlg.setGrain(1);
+      dataAlg.execute([&](const SIMPLRange& range) {
+        for(size_t i = range.min(); i < range.max(); i++)
+        {
+          TrialMove& move = trialMoves[i];
+          move.change = updateFootprint(move.feature, false, featureOwners, exclusionOwners, move.pointsToAdd, move.pointsToRemove);
+          moveFeature(move.feature, move.newCentroid[0], move.newCentroid[1], move.newCentroid[2]);
+          move.change += updateFootprint(move.feature, true, featureOwners, exclusionOwners, move.pointsToAdd, move.pointsToRemove);
+          move.accepted = (move.change <= 0);
+          if(!move.accepted)
+          {
+            updateFootprint(move.feature, false, featureOwners, exclusionOwners, move.pointsToAdd, move.pointsToRemove);
+            moveFeature(move.feature, move.oldCentroid[0], move.oldCentroid[1], move.oldCentroid[2]);
+            updateFootprint(move.feature, true, featureOwners, exclusionOwners, move.pointsToAdd, move.pointsToRemove);
+            move.pointsToAdd.clear();
+            move.pointsToRemove.clear();
+          }
+        }
+      });
+
+      // commit the accepted moves in the order they were proposed
+      int32_t lastAcceptedFeature = -1;
+      for(const TrialMove& move : trialMoves)
       {
-        xc = oldxc + xshift;
+        if(!move.accepted)
+        {
+          continue;
+        }
+        fillingErrorSum += move.change;
+        m_PointsToAdd.insert(m_PointsToAdd.end(), move.pointsToAdd.begin(), move.pointsToAdd.end());
+        m_PointsToRemove.insert(m_PointsToRemove.end(), move.pointsToRemove.begin(), move.pointsToRemove.end());
+        lastAcceptedFeature = move.feature;
+        acceptedmoves++;
       }
-      else
+      m_FillingError = static_cast<float>(fillingErrorSum) / float(m_TotalPackingPoints);
+      if(lastAcceptedFeature >= 0)
+      {
+        updateAvailablePoints(exclusionOwnersPtr);
+        // the neighborhood error is only reported, so it is refreshed once per batch instead of once per move
+        m_OldNeighborhoodError = checkNeighborhoodError(-1000, lastAcceptedFeature);
+      }
+    }
+  }
+  else
+  {
+    int32_t lastIteration = 0;
+    for(int32_t iteration = 0; iteration < totalAdjustments; ++iteration)
+    {
+      uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
+      if(currentMillis - millis > 1000)
       {
-        xc = oldxc;
+        QString ss = QObject::tr("Swapping/Moving/Adding/Removing Features Iteration %1/%2").arg(iteration).arg(totalAdjustments);
+        timeDiff = ((float)iteration / (float)(currentMillis - startMillis));
+        estimatedTime = (float)(totalAdjustments - iteration) / timeDiff;
+
+        ss += QObject::tr(" || Est. Time Remain: %1 || Iterations/Sec: %2").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime)).arg(timeDiff * 1000);
+        notifyStatusMessage(ss);
+
+        millis = QDateTime::currentMSecsSinceEpoch();
+        lastIteration = iteration;
       }
-      if((oldyc + yshift) < m_SizeY && (oldyc + yshift) > 0)
+
+      if(getCancel())
       {
-        yc = oldyc + yshift;
+        return;
       }
-      else
+
+      int32_t option = iteration % 2;
+
+      if(writeErrorFile && iteration % 25 == 0)
       {
-        yc = oldyc;
+        outFile << iteration << " " << m_FillingError << "  " << m_AvailablePoints.size() << "  " << m_AvailablePointsCount << " " << totalFeatures << " " << acceptedmoves << "\n";
       }
-      if((oldzc + zshift) < m_SizeZ && (oldzc + zshift) > 0)
+
+      randomfeature = selectRandomFeature();
+      oldxc = m_Centroids[3 * randomfeature];
+      oldyc = m_Centroids[3 * randomfeature + 1];
+      oldzc = m_Centroids[3 * randomfeature + 2];
+      // JUMP - this option moves one feature to a random spot in the volume
+      if(option == 0)
       {
-        zc = oldzc + zshift;
+        selectJumpTarget(xc, yc, zc);
       }
+      // NUDGE - this option moves one feature to a spot close to its current centroid
       else
       {
-        zc = oldzc;
+        selectNudgeTarget(randomfeature, xc, yc, zc);
       }
       m_OldFillingError = m_FillingError;
       m_FillingError = checkFillingError(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
@@ -1707,15 +1939,15 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
       if(m_FillingError <= m_OldFillingError)
       {
         m_OldNeighborhoodError = m_CurrentNeighborhoodError;
-        updateAvailablePoints(availablePoints, availablePointsInv);
+        updateAvailablePoints(exclusionOwnersPtr);
         acceptedmoves++;
       }
       //      else if(fillingerror > oldfillingerror || currentneighborhooderror < oldneighborhooderror)
       else if(m_FillingError > m_OldFillingError)
       {
-        m_FillingError = checkFillingError(-1000, static_cast<int>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
+        m_FillingError = checkFillingError(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
         moveFeature(randomfeature, oldxc, oldyc, oldzc);
-        m_FillingError = checkFillingError(static_cast<int>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+        m_FillingError = checkFillingError(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
         m_PointsToRemove.clear();
         m_PointsToAdd.clear();
       }
@@ -1785,7 +2017,8 @@ Int32ArrayType::Pointer PackPrimaryPhases::initializePackingGrid()
 // -----------------------------------------------------------------------------
 void PackPrimaryPhases::generateFeature(int32_t phase, Feature_t* feature, uint32_t shapeclass)
 {
-  SIMPL_RANDOMNG_NEW_SEEDED(m_Seed)
+  // every generated Feature draws from its own stream
+  SIMPL_RANDOMNG_NEW_SEEDED(PhiloxRandom::StreamSeed(m_RandomSeed, PhiloxRandom::StreamId(k_RandomStreamFilterId, k_FeatureGenerationStreams, m_RandomStream)))
 
   StatsDataArray& statsDataArray = *(m_StatsDataArray.lock().get());
 
@@ -1936,17 +2169,12 @@ void PackPrimaryPhases::moveFeature(size_t gnum, float xc, float yc, float zc)
   m_Centroids[3 * gnum] = xc;
   m_Centroids[3 * gnum + 1] = yc;
   m_Centroids[3 * gnum + 2] = zc;
-  size_t size = m_ColumnList[gnum].size();
 
-  for(size_t i = 0; i < size; i++)
-  {
-    int64_t& cl = m_ColumnList[gnum][i];
-    cl += shiftcolumn;
-    int64_t& rl = m_RowList[gnum][i];
-    rl += shiftrow;
-    int64_t& pl = m_PlaneList[gnum][i];
-    pl += shiftplane;
-  }
+  // The footprint is stored relative to the anchor, so only the anchor moves
+  std::array<int64_t, 3>& anchor = m_FootprintAnchors[gnum];
+  anchor[0] += shiftcolumn;
+  anchor[1] += shiftrow;
+  anchor[2] += shiftplane;
 }
 
 // -----------------------------------------------------------------------------
@@ -2292,216 +2520,149 @@ float PackPrimaryPhases::checkSizeDistError(Feature_t* feature)
 // -----------------------------------------------------------------------------
 float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr)
 {
-  size_t featureOwnersIdx = 0;
   int32_t* featureOwners = featureOwnersPtr->getPointer(0);
   int32_t* exclusionOwners = exclusionOwnersPtr->getPointer(0);
 
-  m_FillingError = m_FillingError * float(m_TotalPackingPoints);
-  int64_t col = 0, row = 0, plane = 0;
-  int32_t k1 = 0, k2 = 0, k3 = 0;
+  int64_t change = 0;
   if(gadd > 0)
   {
-    k1 = 2;
-    k2 = -1;
-    k3 = 1;
-    size_t numVoxelsForCurrentGrain = m_ColumnList[gadd].size();
-    std::vector<int64_t>& cl = m_ColumnList[gadd];
-    std::vector<int64_t>& rl = m_RowList[gadd];
-    std::vector<int64_t>& pl = m_PlaneList[gadd];
-    std::vector<float>& efl = m_EllipFuncList[gadd];
-    float packquality = 0;
-    for(size_t i = 0; i < numVoxelsForCurrentGrain; i++)
-    {
-      col = cl[i];
-      row = rl[i];
-      plane = pl[i];
-      if(m_PeriodicBoundaries)
-      {
-        // Perform mod arithmetic to ensure we are within the packing points range
-        col = col % m_PackingPoints[0];
-        row = row % m_PackingPoints[1];
-        plane = plane % m_PackingPoints[2];
-
-        if(col < 0)
-        {
-          col = col + m_PackingPoints[0];
-        }
-        if(col > m_PackingPoints[0] - 1)
-        {
-          col = col - m_PackingPoints[0];
-        }
-        if(row < 0)
-        {
-          row = row + m_PackingPoints[1];
-        }
-        if(row > m_PackingPoints[1] - 1)
-        {
-          row = row - m_PackingPoints[1];
-        }
-        if(plane < 0)
-        {
-          plane = plane + m_PackingPoints[2];
-        }
-        if(plane > m_PackingPoints[2] - 1)
-        {
-          plane = plane - m_PackingPoints[2];
-        }
-        featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
-        int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
-        if(efl[i] > 0.1f)
-        {
-          if(exclusionOwners[featureOwnersIdx] == 0)
-          {
-            m_PointsToRemove.push_back(featureOwnersIdx);
-          }
-          exclusionOwners[featureOwnersIdx]++;
-        }
-        m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
-        //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
-        featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
-        packquality = static_cast<float>(packquality + ((currentFeatureOwner) * (currentFeatureOwner)));
-      }
-      else
-      {
-        if(col >= 0 && col < m_PackingPoints[0] && row >= 0 && row < m_PackingPoints[1] && plane >= 0 && plane < m_PackingPoints[2])
-        {
-          featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
-          int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
-          if(exclusionOwners[featureOwnersIdx] > 0)
-          {
-          }
-          if(efl[i] > 0.1f)
-          {
-            if(exclusionOwners[featureOwnersIdx] == 0)
-            {
-              m_PointsToRemove.push_back(featureOwnersIdx);
-            }
-            exclusionOwners[featureOwnersIdx]++;
-          }
-          m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
-          //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
-          featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
-          packquality = static_cast<float>(packquality + ((currentFeatureOwner) * (currentFeatureOwner)));
-        }
-      }
-    }
-    m_PackQualities[gadd] = static_cast<int64_t>(packquality / float(numVoxelsForCurrentGrain));
+    change += updateFootprint(gadd, true, featureOwners, exclusionOwners, m_PointsToAdd, m_PointsToRemove);
   }
   if(gremove > 0)
   {
-    k1 = -2;
-    k2 = 3;
-    k3 = -1;
-    size_t size = m_ColumnList[gremove].size();
-    std::vector<int64_t>& cl = m_ColumnList[gremove];
-    std::vector<int64_t>& rl = m_RowList[gremove];
-    std::vector<int64_t>& pl = m_PlaneList[gremove];
-    std::vector<float>& efl = m_EllipFuncList[gremove];
-    for(size_t i = 0; i < size; i++)
-    {
-      col = cl[i];
-      row = rl[i];
-      plane = pl[i];
-      if(m_PeriodicBoundaries)
-      {
-        // Perform mod arithmetic to ensure we are within the packing points range
-        col = col % m_PackingPoints[0];
-        row = row % m_PackingPoints[1];
-        plane = plane % m_PackingPoints[2];
-
-        if(col < 0)
-        {
-          col = col + m_PackingPoints[0];
-        }
-        if(col > m_PackingPoints[0] - 1)
-        {
-          col = col - m_PackingPoints[0];
-        }
-        if(row < 0)
-        {
-          row = row + m_PackingPoints[1];
-        }
-        if(row > m_PackingPoints[1] - 1)
-        {
-          row = row - m_PackingPoints[1];
-        }
-        if(plane < 0)
-        {
-          plane = plane + m_PackingPoints[2];
-        }
-        if(plane > m_PackingPoints[2] - 1)
-        {
-          plane = plane - m_PackingPoints[2];
-        }
-        featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
-        int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
-        if(efl[i] > 0.1f)
+    change += updateFootprint(gremove, false, featureOwners, exclusionOwners, m_PointsToAdd, m_PointsToRemove);
+  }
+  m_FillingError = (m_FillingError * float(m_TotalPackingPoints) + static_cast<float>(change)) / float(m_TotalPackingPoints);
+  return m_FillingError;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t PackPrimaryPhases::updateFootprint(int32_t gnum, bool add, int32_t* featureOwners, int32_t* exclusionOwners, std::vector<size_t>& pointsToAdd, std::vector<size_t>& pointsToRemove)
+{
+  // Adding a Feature to a point owned by n Features changes (n - 1)^2 by 2n - 1, removing one changes it by 3 - 2n
+  const int32_t k1 = add ? 2 : -2;
+  const int32_t k2 = add ? -1 : 3;
+  const int32_t k3 = add ? 1 : -1;
+  const std::vector<FootprintVoxel>& footprint = m_Footprints[gnum];
+  const std::array<int64_t, 3>& anchor = m_FootprintAnchors[gnum];
+  int64_t change = 0;
+  float packquality = 0.0f;
+  for(const FootprintVoxel& voxel : footprint)
+  {
+    int64_t featureOwnersIdx = packingPointIndex(anchor[0] + voxel.column, anchor[1] + voxel.row, anchor[2] + voxel.plane);
+    if(featureOwnersIdx < 0)
+    {
+      continue;
+    }
+    int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
+    if(voxel.exclusion != 0)
+    {
+      if(add)
+      {
+        if(exclusionOwners[featureOwnersIdx] == 0)
         {
-          exclusionOwners[featureOwnersIdx]--;
-          if(exclusionOwners[featureOwnersIdx] == 0)
-          {
-            m_PointsToAdd.push_back(featureOwnersIdx);
-          }
+          pointsToRemove.push_back(static_cast<size_t>(featureOwnersIdx));
         }
-        m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
-        //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
-        featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
+        exclusionOwners[featureOwnersIdx]++;
       }
       else
       {
-        if(col >= 0 && col < m_PackingPoints[0] && row >= 0 && row < m_PackingPoints[1] && plane >= 0 && plane < m_PackingPoints[2])
+        exclusionOwners[featureOwnersIdx]--;
+        if(exclusionOwners[featureOwnersIdx] == 0)
         {
-          featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
-          int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
-          if(efl[i] > 0.1f)
-          {
-            exclusionOwners[featureOwnersIdx]--;
-            if(exclusionOwners[featureOwnersIdx] == 0)
-            {
-              m_PointsToAdd.push_back(featureOwnersIdx);
-            }
-          }
-          m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
-          //          fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
-          featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
+          pointsToAdd.push_back(static_cast<size_t>(featureOwnersIdx));
         }
       }
     }
+    change += k1 * currentFeatureOwner + k2;
+    featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
+    packquality = static_cast<float>(packquality + ((currentFeatureOwner) * (currentFeatureOwner)));
   }
-  m_FillingError = m_FillingError / float(m_TotalPackingPoints);
-  return m_FillingError;
+  if(add)
+  {
+    m_PackQualities[gnum] = static_cast<int64_t>(packquality / float(footprint.size()));
+  }
+  return change;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void PackPrimaryPhases::updateAvailablePoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv)
+int64_t PackPrimaryPhases::packingPointIndex(int64_t column, int64_t row, int64_t plane) const
 {
-  size_t removeSize = m_PointsToRemove.size();
-  size_t addSize = m_PointsToAdd.size();
-  size_t featureOwnersIdx = 0;
-  size_t key = 0, val = 0;
-  for(size_t i = 0; i < removeSize; i++)
+  if(m_PeriodicBoundaries)
   {
-    featureOwnersIdx = m_PointsToRemove[i];
-    key = availablePoints[featureOwnersIdx];
-    //  availablePoints.erase(featureOwnersIdx);
-    val = availablePointsInv[m_AvailablePointsCount - 1];
-    //  availablePointsInv.erase(availablePointsCount-1);
-    if(key < m_AvailablePointsCount - 1)
+    // Perform mod arithmetic to ensure we are within the packing points range
+    column = ((column % m_PackingPoints[0]) + m_PackingPoints[0]) % m_PackingPoints[0];
+    row = ((row % m_PackingPoints[1]) + m_PackingPoints[1]) % m_PackingPoints[1];
+    plane = ((plane % m_PackingPoints[2]) + m_PackingPoints[2]) % m_PackingPoints[2];
+  }
+  else if(column < 0 || column >= m_PackingPoints[0] || row < 0 || row >= m_PackingPoints[1] || plane < 0 || plane >= m_PackingPoints[2])
+  {
+    return -1;
+  }
+  return (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + column;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::initializeAvailablePoints(const Int32ArrayType::Pointer& exclusionOwnersPtr)
+{
+  int32_t* exclusionOwners = exclusionOwnersPtr->getPointer(0);
+
+  m_AvailablePoints.clear();
+  m_AvailablePointSlots.assign(m_TotalPackingPoints, -1);
+  for(int64_t i = 0; i < m_TotalPackingPoints; i++)
+  {
+    if((exclusionOwners[i] == 0 && !m_UseMask) || (exclusionOwners[i] == 0 && m_UseMask && m_Mask[i]))
     {
-      availablePointsInv[key] = val;
-      availablePoints[val] = key;
+      m_AvailablePointSlots[i] = static_cast<int64_t>(m_AvailablePoints.size());
+      m_AvailablePoints.push_back(i);
     }
-    m_AvailablePointsCount--;
   }
-  for(size_t i = 0; i < addSize; i++)
+  m_AvailablePointsCount = m_AvailablePoints.size();
+
+  // and clear the pointsToRemove and pointsToAdd vectors from the initial packing
+  m_PointsToRemove.clear();
+  m_PointsToAdd.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::updateAvailablePoints(const Int32ArrayType::Pointer& exclusionOwnersPtr)
+{
+  int32_t* exclusionOwners = exclusionOwnersPtr->getPointer(0);
+
+  // A point can be freed by the old position of a Feature and covered again by its new position,
+  // so the current exclusion state decides whether a point is actually added or removed
+  for(size_t featureOwnersIdx : m_PointsToRemove)
   {
-    featureOwnersIdx = m_PointsToAdd[i];
-    availablePoints[featureOwnersIdx] = m_AvailablePointsCount;
-    availablePointsInv[m_AvailablePointsCount] = featureOwnersIdx;
-    m_AvailablePointsCount++;
+    int64_t slot = m_AvailablePointSlots[featureOwnersIdx];
+    if(slot < 0 || exclusionOwners[featureOwnersIdx] == 0)
+    {
+      continue;
+    }
+    // Swap the last available point into the slot being freed
+    int64_t lastPoint = m_AvailablePoints.back();
+    m_AvailablePoints[slot] = lastPoint;
+    m_AvailablePointSlots[lastPoint] = slot;
+    m_AvailablePoints.pop_back();
+    m_AvailablePointSlots[featureOwnersIdx] = -1;
   }
+  for(size_t featureOwnersIdx : m_PointsToAdd)
+  {
+    if(m_AvailablePointSlots[featureOwnersIdx] >= 0 || exclusionOwners[featureOwnersIdx] != 0 || (m_UseMask && !m_Mask[featureOwnersIdx]))
+    {
+      continue;
+    }
+    m_AvailablePointSlots[featureOwnersIdx] = static_cast<int64_t>(m_AvailablePoints.size());
+    m_AvailablePoints.push_back(static_cast<int64_t>(featureOwnersIdx));
+  }
+  m_AvailablePointsCount = m_AvailablePoints.size();
   m_PointsToRemove.clear();
   m_PointsToAdd.clear();
 }
@@ -2511,8 +2672,6 @@ void PackPrimaryPhases::updateAvailablePoints(std::map<size_t, size_t>& availabl
 // -----------------------------------------------------------------------------
 void PackPrimaryPhases::insertFeature(size_t gnum)
 {
-  SIMPL_RANDOMNG_NEW();
-
   float inside = -1.0f;
   int64_t column = 0, row = 0, plane = 0;
   int64_t centercolumn = 0, centerrow = 0, centerplane = 0;
@@ -2594,6 +2753,17 @@ void PackPrimaryPhases::insertFeature(size_t gnum)
     zmax = (2 * m_PackingPoints[2] - 1);
   }
 
+  // The footprint offsets are stored as 16 bit values relative to the center point
+  std::array<int64_t, 3> halfExtents = {std::max(centercolumn - xmin, xmax - centercolumn), std::max(centerrow - ymin, ymax - centerrow), std::max(centerplane - zmin, zmax - centerplane)};
+  if(*std::max_element(halfExtents.begin(), halfExtents.end()) > std::numeric_limits<int16_t>::max())
+  {
+    QString ss = QObject::tr("Feature %1 spans more than %2 packing points from its center. Use a coarser packing resolution.").arg(gnum).arg(std::numeric_limits<int16_t>::max());
+    setErrorCondition(-78015, ss);
+    return;
+  }
+  m_FootprintAnchors[gnum] = {centercolumn, centerrow, centerplane};
+  std::vector<FootprintVoxel>& footprint = m_Footprints[gnum];
+
   float OneOverRadcur1 = 1.0f / radcur1;
   float OneOverRadcur2 = 1.0f / radcur2;
   float OneOverRadcur3 = 1.0f / radcur3;
@@ -2620,10 +2790,7 @@ void PackPrimaryPhases::insertFeature(size_t gnum)
         inside = m_ShapeOps[shapeclass]->inside(axis1comp, axis2comp, axis3comp);
         if(inside >= 0)
         {
-          m_ColumnList[gnum].push_back(column);
-          m_RowList[gnum].push_back(row);
-          m_PlaneList[gnum].push_back(plane);
-          m_EllipFuncList[gnum].push_back(inside);
+          footprint.push_back({static_cast<int16_t>(column - centercolumn), static_cast<int16_t>(row - centerrow), static_cast<int16_t>(plane - centerplane), static_cast<uint8_t>(inside > 0.1f ? 1 : 0)});
         }
       }
     }
@@ -3296,7 +3463,7 @@ int32_t PackPrimaryPhases::estimateNumFeatures(size_t xpoints, size_t ypoints, s
   // Create a Reference Variable so we can use the [] syntax
   StatsDataArray& statsDataArray = *(m_StatsDataArray.lock().get());
 
-  SIMPL_RANDOMNG_NEW()
+  SIMPL_RANDOMNG_NEW_SEEDED(PhiloxRandom::StreamSeed(m_RandomSeed, PhiloxRandom::StreamId(k_RandomStreamFilterId, k_EstimateStream, 0)))
 
   std::vector<int32_t> primaryPhasesLocal;
   std::vector<double> primaryPhaseFractionsLocal;
@@ -3837,6 +4004,42 @@ bool PackPrimaryPhases::getPeriodicBoundaries() const
   return m_PeriodicBoundaries;
 }
 
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::setUseParallelPlacement(bool value)
+{
+  m_UseParallelPlacement = value;
+}
+
+// -----------------------------------------------------------------------------
+bool PackPrimaryPhases::getUseParallelPlacement() const
+{
+  return m_UseParallelPlacement;
+}
+
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::setUseSeed(bool value)
+{
+  m_UseSeed = value;
+}
+
+// -----------------------------------------------------------------------------
+bool PackPrimaryPhases::getUseSeed() const
+{
+  return m_UseSeed;
+}
+
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::setSeedValue(int value)
+{
+  m_SeedValue = value;
+}
+
+// -----------------------------------------------------------------------------
+int PackPrimaryPhases::getSeedValue() const
+{
+  return m_SeedValue;
+}
+
 // -----------------------------------------------------------------------------
 void PackPrimaryPhases::setWriteGoalAttributes(bool value)
 {
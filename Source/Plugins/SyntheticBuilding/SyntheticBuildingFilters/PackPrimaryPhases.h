@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 
 #include "SIMPLib/SIMPLib.h"
@@ -89,6 +90,9 @@ class SyntheticBuilding_EXPORT PackPrimaryPhases : public AbstractFilter
   PYB11_PROPERTY(QString FeatureInputFile READ getFeatureInputFile WRITE setFeatureInputFile)
   PYB11_PROPERTY(QString CsvOutputFile READ getCsvOutputFile WRITE setCsvOutputFile)
   PYB11_PROPERTY(bool PeriodicBoundaries READ getPeriodicBoundaries WRITE setPeriodicBoundaries)
+  PYB11_PROPERTY(bool UseParallelPlacement READ getUseParallelPlacement WRITE setUseParallelPlacement)
+  PYB11_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+  PYB11_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
   PYB11_PROPERTY(bool WriteGoalAttributes READ getWriteGoalAttributes WRITE setWriteGoalAttributes)
   PYB11_PROPERTY(int SaveGeometricDescriptions READ getSaveGeometricDescriptions WRITE setSaveGeometricDescriptions)
   PYB11_PROPERTY(DataArrayPath NewAttributeMatrixPath READ getNewAttributeMatrixPath WRITE setNewAttributeMatrixPath)
@@ -322,6 +326,39 @@ public:
   bool getPeriodicBoundaries() const;
   Q_PROPERTY(bool PeriodicBoundaries READ getPeriodicBoundaries WRITE setPeriodicBoundaries)
 
+  /**
+   * @brief Setter property for UseParallelPlacement
+   */
+  void setUseParallelPlacement(bool value);
+  /**
+   * @brief Getter property for UseParallelPlacement
+   * @return Value of UseParallelPlacement
+   */
+  bool getUseParallelPlacement() const;
+  Q_PROPERTY(bool UseParallelPlacement READ getUseParallelPlacement WRITE setUseParallelPlacement)
+
+  /**
+   * @brief Setter property for UseSeed
+   */
+  void setUseSeed(bool value);
+  /**
+   * @brief Getter property for UseSeed
+   * @return Value of UseSeed
+   */
+  bool getUseSeed() const;
+  Q_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+
+  /**
+   * @brief Setter property for SeedValue
+   */
+  void setSeedValue(int value);
+  /**
+   * @brief Getter property for SeedValue
+   * @return Value of SeedValue
+   */
+  int getSeedValue() const;
+  Q_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
+
   /**
    * @brief Setter property for WriteGoalAttributes
    */
@@ -541,11 +578,37 @@ protected:
   float checkFillingError(int32_t gadd, int32_t gremove, Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr);
 
   /**
-   * @brief update_availablepoints Updates the maps used to associate packing points with an "available" state
-   * @param availablePoints Map between Feature owners and number of available points
-   * @param availablePointsInv Inverse associations for the availablePoints map
+   * @brief updateFootprint Adds or removes the footprint of a Feature at its current anchor and collects the
+   * packing points that enter or leave an exclusion zone. Only the packing points covered by the footprint are
+   * touched, so Features with disjoint footprints may be updated concurrently
+   * @param gnum Id of the Feature
+   * @param add Whether the Feature is added to or removed from the packing grid
+   * @param featureOwners Array of Feature Ids for each packing point
+   * @param exclusionOwners Array of exlusion Ids for each packing point
+   * @param pointsToAdd Receives the points that leave every exclusion zone
+   * @param pointsToRemove Receives the points that enter an exclusion zone
+   * @return Change in the sum of squared extra owners over the packing grid
    */
-  void updateAvailablePoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
+  int64_t updateFootprint(int32_t gnum, bool add, int32_t* featureOwners, int32_t* exclusionOwners, std::vector<size_t>& pointsToAdd, std::vector<size_t>& pointsToRemove);
+
+  /**
+   * @brief packingPointIndex Computes the index of a packing point, wrapping it for periodic boundaries
+   * @return Index of the packing point or -1 if it lies outside of a non-periodic packing grid
+   */
+  int64_t packingPointIndex(int64_t column, int64_t row, int64_t plane) const;
+
+  /**
+   * @brief initializeAvailablePoints Fills the pool of available packing points with every point that is not
+   * in an exclusion zone (and is inside the mask, if one is used)
+   * @param exclusionOwnersPtr Array of exlusion Ids for each packing point
+   */
+  void initializeAvailablePoints(const Int32ArrayType::Pointer& exclusionOwnersPtr);
+
+  /**
+   * @brief updateAvailablePoints Applies the points collected by checkFillingError to the pool of available points
+   * @param exclusionOwnersPtr Array of exlusion Ids for each packing point
+   */
+  void updateAvailablePoints(const Int32ArrayType::Pointer& exclusionOwnersPtr);
 
   /**
    * @brief assign_voxels Assigns Feature Id values to voxels within the packing grid
@@ -658,6 +721,9 @@ private:
   QString m_FeatureInputFile = {};
   QString m_CsvOutputFile = {};
   bool m_PeriodicBoundaries = {};
+  bool m_UseParallelPlacement = {};
+  bool m_UseSeed = {false};
+  int m_SeedValue = {0};
   bool m_WriteGoalAttributes = {};
   int m_SaveGeometricDescriptions = {};
   DataArrayPath m_NewAttributeMatrixPath = {};
@@ -688,15 +754,24 @@ private:
   ShapeOps::Pointer m_EllipsoidOps;
   ShapeOps::Pointer m_SuperEllipsoidOps;
 
-  std::vector<std::vector<int64_t>> m_ColumnList;
-  std::vector<std::vector<int64_t>> m_RowList;
-  std::vector<std::vector<int64_t>> m_PlaneList;
-  std::vector<std::vector<float>> m_EllipFuncList;
+  /**
+   * @brief The FootprintVoxel struct is one packing point covered by a Feature, stored relative to the Feature's anchor point
+   */
+  struct FootprintVoxel
+  {
+    int16_t column;
+    int16_t row;
+    int16_t plane;
+    uint8_t exclusion; // Set when the point is far enough inside the Feature to be part of its exclusion zone
+  };
+  std::vector<std::vector<FootprintVoxel>> m_Footprints;
+  std::vector<std::array<int64_t, 3>> m_FootprintAnchors;
 
   std::vector<size_t> m_PointsToAdd;
   std::vector<size_t> m_PointsToRemove;
 
-  uint64_t m_Seed;
+  uint64_t m_RandomSeed = 0;
+  uint64_t m_RandomStream;
 
   int32_t m_FirstPrimaryFeature;
 
@@ -727,6 +802,8 @@ private:
   std::vector<float> m_PrimaryPhaseFractions;
 
   size_t m_AvailablePointsCount;
+  std::vector<int64_t> m_AvailablePoints;
+  std::vector<int64_t> m_AvailablePointSlots;
   float m_FillingError, m_OldFillingError;
   float m_CurrentNeighborhoodError, m_OldNeighborhoodError;
   float m_CurrentSizeDistError, m_OldSizeDistError;
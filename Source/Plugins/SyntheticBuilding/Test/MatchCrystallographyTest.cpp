@@ -0,0 +1,433 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <array>
+#include <cmath>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataArrays/StatsDataArray.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/StatsData/PrimaryStatsData.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SyntheticBuilding/SyntheticBuildingFilters/MatchCrystallography.h"
+
+#include "SyntheticBuildingTestFileLocations.h"
+
+class MatchCrystallographyTest
+{
+  const QString k_StatsDataContainerName = QString("StatsGeneratorDataContainer");
+  const QString k_VolumeDataContainerName = QString("SyntheticVolumeDataContainer");
+  // The volume is a grid of k_Bricks^3 cubic Features with k_BrickSize Cells along each edge
+  static constexpr size_t k_Bricks = 8;
+  static constexpr size_t k_BrickSize = 4;
+  static constexpr int k_SeedValue = 5489;
+  static constexpr int k_MaxIterations = 20000;
+
+public:
+  MatchCrystallographyTest() = default;
+  virtual ~MatchCrystallographyTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the MatchCrystallography Filter from the FilterManager
+    // Also test for the stats filter that generates its input
+    FilterManager* fm = FilterManager::Instance();
+    QStringList filtNames = {"MatchCrystallography", "GeneratePrimaryStatsData"};
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The MatchCrystallographyTest Requires the use of the " << filtName.toStdString() << " filter which is found in the SyntheticBuilding Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer createFilter(const DataContainerArray::Pointer& dca, const QString& filtName)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == factory.get())
+    {
+      return AbstractFilter::NullPointer();
+    }
+    AbstractFilter::Pointer filter = factory->create();
+    filter->setDataContainerArray(dca);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void setProperty(const AbstractFilter::Pointer& filter, const char* name, const QVariant& value)
+  {
+    bool propWasSet = filter->setProperty(name, value);
+    if(!propWasSet)
+    {
+      qDebug() << "Unable to set property " << name;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QVariant pathVariant(const QString& dcName, const QString& amName, const QString& arrayName)
+  {
+    QVariant var;
+    var.setValue(DataArrayPath(dcName, amName, arrayName));
+    return var;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  size_t brickId(size_t x, size_t y, size_t z)
+  {
+    return 1 + x + k_Bricks * (y + k_Bricks * z);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds a cubic primary phase with GeneratePrimaryStatsData and a volume of brick shaped
+  // Features together with the neighbor lists and surface flags MatchCrystallography expects
+  // -----------------------------------------------------------------------------
+  int createInputs(const DataContainerArray::Pointer& dca)
+  {
+    AbstractFilter::Pointer filter = createFilter(dca, "GeneratePrimaryStatsData");
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    setProperty(filter, "PhaseName", QString("Primary"));
+    setProperty(filter, "CrystalSymmetry", static_cast<int>(EbsdLib::CrystalStructure::Cubic_High));
+    setProperty(filter, "MicroPresetModel", 0);
+    setProperty(filter, "PhaseFraction", 1.0);
+    setProperty(filter, "CreateEnsembleAttributeMatrix", true);
+    setProperty(filter, "AppendToExistingAttributeMatrix", false);
+    setProperty(filter, "DataContainerName", pathVariant(k_StatsDataContainerName, "", ""));
+    setProperty(filter, "CellEnsembleAttributeMatrixName", SIMPL::Defaults::CellEnsembleAttributeMatrixName);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    DataContainer::Pointer dc = DataContainer::New(k_VolumeDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    const size_t dim = k_Bricks * k_BrickSize;
+    std::vector<size_t> tDims = {dim, dim, dim};
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(tDims.data());
+    image->setSpacing(FloatVec3Type(1.0f, 1.0f, 1.0f));
+    image->setOrigin(FloatVec3Type(0.0f, 0.0f, 0.0f));
+    dc->setGeometry(image);
+
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(dim * dim * dim, SIMPL::CellData::FeatureIds, true);
+    cellAttrMat->insertOrAssign(featureIds);
+    for(size_t z = 0; z < dim; z++)
+    {
+      for(size_t y = 0; y < dim; y++)
+      {
+        for(size_t x = 0; x < dim; x++)
+        {
+          featureIds->setValue((z * dim + y) * dim + x, static_cast<int32_t>(brickId(x / k_BrickSize, y / k_BrickSize, z / k_BrickSize)));
+        }
+      }
+    }
+
+    const size_t numFeatures = k_Bricks * k_Bricks * k_Bricks + 1;
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New({numFeatures}, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAttrMat);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(numFeatures, SIMPL::FeatureData::Phases, true);
+    BoolArrayType::Pointer surfaceFeatures = BoolArrayType::CreateArray(numFeatures, SIMPL::FeatureData::SurfaceFeatures, true);
+    NeighborList<int32_t>::Pointer neighborList = NeighborList<int32_t>::CreateArray(numFeatures, SIMPL::FeatureData::NeighborList, true);
+    NeighborList<float>::Pointer sharedSurfaceAreaList = NeighborList<float>::CreateArray(numFeatures, SIMPL::FeatureData::SharedSurfaceAreaList, true);
+    phases->setValue(0, 0);
+    surfaceFeatures->setValue(0, false);
+    const float faceArea = static_cast<float>(k_BrickSize * k_BrickSize);
+    for(size_t z = 0; z < k_Bricks; z++)
+    {
+      for(size_t y = 0; y < k_Bricks; y++)
+      {
+        for(size_t x = 0; x < k_Bricks; x++)
+        {
+          size_t feature = brickId(x, y, z);
+          phases->setValue(feature, 1);
+          bool surface = x == 0 || y == 0 || z == 0 || x == k_Bricks - 1 || y == k_Bricks - 1 || z == k_Bricks - 1;
+          surfaceFeatures->setValue(feature, surface);
+
+          NeighborList<int32_t>::SharedVectorType neighbors(new std::vector<int32_t>);
+          NeighborList<float>::SharedVectorType areas(new std::vector<float>);
+          const std::array<std::array<int64_t, 3>, 6> offsets = {{{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}}};
+          for(const std::array<int64_t, 3>& offset : offsets)
+          {
+            int64_t nx = static_cast<int64_t>(x) + offset[0];
+            int64_t ny = static_cast<int64_t>(y) + offset[1];
+            int64_t nz = static_cast<int64_t>(z) + offset[2];
+            int64_t bricks = static_cast<int64_t>(k_Bricks);
+            if(nx < 0 || ny < 0 || nz < 0 || nx >= bricks || ny >= bricks || nz >= bricks)
+            {
+              continue;
+            }
+            neighbors->push_back(static_cast<int32_t>(brickId(static_cast<size_t>(nx), static_cast<size_t>(ny), static_cast<size_t>(nz))));
+            areas->push_back(faceArea);
+          }
+          neighborList->setList(static_cast<int32_t>(feature), neighbors);
+          sharedSurfaceAreaList->setList(static_cast<int32_t>(feature), areas);
+        }
+      }
+    }
+    featureAttrMat->insertOrAssign(phases);
+    featureAttrMat->insertOrAssign(surfaceFeatures);
+    featureAttrMat->insertOrAssign(neighborList);
+    featureAttrMat->insertOrAssign(sharedSurfaceAreaList);
+
+    AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New({2}, SIMPL::Defaults::CellEnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAttrMat);
+    Int32ArrayType::Pointer numFeaturesArray = Int32ArrayType::CreateArray(2, SIMPL::EnsembleData::NumFeatures, true);
+    numFeaturesArray->setValue(0, 0);
+    numFeaturesArray->setValue(1, static_cast<int32_t>(numFeatures - 1));
+    ensembleAttrMat->insertOrAssign(numFeaturesArray);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  MatchCrystallography::Pointer runMatching(const DataContainerArray::Pointer& dca, bool parallelMatching)
+  {
+    int err = createInputs(dca);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+
+    AbstractFilter::Pointer filter = createFilter(dca, "MatchCrystallography");
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    const QString statsAM = SIMPL::Defaults::CellEnsembleAttributeMatrixName;
+    const QString featureAM = SIMPL::Defaults::CellFeatureAttributeMatrixName;
+    setProperty(filter, "InputStatsArrayPath", pathVariant(k_StatsDataContainerName, statsAM, SIMPL::EnsembleData::Statistics));
+    setProperty(filter, "CrystalStructuresArrayPath", pathVariant(k_StatsDataContainerName, statsAM, SIMPL::EnsembleData::CrystalStructures));
+    setProperty(filter, "PhaseTypesArrayPath", pathVariant(k_StatsDataContainerName, statsAM, SIMPL::EnsembleData::PhaseTypes));
+    setProperty(filter, "FeatureIdsArrayPath", pathVariant(k_VolumeDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+    setProperty(filter, "FeaturePhasesArrayPath", pathVariant(k_VolumeDataContainerName, featureAM, SIMPL::FeatureData::Phases));
+    setProperty(filter, "SurfaceFeaturesArrayPath", pathVariant(k_VolumeDataContainerName, featureAM, SIMPL::FeatureData::SurfaceFeatures));
+    setProperty(filter, "NeighborListArrayPath", pathVariant(k_VolumeDataContainerName, featureAM, SIMPL::FeatureData::NeighborList));
+    setProperty(filter, "SharedSurfaceAreaListArrayPath", pathVariant(k_VolumeDataContainerName, featureAM, SIMPL::FeatureData::SharedSurfaceAreaList));
+    setProperty(filter, "NumFeaturesArrayPath", pathVariant(k_VolumeDataContainerName, statsAM, SIMPL::EnsembleData::NumFeatures));
+    setProperty(filter, "MaxIterations", k_MaxIterations);
+    setProperty(filter, "UseSeed", true);
+    setProperty(filter, "SeedValue", k_SeedValue);
+    setProperty(filter, "UseParallelMatching", parallelMatching);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    MatchCrystallography::Pointer matchFilter = std::dynamic_pointer_cast<MatchCrystallography>(filter);
+    DREAM3D_REQUIRE_VALID_POINTER(matchFilter.get())
+    return matchFilter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  typename DataArray<T>::Pointer getFeatureArray(const DataContainerArray::Pointer& dca, const QString& arrayName)
+  {
+    return dca->getAttributeMatrix(DataArrayPath(k_VolumeDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""))->getAttributeArrayAs<DataArray<T>>(arrayName);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  double squaredError(const FloatArrayType::Pointer& actual, const std::vector<double>& sim)
+  {
+    double error = 0.0;
+    for(size_t i = 0; i < sim.size(); i++)
+    {
+      double delta = static_cast<double>(actual->getValue(i)) - sim[i];
+      error += delta * delta;
+    }
+    return error;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSerialAndParallelMatchingAgree()
+  {
+    DataContainerArray::Pointer serialDca = DataContainerArray::New();
+    MatchCrystallography::Pointer serialFilter = runMatching(serialDca, false);
+    DataContainerArray::Pointer parallelDca = DataContainerArray::New();
+    MatchCrystallography::Pointer parallelFilter = runMatching(parallelDca, true);
+
+    FloatArrayType::Pointer serialEulers = getFeatureArray<float>(serialDca, SIMPL::FeatureData::EulerAngles);
+    FloatArrayType::Pointer parallelEulers = getFeatureArray<float>(parallelDca, SIMPL::FeatureData::EulerAngles);
+    DREAM3D_REQUIRE_VALID_POINTER(serialEulers.get())
+    DREAM3D_REQUIRE_VALID_POINTER(parallelEulers.get())
+    DREAM3D_REQUIRE_EQUAL(serialEulers->getSize(), parallelEulers->getSize())
+    for(size_t i = 0; i < serialEulers->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(serialEulers->getValue(i), parallelEulers->getValue(i))
+    }
+
+    DREAM3D_REQUIRE(serialFilter->getOdfErrors() == parallelFilter->getOdfErrors())
+    DREAM3D_REQUIRE(serialFilter->getMdfErrors() == parallelFilter->getMdfErrors())
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Rebuilds the simulated ODF and MDF from the matched orientations and compares their errors
+  // with the errors the filter maintained from the change of every accepted move
+  // -----------------------------------------------------------------------------
+  int TestIncrementalErrorsMatchRecomputation()
+  {
+    for(bool parallelMatching : {false, true})
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      MatchCrystallography::Pointer filter = runMatching(dca, parallelMatching);
+
+      StatsDataArray::Pointer statsArray =
+          dca->getAttributeMatrix(DataArrayPath(k_StatsDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, ""))->getAttributeArrayAs<StatsDataArray>(SIMPL::EnsembleData::Statistics);
+      DREAM3D_REQUIRE_VALID_POINTER(statsArray.get())
+      PrimaryStatsData::Pointer stats = std::dynamic_pointer_cast<PrimaryStatsData>((*statsArray)[1]);
+      DREAM3D_REQUIRE_VALID_POINTER(stats.get())
+      FloatArrayType::Pointer actualOdf = stats->getODF();
+      FloatArrayType::Pointer actualMdf = stats->getMisorientationBins();
+
+      FloatArrayType::Pointer volumes = getFeatureArray<float>(dca, SIMPL::FeatureData::Volumes);
+      FloatArrayType::Pointer eulers = getFeatureArray<float>(dca, SIMPL::FeatureData::EulerAngles);
+      FloatArrayType::Pointer quats = getFeatureArray<float>(dca, SIMPL::FeatureData::AvgQuats);
+      BoolArrayType::Pointer surfaceFeatures = getFeatureArray<bool>(dca, SIMPL::FeatureData::SurfaceFeatures);
+      AttributeMatrix::Pointer featureAttrMat = dca->getAttributeMatrix(DataArrayPath(k_VolumeDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""));
+      NeighborList<int32_t>::Pointer neighborList = featureAttrMat->getAttributeArrayAs<NeighborList<int32_t>>(SIMPL::FeatureData::NeighborList);
+      NeighborList<float>::Pointer sharedSurfaceAreaList = featureAttrMat->getAttributeArrayAs<NeighborList<float>>(SIMPL::FeatureData::SharedSurfaceAreaList);
+
+      LaueOps::Pointer laueOp = LaueOps::GetAllOrientationOps()[EbsdLib::CrystalStructure::Cubic_High];
+      size_t numFeatures = volumes->getNumberOfTuples();
+
+      double unbiasedVolume = 0.0;
+      double totalSurfaceArea = 0.0;
+      for(size_t i = 1; i < numFeatures; i++)
+      {
+        if(!surfaceFeatures->getValue(i))
+        {
+          unbiasedVolume += volumes->getValue(i);
+        }
+        for(const float& area : sharedSurfaceAreaList->getListReference(static_cast<int32_t>(i)))
+        {
+          totalSurfaceArea += area;
+        }
+      }
+
+      std::vector<double> simOdf(actualOdf->getSize(), 0.0);
+      std::vector<double> simMdf(actualMdf->getSize(), 0.0);
+      for(size_t i = 1; i < numFeatures; i++)
+      {
+        if(surfaceFeatures->getValue(i))
+        {
+          continue;
+        }
+        OrientationD eu(eulers->getValue(3 * i), eulers->getValue(3 * i + 1), eulers->getValue(3 * i + 2));
+        OrientationD rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
+        simOdf[laueOp->getOdfBin(rod)] += volumes->getValue(i) / unbiasedVolume;
+
+        // A boundary is counted from its lower Feature unless the other side is a surface Feature
+        QuatF q1(quats->getValue(4 * i), quats->getValue(4 * i + 1), quats->getValue(4 * i + 2), quats->getValue(4 * i + 3));
+        const std::vector<int32_t>& neighbors = neighborList->getListReference(static_cast<int32_t>(i));
+        const std::vector<float>& areas = sharedSurfaceAreaList->getListReference(static_cast<int32_t>(i));
+        for(size_t j = 0; j < neighbors.size(); j++)
+        {
+          int32_t neighbor = neighbors[j];
+          if(neighbor < static_cast<int32_t>(i) && !surfaceFeatures->getValue(neighbor))
+          {
+            continue;
+          }
+          QuatF q2(quats->getValue(4 * neighbor), quats->getValue(4 * neighbor + 1), quats->getValue(4 * neighbor + 2), quats->getValue(4 * neighbor + 3));
+          OrientationD axisAngle = neighbor > static_cast<int32_t>(i) ? laueOp->calculateMisorientation(q1, q2) : laueOp->calculateMisorientation(q2, q1);
+          OrientationD misoRod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
+          simMdf[laueOp->getMisoBin(misoRod)] += areas[j] / totalSurfaceArea;
+        }
+      }
+
+      double odfError = squaredError(actualOdf, simOdf);
+      double mdfError = squaredError(actualMdf, simMdf);
+      std::vector<double> odfErrors = filter->getOdfErrors();
+      std::vector<double> mdfErrors = filter->getMdfErrors();
+      DREAM3D_REQUIRE_EQUAL(odfErrors.size(), statsArray->getNumberOfTuples())
+      DREAM3D_REQUIRE_EQUAL(mdfErrors.size(), statsArray->getNumberOfTuples())
+      DREAM3D_REQUIRE(odfError > 0.0 && mdfError > 0.0)
+      DREAM3D_REQUIRE(std::fabs(odfErrors[1] - odfError) <= 1.0E-3 * odfError)
+      DREAM3D_REQUIRE(std::fabs(mdfErrors[1] - mdfError) <= 1.0E-3 * mdfError)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestSerialAndParallelMatchingAgree())
+    DREAM3D_REGISTER_TEST(TestIncrementalErrorsMatchRecomputation())
+  }
+
+public:
+  MatchCrystallographyTest(const MatchCrystallographyTest&) = delete;            // Copy Constructor Not Implemented
+  MatchCrystallographyTest(MatchCrystallographyTest&&) = delete;                 // Move Constructor Not Implemented
+  MatchCrystallographyTest& operator=(const MatchCrystallographyTest&) = delete; // Copy Assignment Not Implemented
+  MatchCrystallographyTest& operator=(MatchCrystallographyTest&&) = delete;      // Move Assignment Not Implemented
+};
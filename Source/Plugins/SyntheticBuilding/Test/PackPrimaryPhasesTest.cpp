@@ -0,0 +1,353 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/ShapeType.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#endif
+
+#include "UnitTestSupport.hpp"
+
+#include "SyntheticBuildingTestFileLocations.h"
+
+class PackPrimaryPhasesTest
+{
+  const QString k_StatsDataContainerName = QString("StatsGeneratorDataContainer");
+  const QString k_VolumeDataContainerName = QString("SyntheticVolumeDataContainer");
+  const QString k_ShapeParametersName = QString("Synthetic Shape Parameters (Primary Phase)");
+  static constexpr size_t k_Dimension = 40;
+  static constexpr int k_SeedValue = 5489;
+  // Primary phase fractions given to GeneratePrimaryStatsData, Phase 0 is the unused slot
+  const std::vector<float> k_PhaseFractions = {0.0f, 0.7f, 0.3f};
+
+public:
+  PackPrimaryPhasesTest() = default;
+  virtual ~PackPrimaryPhasesTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the PackPrimaryPhases Filter from the FilterManager
+    // Also test for the stats filter that generates its input
+    FilterManager* fm = FilterManager::Instance();
+    QStringList filtNames = {"PackPrimaryPhases", "GeneratePrimaryStatsData"};
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The PackPrimaryPhasesTest Requires the use of the " << filtName.toStdString() << " filter which is found in the SyntheticBuilding Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer createFilter(const DataContainerArray::Pointer& dca, const QString& filtName)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == factory.get())
+    {
+      return AbstractFilter::NullPointer();
+    }
+    AbstractFilter::Pointer filter = factory->create();
+    filter->setDataContainerArray(dca);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void setProperty(const AbstractFilter::Pointer& filter, const char* name, const QVariant& value)
+  {
+    bool propWasSet = filter->setProperty(name, value);
+    if(!propWasSet)
+    {
+      qDebug() << "Unable to set property " << name;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QVariant pathVariant(const QString& dcName, const QString& amName, const QString& arrayName)
+  {
+    QVariant var;
+    var.setValue(DataArrayPath(dcName, amName, arrayName));
+    return var;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds two equiaxed primary phases with GeneratePrimaryStatsData plus the Shape Types
+  // array, and an empty Image Geometry for the packing
+  // -----------------------------------------------------------------------------
+  int createInputs(const DataContainerArray::Pointer& dca)
+  {
+    for(size_t phase = 1; phase < k_PhaseFractions.size(); phase++)
+    {
+      AbstractFilter::Pointer filter = createFilter(dca, "GeneratePrimaryStatsData");
+      DREAM3D_REQUIRE(filter.get() != nullptr);
+      setProperty(filter, "PhaseName", QString("Primary %1").arg(phase));
+      setProperty(filter, "CrystalSymmetry", 1);
+      setProperty(filter, "MicroPresetModel", 0);
+      setProperty(filter, "PhaseFraction", static_cast<double>(k_PhaseFractions[phase]));
+      setProperty(filter, "Mu", 2.0);
+      setProperty(filter, "Sigma", 0.1);
+      setProperty(filter, "MinCutOff", 5.0);
+      setProperty(filter, "MaxCutOff", 5.0);
+      setProperty(filter, "BinStepSize", 0.5);
+      setProperty(filter, "CreateEnsembleAttributeMatrix", phase == 1);
+      setProperty(filter, "AppendToExistingAttributeMatrix", phase != 1);
+      setProperty(filter, "DataContainerName", pathVariant(k_StatsDataContainerName, "", ""));
+      setProperty(filter, "CellEnsembleAttributeMatrixName", SIMPL::Defaults::CellEnsembleAttributeMatrixName);
+      setProperty(filter, "SelectedEnsembleAttributeMatrix", pathVariant(k_StatsDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, ""));
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+    }
+
+    AttributeMatrix::Pointer ensembleAttrMat = dca->getAttributeMatrix(DataArrayPath(k_StatsDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, ""));
+    DREAM3D_REQUIRE_VALID_POINTER(ensembleAttrMat.get())
+    UInt32ArrayType::Pointer shapeTypes = UInt32ArrayType::CreateArray(k_PhaseFractions.size(), SIMPL::EnsembleData::ShapeTypes, true);
+    shapeTypes->setValue(0, static_cast<ShapeType::EnumType>(ShapeType::Type::Unknown));
+    for(size_t phase = 1; phase < k_PhaseFractions.size(); phase++)
+    {
+      shapeTypes->setValue(phase, static_cast<ShapeType::EnumType>(ShapeType::Type::Ellipsoid));
+    }
+    ensembleAttrMat->insertOrAssign(shapeTypes);
+
+    DataContainer::Pointer dc = DataContainer::New(k_VolumeDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    std::vector<size_t> tDims = {k_Dimension, k_Dimension, k_Dimension};
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(tDims.data());
+    image->setSpacing(FloatVec3Type(1.0f, 1.0f, 1.0f));
+    image->setOrigin(FloatVec3Type(0.0f, 0.0f, 0.0f));
+    dc->setGeometry(image);
+    AttributeMatrix::Pointer attrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(attrMat);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Packs a fresh volume with a fixed seed. A threadCount of 0 leaves the thread count to TBB
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer runPacking(bool parallelPlacement, int threadCount)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    int err = createInputs(dca);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+
+    AbstractFilter::Pointer filter = createFilter(dca, "PackPrimaryPhases");
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    setProperty(filter, "OutputCellAttributeMatrixPath", pathVariant(k_VolumeDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+    setProperty(filter, "OutputCellFeatureAttributeMatrixName", SIMPL::Defaults::CellFeatureAttributeMatrixName);
+    setProperty(filter, "OutputCellEnsembleAttributeMatrixName", SIMPL::Defaults::CellEnsembleAttributeMatrixName);
+    setProperty(filter, "InputStatsArrayPath", pathVariant(k_StatsDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::Statistics));
+    setProperty(filter, "InputPhaseTypesArrayPath", pathVariant(k_StatsDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::PhaseTypes));
+    setProperty(filter, "InputPhaseNamesArrayPath", pathVariant(k_StatsDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::PhaseName));
+    setProperty(filter, "InputShapeTypesArrayPath", pathVariant(k_StatsDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::ShapeTypes));
+    setProperty(filter, "UseMask", false);
+    setProperty(filter, "FeatureGeneration", 0);
+    setProperty(filter, "PeriodicBoundaries", false);
+    setProperty(filter, "WriteGoalAttributes", false);
+    setProperty(filter, "UseParallelPlacement", parallelPlacement);
+    setProperty(filter, "UseSeed", true);
+    setProperty(filter, "SeedValue", k_SeedValue);
+    setProperty(filter, "SaveGeometricDescriptions", 1);
+    setProperty(filter, "NewAttributeMatrixPath", pathVariant(k_VolumeDataContainerName, k_ShapeParametersName, ""));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(threadCount > 0)
+    {
+      tbb::task_arena arena(threadCount);
+      arena.execute([&] { filter->execute(); });
+    }
+    else
+    {
+      filter->execute();
+    }
+#else
+    (void)threadCount;
+    filter->execute();
+#endif
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  Int32ArrayType::Pointer getFeatureIds(const DataContainerArray::Pointer& dca)
+  {
+    return dca->getAttributeMatrix(DataArrayPath(k_VolumeDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""))->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Fraction of the goal Feature volume that is missing from the packed volume. The gaps left
+  // by the packing are grown into afterwards, so a Feature only ends up below its goal volume
+  // where it overlapped its neighbors.
+  // -----------------------------------------------------------------------------
+  float lostVolumeFraction(const DataContainerArray::Pointer& dca)
+  {
+    Int32ArrayType::Pointer featureIds = getFeatureIds(dca);
+    FloatArrayType::Pointer goalVolumes =
+        dca->getAttributeMatrix(DataArrayPath(k_VolumeDataContainerName, k_ShapeParametersName, ""))->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::Volumes);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+    DREAM3D_REQUIRE_VALID_POINTER(goalVolumes.get())
+
+    std::vector<size_t> counts(goalVolumes->getNumberOfTuples(), 0);
+    for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+    {
+      int32_t featureId = featureIds->getValue(i);
+      DREAM3D_REQUIRE(featureId >= 0 && static_cast<size_t>(featureId) < counts.size())
+      counts[featureId]++;
+    }
+
+    double goal = 0.0;
+    double lost = 0.0;
+    for(size_t i = 1; i < counts.size(); i++)
+    {
+      double goalVolume = static_cast<double>(goalVolumes->getValue(i));
+      goal += goalVolume;
+      lost += std::max(0.0, goalVolume - static_cast<double>(counts[i]));
+    }
+    DREAM3D_REQUIRE(goal > 0.0)
+    return static_cast<float>(lost / goal);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestParallelPlacementIsValid()
+  {
+    DataContainerArray::Pointer dca = runPacking(true, 0);
+
+    Int32ArrayType::Pointer featureIds = getFeatureIds(dca);
+    Int32ArrayType::Pointer cellPhases =
+        dca->getAttributeMatrix(DataArrayPath(k_VolumeDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""))->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+    DREAM3D_REQUIRE_VALID_POINTER(cellPhases.get())
+
+    // Every Cell belongs to a Feature once the gaps are filled
+    std::vector<size_t> phaseCounts(k_PhaseFractions.size(), 0);
+    for(size_t i = 0; i < cellPhases->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE(featureIds->getValue(i) > 0)
+      int32_t phase = cellPhases->getValue(i);
+      DREAM3D_REQUIRE(phase > 0 && static_cast<size_t>(phase) < phaseCounts.size())
+      phaseCounts[phase]++;
+    }
+
+    float totalFraction = 0.0f;
+    for(size_t phase = 1; phase < k_PhaseFractions.size(); phase++)
+    {
+      totalFraction += k_PhaseFractions[phase];
+    }
+    for(size_t phase = 1; phase < k_PhaseFractions.size(); phase++)
+    {
+      float fraction = static_cast<float>(phaseCounts[phase]) / static_cast<float>(cellPhases->getNumberOfTuples());
+      DREAM3D_REQUIRE(std::fabs(fraction - k_PhaseFractions[phase] / totalFraction) < 0.1f)
+    }
+
+    // The batched placement drops conflicting moves, so allow it slightly less compaction than the serial placement
+    float parallelLost = lostVolumeFraction(dca);
+    float serialLost = lostVolumeFraction(runPacking(false, 0));
+    DREAM3D_REQUIRE(parallelLost < 0.25f)
+    DREAM3D_REQUIRE(parallelLost <= serialLost + 0.05f)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestParallelPlacementIsDeterministic()
+  {
+    Int32ArrayType::Pointer reference = getFeatureIds(runPacking(true, 1));
+    DREAM3D_REQUIRE_VALID_POINTER(reference.get())
+
+    std::vector<int> threadCounts = {0, 2, 1};
+    for(int threadCount : threadCounts)
+    {
+      Int32ArrayType::Pointer featureIds = getFeatureIds(runPacking(true, threadCount));
+      DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+      DREAM3D_REQUIRE_EQUAL(featureIds->getNumberOfTuples(), reference->getNumberOfTuples())
+      for(size_t i = 0; i < reference->getNumberOfTuples(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), reference->getValue(i))
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestParallelPlacementIsValid())
+    DREAM3D_REGISTER_TEST(TestParallelPlacementIsDeterministic())
+  }
+
+public:
+  PackPrimaryPhasesTest(const PackPrimaryPhasesTest&) = delete;            // Copy Constructor Not Implemented
+  PackPrimaryPhasesTest(PackPrimaryPhasesTest&&) = delete;                 // Move Constructor Not Implemented
+  PackPrimaryPhasesTest& operator=(const PackPrimaryPhasesTest&) = delete; // Copy Assignment Not Implemented
+  PackPrimaryPhasesTest& operator=(PackPrimaryPhasesTest&&) = delete;      // Move Assignment Not Implemented
+};